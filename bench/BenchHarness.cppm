@@ -0,0 +1,223 @@
+module;
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+export module Bench.Harness;
+
+import Core.Types;
+import Core.Log;
+import ECS.Component;
+import std;
+
+// The micro-benchmark harness. Every kernel runs in batches sized so one batch takes at least
+// --batch-ms; after --warmup batches (which also let the CPU settle on its clock) it is timed
+// --reps times and the best and median batch are reported per op. Inputs derive from --seed,
+// and each kernel's checksum must match across runs and changes that claim to keep results
+// identical.
+//
+//   <tool> [--filter substr] [--reps N] [--warmup N] [--batch-ms ms] [--seed N]
+//          [--format text|json|csv] [--out file] [--pin cpu]
+
+// Components for ECS kernels, with ids no engine component uses.
+export struct Position { F32 x{}, y{}, z{}; };
+export struct Velocity { F32 x{}, y{}, z{}; };
+
+export template<> struct ComponentTypeID<Position> { static consteval ComponentID value() { return 50; } };
+export template<> struct ComponentTypeID<Velocity> { static consteval ComponentID value() { return 51; } };
+
+export U64 Bits(F32 v) { return std::bit_cast<U32>(v); }
+
+export U64 Mix(U64 h, U64 v) { return (h ^ v) * 0x100000001B3ull; }
+
+// Ends an iteration: the compiler has to assume memory changed, so it can neither hoist a
+// pure kernel out of the loop nor fold repeated iterations into one.
+export void Clobber() { std::atomic_signal_fence(std::memory_order_seq_cst); }
+
+// One kernel: prepare sets up the inputs of a batch outside the timed region, run executes
+// `iterations` identical iterations of opsPerIteration ops each and returns the checksum of
+// the last one, so it does not depend on the batch size.
+export struct Kernel {
+    std::function<void(U64)> prepare{};
+    std::function<U64(U64)> run{};
+    U64 opsPerIteration{1};
+};
+
+// make returns no kernel when the seed yields no input or the CPU lacks the instructions.
+export struct Benchmark {
+    std::string name{};
+    std::string unit{};
+    std::function<std::optional<Kernel>(U64 seed)> make{};
+};
+
+namespace {
+    struct Options {
+        std::string filter{};
+        U32 reps{15};
+        U32 warmup{3};
+        F64 batchMs{20.0};
+        U64 seed{0x5EEDu};
+        std::string format{"text"};
+        std::string out{};
+        S32 pin{-1};
+    };
+
+    struct Result {
+        std::string name{};
+        std::string unit{};
+        U64 opsPerBatch{};
+        F64 bestNs{};
+        F64 medianNs{};
+        F64 meanNs{};
+        F64 stddevNs{};
+        U64 checksum{};
+    };
+
+    std::optional<Options> ParseOptions(int argc, char** argv) {
+        Options o{};
+        for (int i{1}; i < argc; ++i) {
+            const std::string_view arg{argv[i]};
+            if (i + 1 >= argc) return std::nullopt;
+            const std::string value{argv[++i]};
+            if (arg == "--filter") o.filter = value;
+            else if (arg == "--reps") o.reps = std::max(1u, static_cast<U32>(std::stoul(value)));
+            else if (arg == "--warmup") o.warmup = static_cast<U32>(std::stoul(value));
+            else if (arg == "--batch-ms") o.batchMs = std::stod(value);
+            else if (arg == "--seed") o.seed = std::stoull(value, nullptr, 0);
+            else if (arg == "--format") o.format = value;
+            else if (arg == "--out") o.out = value;
+            else if (arg == "--pin") o.pin = std::stoi(value);
+            else return std::nullopt;
+        }
+        if (o.format != "text" && o.format != "json" && o.format != "csv") return std::nullopt;
+        return o;
+    }
+
+    // Keeps the calling thread on one core so migrations do not show up as noise.
+    bool PinToCpu(S32 cpu) {
+#if defined(_WIN32)
+        return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu) != 0;
+#elif defined(__linux__)
+        cpu_set_t set{};
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    F64 TimeBatch(Kernel const& k, U64 iterations, U64& checksum) {
+        if (k.prepare) k.prepare(iterations);
+        const auto start{std::chrono::steady_clock::now()};
+        checksum = k.run(iterations);
+        return std::chrono::duration<F64, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    Result Measure(std::string_view tool, Benchmark const& b, Kernel const& k, Options const& opt) {
+        U64 checksum{};
+
+        // Doubles the batch until it is long enough for the clock to resolve it well.
+        U64 iterations{1};
+        const F64 target{opt.batchMs * 1e6};
+        for (;;) {
+            const F64 ns{TimeBatch(k, iterations, checksum)};
+            if (ns >= target || iterations >= (1ull << 30)) break;
+            const F64 scale{ns > 0.0 ? target / ns : 16.0};
+            iterations = std::max(iterations * 2u, static_cast<U64>(static_cast<F64>(iterations) * std::min(scale, 16.0)));
+        }
+
+        for (U32 i{}; i < opt.warmup; ++i) TimeBatch(k, iterations, checksum);
+
+        const F64 ops{static_cast<F64>(iterations * k.opsPerIteration)};
+        Vector<F64> perOp{};
+        perOp.reserve(opt.reps);
+        U64 first{};
+        for (U32 r{}; r < opt.reps; ++r) {
+            perOp.push_back(TimeBatch(k, iterations, checksum) / ops);
+            if (r == 0) first = checksum;
+            else if (checksum != first) std::cerr << std::format("{}: {} checksum changed between repetitions\n", tool, b.name);
+        }
+
+        Result res{b.name, b.unit, iterations * k.opsPerIteration};
+        std::ranges::sort(perOp);
+        res.bestNs = perOp.front();
+        res.medianNs = perOp.size() % 2 ? perOp[perOp.size() / 2] : 0.5 * (perOp[perOp.size() / 2 - 1] + perOp[perOp.size() / 2]);
+        res.meanNs = std::accumulate(perOp.begin(), perOp.end(), 0.0) / static_cast<F64>(perOp.size());
+        F64 var{};
+        for (F64 v : perOp) var += (v - res.meanNs) * (v - res.meanNs);
+        res.stddevNs = std::sqrt(var / static_cast<F64>(perOp.size()));
+        res.checksum = checksum;
+        return res;
+    }
+
+    std::string Report(std::string_view tool, Vector<Result> const& results, Options const& opt) {
+        std::string s{};
+        if (opt.format == "json") {
+            s += std::format("{{\n  \"benchmark\": \"{}\",\n  \"seed\": {},\n  \"reps\": {},\n  \"warmup\": {},\n  \"results\": [", tool, opt.seed, opt.reps, opt.warmup);
+            for (USize i{}; i < results.size(); ++i) {
+                Result const& r{results[i]};
+                s += std::format("{}\n    {{\"name\": \"{}\", \"unit\": \"{}\", \"opsPerBatch\": {}, \"bestNs\": {:.3f}, \"medianNs\": {:.3f}, "
+                                 "\"meanNs\": {:.3f}, \"stddevNs\": {:.3f}, \"checksum\": \"{:016x}\"}}",
+                                 i ? "," : "", r.name, r.unit, r.opsPerBatch, r.bestNs, r.medianNs, r.meanNs, r.stddevNs, r.checksum);
+            }
+            s += "\n  ]\n}\n";
+        } else if (opt.format == "csv") {
+            s += "name,unit,ops_per_batch,best_ns,median_ns,mean_ns,stddev_ns,checksum\n";
+            for (Result const& r : results) {
+                s += std::format("{},{},{},{:.3f},{:.3f},{:.3f},{:.3f},{:016x}\n", r.name, r.unit, r.opsPerBatch, r.bestNs, r.medianNs, r.meanNs, r.stddevNs, r.checksum);
+            }
+        } else {
+            s += std::format("seed {:#x}, {} reps after {} warmup batches\n", opt.seed, opt.reps, opt.warmup);
+            s += std::format("{:<30} {:>14} {:>14} {:>7} {:>14}  {}\n", "kernel", "best ns/op", "median ns/op", "cv", "ops/s", "checksum");
+            for (Result const& r : results) {
+                s += std::format("{:<30} {:>14.2f} {:>14.2f} {:>6.1f}% {:>14.0f}  {:016x}  ({})\n", r.name, r.bestNs, r.medianNs,
+                                 r.meanNs > 0.0 ? 100.0 * r.stddevNs / r.meanNs : 0.0, r.bestNs > 0.0 ? 1e9 / r.bestNs : 0.0, r.checksum, r.unit);
+            }
+        }
+        return s;
+    }
+}
+
+// Parses the command line, measures every benchmark of the registry that matches the filter
+// and writes the report. Returns the process exit code.
+export int RunBenchmarks(std::string_view tool, Vector<Benchmark> const& registry, int argc, char** argv) {
+    const std::optional<Options> parsed{ParseOptions(argc, argv)};
+    if (!parsed) {
+        std::cerr << std::format("usage: {} [--filter substr] [--reps N] [--warmup N] [--batch-ms ms] [--seed N]"
+                                 " [--format text|json|csv] [--out file] [--pin cpu]\n", tool);
+        return 2;
+    }
+    Options const& opt{*parsed};
+
+    // Machine-readable output owns stdout; progress and warnings go to stderr.
+    Logger::EnableConsole(false);
+    if (opt.pin >= 0 && !PinToCpu(opt.pin)) std::cerr << std::format("{}: cannot pin to cpu {}\n", tool, opt.pin);
+
+    Vector<Result> results{};
+    for (Benchmark const& b : registry) {
+        if (!opt.filter.empty() && b.name.find(opt.filter) == std::string::npos) continue;
+        std::cerr << std::format("{}...\n", b.name);
+        const std::optional<Kernel> kernel{b.make(opt.seed)};
+        if (!kernel) {
+            std::cerr << std::format("{}: {} has no input for seed {:#x} or is not supported here, skipped\n", tool, b.name, opt.seed);
+            continue;
+        }
+        results.push_back(Measure(tool, b, *kernel, opt));
+    }
+
+    const std::string report{Report(tool, results, opt)};
+    if (opt.out.empty()) {
+        std::cout << report;
+    } else {
+        std::ofstream file{opt.out};
+        if (!file) {
+            std::cerr << std::format("{}: cannot write '{}'\n", tool, opt.out);
+            return 1;
+        }
+        file << report;
+    }
+    return 0;
+}
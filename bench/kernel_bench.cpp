@@ -0,0 +1,570 @@
+import Core.Types;
+import ECS.Component;
+import ECS.World;
+import ECS.Query;
+import Components.Voxel;
+import Components.VoxelChunkIndex;
+import Systems.VoxelGeneration;
+import Systems.VoxelColumnCache;
+import Systems.VoxelMesher;
+import Systems.VoxelMeshing;
+import Systems.VoxelNoise;
+import Systems.VoxelRaycast;
+import Tasks.TaskGraph;
+import Math.Core;
+import Math.Vector;
+import Math.Matrix;
+import Math.Transform;
+import Math.Culling;
+import Bench.Harness;
+import std;
+
+// Micro-benchmarks for the engine's hot kernels, measured by Bench.Harness. SIMD variants of
+// a kernel are separate entries over the same input, so matching checksums show they agree.
+
+namespace {
+    // ===== Voxel =====
+
+    constexpr F32 kBlockSize{1.0f};
+
+    U64 HashBlocks(VoxelBlocks const& blocks) {
+        U64 h{0xCBF29CE484222325ull};
+        for (U32 i{}; i < VoxelBlocks::Volume; i += 61) h = Mix(h, static_cast<U64>(blocks.Get(i)));
+        return h;
+    }
+
+    U64 HashMesh(VoxelMeshBuffers const& mesh) {
+        U64 h{Mix(mesh.vertices.size(), mesh.indices.size())};
+        for (USize i{}; i < mesh.vertices.size(); i += 97) h = Mix(h, (static_cast<U64>(mesh.vertices[i].hi) << 32) | mesh.vertices[i].lo);
+        return h;
+    }
+
+    // Walks columns from a seed-derived start until one is entirely of the requested biome,
+    // or mixed when biome is empty.
+    std::optional<std::pair<S32, S32>> FindColumn(U64 seed, std::optional<BiomeType> biome, VoxelColumn& column) {
+        const S32 x0{static_cast<S32>(seed % 4096u)};
+        const S32 z0{static_cast<S32>((seed >> 12) % 4096u)};
+        for (S32 i{}; i < 4096; ++i) {
+            const S32 cx{x0 + (i % 64) * 3};
+            const S32 cz{z0 + (i / 64) * 3};
+            GenerateVoxelColumn(cx, cz, kBlockSize, column);
+            const auto desert{std::ranges::count(column.biomes, static_cast<U8>(BiomeType::Desert))};
+            const bool match{!biome ? desert > 0 && desert < static_cast<S64>(VoxelColumn::Size)
+                                    : desert == (*biome == BiomeType::Desert ? static_cast<S64>(VoxelColumn::Size) : 0)};
+            if (match) return std::pair{cx, cz};
+        }
+        return std::nullopt;
+    }
+
+    // The chunk holding the column's average surface, so both terrain and vegetation run.
+    S32 SurfaceChunkY(VoxelColumn const& column) {
+        const S64 sum{std::accumulate(column.heights.begin(), column.heights.end(), S64{0})};
+        const S64 mean{sum / static_cast<S64>(VoxelColumn::Size)};
+        return static_cast<S32>(std::floor(static_cast<F64>(mean) / VoxelChunk::SizeY));
+    }
+
+    std::optional<Kernel> GenerateKernel(U64 seed, std::optional<BiomeType> biome) {
+        auto column{std::make_shared<VoxelColumn>()};
+        const auto found{FindColumn(seed, biome, *column)};
+        if (!found) return std::nullopt;
+        const auto [cx, cz]{*found};
+        const S32 cy{SurfaceChunkY(*column)};
+        // Column noise is included: GenerateChunk computes it on every column cache miss.
+        return Kernel{{}, [=](U64 iterations) {
+            U64 h{};
+            for (U64 i{}; i < iterations; ++i) {
+                GenerateVoxelColumn(cx, cz, kBlockSize, *column);
+                h = HashBlocks(GenerateVoxelChunk(cx, cy, cz, kBlockSize, *column));
+                Clobber();
+            }
+            return h;
+        }};
+    }
+
+    // Biome and terrain noise for every column of a chunk, one row of x per z, as
+    // GenerateHeightMap evaluates it.
+    std::optional<Kernel> NoiseRowKernel(U64 seed, NoiseKernel kernel) {
+        if (!noise::IsKernelSupported(kernel)) return std::nullopt;
+        constexpr U32 kWidth{VoxelChunk::SizeX};
+        constexpr U32 kRows{VoxelChunk::SizeZ};
+        const F32 x0{static_cast<F32>((seed % 4096u) * kWidth)};
+        const F32 z0{static_cast<F32>(((seed >> 12) % 4096u) * kRows)};
+        return Kernel{{}, [=](U64 iterations) {
+            std::array<F32, kWidth> xs{}, biome{}, terrain{};
+            for (U32 x{}; x < kWidth; ++x) xs[x] = x0 + static_cast<F32>(x);
+            U64 h{};
+            for (U64 i{}; i < iterations; ++i) {
+                F32 sum{};
+                for (U32 r{}; r < kRows; ++r) {
+                    noise::BiomeValueRow(kernel, xs, z0 + static_cast<F32>(r), biome);
+                    noise::TerrainNoiseRow(kernel, xs, z0 + static_cast<F32>(r), terrain);
+                    for (U32 x{}; x < kWidth; ++x) sum += biome[x] + terrain[x];
+                }
+                h = Bits(sum);
+                Clobber();
+            }
+            return h;
+        }, kWidth * kRows};
+    }
+
+    struct MeshScene {
+        VoxelBlocks center{};
+        std::array<VoxelBlocks, NeighborCount> neighbors{};
+        VoxelMeshBuffers out{};
+
+        [[nodiscard]] VoxelMeshInput Input() const {
+            VoxelMeshInput in{&center};
+            for (U32 n{}; n < NeighborCount; ++n) in.neighbors[n] = &neighbors[n];
+            return in;
+        }
+    };
+
+    std::shared_ptr<MeshScene> FlatScene() {
+        auto scene{std::make_shared<MeshScene>()};
+        Vector<Voxel> dense(VoxelBlocks::Volume, Voxel::Air);
+        for (U32 z{}; z < VoxelChunk::SizeZ; ++z)
+            for (U32 y{}; y < VoxelChunk::SizeY / 2u; ++y)
+                for (U32 x{}; x < VoxelChunk::SizeX; ++x) dense[VoxelIndex(x, y, z)] = y + 1u == VoxelChunk::SizeY / 2u ? Voxel::Grass : Voxel::Stone;
+        scene->center.Assign(dense);
+        for (auto& n : scene->neighbors) n.Assign(dense);
+        return scene;
+    }
+
+    // Alternating solid and air in all three axes: no two faces merge and every solid voxel
+    // shows all six, the greedy mesher's worst case.
+    std::shared_ptr<MeshScene> CheckerboardScene(U64 seed) {
+        auto scene{std::make_shared<MeshScene>()};
+        std::mt19937_64 rng{seed};
+        constexpr std::array<Voxel, 4> kSolid{Voxel::Stone, Voxel::Dirt, Voxel::Grass, Voxel::Sand};
+        Vector<Voxel> dense(VoxelBlocks::Volume, Voxel::Air);
+        for (U32 z{}; z < VoxelChunk::SizeZ; ++z)
+            for (U32 y{}; y < VoxelChunk::SizeY; ++y)
+                for (U32 x{}; x < VoxelChunk::SizeX; ++x)
+                    if (((x + y + z) & 1u) == 0u) dense[VoxelIndex(x, y, z)] = kSolid[rng() % kSolid.size()];
+        scene->center.Assign(dense);
+        for (auto& n : scene->neighbors) n.Assign(dense);
+        return scene;
+    }
+
+    // A generated surface chunk with its six generated neighbours.
+    std::shared_ptr<MeshScene> TerrainScene(U64 seed) {
+        VoxelColumn column{};
+        const auto found{FindColumn(seed, BiomeType::Plains, column)};
+        if (!found) return nullptr;
+        const auto [cx, cz]{*found};
+        const S32 cy{SurfaceChunkY(column)};
+        auto chunk = [&](S32 x, S32 y, S32 z) {
+            VoxelColumn c{};
+            GenerateVoxelColumn(x, z, kBlockSize, c);
+            return GenerateVoxelChunk(x, y, z, kBlockSize, c);
+        };
+        auto scene{std::make_shared<MeshScene>()};
+        scene->center = chunk(cx, cy, cz);
+        constexpr S32 kOffsets[NeighborCount][3]{{-1,0,0},{1,0,0},{0,-1,0},{0,1,0},{0,0,-1},{0,0,1}};
+        for (U32 n{}; n < NeighborCount; ++n) scene->neighbors[n] = chunk(cx + kOffsets[n][0], cy + kOffsets[n][1], cz + kOffsets[n][2]);
+        return scene;
+    }
+
+    std::optional<Kernel> MeshKernel(std::shared_ptr<MeshScene> scene, VoxelMesherKind kind) {
+        if (!scene) return std::nullopt;
+        return Kernel{{}, [scene, kind](U64 iterations) {
+            U64 h{};
+            const VoxelMeshInput in{scene->Input()};
+            for (U64 i{}; i < iterations; ++i) {
+                scene->out.Clear();
+                MeshChunk(kind, in, scene->out);
+                h = HashMesh(scene->out);
+                Clobber();
+            }
+            return h;
+        }};
+    }
+
+    // 4x2x4 generated chunks around a plains column; rays start above the ground and look
+    // down into it at random angles.
+    std::optional<Kernel> RaycastKernel(U64 seed) {
+        constexpr S32 kChunksXZ{4}, kChunksY{2};
+        struct Scene {
+            World world{};
+            Vector<VoxelRay> rays{};
+        };
+        auto scene{std::make_shared<Scene>()};
+        World& world{scene->world};
+        world.AddComponent(world.CreateEntity(), VoxelWorldConfig{kChunksXZ, kChunksY, kChunksXZ, kBlockSize});
+        world.AddComponent(world.CreateEntity(), VoxelChunkIndex{});
+
+        S32 minHeight{std::numeric_limits<S32>::max()}, maxHeight{std::numeric_limits<S32>::lowest()};
+        for (S32 cz{}; cz < kChunksXZ; ++cz) {
+            for (S32 cx{}; cx < kChunksXZ; ++cx) {
+                VoxelColumn column{};
+                GenerateVoxelColumn(cx, cz, kBlockSize, column);
+                for (S32 hgt : column.heights) { minHeight = std::min(minHeight, hgt); maxHeight = std::max(maxHeight, hgt); }
+                for (S32 cy{}; cy < kChunksY; ++cy) {
+                    VoxelChunk chunk{};
+                    chunk.cx = static_cast<U32>(cx);
+                    chunk.cy = static_cast<U32>(cy);
+                    chunk.cz = static_cast<U32>(cz);
+                    chunk.origin = Math::Vec3{static_cast<F32>(cx * 32), static_cast<F32>(cy * 32), static_cast<F32>(cz * 32)};
+                    chunk.blocks = GenerateVoxelChunk(cx, cy, cz, kBlockSize, column);
+                    chunk.dirty = false;
+                    auto e{world.CreateEntity()};
+                    world.AddComponent(e, std::move(chunk));
+                    FindVoxelChunkIndex(&world)->Insert(cx, cy, cz, e);
+                }
+            }
+        }
+
+        std::mt19937_64 rng{seed};
+        const F32 extent{static_cast<F32>(kChunksXZ * 32)};
+        std::uniform_real_distribution<F32> xz{8.0f, extent - 8.0f};
+        std::uniform_real_distribution<F32> slope{-1.0f, 1.0f};
+        const F32 eyeY{std::min(static_cast<F32>(maxHeight) + 4.0f, static_cast<F32>(kChunksY * 32) - 1.0f)};
+        scene->rays.resize(4096);
+        for (auto& r : scene->rays) r = VoxelRay{Math::Vec3{xz(rng), eyeY, xz(rng)}, Math::Vec3{slope(rng), -1.0f, slope(rng)}, 64.0f};
+
+        return Kernel{{}, [scene](U64 iterations) {
+            U64 h{};
+            for (U64 i{}; i < iterations; ++i) {
+                h = 0;
+                for (VoxelRay const& r : scene->rays) {
+                    const VoxelRayHit hit{RaycastVoxelDDA(&scene->world, r.origin, r.dir, r.maxDist)};
+                    h = Mix(h, hit.hit ? static_cast<U64>(hit.gx) * 73856093u ^ static_cast<U64>(hit.gy) * 19349663u ^ static_cast<U64>(hit.gz) * 83492791u : 0u);
+                    if (!hit.hit) continue;
+                    h = Mix(h, static_cast<U64>(hit.pgx) * 73856093u ^ static_cast<U64>(hit.pgy) * 19349663u ^ static_cast<U64>(hit.pgz) * 83492791u);
+                    h = Mix(Mix(h, Bits(hit.t)), Bits(hit.normal.x) ^ Bits(hit.normal.y) << 8 ^ Bits(hit.normal.z) << 16);
+                }
+                Clobber();
+            }
+            return h;
+        }, scene->rays.size()};
+    }
+
+    // ===== ECS =====
+
+    constexpr U32 kEntities{50000};
+
+    Vector<EntityHandle> ShuffledHandles(U64 seed) {
+        Vector<EntityHandle> handles{};
+        handles.reserve(kEntities);
+        for (U32 i{}; i < kEntities; ++i) handles.push_back(EntityHandle{static_cast<U16>(i + 1u), 1});
+        std::ranges::shuffle(handles, std::mt19937_64{seed});
+        return handles;
+    }
+
+    std::optional<Kernel> StorageInsertKernel(U64 seed) {
+        auto handles{std::make_shared<Vector<EntityHandle>>(ShuffledHandles(seed))};
+        return Kernel{{}, [handles](U64 iterations) {
+            U64 h{};
+            for (U64 i{}; i < iterations; ++i) {
+                ComponentStorage<Position> storage{};
+                for (EntityHandle e : *handles) storage.Insert(e, Position{static_cast<F32>(e.id()), 0.0f, 0.0f});
+                h = storage.Size();
+                Clobber();
+            }
+            return h;
+        }, kEntities};
+    }
+
+    std::optional<Kernel> StorageRemoveKernel(U64 seed) {
+        struct State {
+            Vector<EntityHandle> handles{};
+            std::deque<ComponentStorage<Position>> filled{};
+        };
+        auto state{std::make_shared<State>()};
+        state->handles = ShuffledHandles(seed);
+        return Kernel{[state](U64 iterations) {
+            state->filled.clear();
+            Vector<EntityHandle> inOrder{state->handles};
+            std::ranges::sort(inOrder, {}, &EntityHandle::id);
+            for (U64 i{}; i < iterations; ++i) {
+                auto& storage{state->filled.emplace_back()};
+                for (EntityHandle e : inOrder) storage.Insert(e, Position{});
+            }
+        }, [state](U64) {
+            U64 h{};
+            for (auto& storage : state->filled) {
+                for (EntityHandle e : state->handles) storage.Remove(e);
+                h = storage.Size();
+                Clobber();
+            }
+            return h;
+        }, kEntities};
+    }
+
+    std::optional<Kernel> StorageIterateKernel(U64 seed) {
+        auto storage{std::make_shared<ComponentStorage<Position>>()};
+        for (EntityHandle e : ShuffledHandles(seed)) storage->Insert(e, Position{static_cast<F32>(e.id()), 1.0f, 2.0f});
+        return Kernel{{}, [storage](U64 iterations) {
+            U64 h{};
+            for (U64 i{}; i < iterations; ++i) {
+                F32 sum{};
+                for (auto [e, p] : *storage) sum += p.x + p.y * static_cast<F32>(e.id() & 7u);
+                h = Bits(sum);
+                Clobber();
+            }
+            return h;
+        }, kEntities};
+    }
+
+    // Half of the entities carry Velocity, in a seed-shuffled pattern.
+    std::shared_ptr<World> QueryWorld(U64 seed, U64& matching) {
+        auto world{std::make_shared<World>()};
+        std::mt19937_64 rng{seed};
+        matching = 0;
+        for (U32 i{}; i < kEntities; ++i) {
+            EntityHandle e{world->CreateEntity()};
+            world->AddComponent(e, Position{static_cast<F32>(i), 0.0f, 0.0f});
+            if (rng() & 1u) {
+                world->AddComponent(e, Velocity{1.0f, 0.5f, 0.25f});
+                ++matching;
+            }
+        }
+        return world;
+    }
+
+    std::optional<Kernel> QueryKernel(U64 seed) {
+        U64 matching{};
+        auto world{QueryWorld(seed, matching)};
+        return Kernel{{}, [world](U64 iterations) {
+            U64 h{};
+            for (U64 i{}; i < iterations; ++i) {
+                F32 sum{};
+                Query<World, Position, Read<Velocity>>{world.get()}.ForEach([&](Position* p, Velocity const* v) {
+                    p->y = p->x * v->y;
+                    sum += p->y;
+                });
+                h = Bits(sum);
+                Clobber();
+            }
+            return h;
+        }, std::max<U64>(matching, 1)};
+    }
+
+    // The query path before archetype buckets: test every entity's archetype, then look each
+    // component up through its storage.
+    std::optional<Kernel> QueryScanKernel(U64 seed) {
+        U64 matching{};
+        auto world{QueryWorld(seed, matching)};
+        return Kernel{{}, [world](U64 iterations) {
+            constexpr Archetype kMoving{MakeArchetype<Position, Velocity>()};
+            U64 h{};
+            for (U64 i{}; i < iterations; ++i) {
+                F32 sum{};
+                for (auto it{world->EntitiesBegin()}; it != world->EntitiesEnd(); ++it) {
+                    if ((it->second & kMoving) != kMoving) continue;
+                    Position* p{world->GetStorage<Position>()->Get(it->first)};
+                    Velocity const* v{world->GetStorage<Velocity>()->Get(it->first)};
+                    p->y = p->x * v->y;
+                    sum += p->y;
+                }
+                h = Bits(sum);
+                Clobber();
+            }
+            return h;
+        }, std::max<U64>(matching, 1)};
+    }
+
+    std::optional<Kernel> QueryChunkKernel(U64 seed) {
+        U64 matching{};
+        auto world{QueryWorld(seed, matching)};
+        return Kernel{{}, [world](U64 iterations) {
+            U64 h{};
+            for (U64 i{}; i < iterations; ++i) {
+                F32 sum{};
+                Query<World, Velocity>{world.get()}.ForEachChunk([&](std::span<const EntityHandle>, std::span<Velocity> vs) {
+                    for (Velocity& v : vs) {
+                        v.z = v.x * v.y;
+                        sum += v.z;
+                    }
+                });
+                h = Bits(sum);
+                Clobber();
+            }
+            return h;
+        }, std::max<U64>(matching, 1)};
+    }
+
+    // ===== Tasks =====
+
+    // One graph run of root -> width leaves -> sink: the round trip of waking the workers,
+    // spreading trivial tasks and joining them.
+    std::optional<Kernel> FanOutKernel(U32 width) {
+        struct State {
+            TaskGraph graph{0};
+            std::atomic<U64> counter{0};
+        };
+        auto state{std::make_shared<State>()};
+        state->graph.SetProfilingEnabled(false);
+        TaskPhase* phase{state->graph.CreatePhase("FanOut")};
+        Task* root{phase->AddTask("root", [] {})};
+        Task* sink{phase->AddTask("sink", [] {})};
+        for (U32 i{}; i < width; ++i) {
+            Task* leaf{phase->AddTask("leaf" + std::to_string(i), [s{state.get()}] { s->counter.fetch_add(1, std::memory_order_relaxed); })};
+            phase->AddDependency(leaf, root);
+            phase->AddDependency(sink, leaf);
+        }
+        return Kernel{{}, [state](U64 iterations) {
+            state->counter.store(0);
+            for (U64 i{}; i < iterations; ++i) state->graph.Execute();
+            return state->counter.load() / std::max<U64>(iterations, 1);
+        }};
+    }
+
+    // ===== Math =====
+
+    Vector<Math::Mat4> RandomTransforms(U64 seed, U32 count) {
+        std::mt19937_64 rng{seed};
+        std::uniform_real_distribution<F32> unit{-1.0f, 1.0f};
+        std::uniform_real_distribution<F32> scale{0.5f, 2.0f};
+        Vector<Math::Mat4> out{};
+        out.reserve(count);
+        for (U32 i{}; i < count; ++i) {
+            const Math::Vec3 axis{Math::Vec3{unit(rng), unit(rng), unit(rng)}.Normalized()};
+            out.push_back(Math::Mat4::Translation(unit(rng) * 100.0f, unit(rng) * 100.0f, unit(rng) * 100.0f)
+                          * Math::Mat4::Rotation(axis.LengthSquared() > 0.0f ? axis : Math::Vec3::Up, unit(rng) * Math::PI)
+                          * Math::Mat4::Scale(scale(rng), scale(rng), scale(rng)));
+        }
+        return out;
+    }
+
+    U64 HashMatrix(Math::Mat4 const& m) {
+        return Mix(Mix(Bits(m.m[0][0]), Bits(m.m[1][2])), Bits(m.m[3][3]));
+    }
+
+    std::optional<Kernel> MatMulKernel(U64 seed) {
+        auto mats{std::make_shared<Vector<Math::Mat4>>(RandomTransforms(seed, 1024))};
+        return Kernel{{}, [mats](U64 iterations) {
+            U64 h{};
+            auto const& m{*mats};
+            for (U64 i{}; i < iterations; ++i) {
+                h = 0;
+                for (USize k{}; k + 1 < m.size(); k += 2) h = Mix(h, HashMatrix(m[k] * m[k + 1]));
+                Clobber();
+            }
+            return h;
+        }, mats->size() / 2};
+    }
+
+    std::optional<Kernel> MatInverseKernel(U64 seed) {
+        auto mats{std::make_shared<Vector<Math::Mat4>>(RandomTransforms(seed, 1024))};
+        return Kernel{{}, [mats](U64 iterations) {
+            U64 h{};
+            for (U64 i{}; i < iterations; ++i) {
+                h = 0;
+                for (Math::Mat4 const& m : *mats) h = Mix(h, HashMatrix(m.Inverse()));
+                Clobber();
+            }
+            return h;
+        }, mats->size()};
+    }
+
+    // Chunk-sized boxes scattered around the camera, about a third of them visible, in both
+    // layouts.
+    struct CullScene {
+        Math::Vec3 eye{};
+        Math::Vec3 dir{};
+        Math::Frustum frustum{};
+        Vector<Math::Bounds> bounds{};
+        Math::BoundsSoA soa{};
+        Math::CullResult result{};
+    };
+
+    std::shared_ptr<CullScene> MakeCullScene(U64 seed) {
+        auto scene{std::make_shared<CullScene>()};
+        scene->eye = Math::Vec3{0.0f, 40.0f, 0.0f};
+        scene->dir = Math::Vec3{0.0f, -10.0f, -100.0f}.Normalized();
+        const Math::Mat4 view{Math::Mat4::LookAt(scene->eye, Math::Vec3{0.0f, 30.0f, -100.0f}, Math::Vec3::Up)};
+        scene->frustum.SetFromMatrix(Math::Mat4::Perspective(Math::ToRadians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f) * view);
+        std::mt19937_64 rng{seed};
+        std::uniform_real_distribution<F32> pos{-256.0f, 256.0f};
+        scene->bounds.reserve(4096);
+        scene->soa.Reserve(4096);
+        for (U32 i{}; i < 4096; ++i) {
+            const Math::Vec3 lo{std::floor(pos(rng) / 32.0f) * 32.0f, std::floor(pos(rng) / 128.0f) * 32.0f, std::floor(pos(rng) / 32.0f) * 32.0f};
+            scene->bounds.emplace_back(lo, lo + Math::Vec3{32.0f, 32.0f, 32.0f});
+            scene->soa.Add(scene->bounds.back());
+        }
+        return scene;
+    }
+
+    // One Frustum::Intersects per box: the baseline the SoA kernels must match.
+    std::optional<Kernel> FrustumKernel(U64 seed) {
+        auto scene{MakeCullScene(seed)};
+        return Kernel{{}, [scene](U64 iterations) {
+            U64 visible{};
+            for (U64 i{}; i < iterations; ++i) {
+                visible = 0;
+                for (Math::Bounds const& b : scene->bounds) visible += scene->frustum.Intersects(b) ? 1u : 0u;
+                Clobber();
+            }
+            return visible;
+        }, scene->bounds.size()};
+    }
+
+    std::optional<Kernel> CullSoAKernel(U64 seed, Math::CullKernel kernel) {
+        if (!Math::IsCullKernelSupported(kernel)) return std::nullopt;
+        auto scene{MakeCullScene(seed)};
+        return Kernel{{}, [scene, kernel](U64 iterations) {
+            U64 visible{};
+            for (U64 i{}; i < iterations; ++i) {
+                Math::Cull(kernel, Math::CullQuery{.frustum = &scene->frustum}, scene->soa, scene->result);
+                visible = scene->result.indices.size();
+                Clobber();
+            }
+            return visible;
+        }, scene->bounds.size()};
+    }
+
+    // The frustum and view-cone pass VoxelMeshingSystem runs over its dirty chunks.
+    std::optional<Kernel> CullConeKernel(U64 seed) {
+        auto scene{MakeCullScene(seed)};
+        return Kernel{{}, [scene](U64 iterations) {
+            U64 visible{};
+            for (U64 i{}; i < iterations; ++i) {
+                Math::CullViewCone(&scene->frustum, scene->eye, scene->dir, VoxelMeshingConeCos, scene->soa, scene->result);
+                visible = scene->result.indices.size();
+                Clobber();
+            }
+            return visible;
+        }, scene->bounds.size()};
+    }
+
+    Vector<Benchmark> Registry() {
+        Vector<Benchmark> all{};
+        all.push_back({"voxel.generate.plains", "chunk", [](U64 s) { return GenerateKernel(s, BiomeType::Plains); }});
+        all.push_back({"voxel.generate.desert", "chunk", [](U64 s) { return GenerateKernel(s, BiomeType::Desert); }});
+        all.push_back({"voxel.generate.mixed", "chunk", [](U64 s) { return GenerateKernel(s, std::nullopt); }});
+        for (auto [kernel, name] : {std::pair{NoiseKernel::Scalar, "scalar"}, std::pair{NoiseKernel::SSE41, "sse41"},
+                                    std::pair{NoiseKernel::AVX2, "avx2"}}) {
+            all.push_back({std::string{"voxel.noise."} + name, "column", [kernel](U64 s) { return NoiseRowKernel(s, kernel); }});
+        }
+        for (auto [kind, name] : {std::pair{VoxelMesherKind::Greedy, "greedy"}, std::pair{VoxelMesherKind::Binary, "binary"}}) {
+            const std::string prefix{std::string{"voxel.mesh."} + name};
+            all.push_back({prefix + ".flat", "chunk", [kind](U64) { return MeshKernel(FlatScene(), kind); }});
+            all.push_back({prefix + ".terrain", "chunk", [kind](U64 s) { return MeshKernel(TerrainScene(s), kind); }});
+            all.push_back({prefix + ".checkerboard", "chunk", [kind](U64 s) { return MeshKernel(CheckerboardScene(s), kind); }});
+        }
+        all.push_back({"voxel.raycast.dda", "ray", RaycastKernel});
+        all.push_back({"ecs.storage.insert", "component", StorageInsertKernel});
+        all.push_back({"ecs.storage.remove", "component", StorageRemoveKernel});
+        all.push_back({"ecs.storage.iterate", "component", StorageIterateKernel});
+        all.push_back({"ecs.query.scan", "entity", QueryScanKernel});
+        all.push_back({"ecs.query.foreach", "entity", QueryKernel});
+        all.push_back({"ecs.query.chunk", "entity", QueryChunkKernel});
+        all.push_back({"tasks.fanout.16", "graph", [](U64) { return FanOutKernel(16); }});
+        all.push_back({"tasks.fanout.256", "graph", [](U64) { return FanOutKernel(256); }});
+        all.push_back({"math.mat4.multiply", "matrix", MatMulKernel});
+        all.push_back({"math.mat4.inverse", "matrix", MatInverseKernel});
+        all.push_back({"math.frustum.intersects", "box", FrustumKernel});
+        for (auto [kernel, name] : {std::pair{Math::CullKernel::Scalar, "scalar"}, std::pair{Math::CullKernel::SSE, "sse"},
+                                    std::pair{Math::CullKernel::AVX, "avx"}}) {
+            all.push_back({std::string{"math.frustum.soa."} + name, "box", [kernel](U64 s) { return CullSoAKernel(s, kernel); }});
+        }
+        all.push_back({"math.frustum.cone", "box", CullConeKernel});
+        return all;
+    }
+}
+
+int main(int argc, char** argv) {
+    return RunBenchmarks("kernel_bench", Registry(), argc, argv);
+}
@@ -0,0 +1,381 @@
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+import Core.Types;
+import Core.Log;
+import ECS.World;
+import ECS.SystemScheduler;
+import Components.Transform;
+import Components.Camera;
+import Components.Voxel;
+import Components.VoxelStreaming;
+import Systems.CameraSystem;
+import Systems.VoxelStreaming;
+import Systems.VoxelGeneration;
+import Systems.VoxelMeshing;
+import Systems.VoxelUpload;
+import Graphics.MeshArena;
+import Graphics.Null.GraphicsContext;
+import Tasks.Orchestrator;
+import Tasks.ECSIntegration;
+import Tasks.TaskProfiler;
+import Math.Core;
+import Math.Vector;
+import Math.Transform;
+import std;
+
+// Headless run of the streaming -> generation -> meshing -> upload pipeline along a camera
+// path, on a NullGraphicsContext. Frames are stepped as fast as they complete; the path
+// advances a fixed 1/60 s per frame so runs are comparable whatever the machine.
+//
+//   voxel_bench [--path static|fly|orbit|<file>] [--frames N] [--speed blocks/s]
+//               [--radius R] [--threads N] [--out file.json]
+//
+// A path file holds one frame per line, "px py pz dx dy dz" (position, look direction); the
+// game writes this format with F6. Results go to stdout as JSON unless --out is given.
+
+namespace {
+    constexpr F32 kStep{1.0f / 60.0f};
+    constexpr F32 kHeight{40.0f};
+    constexpr std::chrono::seconds kDrainLimit{30};
+
+    struct CameraSample {
+        Math::Vec3 position{};
+        Math::Vec3 direction{};
+    };
+
+    struct Options {
+        std::string path{"fly"};
+        U32 frames{1200};
+        F32 speed{32.0f};
+        U32 radius{8};
+        U32 threads{0};
+        std::string out{};
+    };
+
+    std::optional<Options> ParseOptions(int argc, char** argv) {
+        Options o{};
+        for (int i{1}; i < argc; ++i) {
+            const std::string_view arg{argv[i]};
+            if (i + 1 >= argc) return std::nullopt;
+            const std::string_view value{argv[++i]};
+            if (arg == "--path") o.path = value;
+            else if (arg == "--frames") o.frames = static_cast<U32>(std::stoul(std::string{value}));
+            else if (arg == "--speed") o.speed = std::stof(std::string{value});
+            else if (arg == "--radius") o.radius = static_cast<U32>(std::stoul(std::string{value}));
+            else if (arg == "--threads") o.threads = static_cast<U32>(std::stoul(std::string{value}));
+            else if (arg == "--out") o.out = value;
+            else return std::nullopt;
+        }
+        return o;
+    }
+
+    Vector<CameraSample> ScriptedPath(std::string_view name, U32 frames, F32 speed) {
+        Vector<CameraSample> path{};
+        path.reserve(frames);
+        const F32 orbit{192.0f};
+        for (U32 f{}; f < frames; ++f) {
+            const F32 t{static_cast<F32>(f) * kStep};
+            if (name == "static") {
+                path.push_back({Math::Vec3{0.0f, kHeight, 0.0f}, Math::Vec3{0.0f, -0.3f, -1.0f}});
+            } else if (name == "fly") {
+                path.push_back({Math::Vec3{speed * t, kHeight, 0.0f}, Math::Vec3{1.0f, -0.3f, 0.0f}});
+            } else {
+                const F32 a{speed * t / orbit};
+                path.push_back({Math::Vec3{orbit * std::cos(a), kHeight, orbit * std::sin(a)},
+                                Math::Vec3{-std::sin(a), -0.3f, std::cos(a)}});
+            }
+        }
+        return path;
+    }
+
+    std::optional<Vector<CameraSample>> LoadPath(std::filesystem::path const& file) {
+        std::ifstream in{file};
+        if (!in) return std::nullopt;
+        Vector<CameraSample> path{};
+        std::string line{};
+        while (std::getline(in, line)) {
+            if (line.empty() || line.front() == '#') continue;
+            std::istringstream ss{line};
+            CameraSample s{};
+            if (ss >> s.position.x >> s.position.y >> s.position.z >> s.direction.x >> s.direction.y >> s.direction.z) {
+                path.push_back(s);
+            }
+        }
+        if (path.empty()) return std::nullopt;
+        return path;
+    }
+
+    // Paths come from the command line, so Windows separators and quotes must be escaped.
+    std::string EscapeJson(std::string_view text) {
+        std::string out{};
+        out.reserve(text.size());
+        for (char c : text) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) >= 0x20) out += c;
+                    else out += std::format("\\u{:04x}", static_cast<unsigned>(c));
+                    break;
+            }
+        }
+        return out;
+    }
+
+    U64 PeakRssBytes() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS pmc{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return static_cast<U64>(pmc.PeakWorkingSetSize);
+        return 0;
+#else
+        std::ifstream status{"/proc/self/status"};
+        std::string line{};
+        while (std::getline(status, line)) {
+            if (line.starts_with("VmHWM:")) return std::stoull(line.substr(6)) * 1024ull;
+        }
+        return 0;
+#endif
+    }
+
+    // Every chunk of the load region is generated, and every one the camera sees has its mesh
+    // built and uploaded.
+    bool FullView(World& world, Camera const& camera, Transform const& eye, VoxelWorldConfig const& wc,
+                  VoxelStreamingConfig const& sc) {
+        auto* store{world.GetStorage<VoxelChunk>()};
+        if (!store) return false;
+        Math::Frustum fr{};
+        fr.SetFromMatrix(camera.viewProjection);
+        const Math::Vec3 camPos{eye.position};
+        const Math::Vec3 camDir{eye.Forward()};
+        // Chunk extents in world units, as streaming computes them.
+        const Math::Vec3 extent{wc.blockSize * static_cast<F32>(VoxelChunk::SizeX),
+                                wc.blockSize * static_cast<F32>(VoxelChunk::SizeY),
+                                wc.blockSize * static_cast<F32>(VoxelChunk::SizeZ)};
+        const S32 ccx{static_cast<S32>(std::floor(camPos.x / extent.x))};
+        const S32 ccy{static_cast<S32>(std::floor(camPos.y / extent.y))};
+        const S32 ccz{static_cast<S32>(std::floor(camPos.z / extent.z))};
+        const S32 r{static_cast<S32>(sc.radius)};
+
+        U32 ready{0};
+        for (auto [h, c] : *store) {
+            const S32 dx{static_cast<S32>(c.cx) - ccx}, dy{static_cast<S32>(c.cy) - ccy}, dz{static_cast<S32>(c.cz) - ccz};
+            if (std::abs(dx) > r || std::abs(dz) > r || dy < sc.minChunkY || dy > sc.maxChunkY) continue;
+            if (c.blocks.Empty() || c.generating) return false;
+            const Math::Bounds bounds{c.origin, c.origin + extent};
+            const F32 cosine{(bounds.Center() - camPos).Normalized().Dot(camDir)};
+            if (fr.Intersects(bounds) && cosine >= VoxelMeshingConeCos) {
+                auto const* mesh{world.GetComponent<VoxelMesh>(h)};
+                if (c.dirty || !mesh || mesh->meshing || mesh->gpuDirty) return false;
+            }
+            ++ready;
+        }
+        const U32 side{2u * sc.radius + 1u};
+        return ready == side * side * static_cast<U32>(sc.maxChunkY - sc.minChunkY + 1);
+    }
+
+    struct Series {
+        Vector<F64> samples{};
+
+        void Add(F64 v) { samples.push_back(v); }
+
+        [[nodiscard]] F64 Sum() const { return std::accumulate(samples.begin(), samples.end(), 0.0); }
+        [[nodiscard]] F64 Mean() const { return samples.empty() ? 0.0 : Sum() / static_cast<F64>(samples.size()); }
+
+        // Nearest-rank percentile.
+        [[nodiscard]] F64 Percentile(F64 p) const {
+            if (samples.empty()) return 0.0;
+            Vector<F64> sorted{samples};
+            std::ranges::sort(sorted);
+            const USize rank{static_cast<USize>(std::ceil(p / 100.0 * static_cast<F64>(sorted.size())))};
+            return sorted[std::clamp<USize>(rank, 1, sorted.size()) - 1];
+        }
+
+        [[nodiscard]] std::string Json() const {
+            return std::format(R"({{"mean": {:.4f}, "p50": {:.4f}, "p90": {:.4f}, "p99": {:.4f}, "max": {:.4f}}})",
+                               Mean(), Percentile(50.0), Percentile(90.0), Percentile(99.0), Percentile(100.0));
+        }
+    };
+
+    // Per-system task times and pipeline counters, taken from the profiler's finished frames.
+    struct ProfileTotals {
+        std::map<std::string, Series> systems{};
+        std::map<std::string, S64> counters{};
+        U64 lastFrame{0};
+
+        void Collect(Vector<std::string> const& systemNames) {
+            auto const& history{TaskProfiler::Get().GetFrameHistory()};
+            if (history.empty() || history.back().frameNumber == lastFrame) return;
+            FrameProfile const& frame{history.back()};
+            lastFrame = frame.frameNumber;
+            for (PhaseProfile const& phase : frame.phases) {
+                for (TaskProfile const& task : phase.tasks) {
+                    if (std::ranges::find(systemNames, task.name) == systemNames.end()) continue;
+                    systems[task.name].Add(task.GetDurationMillis());
+                }
+            }
+            for (auto const& [name, value] : frame.counters) counters[name] += value;
+        }
+    };
+}
+
+int main(int argc, char** argv) {
+    const std::optional<Options> parsed{ParseOptions(argc, argv)};
+    if (!parsed) {
+        std::cerr << "usage: voxel_bench [--path static|fly|orbit|<file>] [--frames N] [--speed blocks/s]"
+                     " [--radius R] [--threads N] [--out file.json]\n";
+        return 2;
+    }
+    Options const& opt{*parsed};
+
+    Vector<CameraSample> path{};
+    if (opt.path == "static" || opt.path == "fly" || opt.path == "orbit") {
+        path = ScriptedPath(opt.path, opt.frames, opt.speed);
+    } else if (auto loaded{LoadPath(opt.path)}) {
+        path = std::move(*loaded);
+    } else {
+        std::cerr << std::format("voxel_bench: cannot read camera path '{}'\n", opt.path);
+        return 2;
+    }
+
+    // The JSON report owns stdout.
+    Logger::EnableConsole(false);
+
+    NullGraphicsContext gfx{};
+    World world{};
+
+    auto cameraEntity{world.CreateEntity()};
+    world.AddComponent(cameraEntity, Transform{path.front().position});
+    Camera cam{};
+    cam.fov = Math::ToRadians(60.0f);
+    cam.aspectRatio = 16.0f / 9.0f;
+    cam.nearPlane = 0.1f;
+    cam.farPlane = 500.0f;
+    cam.isPrimary = true;
+    cam.UpdateProjection();
+    world.AddComponent(cameraEntity, cam);
+
+    const VoxelWorldConfig wcfg{};
+    world.AddComponent(world.CreateEntity(), wcfg);
+    VoxelStreamingConfig scfg{};
+    scfg.radius = opt.radius;
+    scfg.margin = 2;
+    scfg.minChunkY = -1;
+    scfg.maxChunkY = 1;
+    scfg.createBudget = 16;
+    scfg.removeBudget = 16;
+    world.AddComponent(world.CreateEntity(), scfg);
+
+    EngineOrchestrator orchestrator{opt.threads};
+    orchestrator.SetWorld(&world);
+    orchestrator.SetGraphicsContext(&gfx);
+
+    EngineOrchestratorECS orchestratorECS{&orchestrator};
+    SystemScheduler* scheduler{orchestratorECS.GetSystemScheduler()};
+    scheduler->AddSystem<CameraSystem>();
+    scheduler->AddSystem<CameraLifecycleSystem>();
+    scheduler->AddSystem<VoxelStreamingSystem>();
+    scheduler->AddSystem<VoxelGenerationSystem>();
+    scheduler->AddSystem<VoxelMeshingSystem>();
+    scheduler->AddSystem<VoxelUploadSystem>()->SetGraphicsContext(&gfx);
+    orchestratorECS.BuildECSExecutionGraph(&world);
+
+    Vector<std::string> systemNames{};
+    for (auto&& [stage, nodes] : scheduler->GetStageNodes()) {
+        for (auto* node : nodes) systemNames.push_back(node->metadata.name);
+    }
+
+    orchestrator.SetProfilingEnabled(true);
+    TaskProfiler::Get().SetEnabled(true);
+
+    U32 frame{0};
+    orchestrator.SetPreFrameCallback([&](EngineOrchestrator::FrameData&) {
+        CameraSample const& s{path[std::min<USize>(frame, path.size() - 1)]};
+        if (auto* t{world.GetComponent<Transform>(cameraEntity)}) {
+            t->SetPosition(s.position);
+            t->LookAt(s.position + s.direction.Normalized());
+        }
+        orchestratorECS.UpdateECS(kStep);
+    });
+
+    const U32 frames{opt.path == "static" || opt.path == "fly" || opt.path == "orbit" ? opt.frames : static_cast<U32>(path.size())};
+    Series frameMs{};
+    ProfileTotals totals{};
+    std::optional<std::pair<U32, F64>> fullView{};
+    const auto start{std::chrono::steady_clock::now()};
+
+    auto step = [&] {
+        const auto frameStart{std::chrono::steady_clock::now()};
+        orchestrator.ExecuteFrame();
+        const auto frameEnd{std::chrono::steady_clock::now()};
+        frameMs.Add(std::chrono::duration<F64, std::milli>(frameEnd - frameStart).count());
+        totals.Collect(systemNames);
+
+        if (!fullView) {
+            auto const* c{world.GetComponent<Camera>(cameraEntity)};
+            auto const* t{world.GetComponent<Transform>(cameraEntity)};
+            if (c && t && FullView(world, *c, *t, wcfg, scfg)) {
+                fullView = std::pair{frame + 1, std::chrono::duration<F64, std::milli>(frameEnd - start).count()};
+            }
+        }
+        ++frame;
+    };
+
+    while (frame < frames) step();
+    // Unpaced frames can outrun the generation and meshing jobs; hold the last pose until the
+    // view fills in so time-to-full-view is always measured.
+    const auto drainEnd{std::chrono::steady_clock::now() + kDrainLimit};
+    while (!fullView && std::chrono::steady_clock::now() < drainEnd) step();
+    const F64 seconds{std::chrono::duration<F64>(std::chrono::steady_clock::now() - start).count()};
+
+    // Moves the last frame into the history so it is counted too.
+    TaskProfiler::Get().BeginFrame(orchestrator.GetCurrentFrame().frameNumber + 1);
+    TaskProfiler::Get().EndFrame();
+    totals.Collect(systemNames);
+
+    auto counter = [&](char const* name) { return totals.counters.contains(name) ? totals.counters.at(name) : S64{0}; };
+    const NullGraphicsStats gs{gfx.GetStats()};
+    const MeshArenaStats as{gfx.GetMeshArena().GetStats()};
+
+    std::string json{"{\n"};
+    json += std::format("  \"benchmark\": \"voxel_bench\",\n  \"path\": \"{}\",\n  \"pathFrames\": {},\n  \"frames\": {},\n  \"threads\": {},\n"
+                        "  \"radius\": {},\n  \"seconds\": {:.4f},\n",
+                        EscapeJson(opt.path), frames, frame, opt.threads, opt.radius, seconds);
+    json += std::format("  \"frameMs\": {},\n", frameMs.Json());
+    json += fullView ? std::format("  \"timeToFullView\": {{\"frames\": {}, \"ms\": {:.3f}}},\n", fullView->first, fullView->second)
+                     : std::string{"  \"timeToFullView\": null,\n"};
+    json += std::format("  \"chunks\": {{\"generated\": {}, \"loaded\": {}, \"meshed\": {}, \"uploaded\": {}}},\n",
+                        counter("ChunksGenerated"), counter("ChunksLoaded"), counter("ChunksMeshed"), counter("MeshesUploaded"));
+    json += std::format("  \"chunksPerSecond\": {{\"generated\": {:.2f}, \"meshed\": {:.2f}, \"uploaded\": {:.2f}}},\n",
+                        static_cast<F64>(counter("ChunksGenerated")) / seconds, static_cast<F64>(counter("ChunksMeshed")) / seconds,
+                        static_cast<F64>(counter("MeshesUploaded")) / seconds);
+    json += std::format("  \"peakRssBytes\": {},\n", PeakRssBytes());
+    // No renderer runs headless, so only upload traffic is reported.
+    json += std::format("  \"graphics\": {{\"bytesUploaded\": {}, \"meshCopies\": {}, \"constantBuffers\": {}}},\n",
+                        gs.bytesUploaded, gs.meshCopies, gs.constantBuffers);
+    json += std::format("  \"meshArena\": {{\"pages\": {}, \"heapBytes\": {}, \"usedBytes\": {}, \"stalls\": {}}},\n",
+                        as.pages, as.heapBytes, as.usedBytes, as.stalls);
+    json += "  \"systemsMs\": {";
+    bool first{true};
+    for (auto const& [name, series] : totals.systems) {
+        json += std::format("{}\n    \"{}\": {}", first ? "" : ",", name, series.Json());
+        first = false;
+    }
+    json += "\n  }\n}\n";
+
+    if (opt.out.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream file{opt.out};
+        if (!file) {
+            std::cerr << std::format("voxel_bench: cannot write '{}'\n", opt.out);
+            return 1;
+        }
+        file << json;
+    }
+    return 0;
+}
@@ -1,35 +1,93 @@
+# Locates the source of the std module for the active toolchain: MSVC ships std.ixx, while
+# libstdc++ (GCC 15+) and libc++ describe theirs in a modules.json next to the library.
+set(VOXEL_STD_MODULE_SOURCE "" CACHE FILEPATH "Source of the std module (found automatically when empty)")
+
+function(find_std_module_source out)
+    if (VOXEL_STD_MODULE_SOURCE)
+        set(${out} "${VOXEL_STD_MODULE_SOURCE}" PARENT_SCOPE)
+        return()
+    endif ()
+
+    if (MSVC)
+        set(${out} "$ENV{VCToolsInstallDir}modules/std.ixx" PARENT_SCOPE)
+        return()
+    endif ()
+
+    separate_arguments(_FLAGS NATIVE_COMMAND "${CMAKE_CXX_FLAGS}")
+    if (CMAKE_CXX_COMPILER_ID STREQUAL "Clang" AND "${CMAKE_CXX_FLAGS}" MATCHES "-stdlib=libc\\+\\+")
+        set(_MANIFEST_NAME "libc++.modules.json")
+    else ()
+        set(_MANIFEST_NAME "libstdc++.modules.json")
+    endif ()
+    execute_process(
+            COMMAND ${CMAKE_CXX_COMPILER} ${_FLAGS} -print-file-name=${_MANIFEST_NAME}
+            OUTPUT_VARIABLE _MANIFEST
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            ERROR_QUIET
+    )
+    if (NOT IS_ABSOLUTE "${_MANIFEST}" OR NOT EXISTS "${_MANIFEST}")
+        set(${out} "" PARENT_SCOPE)
+        return()
+    endif ()
+
+    file(READ "${_MANIFEST}" _JSON)
+    string(JSON _COUNT LENGTH "${_JSON}" modules)
+    math(EXPR _LAST "${_COUNT} - 1")
+    foreach (_I RANGE ${_LAST})
+        string(JSON _NAME GET "${_JSON}" modules ${_I} logical-name)
+        if (_NAME STREQUAL "std")
+            string(JSON _SOURCE GET "${_JSON}" modules ${_I} source-path)
+            cmake_path(GET _MANIFEST PARENT_PATH _MANIFEST_DIR)
+            cmake_path(ABSOLUTE_PATH _SOURCE BASE_DIRECTORY "${_MANIFEST_DIR}" NORMALIZE)
+            set(${out} "${_SOURCE}" PARENT_SCOPE)
+            return()
+        endif ()
+    endforeach ()
+    set(${out} "" PARENT_SCOPE)
+endfunction()
+
 # Create a shared std module target
 function(create_std_module_target)
     if (NOT TARGET std_module)
-        set(_VS_MOD_DIR "$ENV{VCToolsInstallDir}modules")
-        set(_STD_IXX "${_VS_MOD_DIR}\\std.ixx")
+        find_std_module_source(_STD_SOURCE)
 
-        if (EXISTS "${_STD_IXX}")
+        if (_STD_SOURCE AND EXISTS "${_STD_SOURCE}")
+            cmake_path(GET _STD_SOURCE PARENT_PATH _STD_DIR)
             add_library(std_module STATIC)
             target_sources(std_module
                     PUBLIC
                     FILE_SET CXX_MODULES TYPE CXX_MODULES
-                    BASE_DIRS "${_VS_MOD_DIR}"
-                    FILES "${_STD_IXX}"
+                    BASE_DIRS "${_STD_DIR}"
+                    FILES "${_STD_SOURCE}"
             )
             set_target_options(std_module)
-            message(STATUS "Module std créé depuis ${_STD_IXX}")
+            message(STATUS "Module std créé depuis ${_STD_SOURCE}")
         else ()
-            message(FATAL_ERROR "Impossible de trouver std.ixx dans ${_VS_MOD_DIR}")
+            message(FATAL_ERROR "Impossible de trouver le module std; renseigner VOXEL_STD_MODULE_SOURCE")
         endif ()
     endif ()
 endfunction()
 
+# Adds every module under the current directory to target, or only FILES when given.
 function(add_module_library target)
-    file(GLOB_RECURSE _MODULE_INTERFACE
-            "${CMAKE_CURRENT_SOURCE_DIR}/*.cppm"
-            "${CMAKE_CURRENT_SOURCE_DIR}/*.ixx"
-    )
+    cmake_parse_arguments(PARSE_ARGV 1 _ARG "" "" "FILES")
 
-    file(GLOB_RECURSE _MODULE_IMPL
-            CONFIGURE_DEPENDS
-            "${CMAKE_CURRENT_SOURCE_DIR}/*.cpp"
-    )
+    if (_ARG_FILES)
+        set(_MODULE_INTERFACE ${_ARG_FILES})
+        list(FILTER _MODULE_INTERFACE INCLUDE REGEX "\\.(cppm|ixx)$")
+        set(_MODULE_IMPL ${_ARG_FILES})
+        list(FILTER _MODULE_IMPL INCLUDE REGEX "\\.cpp$")
+    else ()
+        file(GLOB_RECURSE _MODULE_INTERFACE
+                "${CMAKE_CURRENT_SOURCE_DIR}/*.cppm"
+                "${CMAKE_CURRENT_SOURCE_DIR}/*.ixx"
+        )
+
+        file(GLOB_RECURSE _MODULE_IMPL
+                CONFIGURE_DEPENDS
+                "${CMAKE_CURRENT_SOURCE_DIR}/*.cpp"
+        )
+    endif ()
 
     if (_MODULE_INTERFACE)
         target_sources(${target}
@@ -49,4 +107,4 @@ function(add_module_library target)
     target_link_libraries(${target} PUBLIC std_module)
 
     set_target_options(${target})
-endfunction()
\ No newline at end of file
+endfunction()
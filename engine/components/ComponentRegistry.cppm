@@ -21,7 +21,14 @@ export enum ComponentIDs : ComponentID {
     VoxelHotbarState_ID,
     VoxelAtlasInfo_ID,
     VoxelCullingStats_ID,
+    VoxelMemoryStats_ID,
     VoxelRayHit_ID,
+    VoxelChunkIndex_ID,
+    VoxelColumnCacheResource_ID,
+    VoxelRegionStoreResource_ID,
+    VoxelBufferPoolResource_ID,
+    VoxelStreamingEvents_ID,
+    VoxelDrawList_ID,
 
     // Game specific components
     GAME_COMPONENT_START
@@ -5,7 +5,9 @@ import Core.Assert;
 import ECS.Component;
 import Components.ComponentRegistry;
 import Math.Vector;
+import Math.Matrix;
 import Graphics;
+import Graphics.MeshArena;
 import std;
 
 export enum class Voxel : U8 {
@@ -19,26 +21,336 @@ export enum class Voxel : U8 {
     Water = 7
 };
 
+// Palette-compressed block storage for one chunk. Each voxel stores an index into a
+// small palette using 0, 1, 2, 4 or 8 bits; a chunk made of a single block type keeps
+// no index data at all. An empty palette means the chunk has not been generated yet.
+export class VoxelBlocks {
+public:
+    static constexpr U32 Volume{32u * 32u * 32u};
+
+    [[nodiscard]] bool Empty() const { return m_Palette.empty(); }
+    [[nodiscard]] bool IsUniform() const { return m_Palette.size() == 1; }
+    [[nodiscard]] U32 BitsPerIndex() const { return m_Bits; }
+    [[nodiscard]] U32 PaletteSize() const { return static_cast<U32>(m_Palette.size()); }
+    [[nodiscard]] std::span<const Voxel> Palette() const { return m_Palette; }
+
+    [[nodiscard]] Voxel Get(USize index) const {
+        if (m_Bits == 0) return m_Palette.empty() ? Voxel::Air : m_Palette[0];
+        return m_Palette[ReadIndex(index)];
+    }
+
+    void Set(USize index, Voxel v) {
+        assert(!Empty(), "Cannot write into an ungenerated chunk");
+        const U32 paletteIndex{FindOrAdd(v)};
+        if (const U32 bits{BitsFor(m_Palette.size())}; bits > m_Bits) Repack(bits);
+        if (m_Bits != 0) WriteIndex(index, paletteIndex);
+        UpdateOccupancy(index, v);
+    }
+
+    void Fill(Voxel v) {
+        m_Palette.assign(1, v);
+        Vector<U64>{}.swap(m_Words);
+        m_Bits = 0;
+        FillOccupancy(v != Voxel::Air);
+    }
+
+    // Occupancy summary for empty-space skipping: a 4x4x4 brick, or an 8x8x8 region, is
+    // occupied when it holds at least one non-Air voxel. Coordinates are chunk-local voxels.
+    [[nodiscard]] bool HasSolid() const { return m_Regions != 0; }
+    [[nodiscard]] bool RegionOccupied(U32 x, U32 y, U32 z) const {
+        return (m_Regions >> ((x >> 3) | ((y >> 3) << 2) | ((z >> 3) << 4))) & 1ull;
+    }
+    [[nodiscard]] bool BrickOccupied(U32 x, U32 y, U32 z) const {
+        return (m_Bricks[z >> 2] >> ((x >> 2) | ((y >> 2) << 3))) & 1ull;
+    }
+
+    // Compresses a dense array of Volume voxels.
+    void Assign(std::span<const Voxel> dense) {
+        Assign(dense, [](USize) { return Vector<U64>{}; });
+    }
+
+    // Same as Assign, but when the index storage is too small it is replaced by
+    // acquire(wordCount), e.g. a vector from a buffer pool.
+    template<typename AcquireWords>
+    void Assign(std::span<const Voxel> dense, AcquireWords&& acquire) {
+        assert(dense.size() == Volume, "Dense block array has the wrong size");
+        std::array<S16, 256> lut{};
+        lut.fill(-1);
+        m_Palette.clear();
+        for (Voxel v : dense) {
+            S16& slot{lut[static_cast<U8>(v)]};
+            if (slot < 0) {
+                slot = static_cast<S16>(m_Palette.size());
+                m_Palette.push_back(v);
+            }
+        }
+
+        m_Bits = BitsFor(m_Palette.size());
+        if (m_Bits == 0) {
+            Vector<U64>{}.swap(m_Words);
+            FillOccupancy(m_Palette[0] != Voxel::Air);
+            return;
+        }
+
+        const USize wordCount{WordCount(m_Bits)};
+        if (m_Words.capacity() < wordCount) m_Words = acquire(wordCount);
+        m_Words.assign(wordCount, 0ull);
+        const U32 perWord{64u / m_Bits};
+        for (USize w{}; w < m_Words.size(); ++w) {
+            U64 word{0};
+            const USize base{w * perWord};
+            for (U32 k{}; k < perWord; ++k) {
+                word |= static_cast<U64>(lut[static_cast<U8>(dense[base + k])]) << (k * m_Bits);
+            }
+            m_Words[w] = word;
+        }
+
+        if (lut[static_cast<U8>(Voxel::Air)] < 0) {
+            FillOccupancy(true);
+        } else {
+            m_Bricks.fill(0);
+            for (USize i{}; i < dense.size(); ++i) {
+                if (dense[i] != Voxel::Air) m_Bricks[i >> 12] |= 1ull << BrickBit(i);
+            }
+            UpdateRegions();
+        }
+    }
+
+    // Copies other; like Assign, too small index storage is replaced by acquire(wordCount).
+    template<typename AcquireWords>
+    void CopyFrom(VoxelBlocks const& other, AcquireWords&& acquire) {
+        m_Palette = other.m_Palette;
+        m_Bits = other.m_Bits;
+        m_Bricks = other.m_Bricks;
+        m_Regions = other.m_Regions;
+        if (m_Words.capacity() < other.m_Words.size()) m_Words = acquire(other.m_Words.size());
+        m_Words.assign(other.m_Words.begin(), other.m_Words.end());
+    }
+
+    // Expands into a dense array of Volume voxels.
+    void CopyTo(std::span<Voxel> dense) const {
+        assert(dense.size() == Volume, "Dense block array has the wrong size");
+        if (m_Bits == 0) {
+            std::ranges::fill(dense, Get(0));
+            return;
+        }
+
+        const U32 perWord{64u / m_Bits};
+        const U64 mask{(1ull << m_Bits) - 1ull};
+        for (USize w{}; w < m_Words.size(); ++w) {
+            U64 word{m_Words[w]};
+            const USize base{w * perWord};
+            for (U32 k{}; k < perWord; ++k) {
+                dense[base + k] = m_Palette[static_cast<USize>(word & mask)];
+                word >>= m_Bits;
+            }
+        }
+    }
+
+    // Drops palette entries no voxel refers to anymore, shrinking the index width if possible.
+    void Compact() {
+        if (m_Bits == 0) return;
+        static thread_local Vector<Voxel> scratch{};
+        scratch.resize(Volume);
+        CopyTo(scratch);
+        Assign(scratch);
+    }
+
+    void Clear() {
+        Vector<Voxel>{}.swap(m_Palette);
+        Vector<U64>{}.swap(m_Words);
+        m_Bits = 0;
+        FillOccupancy(false);
+    }
+
+    // Moves the index storage out (e.g. back into a buffer pool) and leaves the blocks ungenerated.
+    [[nodiscard]] Vector<U64> ReleaseStorage() {
+        Vector<U64> words{std::move(m_Words)};
+        Clear();
+        return words;
+    }
+
+    [[nodiscard]] USize MemoryUsage() const {
+        return m_Palette.capacity() * sizeof(Voxel) + m_Words.capacity() * sizeof(U64);
+    }
+
+private:
+    static constexpr USize WordCount(U32 bits) { return static_cast<USize>(Volume) * bits / 64u; }
+
+    static constexpr U32 BitsFor(USize paletteSize) {
+        if (paletteSize <= 1) return 0;
+        if (paletteSize <= 2) return 1;
+        if (paletteSize <= 4) return 2;
+        if (paletteSize <= 16) return 4;
+        return 8;
+    }
+
+    [[nodiscard]] U32 ReadIndex(USize index) const {
+        const USize bit{index * m_Bits};
+        return static_cast<U32>((m_Words[bit >> 6] >> (bit & 63u)) & ((1ull << m_Bits) - 1ull));
+    }
+
+    void WriteIndex(USize index, U32 value) {
+        const USize bit{index * m_Bits};
+        const U64 mask{((1ull << m_Bits) - 1ull) << (bit & 63u)};
+        U64& word{m_Words[bit >> 6]};
+        word = (word & ~mask) | ((static_cast<U64>(value) << (bit & 63u)) & mask);
+    }
+
+    // Bit of voxel index's brick within its m_Bricks word (one word per 4-voxel Z slab).
+    static constexpr U32 BrickBit(USize index) {
+        return static_cast<U32>(((index & 31u) >> 2) | (((index >> 5) & 31u) >> 2) << 3);
+    }
+
+    void FillOccupancy(bool solid) {
+        m_Bricks.fill(solid ? ~0ull : 0ull);
+        m_Regions = solid ? ~0ull : 0ull;
+    }
+
+    void UpdateRegions() {
+        m_Regions = 0;
+        for (U32 bz{}; bz < 8; ++bz) {
+            const U64 slab{m_Bricks[bz]};
+            if (slab == 0) continue;
+            for (U32 by{}; by < 8; ++by) {
+                for (U32 bx{}; bx < 8; ++bx) {
+                    if ((slab >> (bx | (by << 3))) & 1ull) m_Regions |= 1ull << ((bx >> 1) | ((by >> 1) << 2) | ((bz >> 1) << 4));
+                }
+            }
+        }
+    }
+
+    void UpdateOccupancy(USize index, Voxel v) {
+        U64& slab{m_Bricks[index >> 12]};
+        const U64 bit{1ull << BrickBit(index)};
+        if (v != Voxel::Air) {
+            if (slab & bit) return;
+            slab |= bit;
+        } else {
+            if (!(slab & bit)) return;
+            // The brick empties only if this was its last solid voxel.
+            const USize x0{index & 28u}, y0{(index >> 5) & 28u}, z0{(index >> 10) & 28u};
+            for (USize z{z0}; z < z0 + 4; ++z)
+                for (USize y{y0}; y < y0 + 4; ++y)
+                    for (USize x{x0}; x < x0 + 4; ++x)
+                        if (Get(x + y * 32u + z * 1024u) != Voxel::Air) return;
+            slab &= ~bit;
+        }
+        UpdateRegions();
+    }
+
+    U32 FindOrAdd(Voxel v) {
+        for (USize i{}; i < m_Palette.size(); ++i) {
+            if (m_Palette[i] == v) return static_cast<U32>(i);
+        }
+        m_Palette.push_back(v);
+        return static_cast<U32>(m_Palette.size() - 1);
+    }
+
+    void Repack(U32 bits) {
+        Vector<U64> words(WordCount(bits), 0ull);
+        const U64 mask{(1ull << bits) - 1ull};
+        for (USize i{}; i < Volume; ++i) {
+            const U64 value{m_Bits == 0 ? 0ull : static_cast<U64>(ReadIndex(i))};
+            const USize bit{i * bits};
+            words[bit >> 6] |= (value & mask) << (bit & 63u);
+        }
+        m_Words = std::move(words);
+        m_Bits = bits;
+    }
+
+    Vector<Voxel> m_Palette{};
+    Vector<U64> m_Words{};
+    U32 m_Bits{0};
+    std::array<U64, 8> m_Bricks{};   // 4^3 bricks: word bz, bit bx + 8 * by
+    U64 m_Regions{0};                // 8^3 regions: bit rx + 4 * ry + 16 * rz
+};
 
 export struct VoxelWorldConfig {
     U32 chunksX{1}; U32 chunksY{1}; U32 chunksZ{1}; F32 blockSize{1.0f};
 };
 
+// Chunk-local voxel bounds, inclusive; empty while min > max.
+export struct VoxelEditBox {
+    U8 minX{255}, minY{255}, minZ{255};
+    U8 maxX{0}, maxY{0}, maxZ{0};
+
+    [[nodiscard]] bool Empty() const { return minX > maxX; }
+
+    void Add(U32 x, U32 y, U32 z) {
+        minX = std::min(minX, static_cast<U8>(x)); maxX = std::max(maxX, static_cast<U8>(x));
+        minY = std::min(minY, static_cast<U8>(y)); maxY = std::max(maxY, static_cast<U8>(y));
+        minZ = std::min(minZ, static_cast<U8>(z)); maxZ = std::max(maxZ, static_cast<U8>(z));
+    }
+
+    void Merge(VoxelEditBox const& o) {
+        if (o.Empty()) return;
+        Add(o.minX, o.minY, o.minZ);
+        Add(o.maxX, o.maxY, o.maxZ);
+    }
+};
+
 export struct VoxelChunk {
     static constexpr U32 SizeX{32}, SizeY{32}, SizeZ{32};
     U32 cx{0}, cy{0}, cz{0};
     Math::Vec3 origin{0.0f,0.0f,0.0f};
-    Vector<Voxel> blocks{};
+    VoxelBlocks blocks{};
     bool dirty{true};
     bool generating{false};
+    bool modified{false}; // contents differ from the region store
+    U32 revision{0};
+    VoxelEditBox edited{}; // voxels edited since meshing last took a snapshot; meshed first
+    U32 meshSlot{INVALID_INDEX}; // entry in VoxelMeshingSystem's dirty queue
+
+    // Bumps the revision so in-flight meshing of the previous contents gets discarded.
+    void MarkDirty() { dirty = true; ++revision; }
+};
+
+static_assert(VoxelChunk::SizeX * VoxelChunk::SizeY * VoxelChunk::SizeZ == VoxelBlocks::Volume);
+
+// 8-byte chunk vertex. lo: x, y, z (6 bits each, chunk-local block corner 0..32) and
+// the face (3 bits, NX PX NY PY NZ PZ). hi: u, v (6 bits each, quad-size UVs) and the
+// atlas tile (8 bits). Voxel.hlsl decodes the same layout.
+export struct ChunkVertex {
+    U32 lo{};
+    U32 hi{};
+};
+
+static_assert(sizeof(ChunkVertex) == 8);
+
+export struct ChunkVertexData {
+    U32 x{}, y{}, z{};
+    U32 face{};
+    U32 u{}, v{};
+    U32 tile{};
+
+    constexpr bool operator==(const ChunkVertexData&) const = default;
 };
 
+export constexpr ChunkVertex PackChunkVertex(ChunkVertexData const& d) {
+    return ChunkVertex{
+        (d.x & 63u) | ((d.y & 63u) << 6) | ((d.z & 63u) << 12) | ((d.face & 7u) << 18),
+        (d.u & 63u) | ((d.v & 63u) << 6) | ((d.tile & 255u) << 12)
+    };
+}
+
+export constexpr ChunkVertexData UnpackChunkVertex(ChunkVertex v) {
+    return ChunkVertexData{
+        v.lo & 63u, (v.lo >> 6) & 63u, (v.lo >> 12) & 63u,
+        (v.lo >> 18) & 7u,
+        v.hi & 63u, (v.hi >> 6) & 63u,
+        (v.hi >> 12) & 255u
+    };
+}
+
 export struct VoxelMesh {
-    Vector<Vertex> cpuVertices{}; Vector<U32> cpuIndices{};
-    U32 vertexBuffer{INVALID_INDEX}; U32 indexBuffer{INVALID_INDEX};
+    Vector<ChunkVertex> cpuVertices{}; Vector<U32> cpuIndices{};
+    MeshAllocation gpu{};
+    Math::Mat4 world{};   // chunk-local block corners to world, pushed with each draw
+    U32 drawSlot{INVALID_INDEX}; // entry in VoxelDrawList while the uploaded mesh is non-empty
     U32 vertexCount{0}; U32 indexCount{0};
     bool gpuDirty{false}; bool meshing{false};
-    Vector<Vertex> readyVertices{};
+    Vector<ChunkVertex> readyVertices{}; Vector<U32> readyIndices{};
 };
 
 export struct VoxelRenderResources { U32 pipeline{INVALID_INDEX}; };
@@ -65,6 +377,19 @@ export struct VoxelCullingStats {
     U64 drawnIndices{};
 };
 
+export struct VoxelMemoryStats {
+    U32 chunks{};
+    U32 uniformChunks{};
+    U64 blockBytes{};
+    U64 meshBytes{};
+    U64 bytesPerChunk{};
+    U64 poolBytes{};
+    U64 poolHits{};
+    U64 poolMisses{};
+    U64 gpuMeshBytes{};   // live mesh arena allocations
+    U64 gpuHeapBytes{};   // mesh arena pages
+};
+
 export template<> struct ComponentTypeID<VoxelWorldConfig>{ static consteval ComponentID value(){return VoxelWorldConfig_ID;} };
 export template<> struct ComponentTypeID<VoxelChunk>{ static consteval ComponentID value(){return VoxelChunk_ID;} };
 export template<> struct ComponentTypeID<VoxelMesh>{ static consteval ComponentID value(){return VoxelMesh_ID;} };
@@ -72,6 +397,7 @@ export template<> struct ComponentTypeID<VoxelRenderResources>{ static consteval
 export template<> struct ComponentTypeID<VoxelHotbarState>{ static consteval ComponentID value(){return VoxelHotbarState_ID;} };
 export template<> struct ComponentTypeID<VoxelAtlasInfo>{ static consteval ComponentID value(){return VoxelAtlasInfo_ID;} };
 export template<> struct ComponentTypeID<VoxelCullingStats>{ static consteval ComponentID value(){return VoxelCullingStats_ID;} };
+export template<> struct ComponentTypeID<VoxelMemoryStats>{ static consteval ComponentID value(){return VoxelMemoryStats_ID;} };
 
 export inline USize VoxelIndex(U32 x,U32 y,U32 z){
     return static_cast<USize>(x)+static_cast<USize>(y)*VoxelChunk::SizeX+static_cast<USize>(z)*VoxelChunk::SizeX*VoxelChunk::SizeY;
@@ -0,0 +1,191 @@
+export module Components.VoxelChunkIndex;
+
+import Core.Types;
+import Core.Assert;
+import ECS.Component;
+import ECS.World;
+import Components.ComponentRegistry;
+import Components.Voxel;
+import Math.Vector;
+import std;
+
+namespace detail {
+    // Each coordinate is biased into a 21-bit field, covering [-2^20, 2^20).
+    constexpr U32 kChunkKeyBits{21};
+    constexpr S64 kChunkKeyBias{1ll << 20};
+    constexpr U64 kChunkKeyMask{(1ull << kChunkKeyBits) - 1ull};
+}
+
+export inline U64 PackChunkKey(S32 x, S32 y, S32 z) {
+    return (static_cast<U64>(static_cast<S64>(x) + detail::kChunkKeyBias))
+         | (static_cast<U64>(static_cast<S64>(y) + detail::kChunkKeyBias) << detail::kChunkKeyBits)
+         | (static_cast<U64>(static_cast<S64>(z) + detail::kChunkKeyBias) << (2 * detail::kChunkKeyBits));
+}
+
+// Inverse of PackChunkKey.
+export inline Math::IVec3 UnpackChunkKey(U64 key) {
+    return {static_cast<S32>(static_cast<S64>(key & detail::kChunkKeyMask) - detail::kChunkKeyBias),
+            static_cast<S32>(static_cast<S64>((key >> detail::kChunkKeyBits) & detail::kChunkKeyMask) - detail::kChunkKeyBias),
+            static_cast<S32>(static_cast<S64>((key >> (2 * detail::kChunkKeyBits)) & detail::kChunkKeyMask) - detail::kChunkKeyBias)};
+}
+
+// World-wide chunk coordinate -> entity map. Open addressing with linear probing and
+// backward-shift deletion, so lookups touch one or two cache lines and never allocate.
+// Streaming owns it: entries are added when a chunk entity is created and removed right
+// before it is destroyed. Handles are stored rather than pointers because component
+// storage may move chunks around.
+export class VoxelChunkIndex {
+public:
+    VoxelChunkIndex() { Rehash(kMinCapacity); }
+
+    [[nodiscard]] U32 Size() const { return m_Size; }
+    [[nodiscard]] U32 Capacity() const { return static_cast<U32>(m_Slots.size()); }
+
+    [[nodiscard]] EntityHandle Find(S32 cx, S32 cy, S32 cz) const {
+        const U64 key{PackChunkKey(cx, cy, cz)};
+        for (U32 i{Home(key)};; i = (i + 1) & m_Mask) {
+            Slot const& s{m_Slots[i]};
+            if (!s.handle.valid()) return EntityHandle{};
+            if (s.key == key) return s.handle;
+        }
+    }
+
+    [[nodiscard]] bool Contains(S32 cx, S32 cy, S32 cz) const { return Find(cx, cy, cz).valid(); }
+
+    void Insert(S32 cx, S32 cy, S32 cz, EntityHandle h) {
+        assert(h.valid(), "Cannot index an invalid entity");
+        if ((m_Size + 1) * 2 > Capacity()) Rehash(Capacity() * 2);
+        const U64 key{PackChunkKey(cx, cy, cz)};
+        for (U32 i{Home(key)};; i = (i + 1) & m_Mask) {
+            Slot& s{m_Slots[i]};
+            if (!s.handle.valid()) { s = Slot{key, h}; ++m_Size; return; }
+            if (s.key == key) { s.handle = h; return; }
+        }
+    }
+
+    bool Erase(S32 cx, S32 cy, S32 cz) {
+        const U64 key{PackChunkKey(cx, cy, cz)};
+        U32 i{Home(key)};
+        for (;; i = (i + 1) & m_Mask) {
+            if (!m_Slots[i].handle.valid()) return false;
+            if (m_Slots[i].key == key) break;
+        }
+
+        // Shift following entries back so no probe chain is broken by the hole.
+        for (U32 j{(i + 1) & m_Mask};; j = (j + 1) & m_Mask) {
+            if (!m_Slots[j].handle.valid()) break;
+            const U32 home{Home(m_Slots[j].key)};
+            if (((j - home) & m_Mask) >= ((j - i) & m_Mask)) {
+                m_Slots[i] = m_Slots[j];
+                i = j;
+            }
+        }
+        m_Slots[i] = Slot{};
+        --m_Size;
+        return true;
+    }
+
+    void Clear() {
+        std::ranges::fill(m_Slots, Slot{});
+        m_Size = 0;
+    }
+
+private:
+    struct Slot {
+        U64 key{};
+        EntityHandle handle{};
+    };
+
+    static constexpr U32 kMinCapacity{256};
+
+    [[nodiscard]] U32 Home(U64 key) const {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdull;
+        key ^= key >> 33;
+        return static_cast<U32>(key) & m_Mask;
+    }
+
+    void Rehash(U32 capacity) {
+        Vector<Slot> old{std::move(m_Slots)};
+        m_Slots.assign(capacity, Slot{});
+        m_Mask = capacity - 1;
+        m_Size = 0;
+        for (Slot const& s : old) {
+            if (!s.handle.valid()) continue;
+            for (U32 i{Home(s.key)};; i = (i + 1) & m_Mask) {
+                if (!m_Slots[i].handle.valid()) { m_Slots[i] = s; ++m_Size; break; }
+            }
+        }
+    }
+
+    Vector<Slot> m_Slots{};
+    U32 m_Mask{0};
+    U32 m_Size{0};
+};
+
+export template<>
+struct ComponentTypeID<VoxelChunkIndex> {
+    static consteval ComponentID value() { return VoxelChunkIndex_ID; }
+};
+
+export inline VoxelChunkIndex* FindVoxelChunkIndex(World* world) {
+    auto* store{world->GetStorage<VoxelChunkIndex>()};
+    if (!store) return nullptr;
+    for (auto [h,c] : *store) return &c;
+    return nullptr;
+}
+
+export inline VoxelChunkIndex const* FindVoxelChunkIndex(World const* world) {
+    auto* store{world->GetStorage<VoxelChunkIndex>()};
+    if (!store) return nullptr;
+    for (auto [h,c] : *store) return &c;
+    return nullptr;
+}
+
+export inline VoxelChunk* FindChunk(World* world, VoxelChunkIndex const& index, S32 cx, S32 cy, S32 cz) {
+    const EntityHandle h{index.Find(cx, cy, cz)};
+    return h.valid() ? world->GetComponent<VoxelChunk>(h) : nullptr;
+}
+
+export inline VoxelChunk const* FindChunk(World const* world, VoxelChunkIndex const& index, S32 cx, S32 cy, S32 cz) {
+    const EntityHandle h{index.Find(cx, cy, cz)};
+    return h.valid() ? world->GetComponent<VoxelChunk>(h) : nullptr;
+}
+
+// Re-meshes the six face neighbours, whose border faces depend on this chunk's blocks.
+// Marks only the neighbours whose shared face the edited box touches; their meshes cull
+// against this chunk's boundary voxels. The neighbour's own border layer facing the edit is
+// added to its edited box, so it is remeshed as promptly as the edited chunk itself.
+export inline void MarkChunkFaceNeighborsDirty(World* world, VoxelChunkIndex const& index, VoxelChunk const& chunk,
+                                               VoxelEditBox const& box) {
+    if (box.Empty()) return;
+    constexpr U32 kLastX{VoxelChunk::SizeX - 1}, kLastY{VoxelChunk::SizeY - 1}, kLastZ{VoxelChunk::SizeZ - 1};
+    const S32 cx{static_cast<S32>(chunk.cx)}, cy{static_cast<S32>(chunk.cy)}, cz{static_cast<S32>(chunk.cz)};
+    // face: the box's extent with one axis pinned to the neighbour's facing layer.
+    auto mark = [&](S32 dx, S32 dy, S32 dz, VoxelEditBox face) {
+        if (auto* n{FindChunk(world, index, cx + dx, cy + dy, cz + dz)}) {
+            n->MarkDirty();
+            n->edited.Merge(face);
+        }
+    };
+    auto pinned = [&box](U32 axis, U8 layer) {
+        VoxelEditBox face{box};
+        (axis == 0 ? face.minX : axis == 1 ? face.minY : face.minZ) = layer;
+        (axis == 0 ? face.maxX : axis == 1 ? face.maxY : face.maxZ) = layer;
+        return face;
+    };
+    if (box.minX == 0) mark(-1, 0, 0, pinned(0, kLastX));
+    if (box.maxX == kLastX) mark(1, 0, 0, pinned(0, 0));
+    if (box.minY == 0) mark(0, -1, 0, pinned(1, kLastY));
+    if (box.maxY == kLastY) mark(0, 1, 0, pinned(1, 0));
+    if (box.minZ == 0) mark(0, 0, -1, pinned(2, kLastZ));
+    if (box.maxZ == kLastZ) mark(0, 0, 1, pinned(2, 0));
+}
+
+export inline void MarkChunkNeighborsDirty(World* world, VoxelChunkIndex const& index, VoxelChunk const& chunk) {
+    constexpr S32 kOffsets[6][3]{{-1,0,0},{1,0,0},{0,-1,0},{0,1,0},{0,0,-1},{0,0,1}};
+    const S32 cx{static_cast<S32>(chunk.cx)}, cy{static_cast<S32>(chunk.cy)}, cz{static_cast<S32>(chunk.cz)};
+    for (auto const& o : kOffsets) {
+        if (auto* n{FindChunk(world, index, cx + o[0], cy + o[1], cz + o[2])}) n->MarkDirty();
+    }
+}
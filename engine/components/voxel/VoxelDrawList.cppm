@@ -0,0 +1,78 @@
+export module Components.VoxelDrawList;
+
+import Core.Types;
+import Core.Assert;
+import ECS.Component;
+import ECS.World;
+import Components.ComponentRegistry;
+import Graphics.MeshArena;
+import Math.Matrix;
+import Math.Transform;
+import Math.Culling;
+import std;
+
+export struct VoxelDraw {
+    MeshAllocation gpu{};
+    Math::Mat4 world{};
+};
+
+// Bounds and draw data of every chunk with a non-empty uploaded mesh, so the renderer culls
+// and draws without visiting the chunks. VoxelUploadSystem keeps it in step with the meshes:
+// a chunk gets an entry when its first mesh is uploaded and loses it, by swap-removal, when
+// its mesh becomes empty or it is unloaded. VoxelMesh::drawSlot is the chunk's entry.
+export class VoxelDrawList {
+public:
+    [[nodiscard]] U32 Size() const { return m_Bounds.Size(); }
+    [[nodiscard]] Math::BoundsSoA const& Bounds() const { return m_Bounds; }
+    [[nodiscard]] VoxelDraw const& Draw(U32 slot) const { return m_Draws[slot]; }
+    [[nodiscard]] EntityHandle Owner(U32 slot) const { return m_Owners[slot]; }
+
+    U32 Add(EntityHandle owner, Math::Bounds const& bounds, VoxelDraw const& draw) {
+        m_Owners.push_back(owner);
+        m_Draws.push_back(draw);
+        return m_Bounds.Add(bounds);
+    }
+
+    void Update(U32 slot, VoxelDraw const& draw) {
+        assert(slot < Size(), "Draw slot out of range");
+        m_Draws[slot] = draw;
+    }
+
+    // Returns the owner of the entry moved into slot, or an invalid handle if none moved.
+    EntityHandle Remove(U32 slot) {
+        const U32 last{m_Bounds.RemoveSwap(slot)};
+        EntityHandle moved{};
+        if (last != slot) {
+            m_Owners[slot] = m_Owners[last];
+            m_Draws[slot] = m_Draws[last];
+            moved = m_Owners[slot];
+        }
+        m_Owners.pop_back();
+        m_Draws.pop_back();
+        return moved;
+    }
+
+private:
+    Math::BoundsSoA m_Bounds{};
+    Vector<VoxelDraw> m_Draws{};
+    Vector<EntityHandle> m_Owners{};
+};
+
+export template<>
+struct ComponentTypeID<VoxelDrawList> {
+    static consteval ComponentID value() { return VoxelDrawList_ID; }
+};
+
+export inline VoxelDrawList* FindVoxelDrawList(World* world) {
+    auto* store{world->GetStorage<VoxelDrawList>()};
+    if (!store) return nullptr;
+    for (auto [h,c] : *store) return &c;
+    return nullptr;
+}
+
+export inline VoxelDrawList const* FindVoxelDrawList(World const* world) {
+    auto* store{world->GetStorage<VoxelDrawList>()};
+    if (!store) return nullptr;
+    for (auto [h,c] : *store) return &c;
+    return nullptr;
+}
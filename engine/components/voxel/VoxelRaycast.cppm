@@ -1,10 +1,13 @@
 export module Systems.VoxelRaycast;
 
+import ECS.Component;
 import ECS.World;
 import Components.ComponentRegistry;
 import Components.Voxel;
+import Components.VoxelChunkIndex;
 import Math.Core;
 import Math.Vector;
+import Tasks.TaskGraph;
 import Core.Assert;
 import Core.Types;
 import std;
@@ -17,96 +20,160 @@ export struct VoxelRayHit {
     F32 t{0.0f};
 };
 
+// A batch ray: dir need not be normalized.
+export struct VoxelRay {
+    Math::Vec3 origin{};
+    Math::Vec3 dir{};
+    F32 maxDist{0.0f};
+};
+
 namespace detail {
+    constexpr S32 kNX{static_cast<S32>(VoxelChunk::SizeX)};
+    constexpr S32 kNY{static_cast<S32>(VoxelChunk::SizeY)};
+    constexpr S32 kNZ{static_cast<S32>(VoxelChunk::SizeZ)};
+
     inline S32 floordiv(S32 a, S32 b) {
-        return static_cast<S32>(std::floor(static_cast<F32>(a) / static_cast<F32>(b)));
+        return a >= 0 ? a / b : -((b - 1 - a) / b);
     }
 
-    inline bool FetchChunk(World* w, S32 cx, S32 cy, S32 cz, VoxelChunk*& out) {
-        out = nullptr;
-        if (auto* s = w->GetStorage<VoxelChunk>()) {
-            for (auto [h,c] : *s) {
-                if (static_cast<S32>(c.cx)==cx && static_cast<S32>(c.cy)==cy && static_cast<S32>(c.cz)==cz) {
-                    out = const_cast<VoxelChunk*>(&c);
-                    return true;
-                }
-            }
+    // Read-only view of the loaded chunks. It bypasses World so that task workers, which do
+    // not run under the calling system's declared access, can use it.
+    struct ChunkSource {
+        VoxelChunkIndex const* index{};
+        ComponentStorage<VoxelChunk> const* chunks{};
+
+        [[nodiscard]] VoxelChunk const* Find(S32 cx, S32 cy, S32 cz) const {
+            if (!index || !chunks) return nullptr;
+            const EntityHandle h{index->Find(cx, cy, cz)};
+            return h.valid() ? chunks->Get(h) : nullptr;
         }
-        return false;
-    }
+    };
 
-    inline bool GetVoxel(World* w, S32 gx, S32 gy, S32 gz, Voxel& out) {
-        constexpr S32 NX{static_cast<S32>(VoxelChunk::SizeX)};
-        constexpr S32 NY{static_cast<S32>(VoxelChunk::SizeY)};
-        constexpr S32 NZ{static_cast<S32>(VoxelChunk::SizeZ)};
-        S32 cx{floordiv(gx, NX)}, cy{floordiv(gy, NY)}, cz{floordiv(gz, NZ)};
-        S32 lx{gx - cx*NX}, ly{gy - cy*NY}, lz{gz - cz*NZ};
-        VoxelChunk* ch{};
-        if (!FetchChunk(w, cx, cy, cz, ch)) return false;
-        if (ch->blocks.empty()) return false;
-        out = ch->blocks[VoxelIndex(static_cast<U32>(lx), static_cast<U32>(ly), static_cast<U32>(lz))];
-        return true;
+    inline ChunkSource MakeChunkSource(World const* world) {
+        return ChunkSource{FindVoxelChunkIndex(world), world->GetStorage<VoxelChunk>()};
     }
-}
 
-export VoxelRayHit RaycastVoxelDDA(World* world, Math::Vec3 origin, Math::Vec3 dir, F32 maxDist) {
-    VoxelRayHit hit{};
-    auto* cfgStore{world->GetStorage<VoxelWorldConfig>()};
-    assert(cfgStore && cfgStore->Size()>0, "Missing VoxelWorldConfig");
-    VoxelWorldConfig const* cfg{};
-    for (auto [h,c] : *cfgStore) { cfg = &c; break; }
-    const F32 bs{cfg->blockSize};
+    inline F32 BlockSize(World const* world) {
+        auto* cfgStore{world->GetStorage<VoxelWorldConfig>()};
+        assert(cfgStore && cfgStore->Size()>0, "Missing VoxelWorldConfig");
+        VoxelWorldConfig const* cfg{};
+        for (auto [h,c] : *cfgStore) { cfg = &c; break; }
+        return cfg->blockSize;
+    }
 
-    Math::Vec3 rd{dir.Normalized()};
-    const F32 eps{1e-6f};
-    const F32 inf{1e30f};
+    // DDA that skips lookups in empty space: missing or air-only chunks and empty 8^3 regions
+    // are crossed without touching voxels. Inside occupied regions it steps voxel by voxel,
+    // decoding voxels only in occupied 4^3 bricks; jumping bricks costs more than it saves near
+    // terrain surfaces.
+    //
+    // Every step, including those through empty space, is the classic accumulate-and-divide
+    // walk: the first boundary per axis is divided by the direction and later ones add tDelta,
+    // with ties going to z, then y. Skipping only leaves out the lookups, so hits, previous
+    // cells, normals and distances are bit-identical to a plain per-voxel walk.
+    inline VoxelRayHit Trace(ChunkSource const& source, F32 bs, Math::Vec3 origin, Math::Vec3 dir, F32 maxDist) {
+        constexpr S32 kSize[3]{kNX, kNY, kNZ};
+        constexpr S32 kRegion{8};
+        const F32 eps{1e-6f};
+        const F32 inf{1e30f};
 
-    auto wx = static_cast<F32>(std::floor(origin.x / bs));
-    auto wy = static_cast<F32>(std::floor(origin.y / bs));
-    auto wz = static_cast<F32>(std::floor(origin.z / bs));
-    S32 gx{static_cast<S32>(wx)}, gy{static_cast<S32>(wy)}, gz{static_cast<S32>(wz)};
+        VoxelRayHit hit{};
+        const Math::Vec3 rd{dir.Normalized()};
+        S32 g[3]{}, step[3]{};
+        F32 tMax[3]{}, tDelta[3]{};
+        for (U32 a{}; a < 3; ++a) {
+            g[a] = static_cast<S32>(std::floor(origin[a] / bs));
+            step[a] = rd[a] > 0.0f ? 1 : -1;
+            const F32 nb{(static_cast<F32>(g[a] + (step[a] > 0 ? 1 : 0)) * bs - origin[a])
+                         / (std::abs(rd[a]) < eps ? (step[a] > 0 ? eps : -eps) : rd[a])};
+            tMax[a] = nb < 0.0f ? 0.0f : nb;
+            tDelta[a] = std::abs(rd[a]) < eps ? inf : bs / std::abs(rd[a]);
+        }
 
-    S32 stepx{rd.x>0.0f?1:-1}, stepy{rd.y>0.0f?1:-1}, stepz{rd.z>0.0f?1:-1};
+        S32 p[3]{g[0], g[1], g[2]};
+        // Crosses the next cell boundary and returns the axis it stepped along.
+        auto advance = [&]() -> U32 {
+            const U32 a{tMax[0] < tMax[1] ? (tMax[0] < tMax[2] ? 0u : 2u) : (tMax[1] < tMax[2] ? 1u : 2u)};
+            p[0] = g[0]; p[1] = g[1]; p[2] = g[2];
+            g[a] += step[a];
+            hit.t = tMax[a];
+            tMax[a] += tDelta[a];
+            return a;
+        };
 
-    auto nextBoundary = [&](F32 o, F32 d, S32 g, S32 s)->F32 {
-        F32 nb = (static_cast<F32>(g + (s>0?1:0)) * bs - o) / (std::abs(d)<eps? (s>0?+eps:-eps) : d);
-        return nb < 0.0f ? 0.0f : nb;
-    };
-    auto delta = [&](F32 d)->F32 { return std::abs(d)<eps ? inf : (bs / std::abs(d)); };
-
-    F32 tMaxX{nextBoundary(origin.x, rd.x, gx, stepx)};
-    F32 tMaxY{nextBoundary(origin.y, rd.y, gy, stepy)};
-    F32 tMaxZ{nextBoundary(origin.z, rd.z, gz, stepz)};
-    F32 tDeltaX{delta(rd.x)}, tDeltaY{delta(rd.y)}, tDeltaZ{delta(rd.z)};
-
-    S32 px{gx}, py{gy}, pz{gz};
-    for (;;) {
-        Voxel v{};
-        if (detail::GetVoxel(world, gx, gy, gz, v) && v != Voxel::Air) {
-            hit.hit = true;
-            hit.gx = gx; hit.gy = gy; hit.gz = gz;
-            hit.pgx = px; hit.pgy = py; hit.pgz = pz;
-            hit.t = std::min({tMaxX, tMaxY, tMaxZ});
-            if (tMaxX <= tMaxY && tMaxX <= tMaxZ) hit.normal = Math::Vec3{static_cast<F32>(-stepx),0.0f,0.0f};
-            else if (tMaxY <= tMaxZ) hit.normal = Math::Vec3{0.0f,static_cast<F32>(-stepy),0.0f};
-            else hit.normal = Math::Vec3{0.0f,0.0f,static_cast<F32>(-stepz)};
-            return hit;
-        }
+        S32 c[3]{}, l[3]{};
+        VoxelChunk const* chunk{};
+        // Resolves the chunk of the current cell; the lookup is skipped while it stays the same.
+        auto locate = [&](bool force) {
+            bool moved{force};
+            for (U32 a{}; a < 3; ++a) {
+                const S32 cc{floordiv(g[a], kSize[a])};
+                moved = moved || cc != c[a];
+                c[a] = cc;
+                l[a] = g[a] - cc * kSize[a];
+            }
+            if (moved) chunk = source.Find(c[0], c[1], c[2]);
+        };
+        locate(true);
 
-        if (tMaxX < tMaxY) {
-            if (tMaxX < tMaxZ) {
-                px=gx; py=gy; pz=gz; gx += stepx; hit.t = tMaxX; tMaxX += tDeltaX;
-            } else {
-                px=gx; py=gy; pz=gz; gz += stepz; hit.t = tMaxZ; tMaxZ += tDeltaZ;
+        for (;;) {
+            // Size of the aligned empty box around the cell, or 0 inside an occupied region.
+            S32 box{0};
+            VoxelBlocks const* b{chunk ? &chunk->blocks : nullptr};
+            const U32 x{static_cast<U32>(l[0])}, y{static_cast<U32>(l[1])}, z{static_cast<U32>(l[2])};
+            if (!b || !b->HasSolid()) box = kSize[0];
+            else if (!b->RegionOccupied(x, y, z)) box = kRegion;
+            else if (b->BrickOccupied(x, y, z) && b->Get(VoxelIndex(x, y, z)) != Voxel::Air) {
+                hit.hit = true;
+                hit.gx = g[0]; hit.gy = g[1]; hit.gz = g[2];
+                hit.pgx = p[0]; hit.pgy = p[1]; hit.pgz = p[2];
+                hit.t = std::min({tMax[0], tMax[1], tMax[2]});
+                if (tMax[0] <= tMax[1] && tMax[0] <= tMax[2]) hit.normal = Math::Vec3{static_cast<F32>(-step[0]),0.0f,0.0f};
+                else if (tMax[1] <= tMax[2]) hit.normal = Math::Vec3{0.0f,static_cast<F32>(-step[1]),0.0f};
+                else hit.normal = Math::Vec3{0.0f,0.0f,static_cast<F32>(-step[2])};
+                return hit;
             }
-        } else {
-            if (tMaxY < tMaxZ) {
-                px=gx; py=gy; pz=gz; gy += stepy; hit.t = tMaxY; tMaxY += tDeltaY;
+
+            if (box == 0) {
+                const U32 a{advance()};
+                l[a] += step[a];
+                if (l[a] < 0 || l[a] >= kSize[a]) {
+                    l[a] -= step[a] * kSize[a];
+                    c[a] += step[a];
+                    chunk = source.Find(c[0], c[1], c[2]);
+                }
             } else {
-                px=gx; py=gy; pz=gz; gz += stepz; hit.t = tMaxZ; tMaxZ += tDeltaZ;
+                // Step without lookups until the walk leaves the box; only the axis just stepped
+                // can have left it.
+                S32 lo[3]{};
+                for (U32 a{}; a < 3; ++a) lo[a] = c[a] * kSize[a] + (l[a] & ~(box - 1));
+                U32 a{};
+                do {
+                    a = advance();
+                } while (g[a] >= lo[a] && g[a] < lo[a] + box && hit.t <= maxDist);
+                locate(false);
             }
-        }
 
-        if (hit.t > maxDist) return VoxelRayHit{};
+            if (hit.t > maxDist) return VoxelRayHit{};
+        }
     }
 }
+
+export VoxelRayHit RaycastVoxelDDA(World const* world, Math::Vec3 origin, Math::Vec3 dir, F32 maxDist) {
+    return detail::Trace(detail::MakeChunkSource(world), detail::BlockSize(world), origin, dir, maxDist);
+}
+
+// Casts every ray, spreading them over the task workers when called from a task; hits[i]
+// receives the result of rays[i], the same as RaycastVoxelDDA would return. The caller must
+// declare read access to VoxelWorldConfig, VoxelChunk and VoxelChunkIndex and keep them unchanged
+// until it returns.
+export void RaycastVoxelBatch(World const* world, std::span<const VoxelRay> rays, std::span<VoxelRayHit> hits) {
+    assert(hits.size() >= rays.size(), "Hit buffer is smaller than the ray batch");
+    constexpr U32 kRaysPerTask{64};
+    const detail::ChunkSource source{detail::MakeChunkSource(world)};
+    const F32 bs{detail::BlockSize(world)};
+    ParallelFor(static_cast<U32>(rays.size()), kRaysPerTask, [&](U32 begin, U32 end) {
+        for (U32 i{begin}; i < end; ++i) {
+            hits[i] = detail::Trace(source, bs, rays[i].origin, rays[i].dir, rays[i].maxDist);
+        }
+    });
+}
@@ -5,8 +5,8 @@ import ECS.Component;
 import Components.ComponentRegistry;
 
 export struct VoxelStreamingConfig {
-    U32 radius{8};
-    U32 margin{2};
+    U32 radius{8};   // chunks are loaded within this radius of the camera chunk
+    U32 margin{2};   // and unloaded beyond radius + margin, so they do not thrash at the edge
     S32 minChunkY{-1};
     S32 maxChunkY{1};
     U32 createBudget{16};
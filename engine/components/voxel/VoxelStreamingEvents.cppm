@@ -0,0 +1,39 @@
+export module Components.VoxelStreamingEvents;
+
+import Core.Types;
+import ECS.Component;
+import ECS.World;
+import ECS.EventChannel;
+import Components.ComponentRegistry;
+import std;
+
+// Published during command playback: ChunkLoaded once the chunk entity exists (its blocks are
+// generated later), ChunkUnloaded while the entity and its components are still alive.
+export struct ChunkLoaded {
+    EntityHandle entity{};
+    S32 cx{}, cy{}, cz{};
+};
+
+export struct ChunkUnloaded {
+    EntityHandle entity{};
+    S32 cx{}, cy{}, cz{};
+};
+
+// World resource owned by VoxelStreamingSystem, which clears both channels at the start of
+// its run: polled events stay readable until the next frame's PreUpdate.
+export struct VoxelStreamingEvents {
+    EventChannel<ChunkLoaded> loaded{};
+    EventChannel<ChunkUnloaded> unloaded{};
+};
+
+export template<>
+struct ComponentTypeID<VoxelStreamingEvents> {
+    static consteval ComponentID value() { return VoxelStreamingEvents_ID; }
+};
+
+export inline VoxelStreamingEvents* FindVoxelStreamingEvents(World* world) {
+    auto* store{world->GetStorage<VoxelStreamingEvents>()};
+    if (!store) return nullptr;
+    for (auto [h,c] : *store) return &c;
+    return nullptr;
+}
@@ -0,0 +1,158 @@
+export module Core.FrameArena;
+
+import Core.Types;
+import std;
+
+// Bump allocator for memory that dies all at once. Deallocation is a no-op; Reset() recycles
+// everything. Blocks are kept across resets, and a reset after a frame that spilled into
+// several blocks replaces them with one block of the combined size, so after warm-up a
+// frame allocates nothing from the heap.
+export class LinearArena final : public std::pmr::memory_resource {
+public:
+    explicit LinearArena(USize blockSize = 64 * 1024) : m_BlockSize{blockSize} {}
+
+    LinearArena(LinearArena const&) = delete;
+    LinearArena& operator=(LinearArena const&) = delete;
+
+    void Reset() {
+        if (m_Current > 0) {
+            USize total{0};
+            for (auto const& block : m_Blocks) total += block.size;
+            m_Blocks.clear();
+            m_Blocks.push_back(Block{std::make_unique<std::byte[]>(total), total});
+        }
+        m_Current = 0;
+        m_Offset = 0;
+        m_Allocated = 0;
+    }
+
+    // Bytes handed out since the last reset, including alignment padding.
+    [[nodiscard]] USize Allocated() const { return m_Allocated; }
+    // Largest Allocated() seen between two resets.
+    [[nodiscard]] USize HighWater() const { return m_HighWater; }
+    [[nodiscard]] USize Capacity() const {
+        USize total{0};
+        for (auto const& block : m_Blocks) total += block.size;
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        USize size;
+    };
+
+    void* do_allocate(USize bytes, USize alignment) override {
+        for (;;) {
+            if (m_Current < m_Blocks.size()) {
+                Block& block{m_Blocks[m_Current]};
+                const auto base{reinterpret_cast<std::uintptr_t>(block.data.get())};
+                const USize aligned{((base + m_Offset + alignment - 1) & ~(alignment - 1)) - base};
+                if (aligned + bytes <= block.size) {
+                    m_Allocated += aligned + bytes - m_Offset;
+                    m_HighWater = std::max(m_HighWater, m_Allocated);
+                    m_Offset = aligned + bytes;
+                    return block.data.get() + aligned;
+                }
+                // Skip the rest of this block.
+                m_Allocated += block.size - m_Offset;
+                ++m_Current;
+                m_Offset = 0;
+                continue;
+            }
+
+            const USize last{m_Blocks.empty() ? m_BlockSize : m_Blocks.back().size * 2};
+            const USize size{std::max(last, bytes + alignment)};
+            m_Blocks.push_back(Block{std::make_unique<std::byte[]>(size), size});
+        }
+    }
+
+    void do_deallocate(void*, USize, USize) override {}
+
+    [[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+        return this == &other;
+    }
+
+    Vector<Block> m_Blocks{};
+    USize m_BlockSize;
+    USize m_Current{0};
+    USize m_Offset{0};
+    USize m_Allocated{0};
+    USize m_HighWater{0};
+};
+
+export struct FrameArenaStats {
+    USize allocated{};  // bytes used by the last frame, all threads
+    USize highWater{};  // largest frame so far
+    USize capacity{};   // bytes reserved by all arenas
+    U32 threads{};
+};
+
+// One LinearArena per thread for containers that live no longer than the current frame.
+// EndFrame resets every thread's arena, so it must run while no frame work is in flight,
+// and nothing allocated from Resource() may be kept past the frame.
+export class FrameArena {
+public:
+    [[nodiscard]] static LinearArena& Local() {
+        // Hands the arena back when the thread exits so a later thread can reuse it.
+        struct Owner {
+            Slot* slot{nullptr};
+            ~Owner() {
+                if (slot) slot->owned.store(false, std::memory_order_release);
+            }
+        };
+        thread_local Owner t_Owner{};
+
+        if (!t_Owner.slot) [[unlikely]] {
+            std::lock_guard lock{s_Mutex};
+            for (auto& slot : s_Slots) {
+                if (!slot->owned.load(std::memory_order_acquire)) {
+                    slot->owned.store(true, std::memory_order_relaxed);
+                    t_Owner.slot = slot.get();
+                    break;
+                }
+            }
+            if (!t_Owner.slot) {
+                s_Slots.push_back(std::make_unique<Slot>());
+                t_Owner.slot = s_Slots.back().get();
+            }
+        }
+        return t_Owner.slot->arena;
+    }
+
+    [[nodiscard]] static std::pmr::memory_resource* Resource() { return &Local(); }
+
+    static FrameArenaStats EndFrame() {
+        std::lock_guard lock{s_Mutex};
+        FrameArenaStats stats{};
+        for (auto& slot : s_Slots) {
+            stats.allocated += slot->arena.Allocated();
+            slot->arena.Reset();
+            stats.capacity += slot->arena.Capacity();
+        }
+        s_HighWater = std::max(s_HighWater, stats.allocated);
+        stats.highWater = s_HighWater;
+        stats.threads = static_cast<U32>(s_Slots.size());
+        s_LastFrame = stats;
+        return stats;
+    }
+
+    [[nodiscard]] static FrameArenaStats GetStats() {
+        std::lock_guard lock{s_Mutex};
+        return s_LastFrame;
+    }
+
+private:
+    struct Slot {
+        LinearArena arena{};
+        std::atomic<bool> owned{true};
+    };
+
+    static inline std::mutex s_Mutex{};
+    static inline Vector<UniquePtr<Slot>> s_Slots{};
+    static inline USize s_HighWater{0};
+    static inline FrameArenaStats s_LastFrame{};
+};
+
+export template<typename T>
+using FrameVector = std::pmr::vector<T>;
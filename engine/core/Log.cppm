@@ -60,54 +60,479 @@ struct CategoryEnabled<GeneralTag> : std::false_type {};
 template<typename T>
 concept IsLogCategory = std::is_base_of_v<LogCategory, std::remove_cvref_t<T>>;
 
-export template<typename Config = LogConfig<>>
-class LoggerBase {
-private:
-    static inline std::mutex s_Mutex;
-    static inline std::ofstream s_FileOutput;
-    static inline bool s_ColorEnabled = true;
+template<typename Category>
+constexpr bool IsCategoryEnabled() {
+    if constexpr (requires { typename Category::tag_type; }) {
+        return CategoryEnabled<typename Category::tag_type>::value;
+    } else {
+        return true;
+    }
+}
 
-    template<LogLevel Level, typename Category, typename... Args>
-    static void LogImpl(const Category& category, std::string_view format, Args &&... args) {
-        if constexpr (Level < Config::min_level) {
+// What a full thread ring does with a new message: drop it (counted, and reported in the
+// output) or make the logging thread wait for the writer thread.
+export enum class LogOverflow : U8 {
+    Drop,
+    Block,
+};
+
+export struct LogStats {
+    U64 written{};
+    U64 dropped{};
+};
+
+// Asynchronous backend shared by every LoggerBase. Each logging thread owns a lock-free
+// single-producer ring; a message is stored there as a record holding the format string and
+// a copy of its arguments, plus a decode function instantiated for the argument types. A
+// writer thread drains the rings, formats the records, orders them by a steady-clock stamp
+// (so a wall-clock step cannot reorder one thread's messages) and writes
+// them in batches. Strings are copied by value and other arguments are copy-constructed
+// into the record, so nothing refers back to the caller's stack.
+export class LogBackend {
+public:
+    static constexpr USize RingBytes{64 * 1024};
+
+    [[nodiscard]] static LogBackend& Get() {
+        // Never destroyed, so threads logging during static destruction find a valid backend;
+        // the guard below stops the writer thread and drains what is left.
+        static LogBackend* s_Backend = new LogBackend();
+        static ShutdownGuard s_Guard{};
+        return *s_Backend;
+    }
+
+    template<typename... Args>
+    void Submit(LogLevel level, const char* category, std::string_view format, Args&&... args) {
+        const Timestamp time = Now();
+        if (!m_Running.load(std::memory_order_acquire)) {
+            WriteNow(level, category, time, FormatMessage(format, args...));
             return;
         }
 
-        if constexpr (requires { typename Category::tag_type; }) {
-            if constexpr (!CategoryEnabled<typename Category::tag_type>::value) {
+        const USize size = RecordSize(format, args...);
+        Ring& ring = LocalRing();
+        if (size > RingBytes / 4) {
+            // Rare oversized messages are formatted here and handed over under a lock.
+            std::lock_guard lock{m_LargeMutex};
+            m_Large.push_back(LargeMessage{time, level, category, FormatMessage(format, args...)});
+            return;
+        }
+
+        std::byte* record;
+        while (!(record = ring.Reserve(size))) {
+            if (m_Overflow.load(std::memory_order_relaxed) == LogOverflow::Drop ||
+                std::this_thread::get_id() == m_WriterId) {
+                m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            Wake();
+            std::this_thread::yield();
+            if (!m_Running.load(std::memory_order_acquire)) {
+                WriteNow(level, category, time, FormatMessage(format, args...));
                 return;
             }
         }
 
-        auto now = std::chrono::system_clock::now();
-        std::string message = std::vformat(format, std::make_format_args<std::format_context>(args...));
+        auto* header = new (record) RecordHeader{
+            {&Decode<std::remove_cvref_t<Args>...>, static_cast<U32>(size)},
+            static_cast<U32>(format.size()), time, category, level};
+        std::memcpy(record + sizeof(RecordHeader), format.data(), format.size());
+        USize offset = sizeof(RecordHeader) + header->formatSize;
+        (WriteArg(record, offset, args), ...);
+        ring.Commit();
+
+        if (level >= LogLevel::Error || ring.Used() > RingBytes / 2) Wake();
+    }
+
+    // Blocks until every message submitted before the call has been written.
+    void Flush() {
+        if (m_Running.load(std::memory_order_acquire)) {
+            std::unique_lock lock{m_WakeMutex};
+            const U64 target = ++m_FlushRequested;
+            m_WakeCv.notify_one();
+            m_FlushedCv.wait(lock, [&]() { return m_Flushed >= target || !m_Running.load(); });
+        }
+        std::lock_guard lock{m_OutputMutex};
+        std::cout.flush();
+        if (m_File.is_open()) m_File.flush();
+    }
+
+    // Stops the writer thread after draining the rings; later messages are written
+    // synchronously by the thread that logs them.
+    void Shutdown() {
+        {
+            std::lock_guard lock{m_WakeMutex};
+            if (!m_Running.exchange(false)) return;
+        }
+        m_WakeCv.notify_one();
+        m_Writer.join();
+        Drain();
+        std::lock_guard lock{m_WakeMutex};
+        m_FlushedCv.notify_all();
+    }
+
+    void SetFile(const std::filesystem::path& path) {
+        std::lock_guard lock{m_OutputMutex};
+        if (m_File.is_open()) m_File.close();
+        if (!path.empty()) m_File.open(path);
+    }
+
+    void EnableColor(bool enable) { m_Color.store(enable, std::memory_order_relaxed); }
+    void EnableConsole(bool enable) { m_Console.store(enable, std::memory_order_relaxed); }
+    void SetOverflow(LogOverflow policy) { m_Overflow.store(policy, std::memory_order_relaxed); }
+
+    [[nodiscard]] LogStats GetStats() const {
+        return LogStats{m_Written.load(std::memory_order_relaxed), m_Dropped.load(std::memory_order_relaxed)};
+    }
+
+private:
+    using DecodeFunc = void (*)(std::byte* record, USize offset, std::string_view format, std::string& out);
+
+    // A null decode marks the padding that skips the end of the ring.
+    struct RecordPrefix {
+        DecodeFunc decode;
+        U32 size;
+    };
+
+    // steady orders messages across threads; wall is only displayed.
+    struct Timestamp {
+        S64 steady;
+        S64 wall;
+    };
+
+    struct RecordHeader {
+        RecordPrefix prefix;
+        U32 formatSize;
+        Timestamp time;
+        const char* category;
+        LogLevel level;
+    };
+
+    // Single-producer single-consumer byte ring; records are 16-byte aligned and never wrap.
+    class Ring {
+    public:
+        Ring() : m_Blocks{std::make_unique<Block[]>(RingBytes / sizeof(Block))} {}
+
+        // Returns space for size bytes, or null when the ring is full.
+        std::byte* Reserve(USize size) {
+            const U64 tail = m_Tail.load(std::memory_order_relaxed);
+            const USize offset = tail % RingBytes;
+            const USize pad = offset + size > RingBytes ? RingBytes - offset : 0;
+            if (tail + pad + size - m_Head.load(std::memory_order_acquire) > RingBytes) return nullptr;
+            if (pad > 0) new (Data() + offset) RecordPrefix{nullptr, static_cast<U32>(pad)};
+            m_Pending = tail + pad + size;
+            return Data() + (tail + pad) % RingBytes;
+        }
+
+        void Commit() { m_Tail.store(m_Pending, std::memory_order_release); }
+
+        [[nodiscard]] USize Used() const {
+            return static_cast<USize>(m_Tail.load(std::memory_order_relaxed) - m_Head.load(std::memory_order_relaxed));
+        }
+
+        // Consumer side: calls func(record) for each committed record, then frees them.
+        template<typename Func>
+        void Consume(Func&& func) {
+            U64 head = m_Head.load(std::memory_order_relaxed);
+            const U64 tail = m_Tail.load(std::memory_order_acquire);
+            while (head < tail) {
+                std::byte* record = Data() + head % RingBytes;
+                const auto* prefix = reinterpret_cast<RecordPrefix*>(record);
+                if (prefix->decode) func(record);
+                head += prefix->size;
+            }
+            m_Head.store(head, std::memory_order_release);
+        }
+
+    private:
+        struct alignas(16) Block {
+            std::byte bytes[16];
+        };
+
+        std::byte* Data() { return reinterpret_cast<std::byte*>(m_Blocks.get()); }
+
+        UniquePtr<Block[]> m_Blocks;
+        alignas(64) std::atomic<U64> m_Head{0};
+        alignas(64) std::atomic<U64> m_Tail{0};
+        U64 m_Pending{0};
+    };
+
+    struct Slot {
+        Ring ring{};
+        std::atomic<bool> owned{true};
+    };
+
+    struct Line {
+        Timestamp time;
+        LogLevel level;
+        const char* category;
+        USize begin;
+        USize end;
+    };
+
+    struct LargeMessage {
+        Timestamp time;
+        LogLevel level;
+        const char* category;
+        std::string message;
+    };
+
+    struct ShutdownGuard {
+        ~ShutdownGuard() { Get().Shutdown(); }
+    };
+
+    template<typename T>
+    static constexpr bool IsStringLike = std::is_convertible_v<T const&, std::string_view>;
+
+    static constexpr USize AlignUp(USize value, USize alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
 
-        std::lock_guard lock{s_Mutex};
+    LogBackend() {
+        m_Writer = std::thread([this]() { Run(); });
+        m_WriterId = m_Writer.get_id();
+    }
 
-        if (s_FileOutput.is_open()) {
-            s_FileOutput << std::format("[{:%H:%M:%S}] [{}] [{}] {}\n",
-                std::chrono::floor<std::chrono::seconds>(now),
-                LevelToString(Level),
-                category.name,
-                message);
+    static Timestamp Now() {
+        using std::chrono::duration_cast, std::chrono::nanoseconds;
+        return Timestamp{
+            duration_cast<nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(),
+            duration_cast<nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count()};
+    }
+
+    Ring& LocalRing() {
+        // Hands the ring back when the thread exits so a later thread can reuse it.
+        struct Owner {
+            Slot* slot{nullptr};
+            ~Owner() {
+                if (slot) slot->owned.store(false, std::memory_order_release);
+            }
+        };
+        thread_local Owner t_Owner{};
+
+        if (!t_Owner.slot) [[unlikely]] {
+            std::lock_guard lock{m_SlotMutex};
+            for (auto& slot : m_Slots) {
+                if (!slot->owned.load(std::memory_order_acquire)) {
+                    slot->owned.store(true, std::memory_order_relaxed);
+                    t_Owner.slot = slot.get();
+                    break;
+                }
+            }
+            if (!t_Owner.slot) {
+                m_Slots.push_back(std::make_unique<Slot>());
+                t_Owner.slot = m_Slots.back().get();
+            }
+        }
+        return t_Owner.slot->ring;
+    }
+
+    template<typename T>
+    static USize ArgEnd(USize offset, T const& arg) {
+        if constexpr (IsStringLike<T>) {
+            return AlignUp(offset, alignof(U32)) + sizeof(U32) + std::string_view{arg}.size();
+        } else {
+            using Stored = std::decay_t<T>;
+            static_assert(alignof(Stored) <= 16, "Log argument is over-aligned");
+            return AlignUp(offset, alignof(Stored)) + sizeof(Stored);
         }
+    }
 
-        if (s_ColorEnabled) {
-            std::cout << std::format("{}[{:%H:%M:%S}] [{}] [{}] {}\033[0m\n",
-                GetLevelColor(Level),
-                std::chrono::floor<std::chrono::seconds>(now),
-                LevelToString(Level),
-                category.name,
-                message);
+    template<typename... Args>
+    static USize RecordSize(std::string_view format, Args const&... args) {
+        USize offset = sizeof(RecordHeader) + format.size();
+        ((offset = ArgEnd(offset, args)), ...);
+        return AlignUp(offset, 16);
+    }
+
+    template<typename T>
+    static void WriteArg(std::byte* record, USize& offset, T const& arg) {
+        if constexpr (IsStringLike<T>) {
+            const std::string_view text{arg};
+            const U32 size = static_cast<U32>(text.size());
+            offset = AlignUp(offset, alignof(U32));
+            std::memcpy(record + offset, &size, sizeof(U32));
+            std::memcpy(record + offset + sizeof(U32), text.data(), text.size());
+            offset += sizeof(U32) + text.size();
         } else {
-            std::cout << std::format("[{:%H:%M:%S}] [{}] [{}] {}\n",
-                std::chrono::floor<std::chrono::seconds>(now),
-                LevelToString(Level),
-                category.name,
-                message);
+            using Stored = std::decay_t<T>;
+            offset = AlignUp(offset, alignof(Stored));
+            new (record + offset) Stored(arg);
+            offset += sizeof(Stored);
         }
     }
 
+    template<typename T>
+    using Decoded = std::conditional_t<IsStringLike<T>, std::string_view, std::decay_t<T>&>;
+
+    template<typename T>
+    static Decoded<T> ReadArg(std::byte* record, USize& offset) {
+        if constexpr (IsStringLike<T>) {
+            U32 size;
+            offset = AlignUp(offset, alignof(U32));
+            std::memcpy(&size, record + offset, sizeof(U32));
+            const std::string_view text{reinterpret_cast<const char*>(record + offset + sizeof(U32)), size};
+            offset += sizeof(U32) + size;
+            return text;
+        } else {
+            using Stored = std::decay_t<T>;
+            offset = AlignUp(offset, alignof(Stored));
+            auto* value = std::launder(reinterpret_cast<Stored*>(record + offset));
+            offset += sizeof(Stored);
+            return *value;
+        }
+    }
+
+    template<typename... Args>
+    static void Decode(std::byte* record, USize offset, std::string_view format, std::string& out) {
+        // Braced initialization reads the arguments in order.
+        std::tuple<Decoded<Args>...> args{ReadArg<Args>(record, offset)...};
+        const USize begin = out.size();
+        try {
+            std::apply([&](auto&... a) {
+                std::vformat_to(std::back_inserter(out), format, std::make_format_args(a...));
+            }, args);
+        } catch (const std::format_error& e) {
+            out.resize(begin);
+            std::format_to(std::back_inserter(out), "<bad log format '{}': {}>", format, e.what());
+        }
+        std::apply([](auto&... a) { (DestroyArg(a), ...); }, args);
+    }
+
+    template<typename T>
+    static void DestroyArg(T& arg) {
+        if constexpr (!std::is_trivially_destructible_v<T>) std::destroy_at(&arg);
+    }
+
+    template<typename... Args>
+    static std::string FormatMessage(std::string_view format, Args&... args) {
+        try {
+            return std::vformat(format, std::make_format_args(args...));
+        } catch (const std::format_error& e) {
+            return std::format("<bad log format '{}': {}>", format, e.what());
+        }
+    }
+
+    void Wake() {
+        m_WakeRequested.store(true, std::memory_order_relaxed);
+        m_WakeCv.notify_one();
+    }
+
+    void Run() {
+        std::unique_lock lock{m_WakeMutex};
+        for (;;) {
+            const U64 requested = m_FlushRequested;
+            const bool running = m_Running.load();
+            lock.unlock();
+            Drain();
+            lock.lock();
+            m_Flushed = requested;
+            m_FlushedCv.notify_all();
+            if (!running) return;
+            // Producers only wake the writer for errors and filling rings; the timeout
+            // bounds the latency of everything else.
+            m_WakeCv.wait_for(lock, std::chrono::milliseconds(5), [&]() {
+                return m_WakeRequested.load(std::memory_order_relaxed) ||
+                       m_FlushRequested != m_Flushed || !m_Running.load();
+            });
+            m_WakeRequested.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    // Writer thread, or the thread calling Shutdown once the writer has exited.
+    void Drain() {
+        m_Lines.clear();
+        m_Text.clear();
+        // Slots are never freed, so the rings can be decoded after the lock is released; a
+        // thread logging for the first time then only waits for this copy, not the formatting.
+        m_DrainSlots.clear();
+        {
+            std::lock_guard lock{m_SlotMutex};
+            for (auto& slot : m_Slots) m_DrainSlots.push_back(slot.get());
+        }
+        for (Slot* slot : m_DrainSlots) {
+            slot->ring.Consume([&](std::byte* record) {
+                const auto* header = reinterpret_cast<RecordHeader*>(record);
+                const std::string_view format{
+                    reinterpret_cast<const char*>(record + sizeof(RecordHeader)), header->formatSize};
+                const USize begin = m_Text.size();
+                header->prefix.decode(record, sizeof(RecordHeader) + header->formatSize, format, m_Text);
+                m_Lines.push_back(Line{header->time, header->level, header->category, begin, m_Text.size()});
+            });
+        }
+        {
+            std::lock_guard lock{m_LargeMutex};
+            for (LargeMessage& message : m_Large) {
+                const USize begin = m_Text.size();
+                m_Text += message.message;
+                m_Lines.push_back(Line{message.time, message.level, message.category, begin, m_Text.size()});
+            }
+            m_Large.clear();
+        }
+        U64 notices = 0;
+        if (const U64 dropped = m_Dropped.load(std::memory_order_relaxed); dropped != m_DroppedReported) {
+            const USize begin = m_Text.size();
+            std::format_to(std::back_inserter(m_Text), "{} log messages dropped (ring full)", dropped - m_DroppedReported);
+            m_Lines.push_back(Line{Now(), LogLevel::Warning, "Log", begin, m_Text.size()});
+            m_DroppedReported = dropped;
+            ++notices;
+        }
+        if (m_Lines.empty()) return;
+
+        // Each ring is already in order; merge the threads by timestamp.
+        std::stable_sort(m_Lines.begin(), m_Lines.end(), [](Line const& a, Line const& b) {
+            return a.time.steady < b.time.steady;
+        });
+
+        std::lock_guard lock{m_OutputMutex};
+        const bool console = m_Console.load(std::memory_order_relaxed);
+        const bool color = m_Color.load(std::memory_order_relaxed);
+        m_ConsoleBatch.clear();
+        m_FileBatch.clear();
+        for (Line const& line : m_Lines) {
+            const std::string_view message{m_Text.data() + line.begin, line.end - line.begin};
+            if (console) AppendLine(m_ConsoleBatch, line.time.wall, line.level, line.category, message, color);
+            if (m_File.is_open()) AppendLine(m_FileBatch, line.time.wall, line.level, line.category, message, false);
+        }
+        WriteBatches();
+        m_Written.fetch_add(m_Lines.size() - notices, std::memory_order_relaxed);
+    }
+
+    void WriteNow(LogLevel level, const char* category, Timestamp time, std::string_view message) {
+        std::lock_guard lock{m_OutputMutex};
+        m_ConsoleBatch.clear();
+        m_FileBatch.clear();
+        if (m_Console.load(std::memory_order_relaxed)) {
+            AppendLine(m_ConsoleBatch, time.wall, level, category, message, m_Color.load(std::memory_order_relaxed));
+        }
+        if (m_File.is_open()) AppendLine(m_FileBatch, time.wall, level, category, message, false);
+        WriteBatches();
+        m_Written.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void WriteBatches() {
+        if (!m_ConsoleBatch.empty()) {
+            std::cout.write(m_ConsoleBatch.data(), static_cast<std::streamsize>(m_ConsoleBatch.size()));
+            std::cout.flush();
+        }
+        if (!m_FileBatch.empty()) {
+            m_File.write(m_FileBatch.data(), static_cast<std::streamsize>(m_FileBatch.size()));
+            m_File.flush();
+        }
+    }
+
+    static void AppendLine(std::string& out, S64 time, LogLevel level, const char* category,
+                           std::string_view message, bool color) {
+        const std::chrono::system_clock::time_point point{
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{time})};
+        std::format_to(std::back_inserter(out), "{}[{:%H:%M:%S}] [{}] [{}] {}{}\n",
+            color ? GetLevelColor(level) : "",
+            std::chrono::floor<std::chrono::seconds>(point),
+            LevelToString(level),
+            category,
+            message,
+            color ? "\033[0m" : "");
+    }
+
     static constexpr const char *GetLevelColor(LogLevel level) {
         switch (level) {
             case LogLevel::Trace: return "\033[90m";
@@ -132,14 +557,86 @@ private:
         return "??????";
     }
 
+    std::mutex m_SlotMutex;
+    Vector<UniquePtr<Slot>> m_Slots;
+
+    std::mutex m_LargeMutex;
+    Vector<LargeMessage> m_Large;
+
+    std::mutex m_WakeMutex;
+    std::condition_variable m_WakeCv;
+    std::condition_variable m_FlushedCv;
+    std::atomic<bool> m_WakeRequested{false};
+    U64 m_FlushRequested{0};
+    U64 m_Flushed{0};
+
+    std::atomic<bool> m_Running{true};
+    std::atomic<bool> m_Color{true};
+    std::atomic<bool> m_Console{true};
+    std::atomic<LogOverflow> m_Overflow{LogOverflow::Block};
+    std::atomic<U64> m_Written{0};
+    std::atomic<U64> m_Dropped{0};
+    U64 m_DroppedReported{0};
+
+    // Writer side.
+    Vector<Slot*> m_DrainSlots;
+    Vector<Line> m_Lines;
+    std::string m_Text;
+    std::mutex m_OutputMutex;
+    std::string m_ConsoleBatch;
+    std::string m_FileBatch;
+    std::ofstream m_File;
+
+    std::thread m_Writer;
+    std::thread::id m_WriterId;
+};
+
+export template<typename Config = LogConfig<>>
+class LoggerBase {
+public:
+    // False for levels below Config::min_level and for categories disabled through
+    // CategoryEnabled; such calls compile to nothing. Arguments are still evaluated, so
+    // expensive ones can be guarded with if constexpr on this.
+    template<LogLevel Level, typename Category = std::remove_cvref_t<decltype(LogGeneral)>>
+    static constexpr bool IsEnabled = Level >= Config::min_level && IsCategoryEnabled<std::remove_cvref_t<Category>>();
+
+private:
+    template<LogLevel Level, typename Category, typename... Args>
+    static void LogImpl(const Category& category, std::string_view format, Args &&... args) {
+        if constexpr (IsEnabled<Level, Category>) {
+            LogBackend::Get().Submit(Level, category.name, format, std::forward<Args>(args)...);
+            // The process may be about to go down; do not leave the message in a ring.
+            if constexpr (Level == LogLevel::Critical) LogBackend::Get().Flush();
+        }
+    }
+
 public:
     static void SetFile(const std::filesystem::path &path) {
-        std::lock_guard lock{s_Mutex};
-        s_FileOutput.open(path);
+        LogBackend::Get().SetFile(path);
     }
 
     static void EnableColor(bool enable) {
-        s_ColorEnabled = enable;
+        LogBackend::Get().EnableColor(enable);
+    }
+
+    static void EnableConsole(bool enable) {
+        LogBackend::Get().EnableConsole(enable);
+    }
+
+    static void SetOverflow(LogOverflow policy) {
+        LogBackend::Get().SetOverflow(policy);
+    }
+
+    static void Flush() {
+        LogBackend::Get().Flush();
+    }
+
+    static void Shutdown() {
+        LogBackend::Get().Shutdown();
+    }
+
+    [[nodiscard]] static LogStats GetStats() {
+        return LogBackend::Get().GetStats();
     }
 
     template<typename Category = decltype(LogGeneral), typename... Args>
@@ -0,0 +1,127 @@
+export module Core.VectorPool;
+
+import Core.Types;
+import std;
+
+export struct VectorPoolStats {
+    U64 hits{};        // Acquire served from a retained vector
+    U64 misses{};      // Acquire that had to allocate
+    U64 discarded{};   // Release that freed the vector (over budget or outside the size classes)
+    U64 trimmed{};     // vectors freed by Trim
+    USize retainedBytes{};
+    USize retainedBuffers{};
+};
+
+// Thread-safe free lists of cleared vectors, bucketed by capacity: class k holds capacities
+// in [2^k, 2^(k+1)). Acquire(n) only looks at the class of the next power of two >= n, so a
+// recycled vector never has more than 4x the capacity asked for. Release keeps a vector while
+// the retained bytes stay under the budget; Trim frees the largest vectors first.
+export template<typename T>
+class VectorPool {
+public:
+    explicit VectorPool(USize budgetBytes, U32 minShift = 6, U32 maxShift = 22)
+        : m_Budget{budgetBytes}, m_MinShift{minShift}, m_MaxShift{std::max(minShift, maxShift)} {
+        m_Classes.resize(m_MaxShift - m_MinShift + 1);
+    }
+
+    VectorPool(VectorPool const&) = delete;
+    VectorPool& operator=(VectorPool const&) = delete;
+
+    // Returns an empty vector with capacity >= minCapacity.
+    [[nodiscard]] Vector<T> Acquire(USize minCapacity) {
+        const U32 shift{CeilShift(std::max<USize>(minCapacity, 1))};
+        const bool pooled{shift >= m_MinShift && shift <= m_MaxShift};
+        {
+            std::lock_guard lock{m_Mutex};
+            ++m_Acquires;
+            if (pooled) {
+                if (auto& list{m_Classes[shift - m_MinShift]}; !list.empty()) {
+                    Vector<T> v{std::move(list.back())};
+                    list.pop_back();
+                    m_Stats.retainedBytes -= v.capacity() * sizeof(T);
+                    --m_Stats.retainedBuffers;
+                    ++m_Stats.hits;
+                    return v;
+                }
+            }
+            ++m_Stats.misses;
+        }
+        // Rounded up so the vector lands in the class it is asked from once released.
+        Vector<T> v{};
+        v.reserve(pooled ? USize{1} << shift : minCapacity);
+        return v;
+    }
+
+    void Release(Vector<T>&& v) {
+        Vector<T> local{std::move(v)};
+        const USize capacity{local.capacity()};
+        if (capacity == 0) return;
+
+        const U32 shift{FloorShift(capacity)};
+        const USize bytes{capacity * sizeof(T)};
+        std::lock_guard lock{m_Mutex};
+        if (shift < m_MinShift || shift > m_MaxShift || m_Stats.retainedBytes + bytes > m_Budget) {
+            ++m_Stats.discarded;
+            return;
+        }
+        local.clear();
+        m_Classes[shift - m_MinShift].push_back(std::move(local));
+        m_Stats.retainedBytes += bytes;
+        ++m_Stats.retainedBuffers;
+    }
+
+    // Frees retained vectors, largest first, until at most maxBytes are retained.
+    void Trim(USize maxBytes) {
+        Vector<Vector<T>> freed{};
+        {
+            std::lock_guard lock{m_Mutex};
+            for (USize k{m_Classes.size()}; k-- > 0 && m_Stats.retainedBytes > maxBytes;) {
+                auto& list{m_Classes[k]};
+                while (!list.empty() && m_Stats.retainedBytes > maxBytes) {
+                    m_Stats.retainedBytes -= list.back().capacity() * sizeof(T);
+                    --m_Stats.retainedBuffers;
+                    ++m_Stats.trimmed;
+                    freed.push_back(std::move(list.back()));
+                    list.pop_back();
+                }
+            }
+        }
+        // freed goes out of scope outside the lock.
+    }
+
+    void SetBudget(USize budgetBytes) {
+        {
+            std::lock_guard lock{m_Mutex};
+            m_Budget = budgetBytes;
+        }
+        Trim(budgetBytes);
+    }
+
+    [[nodiscard]] USize Budget() const {
+        std::lock_guard lock{m_Mutex};
+        return m_Budget;
+    }
+
+    [[nodiscard]] VectorPoolStats GetStats() const {
+        std::lock_guard lock{m_Mutex};
+        return m_Stats;
+    }
+
+    // Number of Acquire calls so far, for idle detection.
+    [[nodiscard]] U64 Acquires() const {
+        std::lock_guard lock{m_Mutex};
+        return m_Acquires;
+    }
+
+private:
+    static U32 FloorShift(USize n) { return static_cast<U32>(std::bit_width(n)) - 1u; }
+    static U32 CeilShift(USize n) { return static_cast<U32>(std::bit_width(n - 1)); }
+
+    mutable std::mutex m_Mutex{};
+    Vector<Vector<Vector<T>>> m_Classes{};
+    USize m_Budget;
+    U32 m_MinShift;
+    U32 m_MaxShift;
+    U64 m_Acquires{0};
+    VectorPoolStats m_Stats{};
+};
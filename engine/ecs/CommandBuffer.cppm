@@ -0,0 +1,132 @@
+export module ECS.CommandBuffer;
+
+import ECS.Component;
+import ECS.World;
+import Core.Types;
+import Core.Assert;
+import std;
+
+// Records structural changes (create, add, replace, remove, destroy) so that systems can
+// run without touching World's containers, and plays them back later in recording order.
+// Entities created through the buffer get placeholder handles (generation 0) that are only
+// meaningful as targets of commands in the same buffer; playback maps them to the real
+// entities. A buffer is not thread-safe: give each thread its own and Append them.
+export class CommandBuffer {
+public:
+    using DeferredFunc = std::move_only_function<void(World&, EntityHandle)>;
+
+    [[nodiscard]] static constexpr bool IsPlaceholder(EntityHandle h) {
+        return h.valid() && h.generation() == 0;
+    }
+
+    EntityHandle CreateEntity() {
+        assert(m_Created < 0xFFFF, "Too many entities created in one CommandBuffer");
+        const EntityHandle placeholder{static_cast<U16>(++m_Created), 0};
+        m_Commands.push_back(Command{Kind::Create, placeholder, {}});
+        return placeholder;
+    }
+
+    void DestroyEntity(EntityHandle handle) {
+        if (!handle.valid()) return;
+        m_Commands.push_back(Command{Kind::Destroy, handle, {}});
+    }
+
+    template<typename T>
+    void AddComponent(EntityHandle handle, T&& component) {
+        using U = std::remove_cvref_t<T>;
+        Defer(handle, [c = U{std::forward<T>(component)}](World& world, EntityHandle e) mutable {
+            world.AddComponent(e, std::move(c));
+        });
+    }
+
+    template<typename T>
+    void AddOrReplaceComponent(EntityHandle handle, T&& component) {
+        using U = std::remove_cvref_t<T>;
+        Defer(handle, [c = U{std::forward<T>(component)}](World& world, EntityHandle e) mutable {
+            world.AddOrReplaceComponent(e, std::move(c));
+        });
+    }
+
+    template<typename T>
+    void RemoveComponent(EntityHandle handle) {
+        Defer(handle, [](World& world, EntityHandle e) {
+            world.RemoveComponent<T>(e);
+        });
+    }
+
+    // Runs func(world, entity) at playback with the placeholder resolved; skipped if the
+    // entity could not be created.
+    void Defer(EntityHandle handle, DeferredFunc func) {
+        if (!handle.valid()) return;
+        m_Commands.push_back(Command{Kind::Invoke, handle, std::move(func)});
+    }
+
+    // Runs func(world, {}) at playback, for bookkeeping that is not tied to an entity.
+    void Defer(DeferredFunc func) {
+        m_Commands.push_back(Command{Kind::Invoke, EntityHandle{}, std::move(func)});
+    }
+
+    // Moves other's commands after this buffer's, renumbering its placeholders.
+    void Append(CommandBuffer&& other) {
+        assert(m_Created + other.m_Created <= 0xFFFF, "Too many entities created in one CommandBuffer");
+        const U32 offset{m_Created};
+        m_Commands.reserve(m_Commands.size() + other.m_Commands.size());
+        for (Command& c : other.m_Commands) {
+            if (IsPlaceholder(c.target)) {
+                c.target = EntityHandle{static_cast<U16>(c.target.id() + offset), 0};
+            }
+            m_Commands.push_back(std::move(c));
+        }
+        m_Created += other.m_Created;
+        other.Clear();
+    }
+
+    void Playback(World& world) {
+        m_Resolved.assign(static_cast<USize>(m_Created) + 1, EntityHandle{});
+
+        // Commands may record into this buffer again; those land in the next playback.
+        Vector<Command> commands{std::move(m_Commands)};
+        Clear();
+
+        for (Command& c : commands) {
+            switch (c.kind) {
+                case Kind::Create:
+                    m_Resolved[c.target.id()] = world.CreateEntity();
+                    break;
+                case Kind::Destroy:
+                    if (EntityHandle e{Resolve(c.target)}; e.valid()) world.DestroyEntity(e);
+                    break;
+                case Kind::Invoke:
+                    if (!c.target.valid()) c.func(world, EntityHandle{});
+                    else if (EntityHandle e{Resolve(c.target)}; e.valid()) c.func(world, e);
+                    break;
+            }
+        }
+    }
+
+    void Clear() {
+        m_Commands.clear();
+        m_Created = 0;
+    }
+
+    [[nodiscard]] bool Empty() const { return m_Commands.empty(); }
+    [[nodiscard]] USize Size() const { return m_Commands.size(); }
+
+private:
+    enum class Kind : U8 { Create, Destroy, Invoke };
+
+    struct Command {
+        Kind kind;
+        EntityHandle target;
+        DeferredFunc func;
+    };
+
+    [[nodiscard]] EntityHandle Resolve(EntityHandle h) const {
+        if (!IsPlaceholder(h)) return h;
+        return h.id() < m_Resolved.size() ? m_Resolved[h.id()] : EntityHandle{};
+    }
+
+    Vector<Command> m_Commands{};
+    Vector<EntityHandle> m_Resolved{};
+    U32 m_Created{0};
+};
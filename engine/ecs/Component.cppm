@@ -63,79 +63,91 @@ consteval Archetype MakeArchetype() {
     return arch;
 }
 
+// Sparse set: a paged sparse array maps entity ids to dense indices, and components and
+// their entities are packed densely in that order. Dense components live in fixed pages,
+// so inserting never moves existing components; removal swaps the last one into the hole.
 export template<typename T>
 class ComponentStorage {
 private:
-    static constexpr U32 CHUNK_SIZE = 64;
+    static constexpr U32 SPARSE_PAGE_SIZE = 4096;
+    static constexpr U32 DENSE_PAGE_SIZE = 64;
+    static constexpr U32 INVALID_INDEX = ~0u;
 
-    struct Chunk {
-        alignas(64) std::array<T, CHUNK_SIZE> components{};
-        std::array<EntityHandle, CHUNK_SIZE> entities{};
-        U32 count{0};
+    using SparsePage = std::array<U32, SPARSE_PAGE_SIZE>;
+
+    struct DensePage {
+        alignas(64) std::array<T, DENSE_PAGE_SIZE> components{};
     };
 
-    Vector<UniquePtr<Chunk>> m_Chunks{};
-    UnorderedMap<U16, std::pair<U32, U32>> m_EntityToChunk{};
+    Vector<UniquePtr<SparsePage>> m_Sparse{};
+    Vector<UniquePtr<DensePage>> m_Pages{};
+    Vector<EntityHandle> m_Entities{};
+
+    [[nodiscard]] U32 DenseIndex(U16 id) const {
+        const U32 page = id / SPARSE_PAGE_SIZE;
+        if (page >= m_Sparse.size() || !m_Sparse[page]) return INVALID_INDEX;
+        return (*m_Sparse[page])[id % SPARSE_PAGE_SIZE];
+    }
+
+    U32& SparseSlot(U16 id) {
+        const U32 page = id / SPARSE_PAGE_SIZE;
+        if (page >= m_Sparse.size()) m_Sparse.resize(page + 1);
+        if (!m_Sparse[page]) {
+            m_Sparse[page] = std::make_unique<SparsePage>();
+            m_Sparse[page]->fill(INVALID_INDEX);
+        }
+        return (*m_Sparse[page])[id % SPARSE_PAGE_SIZE];
+    }
+
+    [[nodiscard]] T& At(U32 index) {
+        return m_Pages[index / DENSE_PAGE_SIZE]->components[index % DENSE_PAGE_SIZE];
+    }
+
+    [[nodiscard]] const T& At(U32 index) const {
+        return m_Pages[index / DENSE_PAGE_SIZE]->components[index % DENSE_PAGE_SIZE];
+    }
 
 public:
     void Insert(EntityHandle handle, T component) {
-        auto [it, inserted] = m_EntityToChunk.try_emplace(handle.id());
+        U32& slot = SparseSlot(handle.id());
 
-        if (!inserted) {
-
-            auto [chunkIdx, compIdx] = it->second;
-            m_Chunks[chunkIdx]->components[compIdx] = std::move(component);
-            m_Chunks[chunkIdx]->entities[compIdx] = handle;
+        if (slot != INVALID_INDEX) {
+            At(slot) = std::move(component);
+            m_Entities[slot] = handle;
             return;
         }
 
-        for (U32 i = 0; i < m_Chunks.size(); ++i) {
-            if (m_Chunks[i]->count < CHUNK_SIZE) {
-                U32 idx = m_Chunks[i]->count++;
-                m_Chunks[i]->components[idx] = std::move(component);
-                m_Chunks[i]->entities[idx] = handle;
-                it->second = {i, idx};
-                return;
-            }
+        const U32 index = static_cast<U32>(m_Entities.size());
+        if (index / DENSE_PAGE_SIZE >= m_Pages.size()) {
+            m_Pages.push_back(std::make_unique<DensePage>());
         }
-
-        auto chunk = std::make_unique<Chunk>();
-        chunk->components[0] = std::move(component);
-        chunk->entities[0] = handle;
-        chunk->count = 1;
-        it->second = {static_cast<U32>(m_Chunks.size()), 0};
-        m_Chunks.push_back(std::move(chunk));
+        At(index) = std::move(component);
+        m_Entities.push_back(handle);
+        slot = index;
     }
 
     void Remove(EntityHandle handle) {
-        auto it = m_EntityToChunk.find(handle.id());
-        if (it == m_EntityToChunk.end()) return;
-
-        auto [chunkIdx, compIdx] = it->second;
-        auto& chunk = *m_Chunks[chunkIdx];
-
-        U32 lastIdx = chunk.count - 1;
-        if (compIdx != lastIdx) {
-            chunk.components[compIdx] = std::move(chunk.components[lastIdx]);
-            chunk.entities[compIdx] = chunk.entities[lastIdx];
-
-            m_EntityToChunk[chunk.entities[compIdx].id()] = {chunkIdx, compIdx};
+        const U32 index = DenseIndex(handle.id());
+        if (index == INVALID_INDEX) return;
+
+        const U32 lastIdx = static_cast<U32>(m_Entities.size()) - 1;
+        if (index != lastIdx) {
+            At(index) = std::move(At(lastIdx));
+            m_Entities[index] = m_Entities[lastIdx];
+            SparseSlot(m_Entities[index].id()) = index;
         }
 
-        chunk.count--;
-        m_EntityToChunk.erase(it);
+        // Release whatever the vacated slot still owns.
+        At(lastIdx) = T{};
+        m_Entities.pop_back();
+        SparseSlot(handle.id()) = INVALID_INDEX;
     }
 
     [[nodiscard]] T* Get(EntityHandle handle) {
-        auto it = m_EntityToChunk.find(handle.id());
-        if (it == m_EntityToChunk.end()) return nullptr;
-
-        auto [chunkIdx, compIdx] = it->second;
-        auto& entity = m_Chunks[chunkIdx]->entities[compIdx];
-
-        if (entity.generation() != handle.generation()) return nullptr;
-
-        return &m_Chunks[chunkIdx]->components[compIdx];
+        const U32 index = DenseIndex(handle.id());
+        if (index == INVALID_INDEX) return nullptr;
+        if (m_Entities[index].generation() != handle.generation()) return nullptr;
+        return &At(index);
     }
 
     [[nodiscard]] const T* Get(EntityHandle handle) const {
@@ -143,61 +155,107 @@ public:
     }
 
     [[nodiscard]] bool Contains(EntityHandle handle) const {
-        auto it = m_EntityToChunk.find(handle.id());
-        if (it == m_EntityToChunk.end()) return false;
-
-        auto [chunkIdx, compIdx] = it->second;
-        return m_Chunks[chunkIdx]->entities[compIdx].generation() == handle.generation();
+        const U32 index = DenseIndex(handle.id());
+        return index != INVALID_INDEX && m_Entities[index].generation() == handle.generation();
     }
 
-    class Iterator {
-        const ComponentStorage* storage;
-        U32 chunkIdx;
-        U32 compIdx;
-
-        void Advance() {
-            compIdx++;
-            while (chunkIdx < storage->m_Chunks.size() &&
-                   compIdx >= storage->m_Chunks[chunkIdx]->count) {
-                chunkIdx++;
-                compIdx = 0;
-            }
+    // Removing the current component while iterating is safe: Remove moves the last component
+    // into its slot, so the iterator stays on that slot and visits the moved one next. Removing
+    // other components mid-loop is not supported and may skip one.
+    template<bool Const>
+    class BasicIterator {
+        using Storage = std::conditional_t<Const, const ComponentStorage, ComponentStorage>;
+        using Ref = std::conditional_t<Const, const T&, T&>;
+
+        Storage* storage{};
+        U32 index{};
+        // The entity in the slot when the iterator reached it. Another one there means the
+        // current component was removed and the slot now holds one not yet visited.
+        EntityHandle current{};
+
+        void Arrive() {
+            if (index < storage->m_Entities.size()) current = storage->m_Entities[index];
         }
 
     public:
-        Iterator(const ComponentStorage* s, U32 ci, U32 ii)
-            : storage{s}, chunkIdx{ci}, compIdx{ii} {}
-
-        Iterator& operator++() {
-            Advance();
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::pair<EntityHandle, Ref>;
+        using difference_type = std::ptrdiff_t;
+
+        BasicIterator() = default;
+        BasicIterator(Storage* s, U32 i)
+            : storage{s}, index{i} { Arrive(); }
+
+        BasicIterator& operator++() {
+            const U32 live = static_cast<U32>(storage->m_Entities.size());
+            if (index >= live || storage->m_Entities[index] == current) index++;
+            Arrive();
             return *this;
         }
 
-        bool operator!=(const Iterator& other) const {
-            return chunkIdx != other.chunkIdx || compIdx != other.compIdx;
+        BasicIterator operator++(int) {
+            BasicIterator previous{*this};
+            ++*this;
+            return previous;
+        }
+
+        // Clamped to the live size so removals end the loop instead of walking past the
+        // dense array.
+        bool operator==(const BasicIterator& other) const {
+            const U32 live = static_cast<U32>(storage->m_Entities.size());
+            return std::min(index, live) == std::min(other.index, live);
         }
 
-        std::pair<EntityHandle, T&> operator*() {
-            auto& chunk = *storage->m_Chunks[chunkIdx];
-            return {chunk.entities[compIdx],
-                    const_cast<T&>(chunk.components[compIdx])};
+        value_type operator*() const {
+            return {storage->m_Entities[index], storage->At(index)};
         }
     };
 
-    Iterator begin() const { return Iterator{this, 0, 0}; }
-    Iterator end() const { return Iterator{this, static_cast<U32>(m_Chunks.size()), 0}; }
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    // Calls func(entities, components) once per dense page with both spans in storage order.
+    template<typename Func>
+    void ForEachSpan(Func&& func) {
+        const U32 count = static_cast<U32>(m_Entities.size());
+        for (U32 first = 0; first < count; first += DENSE_PAGE_SIZE) {
+            const U32 n = std::min(DENSE_PAGE_SIZE, count - first);
+            func(std::span<const EntityHandle>{m_Entities.data() + first, n},
+                 std::span<T>{m_Pages[first / DENSE_PAGE_SIZE]->components.data(), n});
+        }
+    }
+
+    template<typename Func>
+    void ForEachSpan(Func&& func) const {
+        const U32 count = static_cast<U32>(m_Entities.size());
+        for (U32 first = 0; first < count; first += DENSE_PAGE_SIZE) {
+            const U32 n = std::min(DENSE_PAGE_SIZE, count - first);
+            func(std::span<const EntityHandle>{m_Entities.data() + first, n},
+                 std::span<const T>{m_Pages[first / DENSE_PAGE_SIZE]->components.data(), n});
+        }
+    }
+
+    Iterator begin() { return Iterator{this, 0}; }
+    Iterator end() { return Iterator{this, static_cast<U32>(m_Entities.size())}; }
+    ConstIterator begin() const { return ConstIterator{this, 0}; }
+    ConstIterator end() const { return ConstIterator{this, static_cast<U32>(m_Entities.size())}; }
 
     void Clear() {
-        m_Chunks.clear();
-        m_EntityToChunk.clear();
+        m_Sparse.clear();
+        m_Pages.clear();
+        m_Entities.clear();
     }
 
     [[nodiscard]] USize Size() const {
-        USize total = 0;
-        for (const auto& chunk : m_Chunks) {
-            total += chunk->count;
-        }
-        return total;
+        return m_Entities.size();
+    }
+
+    // Pages are kept after removals; this frees the ones past the last live component.
+    void ShrinkToFit() {
+        const USize needed = (m_Entities.size() + DENSE_PAGE_SIZE - 1) / DENSE_PAGE_SIZE;
+        m_Pages.resize(needed);
+        m_Entities.shrink_to_fit();
     }
 };
 
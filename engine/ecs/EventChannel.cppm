@@ -0,0 +1,44 @@
+export module ECS.EventChannel;
+
+import Core.Types;
+import std;
+
+// Typed publish/subscribe channel. Publish calls every subscriber synchronously and keeps the
+// event readable through Events() until the owner calls Clear(), so systems can either
+// subscribe once or poll each frame. Not thread-safe: publish from serial code such as
+// command buffer playback, and do not subscribe or unsubscribe from inside a handler.
+export template<typename E>
+class EventChannel {
+public:
+    using Handler = std::function<void(E const&)>;
+    using SubscriptionID = U32;
+
+    SubscriptionID Subscribe(Handler handler) {
+        m_Handlers.push_back(Subscription{++m_NextID, std::move(handler)});
+        return m_NextID;
+    }
+
+    void Unsubscribe(SubscriptionID id) {
+        std::erase_if(m_Handlers, [id](Subscription const& s) { return s.id == id; });
+    }
+
+    void Publish(E const& event) {
+        m_Events.push_back(event);
+        for (auto& s : m_Handlers) s.handler(event);
+    }
+
+    [[nodiscard]] std::span<const E> Events() const { return m_Events; }
+    [[nodiscard]] USize SubscriberCount() const { return m_Handlers.size(); }
+
+    void Clear() { m_Events.clear(); }
+
+private:
+    struct Subscription {
+        SubscriptionID id;
+        Handler handler;
+    };
+
+    Vector<Subscription> m_Handlers{};
+    Vector<E> m_Events{};
+    SubscriptionID m_NextID{0};
+};
@@ -2,6 +2,7 @@ export module ECS.Query;
 
 import ECS.Component;
 import Core.Types;
+import Core.FrameArena;
 import std;
 
 // Component access modifiers
@@ -193,6 +194,25 @@ private:
         return m_World->GetEntityArchetype(handle);
     }
 
+    [[nodiscard]] std::span<const U32> Buckets() const {
+        return m_World->MatchingArchetypes(s_Masks.include, s_Masks.exclude);
+    }
+
+    // Components the query only reads are fetched through a const World, so debug access
+    // checks see a read and callers get const pointers.
+    template<typename T>
+    static constexpr bool s_Writes = ((extract_type<Args>::is_component && extract_type<Args>::is_write &&
+                                       std::is_same_v<typename extract_type<Args>::type, T>) || ...);
+
+    template<typename T>
+    static auto StorageOf(World* world) {
+        if constexpr (s_Writes<T>) {
+            return world->template GetStorage<T>();
+        } else {
+            return std::as_const(*world).template GetStorage<T>();
+        }
+    }
+
 public:
     explicit Query(World* world) : m_World{world} {}
 
@@ -207,10 +227,10 @@ public:
             }.template operator()<Args...>();
 
             if constexpr (isOptional) {
-                auto* storage = world->template GetStorage<T>();
+                auto* storage = StorageOf<T>(world);
                 return storage ? storage->Get(handle) : nullptr;
             } else {
-                return world->template GetStorage<T>()->Get(handle);
+                return StorageOf<T>(world)->Get(handle);
             }
         }
 
@@ -221,98 +241,114 @@ public:
         }
     };
 
+    // Walks the entities of every matching archetype bucket.
     template<typename... Components>
     class TypedIterator {
     private:
-        Query* m_Query;
         World* m_World;
-        typename World::EntityIterator m_Current;
-        typename World::EntityIterator m_End;
+        std::span<const U32> m_Buckets;
+        USize m_Bucket;
+        USize m_Row;
         ComponentGetter<Components...> m_Getter;
 
-        void FindNext() {
-            while (m_Current != m_End) {
-                auto [handle, arch] = *m_Current;
-                if (m_Query->MatchesArchetype(arch)) {
-                    break;
-                }
-                ++m_Current;
+        void SkipEmpty() {
+            while (m_Bucket < m_Buckets.size() &&
+                   m_Row >= m_World->ArchetypeEntities(m_Buckets[m_Bucket]).size()) {
+                ++m_Bucket;
+                m_Row = 0;
             }
         }
 
     public:
-        TypedIterator(Query* query, typename World::EntityIterator begin,
-                     typename World::EntityIterator end)
-            : m_Query{query}, m_World{query->m_World},
-              m_Current{begin}, m_End{end}, m_Getter{query->m_World} {
-            FindNext();
+        TypedIterator(World* world, std::span<const U32> buckets, USize bucket)
+            : m_World{world}, m_Buckets{buckets}, m_Bucket{bucket}, m_Row{0}, m_Getter{world} {
+            SkipEmpty();
         }
 
         auto operator*() const {
-            return m_Getter.Get((*m_Current).first);
+            return m_Getter.Get(m_World->ArchetypeEntities(m_Buckets[m_Bucket])[m_Row]);
         }
 
         TypedIterator& operator++() {
-            ++m_Current;
-            FindNext();
+            ++m_Row;
+            SkipEmpty();
             return *this;
         }
 
         bool operator!=(const TypedIterator& other) const {
-            return m_Current != other.m_Current;
+            return m_Bucket != other.m_Bucket || m_Row != other.m_Row;
         }
     };
 
     template<typename... Components>
     auto Iter() {
         struct Range {
-            Query* query;
+            World* world;
+            std::span<const U32> buckets;
 
-            auto begin() {
-                return TypedIterator<Components...>(
-                    query, query->m_World->EntitiesBegin(),
-                    query->m_World->EntitiesEnd()
-                );
-            }
-
-            auto end() {
-                return TypedIterator<Components...>(
-                    query, query->m_World->EntitiesEnd(),
-                    query->m_World->EntitiesEnd()
-                );
-            }
+            auto begin() { return TypedIterator<Components...>(world, buckets, 0); }
+            auto end() { return TypedIterator<Components...>(world, buckets, buckets.size()); }
         };
-        return Range{this};
+        return Range{m_World, Buckets()};
     }
 
     [[nodiscard]] USize Count() const {
         USize count = 0;
-        for (auto it = m_World->EntitiesBegin(); it != m_World->EntitiesEnd(); ++it) {
-            if (MatchesArchetype(it->second)) {
-                ++count;
-            }
+        for (U32 bucket : Buckets()) {
+            count += m_World->ArchetypeEntities(bucket).size();
         }
         return count;
     }
 
     [[nodiscard]] bool IsEmpty() const {
-        for (auto it = m_World->EntitiesBegin(); it != m_World->EntitiesEnd(); ++it) {
-            if (MatchesArchetype(it->second)) {
+        for (U32 bucket : Buckets()) {
+            if (!m_World->ArchetypeEntities(bucket).empty()) {
                 return false;
             }
         }
         return true;
     }
 
+    // Snapshot of the matching entities, for loops that change the world's structure while
+    // walking them. Lives in the frame arena unless another resource is given.
+    [[nodiscard]] FrameVector<EntityHandle> Collect(std::pmr::memory_resource* resource = FrameArena::Resource()) const {
+        FrameVector<EntityHandle> entities{resource};
+        entities.reserve(Count());
+        for (U32 bucket : Buckets()) {
+            auto bucketEntities = m_World->ArchetypeEntities(bucket);
+            entities.insert(entities.end(), bucketEntities.begin(), bucketEntities.end());
+        }
+        return entities;
+    }
+
     template<typename Func>
     void ForEach(Func func) {
-        for (auto it = m_World->EntitiesBegin(); it != m_World->EntitiesEnd(); ++it) {
-            if (MatchesArchetype(it->second)) {
-                ForEachImpl(it->first, func, std::make_index_sequence<sizeof...(Args)>{});
+        auto storages = std::make_tuple(StorageFor<Args>()...);
+        for (U32 bucket : Buckets()) {
+            for (EntityHandle handle : m_World->ArchetypeEntities(bucket)) {
+                ForEachImpl(handle, func, storages, std::make_index_sequence<sizeof...(Args)>{});
             }
         }
     }
 
+    // Hands the component storage to func as contiguous (entities, components) spans so the
+    // inner loop can vectorize. Only for queries over a single component without filters,
+    // where every stored component matches.
+    template<typename Func>
+    void ForEachChunk(Func func) {
+        static_assert(sizeof...(Args) == 1, "ForEachChunk needs exactly one component argument");
+        using Arg = std::tuple_element_t<0, std::tuple<Args...>>;
+        using Extracted = extract_type<Arg>;
+        static_assert(Extracted::is_component && !Extracted::is_optional,
+                      "ForEachChunk needs a required component argument");
+        using T = typename Extracted::type;
+
+        auto* storage = StorageOf<T>(m_World);
+        if (!storage) return;
+
+        storage->ForEachSpan(func);
+    }
+
     static consteval Archetype GetIncludeMask() { return s_Masks.include; }
     static consteval Archetype GetExcludeMask() { return s_Masks.exclude; }
     static consteval Archetype GetOptionalMask() { return s_Masks.optional; }
@@ -320,14 +356,24 @@ public:
     static consteval Archetype GetWriteMask() { return s_Masks.writes; }
 
 private:
-    template<typename Func, size_t... Is>
-    void ForEachImpl(EntityHandle handle, Func func, std::index_sequence<Is...>) {
-        auto args = std::tuple_cat(GetComponentIfNeeded<Args>(handle)...);
+    // Storage pointers are resolved once per pass instead of once per entity.
+    template<typename Arg>
+    auto StorageFor() {
+        if constexpr (!extract_type<Arg>::is_component) {
+            return nullptr;
+        } else {
+            return StorageOf<typename extract_type<Arg>::type>(m_World);
+        }
+    }
+
+    template<typename Func, typename Storages, size_t... Is>
+    void ForEachImpl(EntityHandle handle, Func& func, Storages& storages, std::index_sequence<Is...>) {
+        auto args = std::tuple_cat(GetComponentIfNeeded<Args>(handle, std::get<Is>(storages))...);
         std::apply(func, args);
     }
 
-    template<typename Arg>
-    auto GetComponentIfNeeded(EntityHandle handle) {
+    template<typename Arg, typename Storage>
+    auto GetComponentIfNeeded(EntityHandle handle, Storage* storage) {
         using T = typename extract_type<Arg>::type;
 
         if constexpr (!extract_type<Arg>::is_component) {
@@ -335,17 +381,21 @@ private:
             return std::tuple<>();
         } else if constexpr (extract_type<Arg>::is_optional) {
             // Optional components
-            auto* storage = m_World->template GetStorage<T>();
             auto* component = storage ? storage->Get(handle) : nullptr;
             return std::make_tuple(component);
         } else if constexpr (extract_type<Arg>::is_read && !extract_type<Arg>::is_write) {
             // Read-only components - return const pointer
-            auto* component = m_World->template GetStorage<T>()->Get(handle);
-            return std::make_tuple(static_cast<const T*>(component));
+            const T* component = storage->Get(handle);
+            return std::make_tuple(component);
         } else {
             // Write or ReadWrite components - return non-const pointer
-            auto* component = m_World->template GetStorage<T>()->Get(handle);
+            auto* component = storage->Get(handle);
             return std::make_tuple(component);
         }
     }
-};
\ No newline at end of file
+
+    template<typename Arg>
+    auto GetComponentIfNeeded(EntityHandle, std::nullptr_t) {
+        return std::tuple<>();
+    }
+};
@@ -8,8 +8,10 @@ void SystemScheduler::RegisterSystemMetadata(ISystem* system, const SystemMetada
     node->system = system;
     node->metadata = metadata;
     node->nodeId = static_cast<U32>(m_SystemNodes.size());
+    node->access = {metadata.readComponents, metadata.writeComponents, nullptr};
 
     SystemNode* nodePtr = node.get();
+    nodePtr->access.system = nodePtr->metadata.name.c_str();
     m_SystemNodes[metadata.name] = nodePtr;
     m_StageNodes[metadata.stage].push_back(nodePtr);
 
@@ -33,6 +35,10 @@ void SystemScheduler::SetExecuteCallback(std::function<void(SystemNode*)> callba
 }
 
 void SystemScheduler::ExecuteSystem(SystemNode* node, F32 dt) {
+    // Systems that declare nothing are not checked.
+    const bool declared = (node->access.reads | node->access.writes) != 0;
+    World::AccessScope accessScope{declared ? &node->access : nullptr};
+
     auto start = std::chrono::high_resolution_clock::now();
 
     node->system->Run(m_World, dt);
@@ -41,9 +47,31 @@ void SystemScheduler::ExecuteSystem(SystemNode* node, F32 dt) {
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
         end - start).count();
 
+    // Systems of a stage may finish concurrently.
+    std::lock_guard lock(m_StatsMutex);
     m_SystemExecutionTimes[node->metadata.name] = duration;
 }
 
+// Plays back the stage's command buffers in registration order, so the result does not
+// depend on which thread finished first.
+void SystemScheduler::FlushCommands(SystemStage stage) {
+    auto it = m_StageNodes.find(stage);
+    if (it == m_StageNodes.end()) return;
+
+    for (SystemNode* node : it->second) {
+        if (CommandBuffer* commands = node->system->GetCommandBuffer(); commands && !commands->Empty()) {
+            commands->Playback(*m_World);
+        }
+    }
+}
+
+void SystemScheduler::FlushAllCommands() {
+    for (SystemStage stage : {SystemStage::PreUpdate, SystemStage::Update, SystemStage::PostUpdate,
+                              SystemStage::PreRender, SystemStage::Render, SystemStage::PostRender}) {
+        FlushCommands(stage);
+    }
+}
+
 std::string SystemScheduler::GenerateDotGraph() const {
     std::stringstream ss;
     ss << "digraph SystemScheduler {\n";
@@ -99,6 +127,7 @@ std::string SystemScheduler::GenerateDotGraph() const {
 SystemExecutionStats SystemScheduler::GetStats() const {
     SystemExecutionStats stats{};
 
+    std::lock_guard lock(m_StatsMutex);
     for (const auto& [name, time] : m_SystemExecutionTimes) {
         stats.systemTimes.emplace_back(name, time);
     }
@@ -153,45 +182,64 @@ void SystemScheduler::ResolveExplicitDependencies() {
 }
 
 void SystemScheduler::InferComponentDependencies() {
-    // Within each stage, infer dependencies based on component access
+    // Within each stage, only conflicting pairs are ordered, higher priority first and then
+    // registration order. Pairs already ordered through other edges are skipped, so the
+    // stage DAG keeps no redundant edges and everything else may run concurrently.
     for (auto& [stage, nodes] : m_StageNodes) {
-        for (size_t i = 0; i < nodes.size(); ++i) {
-            for (size_t j = i + 1; j < nodes.size(); ++j) {
-                CheckComponentConflict(nodes[i], nodes[j]);
+        Vector<SystemNode*> ordered = nodes;
+        std::ranges::stable_sort(ordered, std::ranges::greater{},
+                                 [](const SystemNode* n) { return n->metadata.priority; });
+
+        for (size_t j = 1; j < ordered.size(); ++j) {
+            for (size_t i = j; i-- > 0;) {
+                CheckComponentConflict(ordered[i], ordered[j]);
             }
         }
     }
 }
 
 void SystemScheduler::CheckComponentConflict(SystemNode* a, SystemNode* b) {
-    // Check for conflicts
-    Archetype writeWriteConflict = a->metadata.writeComponents & b->metadata.writeComponents;
-    Archetype readWriteConflictA = a->metadata.readComponents & b->metadata.writeComponents;
-    Archetype readWriteConflictB = b->metadata.readComponents & a->metadata.writeComponents;
-
-    bool hasConflict = writeWriteConflict != 0 || readWriteConflictA != 0 || readWriteConflictB != 0;
-
-    if (hasConflict && !HasExplicitRelationship(a, b)) {
-        // Systems conflict - establish ordering based on priority
-        if (a->metadata.priority >= b->metadata.priority) {
-            b->dependencies.push_back(a);
-            a->dependents.push_back(b);
-        } else {
-            a->dependencies.push_back(b);
-            b->dependents.push_back(a);
-        }
+    if (!Conflicts(a, b) || Reaches(a, b) || Reaches(b, a)) return;
 
-        Logger::Debug(LogECS, "Inferred dependency: {} -> {} due to component conflicts",
-                     a->metadata.name, b->metadata.name);
-    }
+    b->dependencies.push_back(a);
+    a->dependents.push_back(b);
+
+    Logger::Debug(LogECS, "Inferred dependency: {} -> {} due to component conflicts",
+                 a->metadata.name, b->metadata.name);
+}
+
+bool SystemScheduler::Conflicts(const SystemNode* a, const SystemNode* b) {
+    const SystemMetadata& ma = a->metadata;
+    const SystemMetadata& mb = b->metadata;
+
+    // Non-parallel systems touch state outside the World (e.g. the graphics command list),
+    // so they never overlap each other.
+    if (!ma.isParallel && !mb.isParallel) return true;
+
+    Archetype writeWriteConflict = ma.writeComponents & mb.writeComponents;
+    Archetype readWriteConflictA = ma.readComponents & mb.writeComponents;
+    Archetype readWriteConflictB = mb.readComponents & ma.writeComponents;
+
+    return writeWriteConflict != 0 || readWriteConflictA != 0 || readWriteConflictB != 0;
 }
 
-bool SystemScheduler::HasExplicitRelationship(SystemNode* a, SystemNode* b) const {
-    // Check if there's already an explicit dependency between a and b
-    if (std::ranges::find(a->dependencies, b) != a->dependencies.end()) return true;
-    if (std::ranges::find(b->dependencies, a) != b->dependencies.end()) return true;
-    if (std::ranges::find(a->dependents, b) != a->dependents.end()) return true;
-    if (std::ranges::find(b->dependents, a) != b->dependents.end()) return true;
+// Whether `to` already runs after `from` through same-stage edges.
+bool SystemScheduler::Reaches(const SystemNode* from, const SystemNode* to) {
+    Vector<const SystemNode*> stack{from};
+    Vector<const SystemNode*> visited{from};
+
+    while (!stack.empty()) {
+        const SystemNode* node = stack.back();
+        stack.pop_back();
+        if (node == to) return true;
+
+        for (const SystemNode* next : node->dependents) {
+            if (next->metadata.stage != from->metadata.stage) continue;
+            if (std::ranges::find(visited, next) != visited.end()) continue;
+            visited.push_back(next);
+            stack.push_back(next);
+        }
+    }
     return false;
 }
 
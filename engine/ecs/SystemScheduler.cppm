@@ -3,6 +3,7 @@ export module ECS.SystemScheduler;
 import ECS.World;
 import ECS.Query;
 import ECS.Component;
+import ECS.CommandBuffer;
 import Core.Types;
 import Core.Assert;
 import Core.Log;
@@ -45,6 +46,7 @@ public:
     virtual void Run(World* world, F32 dt) = 0;
     [[nodiscard]] virtual std::string GetName() const = 0;
     [[nodiscard]] virtual SystemStage GetStage() const { return SystemStage::Update; }
+    [[nodiscard]] virtual CommandBuffer* GetCommandBuffer() { return nullptr; }
 };
 
 export struct SystemMetadata {
@@ -62,6 +64,7 @@ export struct SystemNode {
     SystemMetadata metadata;
     Vector<SystemNode*> dependencies;
     Vector<SystemNode*> dependents;
+    ComponentAccess access;
     U32 nodeId;
 };
 
@@ -73,6 +76,10 @@ export template<typename Derived>
 class System : public ISystem {
 protected:
     SystemMetadata m_Metadata{};
+    CommandBuffer m_Commands{};
+
+    // Structural changes recorded here are played back when the system's stage ends.
+    CommandBuffer& Commands() { return m_Commands; }
 
     void SetName(std::string name) { m_Metadata.name = std::move(name); }
     void SetStage(SystemStage stage) { m_Metadata.stage = stage; }
@@ -91,6 +98,8 @@ protected:
         m_Metadata.dependencies.push_back({SystemDependency::With, system});
     }
 
+    // Declared access decides which systems of a stage may overlap: only systems whose sets
+    // conflict get ordered. Debug builds check the system's World accesses against it.
     template<typename... Components>
     void ReadsComponents() {
         m_Metadata.readComponents |= MakeArchetype<Components...>();
@@ -106,6 +115,7 @@ public:
 
     [[nodiscard]] std::string GetName() const override { return m_Metadata.name; }
     [[nodiscard]] SystemStage GetStage() const override { return m_Metadata.stage; }
+    [[nodiscard]] CommandBuffer* GetCommandBuffer() override { return &m_Commands; }
     [[nodiscard]] const SystemMetadata& GetMetadata() const { return m_Metadata; }
 };
 
@@ -142,6 +152,7 @@ private:
 
     World* m_World{nullptr};
     UnorderedMap<std::string, U64> m_SystemExecutionTimes;
+    mutable std::mutex m_StatsMutex;
     std::function<void(SystemNode*)> m_ExecuteCallback;
 
 public:
@@ -154,6 +165,8 @@ public:
     void BuildExecutionGraph(World* world);
     void SetExecuteCallback(std::function<void(SystemNode*)> callback);
     void ExecuteSystem(SystemNode* node, F32 dt);
+    void FlushCommands(SystemStage stage);
+    void FlushAllCommands();
 
     [[nodiscard]] const UnorderedMap<SystemStage, Vector<SystemNode*>>& GetStageNodes() const {
         return m_StageNodes;
@@ -172,7 +185,8 @@ private:
     void ResolveExplicitDependencies();
     void InferComponentDependencies();
     void CheckComponentConflict(SystemNode* a, SystemNode* b);
-    bool HasExplicitRelationship(SystemNode* a, SystemNode* b) const;
+    static bool Conflicts(const SystemNode* a, const SystemNode* b);
+    static bool Reaches(const SystemNode* from, const SystemNode* to);
     bool IsImplicitDependency(const SystemNode* dependent, const SystemNode* dependency) const;
 };
 
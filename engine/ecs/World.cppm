@@ -3,8 +3,17 @@ export module ECS.World;
 import ECS.Component;
 import Core.Types;
 import Core.Assert;
+import Core.Log;
 import std;
 
+// Components a running system declared it reads and writes. Debug builds check storage
+// lookups and structural changes made on the system's thread against it.
+export struct ComponentAccess {
+    Archetype reads{0};
+    Archetype writes{0};
+    const char *system{nullptr};
+};
+
 export class World {
 private:
     struct IComponentStorageBase {
@@ -53,11 +62,54 @@ private:
         }
 
         ComponentStorage<T> *GetStorage() { return &storage; }
+
+        const ComponentStorage<T> *GetStorage() const { return &storage; }
+    };
+
+    // Every live entity sits in exactly one bucket, the one for its current archetype.
+    // Buckets are never removed, so their indices stay valid for cached query matches.
+    struct ArchetypeBucket {
+        Archetype archetype{};
+        Vector<EntityHandle> entities{};
+    };
+
+    struct EntityLocation {
+        U32 bucket{};
+        U32 row{};
+    };
+
+    struct QueryMatch {
+        Archetype include{};
+        Archetype exclude{};
+        U32 bucketsSeen{};
+        Vector<U32> buckets{};
     };
 
     EntityManager m_EntityManager{};
     UnorderedMap<ComponentID, UniquePtr<IComponentStorageBase> > m_Storages{};
     UnorderedMap<EntityHandle, Archetype> m_EntityArchetypes{};
+    Vector<ArchetypeBucket> m_Buckets{};
+    UnorderedMap<Archetype, U32> m_BucketIndex{};
+    Vector<EntityLocation> m_Locations{};
+
+    mutable std::mutex m_QueryCacheMutex{};
+    mutable Vector<UniquePtr<QueryMatch> > m_QueryCache{};
+
+    static inline thread_local const ComponentAccess *s_Access{nullptr};
+
+    static void CheckAccess([[maybe_unused]] ComponentID componentID, [[maybe_unused]] bool write) {
+#ifndef NDEBUG
+        const ComponentAccess *access = s_Access;
+        if (!access) return;
+
+        const Archetype allowed = write ? access->writes : (access->reads | access->writes);
+        if ((allowed & (1ULL << componentID)) == 0) {
+            Logger::Error(LogECS, "System '{}' {} component {} without declaring it",
+                          access->system ? access->system : "?", write ? "writes" : "reads", componentID);
+            assert(false, "Undeclared component access");
+        }
+#endif
+    }
 
     void UpdateEntityArchetype(EntityHandle handle) {
         Archetype arch = 0;
@@ -68,10 +120,66 @@ private:
             }
         }
 
-        m_EntityArchetypes[handle] = arch;
+        SetArchetype(handle, arch);
+    }
+
+    U32 GetOrCreateBucket(Archetype arch) {
+        auto [it, inserted] = m_BucketIndex.try_emplace(arch, static_cast<U32>(m_Buckets.size()));
+        if (inserted) {
+            m_Buckets.push_back(ArchetypeBucket{arch, {}});
+        }
+        return it->second;
+    }
+
+    void DetachFromBucket(EntityHandle handle) {
+        const EntityLocation loc = m_Locations[handle.id()];
+        auto &entities = m_Buckets[loc.bucket].entities;
+        if (loc.row + 1 != entities.size()) {
+            entities[loc.row] = entities.back();
+            m_Locations[entities[loc.row].id()].row = loc.row;
+        }
+        entities.pop_back();
+    }
+
+    void AttachToBucket(EntityHandle handle, Archetype arch) {
+        const U32 bucket = GetOrCreateBucket(arch);
+        if (m_Locations.size() <= handle.id()) {
+            m_Locations.resize(static_cast<USize>(handle.id()) + 1);
+        }
+        m_Locations[handle.id()] = {bucket, static_cast<U32>(m_Buckets[bucket].entities.size())};
+        m_Buckets[bucket].entities.push_back(handle);
+    }
+
+    void SetArchetype(EntityHandle handle, Archetype arch) {
+        auto it = m_EntityArchetypes.find(handle);
+        if (it == m_EntityArchetypes.end()) {
+            m_EntityArchetypes.emplace(handle, arch);
+            AttachToBucket(handle, arch);
+            return;
+        }
+        if (it->second == arch) return;
+
+        DetachFromBucket(handle);
+        it->second = arch;
+        AttachToBucket(handle, arch);
     }
 
 public:
+    // Installs access as the current thread's declared access for the scope's lifetime.
+    class AccessScope {
+    public:
+        explicit AccessScope(const ComponentAccess *access) : m_Previous{s_Access} { s_Access = access; }
+        ~AccessScope() { s_Access = m_Previous; }
+
+        AccessScope(const AccessScope &) = delete;
+        AccessScope &operator=(const AccessScope &) = delete;
+
+    private:
+        const ComponentAccess *m_Previous;
+    };
+
+    [[nodiscard]] static const ComponentAccess *CurrentAccess() { return s_Access; }
+
     using EntityArchetypePair = std::pair<EntityHandle, Archetype>;
     using EntityIterator = UnorderedMap<EntityHandle, Archetype>::const_iterator;
 
@@ -86,7 +194,7 @@ public:
     EntityHandle CreateEntity() {
         const auto handle = m_EntityManager.CreateEntity();
         if (handle.valid()) {
-            m_EntityArchetypes[handle] = EMPTY_ARCHETYPE;
+            SetArchetype(handle, EMPTY_ARCHETYPE);
         }
         return handle;
     }
@@ -100,7 +208,9 @@ public:
             }
         }
 
-        m_EntityArchetypes.erase(handle);
+        if (m_EntityArchetypes.erase(handle) > 0) {
+            DetachFromBucket(handle);
+        }
         m_EntityManager.DestroyEntity(handle);
     }
 
@@ -111,6 +221,7 @@ public:
         using U = std::remove_cvref_t<T>;
 
         const ComponentID componentID{ComponentRegistry::GetID<U>()};
+        CheckAccess(componentID, true);
 
         if (!m_Storages.contains(componentID)) {
             m_Storages[componentID] = std::make_unique<TypedStorage<U> >();
@@ -121,7 +232,7 @@ public:
         U tmp{std::forward<T>(component)};
         typed->GetStorage()->Insert(handle, std::move(tmp));
 
-        m_EntityArchetypes[handle] |= (1ULL << componentID);
+        SetArchetype(handle, GetEntityArchetype(handle) | (1ULL << componentID));
     }
 
     template<typename T>
@@ -130,6 +241,7 @@ public:
 
         using U = std::remove_cvref_t<T>;
         const ComponentID componentID{ComponentRegistry::GetID<U>()};
+        CheckAccess(componentID, true);
 
         if (!m_Storages.contains(componentID)) {
             m_Storages[componentID] = std::make_unique<TypedStorage<U> >();
@@ -144,7 +256,7 @@ public:
         } else {
             // add
             typed->GetStorage()->Insert(handle, std::move(tmp));
-            m_EntityArchetypes[handle] |= (1ULL << componentID);
+            SetArchetype(handle, GetEntityArchetype(handle) | (1ULL << componentID));
         }
 
         return *static_cast<U *>(typed->GetRaw(handle));
@@ -157,20 +269,25 @@ public:
 
         using U = std::remove_cvref_t<T>;
         const ComponentID componentID{ComponentRegistry::GetID<U>()};
+        CheckAccess(componentID, true);
 
         auto it = m_Storages.find(componentID);
         if (it == m_Storages.end()) return;
 
         it->second->Remove(handle);
-        m_EntityArchetypes[handle] &= ~(1ULL << componentID);
+        if (m_EntityArchetypes.contains(handle)) {
+            SetArchetype(handle, GetEntityArchetype(handle) & ~(1ULL << componentID));
+        }
     }
 
+    // Mutable access counts as a write; read-only systems go through a const World.
     template<typename T>
     [[nodiscard]] T *GetComponent(EntityHandle handle) {
         if (!handle.valid()) return nullptr;
 
         using U = std::remove_cvref_t<T>;
         const ComponentID componentID{ComponentRegistry::GetID<U>()};
+        CheckAccess(componentID, true);
 
         auto it = m_Storages.find(componentID);
         if (it == m_Storages.end()) return nullptr;
@@ -180,13 +297,23 @@ public:
 
     template<typename T>
     [[nodiscard]] const T *GetComponent(EntityHandle handle) const {
-        return const_cast<World *>(this)->GetComponent<T>(handle);
+        if (!handle.valid()) return nullptr;
+
+        using U = std::remove_cvref_t<T>;
+        const ComponentID componentID{ComponentRegistry::GetID<U>()};
+        CheckAccess(componentID, false);
+
+        auto it = m_Storages.find(componentID);
+        if (it == m_Storages.end()) return nullptr;
+
+        return static_cast<const T *>(std::as_const(*it->second).GetRaw(handle));
     }
 
     template<typename T>
     [[nodiscard]] ComponentStorage<std::remove_cvref_t<T> > *GetStorage() {
         using U = std::remove_cvref_t<T>;
         const ComponentID componentID{ComponentRegistry::GetID<U>()};
+        CheckAccess(componentID, true);
 
         auto it = m_Storages.find(componentID);
         if (it == m_Storages.end()) return nullptr;
@@ -194,6 +321,18 @@ public:
         return static_cast<TypedStorage<U> *>(it->second.get())->GetStorage();
     }
 
+    template<typename T>
+    [[nodiscard]] const ComponentStorage<std::remove_cvref_t<T> > *GetStorage() const {
+        using U = std::remove_cvref_t<T>;
+        const ComponentID componentID{ComponentRegistry::GetID<U>()};
+        CheckAccess(componentID, false);
+
+        auto it = m_Storages.find(componentID);
+        if (it == m_Storages.end()) return nullptr;
+
+        return static_cast<const TypedStorage<U> *>(it->second.get())->GetStorage();
+    }
+
     [[nodiscard]] Archetype GetEntityArchetype(EntityHandle handle) const {
         auto it = m_EntityArchetypes.find(handle);
         return it != m_EntityArchetypes.end() ? it->second : EMPTY_ARCHETYPE;
@@ -203,9 +342,56 @@ public:
         return m_EntityManager.GetMaxEntityID();
     }
 
+    // Buckets whose archetype contains every bit of include and none of exclude. The result
+    // is cached per mask pair and extended only when new archetypes appear, so a query costs
+    // O(matching entities) rather than O(all entities). The span stays valid until the next
+    // structural change to the world.
+    [[nodiscard]] std::span<const U32> MatchingArchetypes(Archetype include, Archetype exclude) const {
+        std::lock_guard lock(m_QueryCacheMutex);
+
+        QueryMatch *match = nullptr;
+        for (const auto &m: m_QueryCache) {
+            if (m->include == include && m->exclude == exclude) {
+                match = m.get();
+                break;
+            }
+        }
+        if (!match) {
+            m_QueryCache.push_back(std::make_unique<QueryMatch>(QueryMatch{include, exclude, 0, {}}));
+            match = m_QueryCache.back().get();
+        }
+
+        for (; match->bucketsSeen < m_Buckets.size(); ++match->bucketsSeen) {
+            const Archetype arch = m_Buckets[match->bucketsSeen].archetype;
+            if ((arch & include) == include && (arch & exclude) == 0) {
+                match->buckets.push_back(match->bucketsSeen);
+            }
+        }
+        return match->buckets;
+    }
+
+    [[nodiscard]] std::span<const EntityHandle> ArchetypeEntities(U32 bucket) const {
+        return m_Buckets[bucket].entities;
+    }
+
+    [[nodiscard]] Archetype GetArchetypeAt(U32 bucket) const {
+        return m_Buckets[bucket].archetype;
+    }
+
+    [[nodiscard]] USize GetArchetypeCount() const {
+        return m_Buckets.size();
+    }
+
     void Clear() {
         m_Storages.clear();
         m_EntityArchetypes.clear();
+        m_Buckets.clear();
+        m_BucketIndex.clear();
+        m_Locations.clear();
+        {
+            std::lock_guard lock(m_QueryCacheMutex);
+            m_QueryCache.clear();
+        }
         m_EntityManager.Clear();
     }
 
@@ -14,6 +14,7 @@ export module Graphics.DX12.GraphicsContext;
 
 import Graphics;
 import Graphics.Window;
+import Graphics.MeshArena;
 import Graphics.DX12.Device;
 import Graphics.DX12.SwapChain;
 import Graphics.DX12.Renderer;
@@ -21,6 +22,7 @@ import Graphics.DX12.Pipeline;
 import Graphics.DX12.Resource;
 import Graphics.DX12.RenderGraph;
 import Graphics.DX12.CommandList;
+import Graphics.DX12.Fence;
 import Graphics.DX12.DescriptorHeap;
 import Graphics.DX12.ShaderManager;
 import Core.Types;
@@ -34,8 +36,11 @@ struct ResourceHandle {
     U32 index;
 };
 
-class DX12GraphicsContext : public IGraphicsContext {
+class DX12GraphicsContext : public IGraphicsContext, private IMeshArenaBackend {
 private:
+    // Root parameter 1 carries the object constants (b1) inline: one float4x4.
+    static constexpr U32 kObjectConstantValues{16};
+
     std::unique_ptr<Renderer> m_Renderer;
     Window *m_Window;
     std::unique_ptr<ShaderManager> m_ShaderManager;
@@ -66,6 +71,12 @@ private:
     std::mutex m_CmdMutex;
     U32 m_CurrentPipelineIndex{UINT_MAX};
 
+    // Mesh heaps live in m_VertexBuffers / m_IndexBuffers; the staging ring stays mapped and the
+    // fence is signalled once per frame after the frame's command list is submitted.
+    std::unique_ptr<Buffer> m_MeshStaging;
+    std::unique_ptr<Fence> m_MeshFence;
+    std::unique_ptr<MeshArena> m_MeshArena;
+
 public:
     DX12GraphicsContext(Window &window, const GraphicsConfig &config) : m_Window{&window} {
         RendererConfig rendererConfig{};
@@ -74,10 +85,15 @@ public:
         m_Renderer = std::make_unique<Renderer>(window, rendererConfig);
         m_Renderer->GetSwapChain().SetVSync(config.enableVSync);
         m_ShaderManager = std::make_unique<ShaderManager>("shaders");
+        m_MeshFence = std::make_unique<Fence>(m_Renderer->GetDevice());
+        m_MeshArena = std::make_unique<MeshArena>(static_cast<IMeshArenaBackend &>(*this));
     }
 
     ~DX12GraphicsContext() {
         if (m_Renderer) { m_Renderer->WaitIdle(); }
+        m_MeshArena.reset();
+        m_MeshStaging.reset();
+        m_MeshFence.reset();
         m_CurrentPassData.reset();
         m_RootSignatures.clear();
         m_Pipelines.clear();
@@ -343,8 +359,8 @@ public:
         p0.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
         rootParams.push_back(p0);
         D3D12_ROOT_PARAMETER p1{};
-        p1.ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-        p1.Descriptor = {1, 0};
+        p1.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+        p1.Constants = {1, 0, kObjectConstantValues};
         p1.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
         rootParams.push_back(p1);
 
@@ -417,6 +433,7 @@ public:
             if (name == "NORMAL") fmt = DXGI_FORMAT_R32G32B32_FLOAT;
             else if (name == "TEXCOORD") fmt = DXGI_FORMAT_R32G32_FLOAT;
             else if (name == "COLOR") fmt = DXGI_FORMAT_R32_UINT;
+            else if (name == "PACKED") fmt = DXGI_FORMAT_R32G32_UINT;
             layout.push_back(D3D12_INPUT_ELEMENT_DESC{
                 name.c_str(), 0, fmt, 0, off, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0
             });
@@ -450,14 +467,18 @@ public:
 
     void BeginFrame() override {
         m_Renderer->BeginFrame();
+        m_MeshArena->BeginFrame();
         m_CurrentPassData = std::make_unique<FramePassData>();
         m_Renderer->ResetRenderGraph();
     }
 
     void EndFrame() override {
+        // Mesh copies go first so this frame's draws already see them.
+        m_MeshArena->EndFrame();
         m_Renderer->GetRenderGraph().Compile();
         m_Renderer->GetRenderGraph().Execute(m_Renderer->GetCurrentCommandList());
         m_Renderer->EndFrame();
+        m_MeshFence->Signal(m_Renderer->GetDevice().GetDirectQueue());
         m_CurrentPassData.reset();
     }
 
@@ -559,6 +580,8 @@ public:
         return m_Window->ShouldClose();
     }
 
+    MeshArena &GetMeshArena() override { return *m_MeshArena; }
+
     ShaderManager *GetShaderManager() { return m_ShaderManager.get(); }
 
     U32 CreateTexture2D(const void *rgba8, U32 width, U32 height, U32 mipLevels = 1) override {
@@ -688,6 +711,7 @@ public:
 
     void SetConstantBuffer(U32 buffer, U32 slot) override {
         assert(m_InRenderPass, "Must be in render pass");
+        assert(slot != 1, "Slot 1 holds root constants, use SetObjectConstants");
         if (buffer >= m_ConstantBuffers.size()) return;
         auto addr{m_ConstantBuffers[buffer]->GetGPUAddress()};
         const U32 p = m_CurrentPipelineIndex;
@@ -695,12 +719,90 @@ public:
         m_CurrentPassData->commands.push_back([=, this](ID3D12GraphicsCommandList *cmd) {
             if (p != UINT_MAX) m_Pipelines[p]->Bind(cmd);
             if (slot == 0) cmd->SetGraphicsRootConstantBufferView(0, addr);
-            else if (slot == 1) cmd->SetGraphicsRootConstantBufferView(1, addr);
             else if (slot == 2) cmd->SetGraphicsRootConstantBufferView(3, addr);
         });
     }
 
+    void SetObjectConstants(const void* data, U32 size) override {
+        assert(m_InRenderPass, "Must be in render pass");
+        assert(data && size > 0 && size <= kObjectConstantValues * sizeof(U32) && size % sizeof(U32) == 0,
+               "object constants must be whole 32-bit values and fit the root constants");
+        std::array<U32, kObjectConstantValues> values{};
+        std::memcpy(values.data(), data, size);
+        const U32 count{size / static_cast<U32>(sizeof(U32))};
+        const U32 p = m_CurrentPipelineIndex;
+        std::lock_guard<std::mutex> lk{m_CmdMutex};
+        m_CurrentPassData->commands.push_back([=, this](ID3D12GraphicsCommandList *cmd) {
+            if (p != UINT_MAX) m_Pipelines[p]->Bind(cmd);
+            cmd->SetGraphicsRoot32BitConstants(1, count, values.data(), 0);
+        });
+    }
+
 private:
+    U32 CreateHeap(MeshHeapKind kind, U64 bytes) override {
+        BufferDesc desc{};
+        desc.size = bytes;
+        desc.usage = (kind == MeshHeapKind::Vertex ? ResourceUsage::VertexBuffer : ResourceUsage::IndexBuffer) | ResourceUsage::CopyDest;
+        desc.cpuAccessible = false;
+        auto buffer{std::make_unique<Buffer>(m_Renderer->GetDevice(), desc)};
+        auto &list{kind == MeshHeapKind::Vertex ? m_VertexBuffers : m_IndexBuffers};
+        U32 handle{static_cast<U32>(list.size())};
+        list.push_back(std::move(buffer));
+        return handle;
+    }
+
+    std::span<std::byte> CreateStaging(U64 bytes) override {
+        BufferDesc desc{};
+        desc.size = bytes;
+        desc.usage = ResourceUsage::CopySource;
+        desc.cpuAccessible = true;
+        m_MeshStaging = std::make_unique<Buffer>(m_Renderer->GetDevice(), desc);
+        return {static_cast<std::byte *>(m_MeshStaging->GetMappedData()), static_cast<size_t>(bytes)};
+    }
+
+    // One barrier batch into COPY_DEST for every heap touched, the copies, one batch back.
+    void RecordCopies(std::span<const MeshCopy> copies) override {
+        auto &curCL{m_Renderer->GetCurrentCommandList()};
+        assert(curCL.IsRecording(), "Mesh copies need the frame command list");
+        auto *cmd{curCL.GetCommandList()};
+
+        std::vector<Buffer *> heaps{};
+        for (MeshCopy const &c: copies) {
+            Buffer *heap{(c.kind == MeshHeapKind::Vertex ? m_VertexBuffers : m_IndexBuffers)[c.heap].get()};
+            if (std::find(heaps.begin(), heaps.end(), heap) == heaps.end()) heaps.push_back(heap);
+        }
+
+        std::vector<D3D12_RESOURCE_BARRIER> barriers{};
+        auto transition = [&](bool toCopy) {
+            barriers.clear();
+            for (Buffer *heap: heaps) {
+                const auto target{toCopy ? D3D12_RESOURCE_STATE_COPY_DEST
+                    : static_cast<U32>(heap->GetDesc().usage & ResourceUsage::VertexBuffer)
+                          ? D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER : D3D12_RESOURCE_STATE_INDEX_BUFFER};
+                if (heap->GetCurrentState() == target) continue;
+                D3D12_RESOURCE_BARRIER b{};
+                b.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                b.Transition.pResource = heap->GetResource();
+                b.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+                b.Transition.StateBefore = heap->GetCurrentState();
+                b.Transition.StateAfter = target;
+                barriers.push_back(b);
+                heap->SetCurrentState(target);
+            }
+            if (!barriers.empty()) cmd->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+        };
+
+        transition(true);
+        for (MeshCopy const &c: copies) {
+            Buffer *heap{(c.kind == MeshHeapKind::Vertex ? m_VertexBuffers : m_IndexBuffers)[c.heap].get()};
+            cmd->CopyBufferRegion(heap->GetResource(), c.dstOffset, m_MeshStaging->GetResource(), c.srcOffset, c.size);
+        }
+        transition(false);
+    }
+
+    U64 FrameFence() const override { return m_MeshFence->GetNextValue(); }
+    U64 CompletedFence() const override { return m_MeshFence->GetCompletedValue(); }
+
     void UpdateBuffer(Buffer& dst, const void* data, U64 size, U64 dstOffset) {
         if (!data || size == 0) { return; }
         assert(dstOffset + size <= dst.GetDesc().size, "update exceeds buffer size");
@@ -868,3 +970,7 @@ private:
 export std::unique_ptr<IGraphicsContext> CreateDX12GraphicsContext(Window &window, const GraphicsConfig &config) {
     return std::make_unique<DX12GraphicsContext>(window, config);
 }
+
+export inline std::unique_ptr<IGraphicsContext> CreateGraphicsContext(Window &window, const GraphicsConfig &config) {
+    return CreateDX12GraphicsContext(window, config);
+}
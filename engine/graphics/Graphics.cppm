@@ -1,7 +1,7 @@
 export module Graphics;
 
 import Core.Types;
-import Graphics.Window;
+import Graphics.MeshArena;
 import std;
 
 export struct Vertex {
@@ -71,9 +71,14 @@ public:
     virtual void SetVertexBuffer(U32 buffer) = 0;
     virtual void SetIndexBuffer(U32 buffer) = 0;
     virtual void SetConstantBuffer(U32 buffer, U32 slot) = 0;
+    // Per-draw object constants (register b1, at most 64 bytes) recorded inline with the draw,
+    // so a per-object transform needs no buffer of its own.
+    virtual void SetObjectConstants(const void* data, U32 size) = 0;
     virtual void Draw(U32 vertexCount, U32 instanceCount = 1, U32 firstVertex = 0, U32 firstInstance = 0) = 0;
     virtual void DrawIndexed(U32 indexCount, U32 instanceCount = 1, U32 firstIndex = 0, S32 vertexOffset = 0, U32 firstInstance = 0) = 0;
     virtual void OnResize(U32 width, U32 height) = 0;
+    // Shared sub-allocated vertex/index memory for meshes that are uploaded often, like chunks.
+    [[nodiscard]] virtual MeshArena& GetMeshArena() = 0;
     [[nodiscard]] virtual bool ShouldClose() const = 0;
 };
 
@@ -82,9 +87,3 @@ export struct GraphicsConfig {
     bool enableVSync = true;
     U32 frameBufferCount = 3;
 };
-
-export std::unique_ptr<IGraphicsContext> CreateDX12GraphicsContext(Window& window, const GraphicsConfig& config);
-
-export inline std::unique_ptr<IGraphicsContext> CreateGraphicsContext(Window& window, const GraphicsConfig& config) {
-    return CreateDX12GraphicsContext(window, config);
-}
\ No newline at end of file
@@ -0,0 +1,384 @@
+export module Graphics.MeshArena;
+
+import Core.Types;
+import Core.Assert;
+import std;
+
+// Best-fit free list over [0, capacity) elements. Free coalesces with both neighbours, so the
+// free list never holds two adjacent ranges.
+export class RangeAllocator {
+public:
+    explicit RangeAllocator(U32 capacity = 0) : m_Capacity{capacity} {
+        if (capacity) Insert(0, capacity);
+    }
+
+    [[nodiscard]] std::optional<U32> Allocate(U32 count) {
+        if (count == 0) return std::nullopt;
+        auto it{m_BySize.lower_bound(count)};
+        if (it == m_BySize.end()) return std::nullopt;
+        const U32 size{it->first};
+        const U32 offset{it->second};
+        m_BySize.erase(it);
+        m_ByOffset.erase(offset);
+        if (size > count) Insert(offset + count, size - count);
+        m_FreeCount -= count;
+        return offset;
+    }
+
+    void Free(U32 offset, U32 count) {
+        if (count == 0) return;
+        assert(offset + count <= m_Capacity, "RangeAllocator: range out of bounds");
+        m_FreeCount += count;
+
+        auto next{m_ByOffset.lower_bound(offset)};
+        assert(next == m_ByOffset.end() || offset + count <= next->first, "RangeAllocator: double free");
+        if (next != m_ByOffset.begin()) {
+            auto prev{std::prev(next)};
+            assert(prev->first + prev->second <= offset, "RangeAllocator: double free");
+            if (prev->first + prev->second == offset) {
+                offset = prev->first;
+                count += prev->second;
+                Erase(prev);
+            }
+        }
+        if (next != m_ByOffset.end() && offset + count == next->first) {
+            count += next->second;
+            Erase(next);
+        }
+        Insert(offset, count);
+    }
+
+    [[nodiscard]] U32 Capacity() const { return m_Capacity; }
+    [[nodiscard]] U32 FreeCount() const { return m_FreeCount; }
+    [[nodiscard]] U32 FreeRanges() const { return static_cast<U32>(m_ByOffset.size()); }
+    [[nodiscard]] U32 LargestFree() const { return m_BySize.empty() ? 0u : std::prev(m_BySize.end())->first; }
+
+private:
+    void Insert(U32 offset, U32 count) {
+        m_ByOffset.emplace(offset, count);
+        m_BySize.emplace(count, offset);
+    }
+
+    void Erase(std::map<U32, U32>::iterator it) {
+        auto [first, last]{m_BySize.equal_range(it->second)};
+        for (; first != last; ++first) {
+            if (first->second == it->first) { m_BySize.erase(first); break; }
+        }
+        m_ByOffset.erase(it);
+    }
+
+    U32 m_Capacity;
+    U32 m_FreeCount{m_Capacity};
+    std::map<U32, U32> m_ByOffset{};       // offset -> count
+    std::multimap<U32, U32> m_BySize{};    // count -> offset
+};
+
+// Byte ring over a persistently mapped upload buffer. Everything allocated between two Retire
+// calls is tagged with that fence value and becomes reusable once Release sees the fence
+// complete. An allocation never wraps; the tail end is skipped instead.
+export class StagingRing {
+public:
+    explicit StagingRing(U64 size = 0) : m_Size{size} {}
+
+    [[nodiscard]] std::optional<U64> Allocate(U64 bytes, U64 align = 16) {
+        if (bytes == 0 || bytes > m_Size) return std::nullopt;
+        if (m_Used == 0) {
+            m_Head = 0;
+            m_Tail = 0;
+        }
+
+        const bool wrapped{m_Head < m_Tail || (m_Head == m_Tail && m_Used > 0)};
+        U64 start{(m_Head + align - 1) / align * align};
+        U64 consumed{};
+        if (wrapped) {
+            if (start + bytes > m_Tail) return std::nullopt;
+            consumed = start + bytes - m_Head;
+        } else if (start + bytes <= m_Size) {
+            consumed = start + bytes - m_Head;
+        } else if (bytes <= m_Tail) {
+            start = 0;
+            consumed = m_Size - m_Head + bytes;
+        } else {
+            return std::nullopt;
+        }
+
+        m_Head = start + bytes;
+        m_Used += consumed;
+        m_Unretired += consumed;
+        return start;
+    }
+
+    // Tags everything allocated since the previous Retire with fence.
+    void Retire(U64 fence) {
+        if (m_Unretired == 0) return;
+        m_InFlight.push_back(Span{fence, m_Unretired, m_Head});
+        m_Unretired = 0;
+    }
+
+    void Release(U64 completedFence) {
+        while (!m_InFlight.empty() && m_InFlight.front().fence <= completedFence) {
+            m_Used -= m_InFlight.front().bytes;
+            m_Tail = m_InFlight.front().end;
+            m_InFlight.pop_front();
+        }
+    }
+
+    [[nodiscard]] U64 Size() const { return m_Size; }
+    [[nodiscard]] U64 Used() const { return m_Used; }
+
+private:
+    struct Span {
+        U64 fence;
+        U64 bytes;
+        U64 end;
+    };
+
+    U64 m_Size;
+    U64 m_Head{0};
+    U64 m_Tail{0};
+    U64 m_Used{0};
+    U64 m_Unretired{0};
+    std::deque<Span> m_InFlight{};
+};
+
+export enum class MeshHeapKind : U8 { Vertex, Index };
+
+// One staging-to-heap copy, in bytes.
+export struct MeshCopy {
+    U32 heap{};
+    MeshHeapKind kind{};
+    U64 srcOffset{};
+    U64 dstOffset{};
+    U64 size{};
+};
+
+// The graphics API side of MeshArena. Heaps are device-local buffers whose handles work with
+// IGraphicsContext::SetVertexBuffer and SetIndexBuffer.
+export class IMeshArenaBackend {
+public:
+    virtual ~IMeshArenaBackend() = default;
+    virtual U32 CreateHeap(MeshHeapKind kind, U64 bytes) = 0;
+    // Upload memory that stays mapped for the lifetime of the backend; called once.
+    virtual std::span<std::byte> CreateStaging(U64 bytes) = 0;
+    // Records the frame's copies so they execute before the frame's draws.
+    virtual void RecordCopies(std::span<const MeshCopy> copies) = 0;
+    // Fence value the GPU reaches once everything submitted up to the end of this frame is done.
+    [[nodiscard]] virtual U64 FrameFence() const = 0;
+    [[nodiscard]] virtual U64 CompletedFence() const = 0;
+};
+
+// Vertex range and index range of one mesh in a heap page. Draw it with the page's heaps bound,
+// DrawIndexed(indexCount, 1, firstIndex, firstVertex).
+export struct MeshAllocation {
+    U32 page{INVALID_INDEX};
+    U32 firstVertex{};
+    U32 vertexCount{};
+    U32 firstIndex{};
+    U32 indexCount{};
+
+    [[nodiscard]] bool Valid() const { return page != INVALID_INDEX; }
+};
+
+export struct MeshArenaConfig {
+    U32 vertexStride{8};
+    U32 pageVertices{1u << 22};     // 32 MiB of 8-byte vertices
+    U32 pageIndices{1u << 23};      // 32 MiB of indices
+    U64 stagingBytes{32ull << 20};
+};
+
+export struct MeshArenaStats {
+    U32 pages{};
+    U64 heapBytes{};          // device memory of all pages
+    U64 usedBytes{};          // live allocations
+    U64 pendingFreeBytes{};   // freed, waiting for the GPU
+    U64 stagingBytes{};       // staging ring in use
+    U64 uploads{};
+    U64 stalls{};             // uploads refused because the staging ring was full
+};
+
+// Mesh memory in a few large vertex/index heap pages instead of a committed buffer per mesh.
+// Upload sub-allocates a range in each heap of one page and writes the data to the staging
+// ring; EndFrame hands the frame's copies to the backend in one batch. Free is deferred until
+// the GPU has passed the frame it was called in, and staging space is reused the same way, so
+// nothing ever waits on the GPU.
+export class MeshArena {
+public:
+    explicit MeshArena(IMeshArenaBackend& backend, MeshArenaConfig const& config = {})
+        : m_Backend{&backend}, m_Config{config}, m_Ring{config.stagingBytes} {
+        assert(config.vertexStride > 0, "MeshArena: zero vertex stride");
+        m_Staging = m_Backend->CreateStaging(config.stagingBytes);
+        assert(m_Staging.size() >= config.stagingBytes, "MeshArena: staging buffer too small");
+    }
+
+    MeshArena(MeshArena const&) = delete;
+    MeshArena& operator=(MeshArena const&) = delete;
+
+    // Returns nullopt when the staging ring has no room this frame; retry next frame. An empty
+    // mesh gets an invalid allocation.
+    [[nodiscard]] std::optional<MeshAllocation> Upload(void const* vertices, U32 vertexCount, U32 const* indices, U32 indexCount) {
+        if (vertexCount == 0) return MeshAllocation{};
+
+        const U64 vbytes{static_cast<U64>(vertexCount) * m_Config.vertexStride};
+        const U64 ibytes{static_cast<U64>(indexCount) * sizeof(U32)};
+        const U64 ioffset{(vbytes + 15) / 16 * 16};
+        assert(ioffset + ibytes <= m_Ring.Size(), "MeshArena: mesh larger than the staging ring");
+
+        std::lock_guard lock{m_Mutex};
+        std::optional<U64> staging{m_Ring.Allocate(ioffset + ibytes)};
+        if (!staging) {
+            CollectLocked();
+            staging = m_Ring.Allocate(ioffset + ibytes);
+        }
+        if (!staging) {
+            ++m_Stalls;
+            return std::nullopt;
+        }
+
+        MeshAllocation a{AllocateRanges(vertexCount, indexCount)};
+        Page const& page{m_Pages[a.page]};
+        std::memcpy(m_Staging.data() + *staging, vertices, vbytes);
+        m_Copies.push_back(MeshCopy{page.vertexHeap, MeshHeapKind::Vertex, *staging,
+                                    static_cast<U64>(a.firstVertex) * m_Config.vertexStride, vbytes});
+        if (ibytes) {
+            std::memcpy(m_Staging.data() + *staging + ioffset, indices, ibytes);
+            m_Copies.push_back(MeshCopy{page.indexHeap, MeshHeapKind::Index, *staging + ioffset,
+                                        static_cast<U64>(a.firstIndex) * sizeof(U32), ibytes});
+        }
+        ++m_Uploads;
+        return a;
+    }
+
+    void Free(MeshAllocation const& allocation) {
+        if (!allocation.Valid()) return;
+        std::lock_guard lock{m_Mutex};
+        m_PendingFrees.push_back(PendingFree{m_Backend->FrameFence(), allocation});
+        m_PendingFreeBytes += AllocationBytes(allocation);
+    }
+
+    // Reclaims staging space and frees whose fence has completed.
+    void BeginFrame() {
+        std::lock_guard lock{m_Mutex};
+        CollectLocked();
+    }
+
+    // Records the frame's copies and tags this frame's staging space with the frame fence.
+    void EndFrame() {
+        std::lock_guard lock{m_Mutex};
+        if (!m_Copies.empty()) {
+            m_Backend->RecordCopies(m_Copies);
+            m_Copies.clear();
+        }
+        m_Ring.Retire(m_Backend->FrameFence());
+    }
+
+    [[nodiscard]] U32 PageCount() const {
+        std::lock_guard lock{m_Mutex};
+        return static_cast<U32>(m_Pages.size());
+    }
+
+    [[nodiscard]] U32 VertexHeap(U32 page) const {
+        std::lock_guard lock{m_Mutex};
+        assert(page < m_Pages.size(), "MeshArena: invalid page");
+        return m_Pages[page].vertexHeap;
+    }
+
+    [[nodiscard]] U32 IndexHeap(U32 page) const {
+        std::lock_guard lock{m_Mutex};
+        assert(page < m_Pages.size(), "MeshArena: invalid page");
+        return m_Pages[page].indexHeap;
+    }
+
+    [[nodiscard]] U32 VertexStride() const { return m_Config.vertexStride; }
+
+    [[nodiscard]] MeshArenaStats GetStats() const {
+        std::lock_guard lock{m_Mutex};
+        MeshArenaStats s{};
+        s.pages = static_cast<U32>(m_Pages.size());
+        for (Page const& p : m_Pages) {
+            s.heapBytes += static_cast<U64>(p.vertices.Capacity()) * m_Config.vertexStride
+                         + static_cast<U64>(p.indices.Capacity()) * sizeof(U32);
+            s.usedBytes += static_cast<U64>(p.vertices.Capacity() - p.vertices.FreeCount()) * m_Config.vertexStride
+                         + static_cast<U64>(p.indices.Capacity() - p.indices.FreeCount()) * sizeof(U32);
+        }
+        s.pendingFreeBytes = m_PendingFreeBytes;
+        s.usedBytes -= m_PendingFreeBytes;
+        s.stagingBytes = m_Ring.Used();
+        s.uploads = m_Uploads;
+        s.stalls = m_Stalls;
+        return s;
+    }
+
+private:
+    struct Page {
+        U32 vertexHeap;
+        U32 indexHeap;
+        RangeAllocator vertices;
+        RangeAllocator indices;
+    };
+
+    struct PendingFree {
+        U64 fence;
+        MeshAllocation allocation;
+    };
+
+    // First page with room for both ranges; a new page otherwise, sized up for oversized meshes.
+    MeshAllocation AllocateRanges(U32 vertexCount, U32 indexCount) {
+        for (U32 i{}; i < m_Pages.size(); ++i) {
+            if (auto a{TryPage(i, vertexCount, indexCount)}) return *a;
+        }
+        const U32 pv{std::max(m_Config.pageVertices, vertexCount)};
+        const U32 pi{std::max(m_Config.pageIndices, std::max(indexCount, 1u))};
+        m_Pages.push_back(Page{
+            m_Backend->CreateHeap(MeshHeapKind::Vertex, static_cast<U64>(pv) * m_Config.vertexStride),
+            m_Backend->CreateHeap(MeshHeapKind::Index, static_cast<U64>(pi) * sizeof(U32)),
+            RangeAllocator{pv}, RangeAllocator{pi}});
+        auto a{TryPage(static_cast<U32>(m_Pages.size() - 1), vertexCount, indexCount)};
+        assert(a.has_value(), "MeshArena: fresh page cannot hold the mesh");
+        return *a;
+    }
+
+    std::optional<MeshAllocation> TryPage(U32 page, U32 vertexCount, U32 indexCount) {
+        Page& p{m_Pages[page]};
+        auto v{p.vertices.Allocate(vertexCount)};
+        if (!v) return std::nullopt;
+        U32 firstIndex{0};
+        if (indexCount) {
+            auto i{p.indices.Allocate(indexCount)};
+            if (!i) {
+                p.vertices.Free(*v, vertexCount);
+                return std::nullopt;
+            }
+            firstIndex = *i;
+        }
+        return MeshAllocation{page, *v, vertexCount, firstIndex, indexCount};
+    }
+
+    void CollectLocked() {
+        const U64 completed{m_Backend->CompletedFence()};
+        m_Ring.Release(completed);
+        while (!m_PendingFrees.empty() && m_PendingFrees.front().fence <= completed) {
+            MeshAllocation const& a{m_PendingFrees.front().allocation};
+            Page& p{m_Pages[a.page]};
+            p.vertices.Free(a.firstVertex, a.vertexCount);
+            p.indices.Free(a.firstIndex, a.indexCount);
+            m_PendingFreeBytes -= AllocationBytes(a);
+            m_PendingFrees.pop_front();
+        }
+    }
+
+    [[nodiscard]] U64 AllocationBytes(MeshAllocation const& a) const {
+        return static_cast<U64>(a.vertexCount) * m_Config.vertexStride + static_cast<U64>(a.indexCount) * sizeof(U32);
+    }
+
+    IMeshArenaBackend* m_Backend;
+    MeshArenaConfig m_Config;
+    std::span<std::byte> m_Staging{};
+    StagingRing m_Ring;
+    Vector<Page> m_Pages{};
+    Vector<MeshCopy> m_Copies{};
+    std::deque<PendingFree> m_PendingFrees{};
+    U64 m_PendingFreeBytes{0};
+    U64 m_Uploads{0};
+    U64 m_Stalls{0};
+    mutable std::mutex m_Mutex{};
+};
@@ -0,0 +1,183 @@
+export module Graphics.Null.GraphicsContext;
+
+import Graphics;
+import Graphics.MeshArena;
+import Core.Types;
+import Core.Assert;
+import std;
+
+export struct NullGraphicsStats {
+    U64 frames{};
+    U32 vertexBuffers{};
+    U32 indexBuffers{};
+    U32 constantBuffers{};
+    U32 textures{};
+    U32 pipelines{};
+    U32 meshHeaps{};
+    U64 bytesUploaded{};     // buffer and texture data, including mesh arena copies
+    U64 meshCopies{};
+    U64 objectConstants{};   // SetObjectConstants calls
+    U64 drawCalls{};
+    U64 drawnVertices{};
+    U64 drawnIndices{};
+};
+
+// IGraphicsContext without a device or a window: resources are handles, uploads and draws are
+// only counted. The mesh arena runs against it with a GPU that finishes every frame at
+// EndFrame, so the streaming, meshing and upload systems run unchanged in headless tools.
+export class NullGraphicsContext : public IGraphicsContext, private IMeshArenaBackend {
+public:
+    explicit NullGraphicsContext(MeshArenaConfig const& arenaConfig = {}) {
+        m_MeshArena = std::make_unique<MeshArena>(static_cast<IMeshArenaBackend&>(*this), arenaConfig);
+    }
+
+    ~NullGraphicsContext() override {
+        m_MeshArena.reset();
+    }
+
+    U32 CreateVertexBuffer(const void*, U64 size) override {
+        std::lock_guard lock{m_Mutex};
+        m_Stats.bytesUploaded += size;
+        ++m_Stats.vertexBuffers;
+        return m_NextVertexBuffer++;
+    }
+
+    U32 CreateIndexBuffer(const void*, U64 size) override {
+        std::lock_guard lock{m_Mutex};
+        m_Stats.bytesUploaded += size;
+        ++m_Stats.indexBuffers;
+        return m_NextIndexBuffer++;
+    }
+
+    void UpdateVertexBuffer(U32 buffer, const void*, U64 size, U64) override {
+        std::lock_guard lock{m_Mutex};
+        assert(buffer < m_NextVertexBuffer, "invalid vertex buffer handle");
+        m_Stats.bytesUploaded += size;
+    }
+
+    void UpdateIndexBuffer(U32 buffer, const void*, U64 size, U64) override {
+        std::lock_guard lock{m_Mutex};
+        assert(buffer < m_NextIndexBuffer, "invalid index buffer handle");
+        m_Stats.bytesUploaded += size;
+    }
+
+    U32 CreateGraphicsPipeline(const GraphicsPipelineCreateInfo&) override {
+        std::lock_guard lock{m_Mutex};
+        return m_Stats.pipelines++;
+    }
+
+    U32 CreateConstantBuffer(U64) override {
+        std::lock_guard lock{m_Mutex};
+        return m_Stats.constantBuffers++;
+    }
+
+    void UpdateConstantBuffer(U32 buffer, const void*, U64 size) override {
+        std::lock_guard lock{m_Mutex};
+        assert(buffer < m_Stats.constantBuffers, "invalid constant buffer handle");
+        m_Stats.bytesUploaded += size;
+    }
+
+    U32 CreateTexture2D(const void*, U32 width, U32 height, U32) override {
+        std::lock_guard lock{m_Mutex};
+        m_Stats.bytesUploaded += static_cast<U64>(width) * height * 4u;
+        return m_Stats.textures++;
+    }
+
+    void SetTexture(U32, U32) override {}
+
+    void BeginFrame() override {
+        m_MeshArena->BeginFrame();
+    }
+
+    void EndFrame() override {
+        assert(!m_InRenderPass, "Frame ended inside a render pass");
+        m_MeshArena->EndFrame();
+        std::lock_guard lock{m_Mutex};
+        m_CompletedFence = m_FrameFence++;
+        ++m_Stats.frames;
+    }
+
+    void BeginRenderPass(const RenderPassInfo&) override {
+        assert(!m_InRenderPass, "Already in render pass");
+        m_InRenderPass = true;
+    }
+
+    void EndRenderPass() override {
+        assert(m_InRenderPass, "Not in render pass");
+        m_InRenderPass = false;
+    }
+
+    void SetPipeline(U32) override {}
+    void SetVertexBuffer(U32) override {}
+    void SetIndexBuffer(U32) override {}
+    void SetConstantBuffer(U32, U32) override {}
+
+    void SetObjectConstants(const void*, U32 size) override {
+        assert(m_InRenderPass, "Must be in render pass");
+        assert(size > 0 && size <= 64, "object constants must fit the root constants");
+        std::lock_guard lock{m_Mutex};
+        ++m_Stats.objectConstants;
+    }
+
+    void Draw(U32 vertexCount, U32 instanceCount, U32, U32) override {
+        std::lock_guard lock{m_Mutex};
+        ++m_Stats.drawCalls;
+        m_Stats.drawnVertices += static_cast<U64>(vertexCount) * instanceCount;
+    }
+
+    void DrawIndexed(U32 indexCount, U32 instanceCount, U32, S32, U32) override {
+        std::lock_guard lock{m_Mutex};
+        ++m_Stats.drawCalls;
+        m_Stats.drawnIndices += static_cast<U64>(indexCount) * instanceCount;
+    }
+
+    void OnResize(U32, U32) override {}
+
+    [[nodiscard]] bool ShouldClose() const override { return false; }
+
+    [[nodiscard]] MeshArena& GetMeshArena() override { return *m_MeshArena; }
+
+    [[nodiscard]] NullGraphicsStats GetStats() const {
+        std::lock_guard lock{m_Mutex};
+        return m_Stats;
+    }
+
+private:
+    // Heaps are vertex and index buffers like any other, as on DX12.
+    U32 CreateHeap(MeshHeapKind kind, U64) override {
+        std::lock_guard lock{m_Mutex};
+        ++m_Stats.meshHeaps;
+        return kind == MeshHeapKind::Vertex ? m_NextVertexBuffer++ : m_NextIndexBuffer++;
+    }
+
+    std::span<std::byte> CreateStaging(U64 bytes) override {
+        m_Staging.resize(static_cast<USize>(bytes));
+        return m_Staging;
+    }
+
+    void RecordCopies(std::span<const MeshCopy> copies) override {
+        std::lock_guard lock{m_Mutex};
+        for (MeshCopy const& c : copies) m_Stats.bytesUploaded += c.size;
+        m_Stats.meshCopies += copies.size();
+    }
+
+    U64 FrameFence() const override {
+        std::lock_guard lock{m_Mutex};
+        return m_FrameFence;
+    }
+
+    U64 CompletedFence() const override {
+        std::lock_guard lock{m_Mutex};
+        return m_CompletedFence;
+    }
+
+    mutable std::mutex m_Mutex{};
+    NullGraphicsStats m_Stats{};
+    Vector<std::byte> m_Staging{};
+    U32 m_NextVertexBuffer{0};
+    U32 m_NextIndexBuffer{0};
+    U64 m_FrameFence{1};
+    U64 m_CompletedFence{0};
+    bool m_InRenderPass{false};
+    std::unique_ptr<MeshArena> m_MeshArena{};
+};
@@ -0,0 +1,358 @@
+module;
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VOXEL_TARGET_AVX __attribute__((target("avx")))
+#else
+#define VOXEL_TARGET_AVX
+#endif
+
+export module Math.Culling;
+
+import Core.Types;
+import Core.Assert;
+import Math.Vector;
+import Math.Transform;
+import std;
+
+export namespace Math {
+    enum class CullKernel : U8 {
+        Scalar,
+        SSE,
+        AVX
+    };
+
+    // Axis-aligned boxes in structure-of-arrays form, stored as centers and half extents so
+    // the plane test matches Frustum::Intersects bit for bit. The arrays are padded to a
+    // multiple of 8 so the kernels never need a scalar tail.
+    class BoundsSoA {
+    public:
+        static constexpr U32 Lanes = 8;
+
+        void Clear() { m_Count = 0; }
+
+        void Reserve(U32 count) {
+            const USize padded = Padded(count);
+            for (auto* a : {&m_CX, &m_CY, &m_CZ, &m_EX, &m_EY, &m_EZ}) a->reserve(padded);
+        }
+
+        U32 Add(const Bounds &bounds) {
+            const U32 index = m_Count++;
+            if (m_CX.size() < Padded(m_Count)) {
+                for (auto* a : {&m_CX, &m_CY, &m_CZ, &m_EX, &m_EY, &m_EZ}) a->resize(Padded(m_Count), 0.0f);
+            }
+            Set(index, bounds);
+            return index;
+        }
+
+        void Set(U32 index, const Bounds &bounds) {
+            assert(index < m_Count, "Bounds index out of range");
+            const Vec3 center = bounds.Center();
+            const Vec3 extents = bounds.Extents();
+            m_CX[index] = center.x; m_CY[index] = center.y; m_CZ[index] = center.z;
+            m_EX[index] = extents.x; m_EY[index] = extents.y; m_EZ[index] = extents.z;
+        }
+
+        // Moves the last box into index and drops the last slot. Returns the slot the moved box
+        // came from, which is index itself when it was the last.
+        U32 RemoveSwap(U32 index) {
+            assert(index < m_Count, "Bounds index out of range");
+            const U32 last = --m_Count;
+            if (index != last) {
+                for (auto* a : {&m_CX, &m_CY, &m_CZ, &m_EX, &m_EY, &m_EZ}) (*a)[index] = (*a)[last];
+            }
+            return last;
+        }
+
+        [[nodiscard]] U32 Size() const { return m_Count; }
+        [[nodiscard]] Vec3 Center(U32 index) const { return Vec3{m_CX[index], m_CY[index], m_CZ[index]}; }
+        [[nodiscard]] Vec3 Extents(U32 index) const { return Vec3{m_EX[index], m_EY[index], m_EZ[index]}; }
+
+        [[nodiscard]] const F32* CX() const { return m_CX.data(); }
+        [[nodiscard]] const F32* CY() const { return m_CY.data(); }
+        [[nodiscard]] const F32* CZ() const { return m_CZ.data(); }
+        [[nodiscard]] const F32* EX() const { return m_EX.data(); }
+        [[nodiscard]] const F32* EY() const { return m_EY.data(); }
+        [[nodiscard]] const F32* EZ() const { return m_EZ.data(); }
+
+    private:
+        static USize Padded(U32 count) { return (static_cast<USize>(count) + Lanes - 1) / Lanes * Lanes; }
+
+        Vector<F32> m_CX, m_CY, m_CZ;
+        Vector<F32> m_EX, m_EY, m_EZ;
+        U32 m_Count = 0;
+    };
+
+    // Every test is optional. The distance band and view cone are measured from eye to the
+    // box centers: minDistance <= |c - eye| <= maxDistance, and the cosine between coneDir
+    // (unit length) and c - eye at least coneMinCos; a center at the eye counts as cosine 1.
+    struct CullQuery {
+        const Frustum* frustum = nullptr;
+        Vec3 eye{};
+        F32 minDistance = 0.0f;
+        F32 maxDistance = std::numeric_limits<F32>::infinity();
+        Vec3 coneDir{};
+        F32 coneMinCos = -2.0f;
+    };
+
+    // Indices of the boxes that passed, in increasing order. distanceSq and cosine are only
+    // filled when the query used a band or a cone, one entry per index.
+    struct CullResult {
+        Vector<U32> indices;
+        Vector<F32> distanceSq;
+        Vector<F32> cosine;
+    };
+}
+
+namespace Math::cull {
+    struct Params {
+        bool frustum;
+        bool metrics;
+        F32 planeN[6][3];
+        F32 planeAbsN[6][3];
+        F32 planeD[6];
+        F32 eye[3];
+        F32 minD2;
+        F32 maxD2;
+        F32 dir[3];
+        F32 minCos;
+    };
+
+    struct Output {
+        U32* indices;
+        F32* distanceSq;
+        F32* cosine;
+    };
+
+    Params MakeParams(const CullQuery &query) {
+        Params p{};
+        p.frustum = query.frustum != nullptr;
+        if (p.frustum) {
+            for (U32 i = 0; i < 6; ++i) {
+                const Plane &plane = query.frustum->planes[i];
+                p.planeN[i][0] = plane.normal.x; p.planeN[i][1] = plane.normal.y; p.planeN[i][2] = plane.normal.z;
+                p.planeAbsN[i][0] = std::abs(plane.normal.x);
+                p.planeAbsN[i][1] = std::abs(plane.normal.y);
+                p.planeAbsN[i][2] = std::abs(plane.normal.z);
+                p.planeD[i] = plane.distance;
+            }
+        }
+        const bool band = query.minDistance > 0.0f || query.maxDistance < std::numeric_limits<F32>::infinity();
+        const bool cone = query.coneMinCos > -1.0f;
+        p.metrics = band || cone;
+        p.eye[0] = query.eye.x; p.eye[1] = query.eye.y; p.eye[2] = query.eye.z;
+        p.minD2 = query.minDistance > 0.0f ? query.minDistance * query.minDistance : -1.0f;
+        p.maxD2 = query.maxDistance * query.maxDistance;
+        p.dir[0] = query.coneDir.x; p.dir[1] = query.coneDir.y; p.dir[2] = query.coneDir.z;
+        p.minCos = cone ? query.coneMinCos : -2.0f;
+        return p;
+    }
+
+    U32 RunScalar(const Params &p, const BoundsSoA &b, U32 end, Output out) {
+        U32 n = 0;
+        for (U32 i = 0; i < end; ++i) {
+            const F32 cx = b.CX()[i], cy = b.CY()[i], cz = b.CZ()[i];
+            bool inside = true;
+            if (p.frustum) {
+                for (U32 k = 0; k < 6 && inside; ++k) {
+                    const F32 r = b.EX()[i] * p.planeAbsN[k][0] + b.EY()[i] * p.planeAbsN[k][1] + b.EZ()[i] * p.planeAbsN[k][2];
+                    const F32 dist = cx * p.planeN[k][0] + cy * p.planeN[k][1] + cz * p.planeN[k][2] - p.planeD[k];
+                    inside = !(dist < -r);
+                }
+            }
+            if (!inside) continue;
+            if (p.metrics) {
+                const F32 tx = cx - p.eye[0], ty = cy - p.eye[1], tz = cz - p.eye[2];
+                const F32 d2 = tx * tx + ty * ty + tz * tz;
+                const F32 cosA = d2 > 1e-6f ? (p.dir[0] * tx + p.dir[1] * ty + p.dir[2] * tz) / std::sqrt(d2) : 1.0f;
+                if (d2 < p.minD2 || d2 > p.maxD2 || cosA < p.minCos) continue;
+                out.distanceSq[n] = d2;
+                out.cosine[n] = cosA;
+            }
+            out.indices[n++] = i;
+        }
+        return n;
+    }
+
+    // Appends the set lanes of mask, plus their metrics when the query has any.
+    inline U32 Emit(U32 mask, U32 base, const F32* d2, const F32* cosA, bool metrics, Output out, U32 n) {
+        while (mask) {
+            const U32 lane = static_cast<U32>(std::countr_zero(mask));
+            mask &= mask - 1;
+            if (metrics) {
+                out.distanceSq[n] = d2[lane];
+                out.cosine[n] = cosA[lane];
+            }
+            out.indices[n++] = base + lane;
+        }
+        return n;
+    }
+
+    U32 RunSSE(const Params &p, const BoundsSoA &b, U32 end, Output out) {
+        U32 n = 0;
+        alignas(16) F32 d2s[4]{}, coss[4]{};
+        for (U32 i = 0; i < end; i += 4) {
+            const __m128 cx = _mm_loadu_ps(b.CX() + i), cy = _mm_loadu_ps(b.CY() + i), cz = _mm_loadu_ps(b.CZ() + i);
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            if (p.frustum) {
+                const __m128 ex = _mm_loadu_ps(b.EX() + i), ey = _mm_loadu_ps(b.EY() + i), ez = _mm_loadu_ps(b.EZ() + i);
+                for (U32 k = 0; k < 6; ++k) {
+                    const __m128 r = _mm_add_ps(_mm_add_ps(
+                        _mm_mul_ps(ex, _mm_set1_ps(p.planeAbsN[k][0])),
+                        _mm_mul_ps(ey, _mm_set1_ps(p.planeAbsN[k][1]))),
+                        _mm_mul_ps(ez, _mm_set1_ps(p.planeAbsN[k][2])));
+                    const __m128 dist = _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+                        _mm_mul_ps(cx, _mm_set1_ps(p.planeN[k][0])),
+                        _mm_mul_ps(cy, _mm_set1_ps(p.planeN[k][1]))),
+                        _mm_mul_ps(cz, _mm_set1_ps(p.planeN[k][2]))),
+                        _mm_set1_ps(p.planeD[k]));
+                    inside = _mm_and_ps(inside, _mm_cmpnlt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), r)));
+                }
+            }
+            U32 mask = static_cast<U32>(_mm_movemask_ps(inside));
+            if (!mask) continue;
+            if (p.metrics) {
+                const __m128 tx = _mm_sub_ps(cx, _mm_set1_ps(p.eye[0]));
+                const __m128 ty = _mm_sub_ps(cy, _mm_set1_ps(p.eye[1]));
+                const __m128 tz = _mm_sub_ps(cz, _mm_set1_ps(p.eye[2]));
+                const __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz));
+                const __m128 dot = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(p.dir[0]), tx), _mm_mul_ps(_mm_set1_ps(p.dir[1]), ty)),
+                    _mm_mul_ps(_mm_set1_ps(p.dir[2]), tz));
+                const __m128 far = _mm_cmpgt_ps(d2, _mm_set1_ps(1e-6f));
+                const __m128 cosA = _mm_or_ps(_mm_and_ps(far, _mm_div_ps(dot, _mm_sqrt_ps(d2))),
+                                              _mm_andnot_ps(far, _mm_set1_ps(1.0f)));
+                const __m128 keep = _mm_and_ps(_mm_and_ps(
+                    _mm_cmpnlt_ps(d2, _mm_set1_ps(p.minD2)), _mm_cmpnlt_ps(_mm_set1_ps(p.maxD2), d2)),
+                    _mm_cmpnlt_ps(cosA, _mm_set1_ps(p.minCos)));
+                mask &= static_cast<U32>(_mm_movemask_ps(keep));
+                _mm_store_ps(d2s, d2);
+                _mm_store_ps(coss, cosA);
+            }
+            n = Emit(mask, i, d2s, coss, p.metrics, out, n);
+        }
+        return n;
+    }
+
+    VOXEL_TARGET_AVX U32 RunAVX(const Params &p, const BoundsSoA &b, U32 end, Output out) {
+        U32 n = 0;
+        alignas(32) F32 d2s[8]{}, coss[8]{};
+        for (U32 i = 0; i < end; i += 8) {
+            const __m256 cx = _mm256_loadu_ps(b.CX() + i), cy = _mm256_loadu_ps(b.CY() + i), cz = _mm256_loadu_ps(b.CZ() + i);
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            if (p.frustum) {
+                const __m256 ex = _mm256_loadu_ps(b.EX() + i), ey = _mm256_loadu_ps(b.EY() + i), ez = _mm256_loadu_ps(b.EZ() + i);
+                for (U32 k = 0; k < 6; ++k) {
+                    const __m256 r = _mm256_add_ps(_mm256_add_ps(
+                        _mm256_mul_ps(ex, _mm256_set1_ps(p.planeAbsN[k][0])),
+                        _mm256_mul_ps(ey, _mm256_set1_ps(p.planeAbsN[k][1]))),
+                        _mm256_mul_ps(ez, _mm256_set1_ps(p.planeAbsN[k][2])));
+                    const __m256 dist = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(
+                        _mm256_mul_ps(cx, _mm256_set1_ps(p.planeN[k][0])),
+                        _mm256_mul_ps(cy, _mm256_set1_ps(p.planeN[k][1]))),
+                        _mm256_mul_ps(cz, _mm256_set1_ps(p.planeN[k][2]))),
+                        _mm256_set1_ps(p.planeD[k]));
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, _mm256_sub_ps(_mm256_setzero_ps(), r), _CMP_NLT_UQ));
+                }
+            }
+            U32 mask = static_cast<U32>(_mm256_movemask_ps(inside));
+            if (!mask) continue;
+            if (p.metrics) {
+                const __m256 tx = _mm256_sub_ps(cx, _mm256_set1_ps(p.eye[0]));
+                const __m256 ty = _mm256_sub_ps(cy, _mm256_set1_ps(p.eye[1]));
+                const __m256 tz = _mm256_sub_ps(cz, _mm256_set1_ps(p.eye[2]));
+                const __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, tx), _mm256_mul_ps(ty, ty)), _mm256_mul_ps(tz, tz));
+                const __m256 dot = _mm256_add_ps(_mm256_add_ps(
+                    _mm256_mul_ps(_mm256_set1_ps(p.dir[0]), tx), _mm256_mul_ps(_mm256_set1_ps(p.dir[1]), ty)),
+                    _mm256_mul_ps(_mm256_set1_ps(p.dir[2]), tz));
+                const __m256 far = _mm256_cmp_ps(d2, _mm256_set1_ps(1e-6f), _CMP_GT_OQ);
+                const __m256 cosA = _mm256_blendv_ps(_mm256_set1_ps(1.0f), _mm256_div_ps(dot, _mm256_sqrt_ps(d2)), far);
+                const __m256 keep = _mm256_and_ps(_mm256_and_ps(
+                    _mm256_cmp_ps(d2, _mm256_set1_ps(p.minD2), _CMP_NLT_UQ),
+                    _mm256_cmp_ps(_mm256_set1_ps(p.maxD2), d2, _CMP_NLT_UQ)),
+                    _mm256_cmp_ps(cosA, _mm256_set1_ps(p.minCos), _CMP_NLT_UQ));
+                mask &= static_cast<U32>(_mm256_movemask_ps(keep));
+                _mm256_store_ps(d2s, d2);
+                _mm256_store_ps(coss, cosA);
+            }
+            n = Emit(mask, i, d2s, coss, p.metrics, out, n);
+        }
+        return n;
+    }
+
+    bool CpuSupports(CullKernel kernel) {
+        if (kernel != CullKernel::AVX) return true;
+#if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4]{};
+        __cpuid(regs, 1);
+        return (regs[2] & (1 << 27)) != 0 && (regs[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx");
+#endif
+    }
+
+    std::atomic<CullKernel> s_ActiveKernel{CpuSupports(CullKernel::AVX) ? CullKernel::AVX : CullKernel::SSE};
+}
+
+export namespace Math {
+    [[nodiscard]] bool IsCullKernelSupported(CullKernel kernel) { return cull::CpuSupports(kernel); }
+
+    // Picked once at startup from the CPU features; can be lowered for testing and benchmarks.
+    [[nodiscard]] CullKernel ActiveCullKernel() { return cull::s_ActiveKernel.load(std::memory_order_relaxed); }
+
+    void SetCullKernel(CullKernel kernel) {
+        assert(cull::CpuSupports(kernel), "Cull kernel not supported by this CPU");
+        cull::s_ActiveKernel.store(kernel, std::memory_order_relaxed);
+    }
+
+    // Tests every box of bounds in one pass; 4 (SSE) or 8 (AVX) boxes per plane test.
+    void Cull(CullKernel kernel, const CullQuery &query, const BoundsSoA &bounds, CullResult &result) {
+        const cull::Params params = cull::MakeParams(query);
+        const U32 count = bounds.Size();
+        // The SIMD kernels also test the padding lanes past count; those are dropped below.
+        const U32 lanes = kernel == CullKernel::AVX ? 8 : kernel == CullKernel::SSE ? 4 : 1;
+        const U32 body = (count + lanes - 1) / lanes * lanes;
+        result.indices.resize(body);
+        result.distanceSq.resize(params.metrics ? body : 0);
+        result.cosine.resize(params.metrics ? body : 0);
+        const cull::Output out{result.indices.data(), result.distanceSq.data(), result.cosine.data()};
+
+        U32 n = 0;
+        switch (kernel) {
+            case CullKernel::AVX: n = cull::RunAVX(params, bounds, body, out); break;
+            case CullKernel::SSE: n = cull::RunSSE(params, bounds, body, out); break;
+            default: n = cull::RunScalar(params, bounds, body, out); break;
+        }
+        while (n > 0 && result.indices[n - 1] >= count) --n;
+        result.indices.resize(n);
+        if (params.metrics) {
+            result.distanceSq.resize(n);
+            result.cosine.resize(n);
+        }
+    }
+
+    void Cull(const CullQuery &query, const BoundsSoA &bounds, CullResult &result) {
+        Cull(ActiveCullKernel(), query, bounds, result);
+    }
+
+    void CullFrustum(const Frustum &frustum, const BoundsSoA &bounds, CullResult &result) {
+        Cull(CullQuery{.frustum = &frustum}, bounds, result);
+    }
+
+    // Frustum plus a band of center distances, e.g. to split chunks into detail levels.
+    void CullFrustumBand(const Frustum &frustum, const Vec3 &eye, F32 minDistance, F32 maxDistance,
+                         const BoundsSoA &bounds, CullResult &result) {
+        Cull(CullQuery{.frustum = &frustum, .eye = eye, .minDistance = minDistance, .maxDistance = maxDistance},
+             bounds, result);
+    }
+
+    // Optional frustum plus a view cone around dir; distanceSq and cosine feed priority scores.
+    void CullViewCone(const Frustum* frustum, const Vec3 &eye, const Vec3 &dir, F32 minCos,
+                      const BoundsSoA &bounds, CullResult &result) {
+        Cull(CullQuery{.frustum = frustum, .eye = eye, .coneDir = dir, .coneMinCos = minCos}, bounds, result);
+    }
+}
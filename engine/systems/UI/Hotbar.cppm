@@ -2,6 +2,7 @@ export module Systems.Hotbar;
 
 import ECS.Component;
 import ECS.SystemScheduler;
+import ECS.CommandBuffer;
 import ECS.World;
 import Components.Voxel;
 import Input.Core;
@@ -51,6 +52,8 @@ public:
         SetStage(SystemStage::PreUpdate);
         SetPriority(SystemPriority::High);
         SetParallel(false);
+        ReadsComponents<VoxelAtlasInfo>();
+        WritesComponents<VoxelHotbarState>();
     }
 
     void SetUIManager(UIManager* ui) { m_UI = ui; }
@@ -132,7 +135,7 @@ private:
         if (m_Built) return;
 
         VoxelAtlasInfo const* ai{};
-        if (auto* s{world->GetStorage<VoxelAtlasInfo>()}) {
+        if (auto* s{std::as_const(*world).GetStorage<VoxelAtlasInfo>()}) {
             for (auto [h, c] : *s) { ai = &c; break; }
         }
         if (!ai || ai->texture == INVALID_INDEX) return;
@@ -235,8 +238,10 @@ private:
 
         auto* store{world->GetStorage<VoxelHotbarState>()};
         if (!store || store->Size() == 0) {
-            m_StateEntity = world->CreateEntity();
-            world->AddComponent(m_StateEntity, hb);
+            auto& cmd{Commands()};
+            auto e{cmd.CreateEntity()};
+            cmd.AddComponent(e, hb);
+            cmd.Defer(e, [this](World&, EntityHandle h) { m_StateEntity = h; });
         } else {
             for (auto [h, st] : *store) { m_StateEntity = h; break; }
             if (auto* st{world->GetComponent<VoxelHotbarState>(m_StateEntity)}) { *st = hb; }
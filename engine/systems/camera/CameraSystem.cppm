@@ -41,6 +41,7 @@ public:
         SetName("CameraLifecycle");
         SetStage(SystemStage::PreUpdate);
         SetPriority(SystemPriority::Critical);
+        ReadsComponents<Camera>();
     }
 
     void Configure(SystemScheduler& scheduler) override {
@@ -53,7 +54,7 @@ public:
             CameraManager::Clear();
         }
 
-        auto* storage = world->GetStorage<Camera>();
+        auto* storage = std::as_const(*world).GetStorage<Camera>();
         if (!storage) return;
 
         for (auto [handle, camera] : *storage) {
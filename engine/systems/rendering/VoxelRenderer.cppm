@@ -10,16 +10,20 @@ import ECS.SystemScheduler;
 import ECS.Query;
 import ECS.World;
 import Components.Voxel;
+import Components.VoxelDrawList;
 import Components.Camera;
 import Components.Transform;
 import Systems.CameraManager;
+import Systems.VoxelBufferPool;
 import Graphics;
 import Graphics.RenderData;
+import Graphics.MeshArena;
 import Core.Types;
 import Core.Assert;
 import Math.Vector;
 import Math.Matrix;
 import Math.Transform;
+import Math.Culling;
 import std;
 
 using Microsoft::WRL::ComPtr;
@@ -125,9 +129,9 @@ export class VoxelRendererSystem : public System<VoxelRendererSystem> {
 private:
     IGraphicsContext *m_Gfx{nullptr};
     U32 m_CameraCB{INVALID_INDEX};
-    U32 m_ObjectCB{INVALID_INDEX};
     U32 m_AtlasCB{INVALID_INDEX};
     U32 m_AtlasTex{INVALID_INDEX};
+    Math::CullResult m_DrawCull{};
 
 public:
     void Setup() {
@@ -135,6 +139,8 @@ public:
         SetStage(SystemStage::Render);
         SetPriority(SystemPriority::Normal);
         SetParallel(false);
+        ReadsComponents<VoxelChunk, VoxelMesh, VoxelDrawList, Camera, Transform, VoxelBufferPoolResource>();
+        WritesComponents<VoxelRenderResources, VoxelAtlasInfo, VoxelCullingStats, VoxelMemoryStats>();
     }
 
     void SetGraphicsContext(IGraphicsContext *gfx) {
@@ -152,8 +158,8 @@ public:
         ps.stage = ShaderStage::Pixel;
         GraphicsPipelineCreateInfo pi{};
         pi.shaders = {vs, ps};
-        pi.vertexAttributes = {{"POSITION", 0}, {"NORMAL", 12}, {"TEXCOORD", 24}, {"COLOR", 32}};
-        pi.vertexStride = sizeof(Vertex);
+        pi.vertexAttributes = {{"PACKED", 0}};
+        pi.vertexStride = sizeof(ChunkVertex);
         pi.topology = PrimitiveTopology::TriangleList;
         pi.depthTest = true;
         pi.depthWrite = true;
@@ -162,6 +168,7 @@ public:
 
     void Run(World *world, F32) override {
         assert(m_Gfx != nullptr, "GraphicsContext must be set");
+        World const *view{world};
 
         auto *rr{world->GetStorage<VoxelRenderResources>()};
         if (!rr || rr->Size() == 0) {
@@ -176,7 +183,6 @@ public:
         assert(res != nullptr && res->pipeline != INVALID_INDEX, "Invalid render resources");
 
         if (m_CameraCB == INVALID_INDEX) m_CameraCB = m_Gfx->CreateConstantBuffer(sizeof(CameraConstants));
-        if (m_ObjectCB == INVALID_INDEX) m_ObjectCB = m_Gfx->CreateConstantBuffer(sizeof(ObjectConstants));
         if (m_AtlasCB == INVALID_INDEX) m_AtlasCB = m_Gfx->CreateConstantBuffer(sizeof(AtlasConstants));
 
         if (m_AtlasTex == INVALID_INDEX) {
@@ -240,12 +246,12 @@ public:
 
         CameraConstants cam{};
         if (auto h{CameraManager::GetPrimaryCamera()}; h.valid()) {
-            if (auto *c{world->GetComponent<Camera>(h)}) {
+            if (auto *c{view->GetComponent<Camera>(h)}) {
                 cam.view = c->view;
                 cam.projection = c->projection;
                 cam.viewProjection = c->viewProjection;
             }
-            if (auto *t{world->GetComponent<Transform>(h)}) {
+            if (auto *t{view->GetComponent<Transform>(h)}) {
                 cam.cameraPosition = t->position;
             }
         }
@@ -254,20 +260,8 @@ public:
         Math::Frustum fr{};
         fr.SetFromMatrix(cam.viewProjection);
 
-        auto* wcfgStore{world->GetStorage<VoxelWorldConfig>()};
-        assert(wcfgStore && wcfgStore->Size() > 0, "Missing VoxelWorldConfig");
-        VoxelWorldConfig const* wcfg{};
-        for (auto [h, c] : *wcfgStore) { wcfg = &c; break; }
-        const F32 sx{wcfg->blockSize * static_cast<F32>(VoxelChunk::SizeX)};
-        const F32 sy{wcfg->blockSize * static_cast<F32>(VoxelChunk::SizeY)};
-        const F32 sz{wcfg->blockSize * static_cast<F32>(VoxelChunk::SizeZ)};
-
-        ObjectConstants obj{};
-        obj.world = Math::Mat4::Identity;
-        m_Gfx->UpdateConstantBuffer(m_ObjectCB, &obj, sizeof(obj));
-
-        auto *storage{world->GetStorage<VoxelMesh>()};
-        if (!storage) return;
+        VoxelDrawList const* draws{FindVoxelDrawList(view)};
+        if (!draws) return;
 
         auto* sStore{world->GetStorage<VoxelCullingStats>()};
         if (!sStore || sStore->Size() == 0) {
@@ -279,35 +273,75 @@ public:
 
         m_Gfx->SetPipeline(res->pipeline);
         m_Gfx->SetConstantBuffer(m_CameraCB, 0);
-        m_Gfx->SetConstantBuffer(m_ObjectCB, 1);
         m_Gfx->SetTexture(m_AtlasTex, 0);
         m_Gfx->SetConstantBuffer(m_AtlasCB, 2);
 
-        for (auto [handle, mesh]: *storage) {
-            if (mesh.vertexBuffer == INVALID_INDEX || mesh.vertexCount == 0) continue;
+        // The upload system keeps the list current, so culling is one pass over stored bounds.
+        Math::CullFrustum(fr, draws->Bounds(), m_DrawCull);
+        stats.tested = draws->Size();
+        stats.visible = static_cast<U32>(m_DrawCull.indices.size());
+        stats.culled = stats.tested - stats.visible;
+
+        // Meshes share a few arena pages; the heaps are only rebound when the page changes.
+        MeshArena& arena{m_Gfx->GetMeshArena()};
+        U32 boundPage{INVALID_INDEX};
+        for (U32 i : m_DrawCull.indices) {
+            VoxelDraw const& draw{draws->Draw(i)};
+            MeshAllocation const& gpu{draw.gpu};
+            const ObjectConstants obj{draw.world};
+            m_Gfx->SetObjectConstants(&obj, sizeof(obj));
+            if (gpu.page != boundPage) {
+                m_Gfx->SetVertexBuffer(arena.VertexHeap(gpu.page));
+                m_Gfx->SetIndexBuffer(arena.IndexHeap(gpu.page));
+                boundPage = gpu.page;
+            }
+            m_Gfx->DrawIndexed(gpu.indexCount, 1, gpu.firstIndex, static_cast<S32>(gpu.firstVertex));
+            stats.drawCalls++;
+            stats.drawnIndices += static_cast<U64>(gpu.indexCount);
+        }
 
-            auto* chunk{world->GetComponent<VoxelChunk>(handle)};
-            if (!chunk) continue;
+        for (auto [h, s] : *sStore) { world->AddOrReplaceComponent(h, stats); break; }
 
-            stats.tested++;
+        UpdateMemoryStats(world, arena);
+    }
 
-            Math::Bounds b{chunk->origin, chunk->origin + Math::Vec3{sx, sy, sz}};
-            if (!fr.Intersects(b)) { stats.culled++; continue; }
+private:
+    static void UpdateMemoryStats(World* world, MeshArena const& arena) {
+        auto* mStore{world->GetStorage<VoxelMemoryStats>()};
+        if (!mStore || mStore->Size() == 0) {
+            auto e{world->CreateEntity()};
+            world->AddComponent(e, VoxelMemoryStats{});
+            mStore = world->GetStorage<VoxelMemoryStats>();
+        }
 
-            stats.visible++;
-            m_Gfx->SetVertexBuffer(mesh.vertexBuffer);
-            if (mesh.indexBuffer != INVALID_INDEX && mesh.indexCount > 0) {
-                m_Gfx->SetIndexBuffer(mesh.indexBuffer);
-                m_Gfx->DrawIndexed(mesh.indexCount);
-                stats.drawCalls++;
-                stats.drawnIndices += static_cast<U64>(mesh.indexCount);
-            } else {
-                m_Gfx->Draw(mesh.vertexCount);
-                stats.drawCalls++;
-                stats.drawnVerts += static_cast<U64>(mesh.vertexCount);
+        VoxelMemoryStats mem{};
+        World const* view{world};
+        if (auto* chunkStore{view->GetStorage<VoxelChunk>()}) {
+            for (auto [h, c] : *chunkStore) {
+                if (c.blocks.Empty()) continue;
+                mem.chunks++;
+                if (c.blocks.IsUniform()) mem.uniformChunks++;
+                mem.blockBytes += c.blocks.MemoryUsage();
+            }
+        }
+        if (auto* meshStore{view->GetStorage<VoxelMesh>()}) {
+            for (auto [h, m] : *meshStore) {
+                mem.meshBytes += (m.cpuVertices.capacity() + m.readyVertices.capacity()) * sizeof(ChunkVertex)
+                               + (m.cpuIndices.capacity() + m.readyIndices.capacity()) * sizeof(U32);
             }
         }
+        mem.bytesPerChunk = mem.chunks ? mem.blockBytes / mem.chunks : 0;
+        if (auto const* pool{FindVoxelBufferPool(world)}) {
+            const auto stats{pool->GetStats()};
+            mem.poolBytes = stats.retainedBytes;
+            mem.poolHits = stats.hits;
+            mem.poolMisses = stats.misses;
+        }
 
-        for (auto [h, s] : *sStore) { world->AddOrReplaceComponent(h, stats); break; }
+        const MeshArenaStats gpu{arena.GetStats()};
+        mem.gpuMeshBytes = gpu.usedBytes;
+        mem.gpuHeapBytes = gpu.heapBytes;
+
+        for (auto [h, s] : *mStore) { world->AddOrReplaceComponent(h, mem); break; }
     }
 };
@@ -0,0 +1,115 @@
+export module Systems.VoxelBufferPool;
+
+import ECS.Component;
+import ECS.World;
+import Components.ComponentRegistry;
+import Components.Voxel;
+import Core.VectorPool;
+import Core.Types;
+import std;
+
+export struct VoxelBufferPoolConfig {
+    USize denseBytes{4ull << 20};    // dense generation scratch, 32 KiB per chunk
+    USize blockBytes{16ull << 20};   // packed block index words
+    USize vertexBytes{32ull << 20};
+    USize indexBytes{32ull << 20};
+    U32 idleFrames{300};             // frames without an Acquire before Tick starts trimming
+};
+
+// Recycles the large per-chunk buffers that streaming churns through: the dense scratch of
+// generation, the index words of VoxelBlocks and the mesh vertex and index buffers. Shared by
+// the generation and meshing workers, upload, and streaming, which returns the buffers of
+// chunks it unloads. Each kind has its own byte budget.
+export class VoxelBufferPool {
+public:
+    explicit VoxelBufferPool(VoxelBufferPoolConfig const& config = {})
+        : m_Dense{config.denseBytes, 15, 15}
+        , m_Blocks{config.blockBytes, 9, 12}
+        , m_Vertices{config.vertexBytes, 10, 20}
+        , m_Indices{config.indexBytes, 10, 21}
+        , m_IdleFrames{config.idleFrames} {}
+
+    [[nodiscard]] VectorPool<Voxel>& Dense() { return m_Dense; }
+    [[nodiscard]] VectorPool<U64>& Blocks() { return m_Blocks; }
+    [[nodiscard]] VectorPool<ChunkVertex>& Vertices() { return m_Vertices; }
+    [[nodiscard]] VectorPool<U32>& Indices() { return m_Indices; }
+
+    // Index storage source for VoxelBlocks::Assign and CopyFrom.
+    [[nodiscard]] auto WordSource() {
+        return [this](USize words) { return m_Blocks.Acquire(words); };
+    }
+
+    void Recycle(VoxelBlocks& blocks) { m_Blocks.Release(blocks.ReleaseStorage()); }
+
+    void Recycle(VoxelMesh& mesh) {
+        m_Vertices.Release(std::move(mesh.cpuVertices));
+        m_Vertices.Release(std::move(mesh.readyVertices));
+        m_Indices.Release(std::move(mesh.cpuIndices));
+        m_Indices.Release(std::move(mesh.readyIndices));
+    }
+
+    // Trim policy, called once per frame from a single thread: once nothing has been
+    // acquired for idleFrames frames, every idle period halves what each pool retains.
+    void Tick() {
+        const U64 acquires{m_Dense.Acquires() + m_Blocks.Acquires() + m_Vertices.Acquires() + m_Indices.Acquires()};
+        if (acquires != m_LastAcquires) {
+            m_LastAcquires = acquires;
+            m_Idle = 0;
+            return;
+        }
+        if (++m_Idle < m_IdleFrames) return;
+        m_Idle = 0;
+        m_Dense.Trim(m_Dense.GetStats().retainedBytes / 2);
+        m_Blocks.Trim(m_Blocks.GetStats().retainedBytes / 2);
+        m_Vertices.Trim(m_Vertices.GetStats().retainedBytes / 2);
+        m_Indices.Trim(m_Indices.GetStats().retainedBytes / 2);
+    }
+
+    void Trim() {
+        m_Dense.Trim(0);
+        m_Blocks.Trim(0);
+        m_Vertices.Trim(0);
+        m_Indices.Trim(0);
+    }
+
+    // Sum over all pools.
+    [[nodiscard]] VectorPoolStats GetStats() const {
+        VectorPoolStats total{};
+        for (VectorPoolStats const& s : {m_Dense.GetStats(), m_Blocks.GetStats(), m_Vertices.GetStats(), m_Indices.GetStats()}) {
+            total.hits += s.hits;
+            total.misses += s.misses;
+            total.discarded += s.discarded;
+            total.trimmed += s.trimmed;
+            total.retainedBytes += s.retainedBytes;
+            total.retainedBuffers += s.retainedBuffers;
+        }
+        return total;
+    }
+
+private:
+    VectorPool<Voxel> m_Dense;
+    VectorPool<U64> m_Blocks;
+    VectorPool<ChunkVertex> m_Vertices;
+    VectorPool<U32> m_Indices;
+    U32 m_IdleFrames;
+    U32 m_Idle{0};
+    U64 m_LastAcquires{0};
+};
+
+// World resource sharing the pool between streaming, generation, meshing and upload.
+export struct VoxelBufferPoolResource {
+    std::shared_ptr<VoxelBufferPool> pool{};
+};
+
+export template<>
+struct ComponentTypeID<VoxelBufferPoolResource> {
+    static consteval ComponentID value() { return VoxelBufferPoolResource_ID; }
+};
+
+// Finding the pool only reads the resource handle; the pool itself is thread-safe.
+export inline VoxelBufferPool* FindVoxelBufferPool(World const* world) {
+    auto* store{world->GetStorage<VoxelBufferPoolResource>()};
+    if (!store) return nullptr;
+    for (auto [h,c] : *store) return c.pool.get();
+    return nullptr;
+}
@@ -0,0 +1,188 @@
+export module Systems.VoxelColumnCache;
+
+import ECS.Component;
+import ECS.World;
+import Components.ComponentRegistry;
+import Components.Voxel;
+import Components.VoxelChunkIndex;
+import Core.Types;
+import Core.Assert;
+import Math.Vector;
+import std;
+
+// 2D terrain data shared by every chunk of a (cx, cz) column.
+export struct VoxelColumn {
+    static constexpr U32 Size{VoxelChunk::SizeX * VoxelChunk::SizeZ};
+    std::array<S32, Size> heights{};
+    std::array<U8, Size> biomes{};
+};
+
+export struct VoxelColumnCacheStats {
+    U64 hits{};
+    U64 misses{};
+    U64 waits{};
+    U64 evictions{};
+    U32 columns{};
+};
+
+// Thread-safe, LRU-bounded cache of generated columns. The first job asking for a column
+// computes it; concurrent jobs for the same column block until it is ready instead of
+// recomputing it. A column being computed is never evicted, and if its fill throws, the
+// waiting jobs rethrow the same exception and the next request computes it again.
+export class VoxelColumnCache {
+public:
+    using ColumnPtr = std::shared_ptr<const VoxelColumn>;
+
+    explicit VoxelColumnCache(U32 capacity = 1024) : m_Capacity{std::max(1u, capacity)} {}
+
+    template<typename Fill>
+    ColumnPtr GetOrCompute(S32 cx, S32 cz, Fill&& fill) {
+        const U64 key{PackChunkKey(cx, 0, cz)};
+        std::shared_ptr<Flight> flight{};
+        {
+            std::unique_lock lk{m_Mutex};
+            if (auto it{m_Entries.find(key)}; it != m_Entries.end()) {
+                if (it->second.column) {
+                    ++m_Stats.hits;
+                    m_Lru.splice(m_Lru.begin(), m_Lru, it->second.lru);
+                    return it->second.column;
+                }
+                // Someone else is filling it; wait on that fill, whatever its outcome.
+                ++m_Stats.waits;
+                std::shared_ptr<Flight> pending{it->second.flight};
+                m_Ready.wait(lk, [&pending]() { return pending->done; });
+                if (pending->error) std::rethrow_exception(pending->error);
+                ++m_Stats.hits;
+                return pending->column;
+            }
+            ++m_Stats.misses;
+            flight = std::make_shared<Flight>();
+            m_Entries.emplace(key, Entry{{}, flight, {}});
+        }
+
+        auto column{std::make_shared<VoxelColumn>()};
+        try {
+            fill(*column);
+        } catch (...) {
+            {
+                std::lock_guard lk{m_Mutex};
+                if (auto it{m_Entries.find(key)}; it != m_Entries.end() && it->second.flight == flight) {
+                    m_Entries.erase(it);
+                }
+                flight->error = std::current_exception();
+                flight->done = true;
+            }
+            m_Ready.notify_all();
+            throw;
+        }
+
+        {
+            std::lock_guard lk{m_Mutex};
+            // The entry is this fill's own: in-flight entries are only removed by their filler.
+            auto it{m_Entries.find(key)};
+            assert(it != m_Entries.end() && it->second.flight == flight, "In-flight column entry was replaced");
+            m_Lru.push_front(key);
+            it->second.column = column;
+            it->second.flight.reset();
+            it->second.lru = m_Lru.begin();
+            flight->column = column;
+            flight->done = true;
+            Trim();
+        }
+        m_Ready.notify_all();
+        return column;
+    }
+
+    // Columns still being computed stay; they land in the LRU like any other.
+    void Evict(S32 cx, S32 cz) {
+        std::lock_guard lk{m_Mutex};
+        auto it{m_Entries.find(PackChunkKey(cx, 0, cz))};
+        if (it == m_Entries.end() || !it->second.column) return;
+        m_Lru.erase(it->second.lru);
+        m_Entries.erase(it);
+        ++m_Stats.evictions;
+    }
+
+    // Drops every column whose Chebyshev XZ distance to (ccx, ccz) exceeds radius.
+    void EvictOutside(S32 ccx, S32 ccz, S32 radius) {
+        std::lock_guard lk{m_Mutex};
+        for (auto it{m_Entries.begin()}; it != m_Entries.end();) {
+            const Math::IVec3 c{UnpackChunkKey(it->first)};
+            if (!it->second.column || std::max(std::abs(c.x - ccx), std::abs(c.z - ccz)) <= radius) { ++it; continue; }
+            m_Lru.erase(it->second.lru);
+            it = m_Entries.erase(it);
+            ++m_Stats.evictions;
+        }
+    }
+
+    void SetCapacity(U32 capacity) {
+        std::lock_guard lk{m_Mutex};
+        m_Capacity = std::max(1u, capacity);
+        Trim();
+    }
+
+    void Clear() {
+        std::lock_guard lk{m_Mutex};
+        for (auto it{m_Entries.begin()}; it != m_Entries.end();) {
+            if (it->second.column) it = m_Entries.erase(it);
+            else ++it;
+        }
+        m_Lru.clear();
+    }
+
+    [[nodiscard]] VoxelColumnCacheStats GetStats() const {
+        std::lock_guard lk{m_Mutex};
+        VoxelColumnCacheStats s{m_Stats};
+        s.columns = static_cast<U32>(m_Lru.size());
+        return s;
+    }
+
+private:
+    // One computation of a column, shared with the jobs waiting for it.
+    struct Flight {
+        ColumnPtr column{};
+        std::exception_ptr error{};
+        bool done{false};
+    };
+
+    // Ready entries have a column and an LRU node; in-flight ones only a flight.
+    struct Entry {
+        ColumnPtr column{};
+        std::shared_ptr<Flight> flight{};
+        std::list<U64>::iterator lru{};
+    };
+
+    // Only ready columns are in the LRU list; in-flight entries are never trimmed.
+    void Trim() {
+        while (m_Lru.size() > m_Capacity) {
+            m_Entries.erase(m_Lru.back());
+            m_Lru.pop_back();
+            ++m_Stats.evictions;
+        }
+    }
+
+    mutable std::mutex m_Mutex{};
+    std::condition_variable m_Ready{};
+    UnorderedMap<U64, Entry> m_Entries{};
+    std::list<U64> m_Lru{};
+    U32 m_Capacity{};
+    VoxelColumnCacheStats m_Stats{};
+};
+
+// World resource sharing the cache between generation workers and streaming.
+export struct VoxelColumnCacheResource {
+    std::shared_ptr<VoxelColumnCache> cache{};
+};
+
+export template<>
+struct ComponentTypeID<VoxelColumnCacheResource> {
+    static consteval ComponentID value() { return VoxelColumnCacheResource_ID; }
+};
+
+// Finding the cache only reads the resource handle; the cache itself is thread-safe.
+export inline VoxelColumnCache* FindVoxelColumnCache(World const* world) {
+    auto* store{world->GetStorage<VoxelColumnCacheResource>()};
+    if (!store) return nullptr;
+    for (auto [h,c] : *store) return c.cache.get();
+    return nullptr;
+}
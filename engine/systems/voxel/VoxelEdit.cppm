@@ -1,14 +1,17 @@
 export module Systems.VoxelEdit;
 
 import ECS.SystemScheduler;
+import ECS.CommandBuffer;
 import ECS.World;
 import ECS.Component;
 import Components.Voxel;
 import Components.Transform;
 import Components.Camera;
 import Components.VoxelSelection;
+import Components.VoxelChunkIndex;
 import Systems.CameraManager;
 import Systems.VoxelRaycast;
+import Systems.VoxelEditBatch;
 import Input.Core;
 import Input.Manager;
 import Input.Bindings;
@@ -17,54 +20,14 @@ import Core.Types;
 import Core.Assert;
 import std;
 
-namespace detail {
-    inline S32 floordiv(S32 a, S32 b) {
-        return static_cast<S32>(std::floor(static_cast<F32>(a) / static_cast<F32>(b)));
-    }
-
-    inline void MarkDirtyNeighbors(World* w, VoxelChunk* ch) {
-        if (auto* store = w->GetStorage<VoxelChunk>()) {
-            for (auto [hh, cc] : *store) {
-                if (cc.cx + 1 == ch->cx && cc.cy == ch->cy && cc.cz == ch->cz) const_cast<VoxelChunk&>(cc).dirty = true;
-                if (cc.cx == ch->cx + 1 && cc.cy == ch->cy && cc.cz == ch->cz) const_cast<VoxelChunk&>(cc).dirty = true;
-                if (cc.cy + 1 == ch->cy && cc.cx == ch->cx && cc.cz == ch->cz) const_cast<VoxelChunk&>(cc).dirty = true;
-                if (cc.cy == ch->cy + 1 && cc.cx == ch->cx && cc.cz == ch->cz) const_cast<VoxelChunk&>(cc).dirty = true;
-                if (cc.cz + 1 == ch->cz && cc.cx == ch->cx && cc.cy == ch->cy) const_cast<VoxelChunk&>(cc).dirty = true;
-                if (cc.cz == ch->cz + 1 && cc.cx == ch->cx && cc.cy == ch->cy) const_cast<VoxelChunk&>(cc).dirty = true;
-            }
-        }
-    }
-
-    inline bool SetVoxel(World* w, S32 gx, S32 gy, S32 gz, Voxel v) {
-        constexpr S32 NX{static_cast<S32>(VoxelChunk::SizeX)};
-        constexpr S32 NY{static_cast<S32>(VoxelChunk::SizeY)};
-        constexpr S32 NZ{static_cast<S32>(VoxelChunk::SizeZ)};
-        S32 cx{floordiv(gx, NX)}, cy{floordiv(gy, NY)}, cz{floordiv(gz, NZ)};
-        S32 lx{gx - cx*NX}, ly{gy - cy*NY}, lz{gz - cz*NZ};
-
-        VoxelChunk* ch{};
-        if (auto* s = w->GetStorage<VoxelChunk>()) {
-            for (auto [h,c] : *s) {
-                if (static_cast<S32>(c.cx)==cx && static_cast<S32>(c.cy)==cy && static_cast<S32>(c.cz)==cz) {
-                    ch = const_cast<VoxelChunk*>(&c);
-                    break;
-                }
-            }
-        }
-        if (!ch || ch->blocks.empty()) return false;
-
-        ch->blocks[VoxelIndex(static_cast<U32>(lx), static_cast<U32>(ly), static_cast<U32>(lz))] = v;
-        ch->dirty = true;
-        MarkDirtyNeighbors(w, ch);
-        return true;
-    }
-}
-
 export class VoxelEditSystem : public System<VoxelEditSystem> {
 private:
     InputManager* m_Input{nullptr};
     std::shared_ptr<InputContext> m_Ctx;
     F32 m_MaxDist{6.0f};
+    VoxelEditJournal m_Journal{};
+    std::mutex m_PendingMutex{};
+    Vector<VoxelEditBatch> m_Pending{};
 
 public:
     void Setup() {
@@ -72,24 +35,44 @@ public:
         SetStage(SystemStage::Update);
         SetPriority(SystemPriority::High);
         RunBefore("VoxelMeshing");
+        ReadsComponents<VoxelWorldConfig, VoxelChunkIndex, VoxelHotbarState, Transform>();
+        WritesComponents<VoxelChunk, VoxelSelection>();
         SetupInput();
     }
 
     void SetInputManager(InputManager* im) { m_Input = im; SetupInput(); }
 
+    // Queues a batch (e.g. from a building tool) to be applied and journaled on the next run.
+    void Submit(VoxelEditBatch batch) {
+        std::lock_guard lock{m_PendingMutex};
+        m_Pending.push_back(std::move(batch));
+    }
+
+    [[nodiscard]] VoxelEditJournal& GetJournal() { return m_Journal; }
+
     void Run(World* world, F32) override {
+        {
+            Vector<VoxelEditBatch> pending{};
+            {
+                std::lock_guard lock{m_PendingMutex};
+                pending.swap(m_Pending);
+            }
+            for (auto const& batch : pending) m_Journal.Push(batch.Apply(world));
+        }
+
         if (!m_Input || !m_Ctx) return;
+        World const* view{world};
 
         Math::Vec3 camPos{};
         Math::Vec3 camDir{};
         if (auto h{CameraManager::GetPrimaryCamera()}; h.valid()) {
-            if (auto* t = world->GetComponent<Transform>(h)) {
+            if (auto* t = view->GetComponent<Transform>(h)) {
                 camPos = t->position;
                 camDir = t->Forward();
             }
         }
 
-        auto hit = RaycastVoxelDDA(world, camPos, camDir, m_MaxDist);
+        auto hit = RaycastVoxelDDA(view, camPos, camDir, m_MaxDist);
 
         VoxelSelection sel{};
         if (hit.hit) {
@@ -100,12 +83,10 @@ public:
         }
 
         {
-            EntityHandle e{};
             auto* s = world->GetStorage<VoxelSelection>();
-            if (!s || s->Size()==0) { e = world->CreateEntity(); world->AddComponent(e, sel); }
+            if (!s || s->Size()==0) { auto& cmd = Commands(); cmd.AddComponent(cmd.CreateEntity(), sel); }
             else {
-                for (auto [h,c] : *s) { e = h; break; }
-                world->AddOrReplaceComponent(e, sel);
+                for (auto [h,c] : *s) { c = sel; break; }
             }
         }
 
@@ -113,16 +94,21 @@ public:
         bool doBreak = m_Ctx->GetAction("VoxelBreak")->JustPressed();
         bool doPlace = m_Ctx->GetAction("VoxelPlace")->JustPressed();
 
+        if (m_Ctx->GetAction("VoxelUndo")->JustPressed()) m_Journal.Undo(world);
+        if (m_Ctx->GetAction("VoxelRedo")->JustPressed()) m_Journal.Redo(world);
+
         if (!sel.valid) return;
 
-        if (doBreak) { detail::SetVoxel(world, sel.gx, sel.gy, sel.gz, Voxel::Air); }
+        VoxelEditBatch batch{};
+        if (doBreak) { batch.Set(Math::IVec3{sel.gx, sel.gy, sel.gz}, Voxel::Air); }
         if (doPlace) {
             Voxel place{Voxel::Dirt};
-            if (auto* st = world->GetStorage<VoxelHotbarState>()) {
+            if (auto* st = view->GetStorage<VoxelHotbarState>()) {
                 for (auto [h, hb] : *st) { place = hb.selected; break; }
             }
-            detail::SetVoxel(world, sel.pgx, sel.pgy, sel.pgz, place);
+            batch.Set(Math::IVec3{sel.pgx, sel.pgy, sel.pgz}, place);
         }
+        if (!batch.Empty()) m_Journal.Push(batch.Apply(world));
     }
 
 private:
@@ -134,6 +120,11 @@ private:
         aBreak->AddBinding(InputBinding::MakeMouseButton(MouseButton::Left));
         auto* aPlace = m_Ctx->AddAction("VoxelPlace");
         aPlace->AddBinding(InputBinding::MakeMouseButton(MouseButton::Right));
+        auto* aUndo = m_Ctx->AddAction("VoxelUndo");
+        aUndo->AddBinding(InputBinding::MakeKey(Key::Z, ModifierKey::Control));
+        auto* aRedo = m_Ctx->AddAction("VoxelRedo");
+        aRedo->AddBinding(InputBinding::MakeKey(Key::Y, ModifierKey::Control));
+        aRedo->AddBinding(InputBinding::MakeKey(Key::Z, ModifierKey::Control | ModifierKey::Shift));
         m_Ctx->Update(*m_Input);
     }
 };
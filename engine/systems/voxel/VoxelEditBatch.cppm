@@ -0,0 +1,410 @@
+export module Systems.VoxelEditBatch;
+
+import ECS.World;
+import Components.Voxel;
+import Components.VoxelChunkIndex;
+import Math.Vector;
+import Core.Types;
+import Core.Assert;
+import std;
+
+namespace detail {
+    constexpr S32 kNX{static_cast<S32>(VoxelChunk::SizeX)};
+    constexpr S32 kNY{static_cast<S32>(VoxelChunk::SizeY)};
+    constexpr S32 kNZ{static_cast<S32>(VoxelChunk::SizeZ)};
+
+    inline S32 FloorDiv(S32 a, S32 b) {
+        const S32 q{a / b};
+        return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+    }
+
+    inline Math::IVec3 ChunkOf(Math::IVec3 g) {
+        return {FloorDiv(g.x, kNX), FloorDiv(g.y, kNY), FloorDiv(g.z, kNZ)};
+    }
+
+    // Dense scratch for rewriting a chunk in bulk.
+    inline std::span<Voxel> Scratch(U32 slot) {
+        static thread_local std::array<Vector<Voxel>, 2> scratch{};
+        scratch[slot].resize(VoxelBlocks::Volume);
+        return scratch[slot];
+    }
+}
+
+// Rectangular block of voxels, X fastest, then Y, then Z.
+export struct VoxelClipboard {
+    S32 sizeX{0}, sizeY{0}, sizeZ{0};
+    Vector<Voxel> voxels{};
+
+    [[nodiscard]] Voxel At(S32 x, S32 y, S32 z) const {
+        return voxels[static_cast<USize>(x) + static_cast<USize>(y) * sizeX + static_cast<USize>(z) * sizeX * sizeY];
+    }
+};
+
+// Consecutive voxel indices of one chunk changed by an edit; values live in before/after.
+export struct VoxelEditRun {
+    U32 start;
+    U32 count;
+};
+
+export struct VoxelChunkEdit {
+    S32 cx{}, cy{}, cz{};
+    VoxelEditBox box{};
+    Vector<VoxelEditRun> runs{};
+    Vector<Voxel> before{};
+    Vector<Voxel> after{};
+};
+
+// Everything an applied batch changed, enough to undo or redo it.
+export struct VoxelEditRecord {
+    Vector<VoxelChunkEdit> chunks{};
+    USize voxels{0};
+
+    [[nodiscard]] bool Empty() const { return chunks.empty(); }
+
+    [[nodiscard]] USize MemoryUsage() const {
+        USize bytes{chunks.capacity() * sizeof(VoxelChunkEdit)};
+        for (auto const& c : chunks) {
+            bytes += c.runs.capacity() * sizeof(VoxelEditRun) + c.before.capacity() + c.after.capacity();
+        }
+        return bytes;
+    }
+};
+
+namespace detail {
+    // Commits a rewritten chunk: recompresses it and marks it and the touched neighbours dirty.
+    inline void CommitChunk(World* world, VoxelChunkIndex const& index, VoxelChunk& chunk,
+                            std::span<const Voxel> dense, VoxelEditBox const& box) {
+        chunk.blocks.Assign(dense);
+        chunk.MarkDirty();
+        chunk.modified = true;
+        chunk.edited.Merge(box);
+        MarkChunkFaceNeighborsDirty(world, index, chunk, box);
+    }
+
+    // Writes the before (undo) or after (redo) values of a record back into the world.
+    inline U32 Replay(World* world, VoxelEditRecord const& record, bool undo) {
+        World const* view{world};
+        auto const* index{FindVoxelChunkIndex(view)};
+        if (!index) return 0;
+        U32 written{0};
+        for (auto const& edit : record.chunks) {
+            VoxelChunk* chunk{FindChunk(world, *index, edit.cx, edit.cy, edit.cz)};
+            if (!chunk || chunk->blocks.Empty()) continue;
+
+            const std::span<Voxel> dense{Scratch(0)};
+            chunk->blocks.CopyTo(dense);
+            Vector<Voxel> const& values{undo ? edit.before : edit.after};
+            USize v{0};
+            for (auto const& run : edit.runs) {
+                std::copy_n(values.begin() + static_cast<SSize>(v), run.count, dense.begin() + run.start);
+                v += run.count;
+            }
+            CommitChunk(world, *index, *chunk, dense, edit.box);
+            ++written;
+        }
+        return written;
+    }
+}
+
+// Reads a box of voxels (corners inclusive); voxels of missing or ungenerated chunks read as Air.
+export inline VoxelClipboard CopyVoxelRegion(World const* world, Math::IVec3 a, Math::IVec3 b) {
+    const Math::IVec3 lo{std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)};
+    const Math::IVec3 hi{std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
+    VoxelClipboard clip{};
+    clip.sizeX = hi.x - lo.x + 1;
+    clip.sizeY = hi.y - lo.y + 1;
+    clip.sizeZ = hi.z - lo.z + 1;
+    clip.voxels.assign(static_cast<USize>(clip.sizeX) * clip.sizeY * clip.sizeZ, Voxel::Air);
+
+    auto const* index{FindVoxelChunkIndex(world)};
+    if (!index) return clip;
+    const Math::IVec3 c0{detail::ChunkOf(lo)}, c1{detail::ChunkOf(hi)};
+    for (S32 cz{c0.z}; cz <= c1.z; ++cz)
+    for (S32 cy{c0.y}; cy <= c1.y; ++cy)
+    for (S32 cx{c0.x}; cx <= c1.x; ++cx) {
+        VoxelChunk const* chunk{FindChunk(world, *index, cx, cy, cz)};
+        if (!chunk || chunk->blocks.Empty()) continue;
+        const Math::IVec3 base{cx * detail::kNX, cy * detail::kNY, cz * detail::kNZ};
+        const Math::IVec3 from{std::max(lo.x, base.x), std::max(lo.y, base.y), std::max(lo.z, base.z)};
+        const Math::IVec3 to{std::min(hi.x, base.x + detail::kNX - 1), std::min(hi.y, base.y + detail::kNY - 1),
+                             std::min(hi.z, base.z + detail::kNZ - 1)};
+        for (S32 z{from.z}; z <= to.z; ++z)
+        for (S32 y{from.y}; y <= to.y; ++y)
+        for (S32 x{from.x}; x <= to.x; ++x) {
+            const Voxel v{chunk->blocks.Get(VoxelIndex(static_cast<U32>(x - base.x), static_cast<U32>(y - base.y),
+                                                       static_cast<U32>(z - base.z)))};
+            clip.voxels[static_cast<USize>(x - lo.x) + static_cast<USize>(y - lo.y) * clip.sizeX +
+                        static_cast<USize>(z - lo.z) * clip.sizeX * clip.sizeY] = v;
+        }
+    }
+    return clip;
+}
+
+// Records shape edits in global voxel coordinates and applies them chunk by chunk: each
+// touched chunk is looked up once, expanded, rewritten by every operation in order and
+// recompressed. Only voxels whose value actually changes end up in the returned record,
+// and only neighbours sharing an edited face are marked dirty. Chunks that are not loaded
+// or not generated yet are skipped.
+export class VoxelEditBatch {
+public:
+    void Set(Math::IVec3 p, Voxel v) { FillBox(p, p, v); }
+
+    // Corners inclusive.
+    void FillBox(Math::IVec3 a, Math::IVec3 b, Voxel v) {
+        Op op{Kind::Box, v};
+        op.lo = {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)};
+        op.hi = {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
+        m_Ops.push_back(std::move(op));
+    }
+
+    // Voxels whose centers lie within radius of the center voxel's center.
+    void FillSphere(Math::IVec3 center, F32 radius, Voxel v) {
+        if (radius < 0.0f) return;
+        const S32 r{static_cast<S32>(std::floor(radius))};
+        Op op{Kind::Sphere, v};
+        op.center = center;
+        op.radius2 = radius * radius;
+        op.lo = center - Math::IVec3{r};
+        op.hi = center + Math::IVec3{r};
+        m_Ops.push_back(std::move(op));
+    }
+
+    // 26-connected line from a to b, both ends included.
+    void Line(Math::IVec3 a, Math::IVec3 b, Voxel v) {
+        Op op{Kind::Points, v};
+        op.first = static_cast<U32>(m_Points.size());
+        const Math::IVec3 d{b - a};
+        const S32 steps{std::max({std::abs(d.x), std::abs(d.y), std::abs(d.z)})};
+        for (S32 i{0}; i <= steps; ++i) {
+            const F32 t{steps ? static_cast<F32>(i) / static_cast<F32>(steps) : 0.0f};
+            m_Points.push_back(Math::IVec3{
+                a.x + static_cast<S32>(std::lround(static_cast<F32>(d.x) * t)),
+                a.y + static_cast<S32>(std::lround(static_cast<F32>(d.y) * t)),
+                a.z + static_cast<S32>(std::lround(static_cast<F32>(d.z) * t))
+            });
+        }
+        op.count = static_cast<U32>(m_Points.size()) - op.first;
+        op.lo = {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)};
+        op.hi = {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
+        m_Ops.push_back(std::move(op));
+    }
+
+    // Writes the clipboard with its minimum corner at origin; Air is skipped unless asked for.
+    void Paste(VoxelClipboard clip, Math::IVec3 origin, bool pasteAir = false) {
+        if (clip.voxels.empty()) return;
+        Op op{Kind::Paste, Voxel::Air};
+        op.lo = origin;
+        op.hi = origin + Math::IVec3{clip.sizeX - 1, clip.sizeY - 1, clip.sizeZ - 1};
+        op.pasteAir = pasteAir;
+        op.clip = std::make_shared<const VoxelClipboard>(std::move(clip));
+        m_Ops.push_back(std::move(op));
+    }
+
+    [[nodiscard]] bool Empty() const { return m_Ops.empty(); }
+    [[nodiscard]] USize Size() const { return m_Ops.size(); }
+
+    void Clear() {
+        m_Ops.clear();
+        m_Points.clear();
+    }
+
+    // Applies every operation in recording order; the batch itself is left untouched.
+    VoxelEditRecord Apply(World* world) const {
+        VoxelEditRecord record{};
+        World const* view{world};
+        auto const* index{FindVoxelChunkIndex(view)};
+        if (!index || m_Ops.empty()) return record;
+
+        Vector<U64> keys{};
+        for (auto const& op : m_Ops) CollectChunks(op, keys);
+        std::ranges::sort(keys);
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        for (U64 key : keys) {
+            const Math::IVec3 c{UnpackChunkKey(key)};
+            VoxelChunk* chunk{FindChunk(world, *index, c.x, c.y, c.z)};
+            if (!chunk || chunk->blocks.Empty()) continue;
+
+            const std::span<Voxel> original{detail::Scratch(0)};
+            const std::span<Voxel> dense{detail::Scratch(1)};
+            chunk->blocks.CopyTo(original);
+            std::ranges::copy(original, dense.begin());
+
+            const Math::IVec3 base{c.x * detail::kNX, c.y * detail::kNY, c.z * detail::kNZ};
+            for (auto const& op : m_Ops) Rasterize(op, base, dense);
+
+            VoxelChunkEdit edit{c.x, c.y, c.z};
+            Diff(original, dense, edit);
+            if (edit.runs.empty()) continue;
+
+            record.voxels += edit.after.size();
+            detail::CommitChunk(world, *index, *chunk, dense, edit.box);
+            record.chunks.push_back(std::move(edit));
+        }
+        return record;
+    }
+
+private:
+    enum class Kind : U8 { Box, Sphere, Points, Paste };
+
+    struct Op {
+        Kind kind;
+        Voxel value;
+        Math::IVec3 lo{}, hi{};
+        Math::IVec3 center{};
+        F32 radius2{0.0f};
+        U32 first{0}, count{0};
+        bool pasteAir{false};
+        std::shared_ptr<const VoxelClipboard> clip{};
+    };
+
+    // Adds the keys of the chunks op writes to. Lines add the chunk of each point and spheres
+    // only the chunks holding a voxel within the radius, so chunks the bounding box merely
+    // crosses are never snapshotted and diffed.
+    void CollectChunks(Op const& op, Vector<U64>& keys) const {
+        if (op.kind == Kind::Points) {
+            for (U32 i{op.first}; i < op.first + op.count; ++i) {
+                const Math::IVec3 c{detail::ChunkOf(m_Points[i])};
+                if (keys.empty() || keys.back() != PackChunkKey(c.x, c.y, c.z)) keys.push_back(PackChunkKey(c.x, c.y, c.z));
+            }
+            return;
+        }
+
+        const Math::IVec3 c0{detail::ChunkOf(op.lo)}, c1{detail::ChunkOf(op.hi)};
+        for (S32 cz{c0.z}; cz <= c1.z; ++cz)
+        for (S32 cy{c0.y}; cy <= c1.y; ++cy)
+        for (S32 cx{c0.x}; cx <= c1.x; ++cx) {
+            if (op.kind == Kind::Sphere) {
+                // The chunk voxel nearest the center is the center clamped into the chunk.
+                const Math::IVec3 base{cx * detail::kNX, cy * detail::kNY, cz * detail::kNZ};
+                const F32 dx{static_cast<F32>(std::clamp(op.center.x, base.x, base.x + detail::kNX - 1) - op.center.x)};
+                const F32 dy{static_cast<F32>(std::clamp(op.center.y, base.y, base.y + detail::kNY - 1) - op.center.y)};
+                const F32 dz{static_cast<F32>(std::clamp(op.center.z, base.z, base.z + detail::kNZ - 1) - op.center.z)};
+                if (dx * dx + dy * dy + dz * dz > op.radius2) continue;
+            }
+            keys.push_back(PackChunkKey(cx, cy, cz));
+        }
+    }
+
+    // Writes the part of op inside the chunk at base into its dense array.
+    void Rasterize(Op const& op, Math::IVec3 base, std::span<Voxel> dense) const {
+        const Math::IVec3 from{std::max(op.lo.x, base.x), std::max(op.lo.y, base.y), std::max(op.lo.z, base.z)};
+        const Math::IVec3 to{std::min(op.hi.x, base.x + detail::kNX - 1), std::min(op.hi.y, base.y + detail::kNY - 1),
+                             std::min(op.hi.z, base.z + detail::kNZ - 1)};
+        if (from.x > to.x || from.y > to.y || from.z > to.z) return;
+
+        auto at = [&](S32 x, S32 y, S32 z) -> Voxel& {
+            return dense[VoxelIndex(static_cast<U32>(x - base.x), static_cast<U32>(y - base.y), static_cast<U32>(z - base.z))];
+        };
+
+        switch (op.kind) {
+            case Kind::Box:
+                for (S32 z{from.z}; z <= to.z; ++z)
+                    for (S32 y{from.y}; y <= to.y; ++y)
+                        std::fill_n(&at(from.x, y, z), to.x - from.x + 1, op.value);
+                break;
+            case Kind::Sphere:
+                for (S32 z{from.z}; z <= to.z; ++z)
+                for (S32 y{from.y}; y <= to.y; ++y)
+                for (S32 x{from.x}; x <= to.x; ++x) {
+                    const F32 dx{static_cast<F32>(x - op.center.x)};
+                    const F32 dy{static_cast<F32>(y - op.center.y)};
+                    const F32 dz{static_cast<F32>(z - op.center.z)};
+                    if (dx * dx + dy * dy + dz * dz <= op.radius2) at(x, y, z) = op.value;
+                }
+                break;
+            case Kind::Points:
+                for (U32 i{op.first}; i < op.first + op.count; ++i) {
+                    const Math::IVec3 p{m_Points[i]};
+                    if (p.x >= from.x && p.x <= to.x && p.y >= from.y && p.y <= to.y && p.z >= from.z && p.z <= to.z) {
+                        at(p.x, p.y, p.z) = op.value;
+                    }
+                }
+                break;
+            case Kind::Paste:
+                for (S32 z{from.z}; z <= to.z; ++z)
+                for (S32 y{from.y}; y <= to.y; ++y)
+                for (S32 x{from.x}; x <= to.x; ++x) {
+                    const Voxel v{op.clip->At(x - op.lo.x, y - op.lo.y, z - op.lo.z)};
+                    if (v != Voxel::Air || op.pasteAir) at(x, y, z) = v;
+                }
+                break;
+        }
+    }
+
+    // Collects the runs of voxels that differ and their bounds.
+    static void Diff(std::span<const Voxel> original, std::span<const Voxel> dense, VoxelChunkEdit& edit) {
+        USize i{0};
+        while (i < original.size()) {
+            const auto [o, d]{std::mismatch(original.begin() + static_cast<SSize>(i), original.end(),
+                                            dense.begin() + static_cast<SSize>(i))};
+            if (o == original.end()) break;
+            i = static_cast<USize>(o - original.begin());
+            const USize start{i};
+            for (; i < original.size() && original[i] != dense[i]; ++i) {
+                edit.before.push_back(original[i]);
+                edit.after.push_back(dense[i]);
+                edit.box.Add(static_cast<U32>(i % VoxelChunk::SizeX),
+                             static_cast<U32>((i / VoxelChunk::SizeX) % VoxelChunk::SizeY),
+                             static_cast<U32>(i / (VoxelChunk::SizeX * VoxelChunk::SizeY)));
+            }
+            edit.runs.push_back(VoxelEditRun{static_cast<U32>(start), static_cast<U32>(i - start)});
+        }
+    }
+
+    Vector<Op> m_Ops{};
+    Vector<Math::IVec3> m_Points{};
+};
+
+// Undo/redo history of applied records, bounded by memory: the oldest records are dropped
+// once the journal holds more than maxBytes.
+export class VoxelEditJournal {
+public:
+    explicit VoxelEditJournal(USize maxBytes = 16ull << 20) : m_MaxBytes{maxBytes} {}
+
+    // Starts a new branch: records that were undone can no longer be redone.
+    void Push(VoxelEditRecord record) {
+        if (record.Empty()) return;
+        for (auto const& r : m_Redo) m_Bytes -= r.MemoryUsage();
+        m_Redo.clear();
+        m_Bytes += record.MemoryUsage();
+        m_Undo.push_back(std::move(record));
+        while (m_Bytes > m_MaxBytes && m_Undo.size() > 1) {
+            m_Bytes -= m_Undo.front().MemoryUsage();
+            m_Undo.pop_front();
+        }
+    }
+
+    // Chunks that were unloaded since the edit are skipped.
+    bool Undo(World* world) {
+        if (m_Undo.empty()) return false;
+        detail::Replay(world, m_Undo.back(), true);
+        m_Redo.push_back(std::move(m_Undo.back()));
+        m_Undo.pop_back();
+        return true;
+    }
+
+    bool Redo(World* world) {
+        if (m_Redo.empty()) return false;
+        detail::Replay(world, m_Redo.back(), false);
+        m_Undo.push_back(std::move(m_Redo.back()));
+        m_Redo.pop_back();
+        return true;
+    }
+
+    [[nodiscard]] bool CanUndo() const { return !m_Undo.empty(); }
+    [[nodiscard]] bool CanRedo() const { return !m_Redo.empty(); }
+    [[nodiscard]] USize MemoryUsage() const { return m_Bytes; }
+
+    void Clear() {
+        m_Undo.clear();
+        m_Redo.clear();
+        m_Bytes = 0;
+    }
+
+private:
+    std::deque<VoxelEditRecord> m_Undo{};
+    Vector<VoxelEditRecord> m_Redo{};
+    USize m_Bytes{0};
+    USize m_MaxBytes;
+};
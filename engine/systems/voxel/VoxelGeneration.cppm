@@ -5,74 +5,23 @@ import ECS.SystemScheduler;
 import ECS.World;
 import Components.Voxel;
 import Components.VoxelStreaming;
+import Components.VoxelChunkIndex;
+import Systems.VoxelNoise;
+import Systems.VoxelColumnCache;
+import Systems.VoxelRegionStore;
+import Systems.VoxelBufferPool;
 import Systems.CameraManager;
 import Components.Transform;
+import Tasks.TaskProfiler;
+import Core.FrameArena;
 import Core.Types;
 import Core.Assert;
 import Math.Core;
 import Math.Vector;
 import std;
 
-namespace noise {
-    inline U32 wang(U32 s) {
-        s = (s ^ 61u) ^ (s >> 16);
-        s *= 9u;
-        s ^= s >> 4;
-        s *= 0x27d4eb2d;
-        s ^= s >> 15;
-        return s;
-    }
-
-    inline F32 rnd(S32 x, S32 y) {
-        U32 h{wang(static_cast<U32>(x) * 73856093u ^ static_cast<U32>(y) * 19349663u)};
-        return static_cast<F32>(h) / static_cast<F32>(std::numeric_limits<U32>::max());
-    }
-
-    inline F32 smooth(F32 t) {
-        return t * t * (3.0f - 2.0f * t);
-    }
-
-    inline F32 value2D(F32 x, F32 y) {
-        S32 ix{static_cast<S32>(std::floor(x))};
-        S32 iy{static_cast<S32>(std::floor(y))};
-        F32 fx{x - static_cast<F32>(ix)};
-        F32 fy{y - static_cast<F32>(iy)};
-        F32 v00{rnd(ix, iy)};
-        F32 v10{rnd(ix + 1, iy)};
-        F32 v01{rnd(ix, iy + 1)};
-        F32 v11{rnd(ix + 1, iy + 1)};
-        F32 sx{smooth(fx)}, sy{smooth(fy)};
-        F32 a{std::lerp(v00, v10, sx)};
-        F32 b{std::lerp(v01, v11, sx)};
-        return std::lerp(a, b, sy);
-    }
-
-    inline F32 fbm2D(F32 x, F32 y, U32 oct, F32 gain, F32 lacunarity) {
-        F32 a{1.0f}, f{1.0f}, sum{0.0f}, norm{0.0f};
-        for (U32 i{}; i < oct; ++i) {
-            sum += a * value2D(x * f, y * f);
-            norm += a;
-            a *= gain;
-            f *= lacunarity;
-        }
-        return sum / std::max(0.0001f, norm);
-    }
-
-    // Generates a simple and balanced biome value
-    inline F32 biomeValue(F32 x, F32 z, F32 freq = 0.004f) {
-        F32 large = value2D(x * freq, z * freq);           // Large areas
-        F32 detail = value2D(x * freq * 3.0f, z * freq * 3.0f) * 0.3f; // Details
-        return large + detail;
-    }
-
-    // Generates basic terrain height
-    inline F32 terrainNoise(F32 x, F32 z, F32 freq = 0.025f) {
-        return fbm2D(x * freq, z * freq, 4u, 0.5f, 2.0f);
-    }
-}
-
 // ===== BIOMES =====
-enum class BiomeType : U32 {
+export enum class BiomeType : U32 {
     Plains = 0,
     Desert = 1
 };
@@ -115,16 +64,13 @@ namespace biomes {
         return GetBiomeData(BiomeType::Plains);
     }
 
-    // Determines the primary biome for a position
-    static BiomeType GetPrimaryBiome(F32 x, F32 z) {
-        F32 biomeNoise = noise::biomeValue(x, z);
+    // Determines the primary biome from the column's biome noise
+    static BiomeType GetPrimaryBiome(F32 biomeNoise) {
         return (biomeNoise > 0.6f) ? BiomeType::Desert : BiomeType::Plains;
     }
 
     // Calculates the blend factor between biomes
-    static F32 GetBiomeBlendFactor(F32 x, F32 z, BiomeType targetBiome) {
-        F32 biomeNoise = noise::biomeValue(x, z);
-
+    static F32 GetBiomeBlendFactor(F32 biomeNoise, BiomeType targetBiome) {
         if (targetBiome == BiomeType::Desert) {
             if (biomeNoise > 0.7f) return 1.0f;
             if (biomeNoise < 0.5f) return 0.0f;
@@ -137,24 +83,24 @@ namespace biomes {
     }
 
     // Generates the height for a specific biome
-    static S32 GenerateBiomeHeight(F32 x, F32 z, const BiomeData& biome) {
-        F32 terrainNoise = noise::terrainNoise(x, z);
+    static S32 GenerateBiomeHeight(F32 terrainNoise, const BiomeData& biome) {
         return static_cast<S32>(biome.heightBase + terrainNoise * biome.heightAmp);
     }
 
-    // Calculates the final height with biome blending
-    static S32 CalculateBlendedHeight(F32 x, F32 z) {
-        BiomeType primaryBiome = GetPrimaryBiome(x, z);
+    // Calculates the final height with biome blending. Both biomes share the same
+    // terrain noise, so each column evaluates biome and terrain noise exactly once.
+    static S32 CalculateBlendedHeight(F32 biomeNoise, F32 terrainNoise) {
+        BiomeType primaryBiome = GetPrimaryBiome(biomeNoise);
         BiomeData primaryData = GetBiomeData(primaryBiome);
-        S32 primaryHeight = GenerateBiomeHeight(x, z, primaryData);
+        S32 primaryHeight = GenerateBiomeHeight(terrainNoise, primaryData);
 
         // Check if we are in a transition zone
         BiomeType otherBiome = (primaryBiome == BiomeType::Plains) ? BiomeType::Desert : BiomeType::Plains;
-        F32 blendFactor = GetBiomeBlendFactor(x, z, otherBiome);
+        F32 blendFactor = GetBiomeBlendFactor(biomeNoise, otherBiome);
 
         if (blendFactor > 0.0f) {
             BiomeData otherData = GetBiomeData(otherBiome);
-            S32 otherHeight = GenerateBiomeHeight(x, z, otherData);
+            S32 otherHeight = GenerateBiomeHeight(terrainNoise, otherData);
             return static_cast<S32>(std::lerp(static_cast<F32>(primaryHeight),
                                             static_cast<F32>(otherHeight),
                                             blendFactor));
@@ -171,6 +117,9 @@ struct GenJob {
     S32 cz;
     Math::Vec3 origin;
     F32 bs;
+    std::shared_ptr<VoxelColumnCache> columns;
+    std::shared_ptr<VoxelRegionStore> store;
+    std::shared_ptr<VoxelBufferPool> pool;
 };
 
 // ===== TERRAIN GENERATION =====
@@ -191,31 +140,35 @@ namespace terrain {
         blocks[VoxelIndex(x, y, z)] = blockType;
     }
 
-    // Generates a heightmap for a chunk
-    static void GenerateHeightMap(Vector<S32>& heightMap, Vector<BiomeType>& biomeMap,
+    // Generates a heightmap for a chunk, one row of columns at a time through the
+    // vectorized noise kernels
+    static void GenerateHeightMap(std::span<S32> heightMap, std::span<U8> biomeMap,
                                  const GenJob& job, U32 chunkSizeX, U32 chunkSizeZ) {
-        for (U32 z{}; z < chunkSizeZ; ++z) {
-            for (U32 x{}; x < chunkSizeX; ++x) {
-                F32 wx{job.origin.x + static_cast<F32>(x) * job.bs};
-                F32 wz{job.origin.z + static_cast<F32>(z) * job.bs};
+        std::array<F32, VoxelChunk::SizeX> xs{}, biomeNoise{}, terrainNoise{};
+        assert(chunkSizeX <= xs.size(), "Heightmap row wider than a chunk");
+        const std::span<const F32> row{xs.data(), chunkSizeX};
+        for (U32 x{}; x < chunkSizeX; ++x) xs[x] = job.origin.x + static_cast<F32>(x) * job.bs;
 
-                BiomeType biome = biomes::GetPrimaryBiome(wx, wz);
-                S32 height = biomes::CalculateBlendedHeight(wx, wz);
+        for (U32 z{}; z < chunkSizeZ; ++z) {
+            F32 wz{job.origin.z + static_cast<F32>(z) * job.bs};
+            noise::BiomeValueRow(row, wz, biomeNoise);
+            noise::TerrainNoiseRow(row, wz, terrainNoise);
 
-                heightMap[x + z * chunkSizeX] = height;
-                biomeMap[x + z * chunkSizeX] = biome;
+            for (U32 x{}; x < chunkSizeX; ++x) {
+                heightMap[x + z * chunkSizeX] = biomes::CalculateBlendedHeight(biomeNoise[x], terrainNoise[x]);
+                biomeMap[x + z * chunkSizeX] = static_cast<U8>(biomes::GetPrimaryBiome(biomeNoise[x]));
             }
         }
     }
 
     // Places all terrain blocks
-    static void PlaceTerrainBlocks(Vector<Voxel>& blocks, const Vector<S32>& heightMap,
-                                  const Vector<BiomeType>& biomeMap, const GenJob& job,
+    static void PlaceTerrainBlocks(Vector<Voxel>& blocks, std::span<const S32> heightMap,
+                                  std::span<const U8> biomeMap, const GenJob& job,
                                   U32 chunkSizeX, U32 chunkSizeY, U32 chunkSizeZ) {
         for (U32 z{}; z < chunkSizeZ; ++z) {
             for (U32 x{}; x < chunkSizeX; ++x) {
                 S32 height = heightMap[x + z * chunkSizeX];
-                BiomeType biome = biomeMap[x + z * chunkSizeX];
+                BiomeType biome = static_cast<BiomeType>(biomeMap[x + z * chunkSizeX]);
                 BiomeData biomeData = biomes::GetBiomeData(biome);
 
                 for (U32 y{}; y < chunkSizeY; ++y) {
@@ -243,7 +196,7 @@ namespace vegetation {
     // Finds candidates for vegetation
 
     // Finds a tree candidate
-    static void FindTreeCandidate(Vector<TreeCandidate>& trees, const Vector<S32>& heightMap,
+    static void FindTreeCandidate(Vector<TreeCandidate>& trees, std::span<const S32> heightMap,
                                  const Vector<Voxel>& blocks, const GenJob& job, U32 seed,
                                  U32 x, U32 z, U32 chunkSizeX, U32 chunkSizeY, BiomeType biome) {
         S32 offsetX{static_cast<S32>(seed % 5) - 2};
@@ -266,7 +219,7 @@ namespace vegetation {
     }
 
     // Finds a cactus candidate
-    static void FindCactusCandidate(Vector<CactusCandidate>& cacti, const Vector<S32>& heightMap,
+    static void FindCactusCandidate(Vector<CactusCandidate>& cacti, std::span<const S32> heightMap,
                                    const Vector<Voxel>& blocks, const GenJob& job, U32 seed,
                                    U32 x, U32 z, U32 chunkSizeX, U32 chunkSizeY) {
         S32 offsetX{static_cast<S32>(seed % 3) - 1};
@@ -289,14 +242,14 @@ namespace vegetation {
     }
 
     static void FindVegetationCandidates(Vector<TreeCandidate>& trees, Vector<CactusCandidate>& cacti,
-                                        const Vector<S32>& heightMap, const Vector<BiomeType>& biomeMap,
+                                        std::span<const S32> heightMap, std::span<const U8> biomeMap,
                                         const Vector<Voxel>& blocks, const GenJob& job,
                                         U32 chunkSizeX, U32 chunkSizeY, U32 chunkSizeZ) {
         for (U32 z{4}; z < chunkSizeZ - 4; z += 4) {
             for (U32 x{4}; x < chunkSizeX - 4; x += 4) {
                 F32 wx{job.origin.x + static_cast<F32>(x) * job.bs};
                 F32 wz{job.origin.z + static_cast<F32>(z) * job.bs};
-                BiomeType biome = biomeMap[x + z * chunkSizeX];
+                BiomeType biome = static_cast<BiomeType>(biomeMap[x + z * chunkSizeX]);
                 BiomeData biomeData = biomes::GetBiomeData(biome);
 
                 U32 seed{noise::wang(static_cast<U32>(wx * 73) ^ static_cast<U32>(wz * 97))};
@@ -392,75 +345,151 @@ namespace vegetation {
     }
 }
 
+// ===== CHUNK GENERATION =====
+// Places the terrain of one chunk, then its vegetation, from its column's heightmap and biomes
+static void PlaceChunkBlocks(Vector<Voxel>& blocks, VoxelColumn const& column, const GenJob& job) {
+    constexpr U32 NX{VoxelChunk::SizeX}, NY{VoxelChunk::SizeY}, NZ{VoxelChunk::SizeZ};
+    const std::span<const S32> heightMap{column.heights};
+    const std::span<const U8> biomeMap{column.biomes};
+
+    terrain::PlaceTerrainBlocks(blocks, heightMap, biomeMap, job, NX, NY, NZ);
+
+    Vector<TreeCandidate> trees{};
+    Vector<CactusCandidate> cacti{};
+    vegetation::FindVegetationCandidates(trees, cacti, heightMap, biomeMap, blocks, job, NX, NY, NZ);
+    vegetation::PlaceAllVegetation(blocks, trees, cacti, NY);
+}
+
+static GenJob MakeGenJob(S32 cx, S32 cy, S32 cz, F32 blockSize) {
+    GenJob job{};
+    job.cx = cx;
+    job.cy = cy;
+    job.cz = cz;
+    // Same rounding as the chunk origins VoxelStreamingSystem assigns.
+    job.origin = Math::Vec3{static_cast<F32>(cx) * (blockSize * static_cast<F32>(VoxelChunk::SizeX)),
+                            static_cast<F32>(cy) * (blockSize * static_cast<F32>(VoxelChunk::SizeY)),
+                            static_cast<F32>(cz) * (blockSize * static_cast<F32>(VoxelChunk::SizeZ))};
+    job.bs = blockSize;
+    return job;
+}
+
+// Heightmap and biomes of the chunk column at (cx, cz); biomes holds BiomeType values
+export void GenerateVoxelColumn(S32 cx, S32 cz, F32 blockSize, VoxelColumn& column) {
+    terrain::GenerateHeightMap(column.heights, column.biomes, MakeGenJob(cx, 0, cz, blockSize),
+                               VoxelChunk::SizeX, VoxelChunk::SizeZ);
+}
+
+// Generates one chunk on the calling thread, exactly as the generation workers do, from its
+// column as filled by GenerateVoxelColumn
+export VoxelBlocks GenerateVoxelChunk(S32 cx, S32 cy, S32 cz, F32 blockSize, VoxelColumn const& column) {
+    Vector<Voxel> blocks(VoxelBlocks::Volume);
+    PlaceChunkBlocks(blocks, column, MakeGenJob(cx, cy, cz, blockSize));
+    VoxelBlocks packed{};
+    packed.Assign(blocks);
+    return packed;
+}
+
+// Bump whenever generation changes what a chunk contains.
+export constexpr U32 VoxelGeneratorVersion{1};
+
+// Identifies the terrain a world generates. Terrain has no seed; it depends on the generator
+// and the block size it is sampled at. Chunks saved under one key must not be mixed with
+// terrain generated under another, so the key selects the save directory.
+export U64 VoxelGeneratorKey(VoxelWorldConfig const& cfg) {
+    U64 h{0xCBF29CE484222325ull};
+    for (U32 v : {VoxelGeneratorVersion, std::bit_cast<U32>(cfg.blockSize), VoxelChunk::SizeX, VoxelChunk::SizeY, VoxelChunk::SizeZ}) {
+        h = (h ^ v) * 0x100000001B3ull;
+    }
+    return h;
+}
+
 // ===== MAIN SYSTEM =====
 export class VoxelGenerationSystem : public System<VoxelGenerationSystem> {
 
     struct GenResult {
         EntityHandle h;
-        Vector<Voxel> blocks;
+        VoxelBlocks blocks;
+        bool fromStore;
     };
 
-    static inline Vector<std::thread> s_Workers{};
-    static inline std::mutex s_Mutex{};
-    static inline std::condition_variable s_CV{};
-    static inline std::deque<GenJob> s_Jobs{};
-    static inline std::mutex s_ReadyMutex{};
-    static inline std::deque<GenResult> s_Ready{};
-    static inline std::atomic<bool> s_Stop{false};
-    static inline std::once_flag s_Once{};
+    // Owned per system like the mesher's pool, so a later World gets fresh workers.
+    Vector<std::thread> m_Workers{};
+    std::mutex m_Mutex{};
+    std::condition_variable m_CV{};
+    std::deque<GenJob> m_Jobs{};
+    bool m_Stop{false};
+    std::mutex m_ReadyMutex{};
+    std::deque<GenResult> m_Ready{};
 
     // Generates a full chunk
-    static void GenerateChunk(const GenJob& job) {
+    void GenerateChunk(const GenJob& job) {
         constexpr U32 NX{VoxelChunk::SizeX}, NY{VoxelChunk::SizeY}, NZ{VoxelChunk::SizeZ};
-        Vector<Voxel> blocks{};
-        blocks.resize(static_cast<USize>(NX) * NY * NZ);
-
-        // Step 1: Generate heightmap and biomes
-        Vector<S32> heightMap{};
-        Vector<BiomeType> biomeMap{};
-        heightMap.resize(NX * NZ);
-        biomeMap.resize(NX * NZ);
-
-        terrain::GenerateHeightMap(heightMap, biomeMap, job, NX, NZ);
+        ProfileZone zone{"GenerateChunk"};
+
+        // Step 0: Chunks saved earlier are loaded instead of generated
+        if (job.store) {
+            VoxelBlocks stored{};
+            if (job.store->Load(job.cx, job.cy, job.cz, stored)) {
+                std::lock_guard lk{m_ReadyMutex};
+                m_Ready.push_back(GenResult{job.h, std::move(stored), true});
+                return;
+            }
+        }
 
-        // Step 2: Place the terrain blocks
-        terrain::PlaceTerrainBlocks(blocks, heightMap, biomeMap, job, NX, NY, NZ);
+        VoxelBufferPool* pool{job.pool.get()};
+        Vector<Voxel> blocks{pool ? pool->Dense().Acquire(VoxelBlocks::Volume) : Vector<Voxel>{}};
+        blocks.resize(static_cast<USize>(NX) * NY * NZ);
 
-        // Step 3: Find vegetation candidates
-        Vector<TreeCandidate> trees{};
-        Vector<CactusCandidate> cacti{};
-        vegetation::FindVegetationCandidates(trees, cacti, heightMap, biomeMap, blocks, job, NX, NY, NZ);
+        // Step 1: Fetch the column's heightmap and biomes, shared by every chunk of the column
+        auto fillColumn = [&job](VoxelColumn& column) {
+            ProfileZone noiseZone{"TerrainNoise"};
+            terrain::GenerateHeightMap(column.heights, column.biomes, job, NX, NZ);
+        };
+        VoxelColumnCache::ColumnPtr column{};
+        if (job.columns) {
+            column = job.columns->GetOrCompute(job.cx, job.cz, fillColumn);
+        } else {
+            auto fresh{std::make_shared<VoxelColumn>()};
+            fillColumn(*fresh);
+            column = std::move(fresh);
+        }
 
-        // Step 4: Place the vegetation
-        vegetation::PlaceAllVegetation(blocks, trees, cacti, NY);
+        // Steps 2-4: Terrain, then vegetation
+        PlaceChunkBlocks(blocks, *column, job);
 
-        // Step 5: Send the result
+        // Step 5: Compress and send the result
+        VoxelBlocks packed{};
+        if (pool) {
+            packed.Assign(blocks, pool->WordSource());
+            pool->Dense().Release(std::move(blocks));
+        } else {
+            packed.Assign(blocks);
+        }
         {
-            std::lock_guard lk{s_ReadyMutex};
-            s_Ready.push_back(GenResult{job.h, std::move(blocks)});
+            std::lock_guard lk{m_ReadyMutex};
+            m_Ready.push_back(GenResult{job.h, std::move(packed), false});
         }
     }
 
-    static void StartPool(U32 threads) {
-        std::call_once(s_Once, [threads]() {
-            U32 n{threads ? threads : std::max(2u, std::thread::hardware_concurrency())};
-            for (U32 i{}; i < n; ++i) {
-                s_Workers.emplace_back([]() {
-                    for (;;) {
-                        GenJob job{};
-                        {
-                            std::unique_lock lk{s_Mutex};
-                            s_CV.wait(lk, []{ return s_Stop.load() || !s_Jobs.empty(); });
-                            if (s_Stop.load()) return;
-                            job = s_Jobs.front();
-                            s_Jobs.pop_front();
-                        }
-
-                        GenerateChunk(job);
+    void StartPool(U32 threads) {
+        if (!m_Workers.empty()) return;
+        const U32 n{threads ? threads : std::max(2u, std::thread::hardware_concurrency())};
+        for (U32 i{}; i < n; ++i) {
+            m_Workers.emplace_back([this]() {
+                for (;;) {
+                    GenJob job{};
+                    {
+                        std::unique_lock lk{m_Mutex};
+                        m_CV.wait(lk, [this]{ return m_Stop || !m_Jobs.empty(); });
+                        if (m_Stop) return;
+                        job = m_Jobs.front();
+                        m_Jobs.pop_front();
                     }
-                });
-            }
-        });
+
+                    GenerateChunk(job);
+                }
+            });
+        }
     }
 
 public:
@@ -470,43 +499,63 @@ public:
         SetPriority(SystemPriority::High);
         SetParallel(true);
         RunBefore("VoxelMeshing");
+        ReadsComponents<VoxelWorldConfig, VoxelStreamingConfig, VoxelChunkIndex, Transform,
+                        VoxelColumnCacheResource, VoxelRegionStoreResource, VoxelBufferPoolResource>();
+        WritesComponents<VoxelChunk>();
         StartPool(0);
     }
 
     ~VoxelGenerationSystem() {
-        s_Stop.store(true);
-        s_CV.notify_all();
-        for (auto &t : s_Workers) if (t.joinable()) t.join();
+        {
+            std::lock_guard lk{m_Mutex};
+            m_Stop = true;
+        }
+        m_CV.notify_all();
+        for (auto &t : m_Workers) if (t.joinable()) t.join();
     }
 
     void Run(World* world, F32) override {
-        auto* wcfgStore{world->GetStorage<VoxelWorldConfig>()};
+        World const* view{world};
+        auto* wcfgStore{view->GetStorage<VoxelWorldConfig>()};
         assert(wcfgStore && wcfgStore->Size() > 0, "Missing VoxelWorldConfig");
         VoxelWorldConfig const* cfg{};
         for (auto [h,c] : *wcfgStore) { cfg = &c; break; }
 
-        auto* scStore{world->GetStorage<VoxelStreamingConfig>()};
+        auto* scStore{view->GetStorage<VoxelStreamingConfig>()};
         assert(scStore && scStore->Size() > 0, "Missing VoxelStreamingConfig");
         VoxelStreamingConfig const* sc{};
         for (auto [h,c] : *scStore) { sc = &c; break; }
 
         Math::Vec3 camPos{};
         if (auto h{CameraManager::GetPrimaryCamera()}; h.valid()) {
-            if (auto* t{world->GetComponent<Transform>(h)}) camPos = t->position;
+            if (auto* t{view->GetComponent<Transform>(h)}) camPos = t->position;
         }
 
         auto* chunkStore{world->GetStorage<VoxelChunk>()};
         if (!chunkStore) return;
 
+        std::shared_ptr<VoxelColumnCache> columns{};
+        if (auto* ccStore{view->GetStorage<VoxelColumnCacheResource>()}) {
+            for (auto [h,c] : *ccStore) { columns = c.cache; break; }
+        }
+        std::shared_ptr<VoxelRegionStore> regionStore{};
+        if (auto* rsStore{view->GetStorage<VoxelRegionStoreResource>()}) {
+            for (auto [h,c] : *rsStore) { regionStore = c.store; break; }
+        }
+        std::shared_ptr<VoxelBufferPool> pool{};
+        if (auto* bpStore{view->GetStorage<VoxelBufferPoolResource>()}) {
+            for (auto [h,c] : *bpStore) { pool = c.pool; break; }
+        }
+
         struct Item { F32 d2; EntityHandle h; };
-        Vector<Item> todo{};
+        FrameVector<Item> todo{FrameArena::Resource()};
 
         const F32 sx{cfg->blockSize * static_cast<F32>(VoxelChunk::SizeX)};
         const F32 sy{cfg->blockSize * static_cast<F32>(VoxelChunk::SizeY)};
         const F32 sz{cfg->blockSize * static_cast<F32>(VoxelChunk::SizeZ)};
 
         for (auto [h,c] : *chunkStore) {
-            if (!c.blocks.empty() || c.generating) continue;
+            if (!c.blocks.Empty() || c.generating) continue;
             Math::Vec3 center{c.origin.x + 0.5f * sx, c.origin.y + 0.5f * sy, c.origin.z + 0.5f * sz};
             F32 d2{(center - camPos).LengthSquared()};
             todo.push_back(Item{d2, h});
@@ -518,7 +567,7 @@ public:
         for (auto const& it : todo) {
             if (enqueueLeft == 0u) break;
             auto* chunk{world->GetComponent<VoxelChunk>(it.h)};
-            if (!chunk || !chunk->blocks.empty() || chunk->generating) continue;
+            if (!chunk || !chunk->blocks.Empty() || chunk->generating) continue;
             chunk->generating = true;
 
             GenJob job{};
@@ -528,47 +577,45 @@ public:
             job.cz = static_cast<S32>(chunk->cz);
             job.origin = chunk->origin;
             job.bs = cfg->blockSize;
+            job.columns = columns;
+            job.store = regionStore;
+            job.pool = pool;
 
             {
-                std::lock_guard lk{s_Mutex};
-                s_Jobs.push_back(job);
+                std::lock_guard lk{m_Mutex};
+                m_Jobs.push_back(job);
             }
-            s_CV.notify_one();
+            m_CV.notify_one();
             --enqueueLeft;
         }
 
+        auto const* index{FindVoxelChunkIndex(view)};
         U32 applyLeft{sc->generateBudget};
+        S64 generated{0}, loaded{0};
         {
-            std::lock_guard lk{s_ReadyMutex};
-            while (applyLeft > 0u && !s_Ready.empty()) {
-                auto res{std::move(s_Ready.front())};
-                s_Ready.pop_front();
+            std::lock_guard lk{m_ReadyMutex};
+            while (applyLeft > 0u && !m_Ready.empty()) {
+                auto res{std::move(m_Ready.front())};
+                m_Ready.pop_front();
                 auto* chunk{world->GetComponent<VoxelChunk>(res.h)};
                 if (chunk) {
                     chunk->blocks = std::move(res.blocks);
-                    chunk->dirty = true;
+                    chunk->MarkDirty();
                     chunk->generating = false;
-
-                    // Mark neighbor chunks as dirty
-                    if (auto* store{world->GetStorage<VoxelChunk>()}) {
-                        for (auto [hh, cc] : *store) {
-                            if (cc.cx + 1 == chunk->cx && cc.cy == chunk->cy && cc.cz == chunk->cz)
-                                const_cast<VoxelChunk&>(cc).dirty = true;
-                            if (cc.cx == chunk->cx + 1 && cc.cy == chunk->cy && cc.cz == chunk->cz)
-                                const_cast<VoxelChunk&>(cc).dirty = true;
-                            if (cc.cy + 1 == chunk->cy && cc.cx == chunk->cx && cc.cz == chunk->cz)
-                                const_cast<VoxelChunk&>(cc).dirty = true;
-                            if (cc.cy == chunk->cy + 1 && cc.cx == chunk->cx && cc.cz == chunk->cz)
-                                const_cast<VoxelChunk&>(cc).dirty = true;
-                            if (cc.cz + 1 == chunk->cz && cc.cx == chunk->cx && cc.cy == chunk->cy)
-                                const_cast<VoxelChunk&>(cc).dirty = true;
-                            if (cc.cz == chunk->cz + 1 && cc.cx == chunk->cx && cc.cy == chunk->cy)
-                                const_cast<VoxelChunk&>(cc).dirty = true;
-                        }
-                    }
+                    // Only edits make a chunk worth saving; generated terrain is regenerated.
+                    chunk->modified = false;
+                    ++(res.fromStore ? loaded : generated);
+
+                    if (index) MarkChunkNeighborsDirty(world, *index, *chunk);
+                } else if (pool) {
+                    // The chunk was unloaded while generating.
+                    pool->Recycle(res.blocks);
                 }
                 --applyLeft;
             }
         }
+
+        if (generated > 0) TaskProfiler::Get().AddCounter("ChunksGenerated", generated);
+        if (loaded > 0) TaskProfiler::Get().AddCounter("ChunksLoaded", loaded);
     }
 };
\ No newline at end of file
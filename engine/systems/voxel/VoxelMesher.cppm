@@ -0,0 +1,348 @@
+export module Systems.VoxelMesher;
+
+import Components.Voxel;
+import Core.Types;
+import Core.Assert;
+import std;
+
+export enum class VoxelMesherKind : U8 {
+    Greedy,
+    Binary
+};
+
+export enum VoxelNeighbor : U32 { NeighborNX, NeighborPX, NeighborNY, NeighborPY, NeighborNZ, NeighborPZ, NeighborCount };
+
+// Everything a mesher needs to build one chunk. Only the six face neighbours can
+// influence the output since faces never look past a single chunk boundary.
+export struct VoxelMeshInput {
+    VoxelBlocks const* center{nullptr};
+    std::array<VoxelBlocks const*, NeighborCount> neighbors{};
+};
+
+// Output of one meshing pass: four vertices and six indices per merged quad.
+export struct VoxelMeshBuffers {
+    Vector<ChunkVertex> vertices{};
+    Vector<U32> indices{};
+
+    void Clear() { vertices.clear(); indices.clear(); }
+};
+
+namespace detail {
+    inline void AddFace(VoxelMeshBuffers& out, std::array<ChunkVertexData, 4> const& corners, bool cw) {
+        const U32 base{static_cast<U32>(out.vertices.size())};
+        for (auto const& c : corners) out.vertices.push_back(PackChunkVertex(c));
+        if (cw) out.indices.insert(out.indices.end(), {base, base + 1u, base + 2u, base, base + 2u, base + 3u});
+        else out.indices.insert(out.indices.end(), {base + 3u, base + 2u, base + 1u, base + 3u, base + 1u, base});
+    }
+}
+
+namespace {
+    enum Face : U32 { NX, PX, NY, PY, NZ, PZ };
+
+    constexpr U32 TILE_DIRT{0u};
+    constexpr U32 TILE_GRASS_SIDE{1u};
+    constexpr U32 TILE_GRASS_TOP{2u};
+    constexpr U32 TILE_STONE{3u};
+    constexpr U32 TILE_LOG{4u};
+    constexpr U32 TILE_LOG_TOP{5u};
+    constexpr U32 TILE_LEAVES{6u};
+    constexpr U32 TILE_SAND{7u};
+    constexpr U32 TILE_WATER{8u};
+
+    struct MaterialDef { std::array<U32, 6> face; };
+
+    constexpr std::array<U32, 6> MakeBlock(U32 tile) { return {tile, tile, tile, tile, tile, tile}; }
+    constexpr std::array<U32, 6> MakeBlock(U32 tile, U32 tileTopAndBottom) { return {tile, tile, tileTopAndBottom, tileTopAndBottom, tile, tile}; }
+    constexpr std::array<U32, 6> MakeBlock(U32 tileTop, U32 tileBottom, U32 tileSide) { return {tileSide, tileSide, tileBottom, tileTop, tileSide, tileSide}; }
+
+    constexpr MaterialDef kMatLUT[]{
+        {{0,0,0,0,0,0}},
+        {MakeBlock(TILE_DIRT)},
+        {{MakeBlock(TILE_GRASS_TOP, TILE_DIRT, TILE_GRASS_SIDE)}},
+        {{MakeBlock(TILE_STONE)}},
+        {{MakeBlock(TILE_LOG, TILE_LOG_TOP)}},
+        {{MakeBlock(TILE_LEAVES)}},
+        {{MakeBlock(TILE_SAND)}},
+        {{MakeBlock(TILE_WATER)}},
+    };
+
+    inline U32 FaceOf(S32 axis, bool back) {
+        if (axis == 0) return back ? NX : PX;
+        if (axis == 1) return back ? NY : PY;
+        return back ? NZ : PZ;
+    }
+
+    inline U32 TileOf(Voxel owner, S32 axis, bool back) {
+        return kMatLUT[static_cast<U32>(owner)].face[FaceOf(axis, back)];
+    }
+
+    constexpr U32 BACK_BIT{0x80000000u};
+    inline U32 PackMask(U32 tile, bool back) { return (tile + 1u) | (back ? BACK_BIT : 0u); }
+    inline bool MaskBack(U32 key) { return (key & BACK_BIT) != 0u; }
+    inline U32 MaskTile(U32 key) { return (key & ~BACK_BIT) - 1u; }
+
+    constexpr S32 N{static_cast<S32>(VoxelChunk::SizeX)};
+    static_assert(VoxelChunk::SizeX == 32 && VoxelChunk::SizeY == 32 && VoxelChunk::SizeZ == 32,
+                  "Binary mesher packs one chunk row into a 32-bit mask");
+
+    // Writes one merged quad. Both meshers share it so their output stays byte-identical.
+    void EmitQuad(VoxelMeshBuffers& out, S32 d, S32 slice, S32 i, S32 j, S32 w, S32 h, U32 key) {
+        const S32 u{(d + 1) % 3};
+        const S32 v{(d + 2) % 3};
+
+        S32 a[4][3]{};
+        a[0][d]=slice; a[0][u]=i;   a[0][v]=j;
+        a[1][d]=slice; a[1][u]=i;   a[1][v]=j+h;
+        a[2][d]=slice; a[2][u]=i+w; a[2][v]=j+h;
+        a[3][d]=slice; a[3][u]=i+w; a[3][v]=j;
+
+        const U32 uw{static_cast<U32>(w)}, uh{static_cast<U32>(h)};
+        U32 t[4][2]{};
+        if (d == 0 || d == 1) {
+            t[1][0] = uh;
+            t[2][0] = uh; t[2][1] = uw;
+            t[3][1] = uw;
+        } else {
+            t[1][1] = uh;
+            t[2][0] = uw; t[2][1] = uh;
+            t[3][0] = uw;
+        }
+
+        const U32 face{FaceOf(d, MaskBack(key))};
+        std::array<ChunkVertexData, 4> corners{};
+        for (U32 k{}; k < 4u; ++k) {
+            corners[k] = ChunkVertexData{
+                static_cast<U32>(a[k][0]), static_cast<U32>(a[k][1]), static_cast<U32>(a[k][2]),
+                face, t[k][0], t[k][1], MaskTile(key)
+            };
+        }
+
+        detail::AddFace(out, corners, !MaskBack(key));
+    }
+
+    Vector<Voxel>& ExpandCenter(VoxelMeshInput const& in) {
+        static thread_local Vector<Voxel> center{};
+        center.resize(VoxelBlocks::Volume);
+        in.center->CopyTo(center);
+        return center;
+    }
+
+    // Voxel owning the face between cells slice-1 and slice along axis d, looking
+    // into the neighbour chunk when that cell lies outside the chunk.
+    Voxel OwnerAt(VoxelMeshInput const& in, Vector<Voxel> const& center, S32 d, S32 cell, S32 cu, S32 cv) {
+        S32 p[3]{};
+        p[d] = cell; p[(d + 1) % 3] = cu; p[(d + 2) % 3] = cv;
+        VoxelBlocks const* nb{nullptr};
+        if (cell < 0) { nb = in.neighbors[static_cast<USize>(d) * 2u]; p[d] += N; }
+        else if (cell >= N) { nb = in.neighbors[static_cast<USize>(d) * 2u + 1u]; p[d] -= N; }
+        else return center[VoxelIndex(static_cast<U32>(p[0]), static_cast<U32>(p[1]), static_cast<U32>(p[2]))];
+        if (!nb) return Voxel::Air;
+        return nb->Get(VoxelIndex(static_cast<U32>(p[0]), static_cast<U32>(p[1]), static_cast<U32>(p[2])));
+    }
+}
+
+export void MeshChunkGreedy(VoxelMeshInput const& in, VoxelMeshBuffers& out) {
+    Vector<Voxel> const& center{ExpandCenter(in)};
+
+    auto sample = [&](S32 lx, S32 ly, S32 lz) -> Voxel {
+        if (lx >= 0 && ly >= 0 && lz >= 0 && lx < N && ly < N && lz < N) {
+            return center[VoxelIndex(static_cast<U32>(lx), static_cast<U32>(ly), static_cast<U32>(lz))];
+        }
+        if (lx < 0 || lx >= N) return OwnerAt(in, center, 0, lx, ly, lz);
+        if (ly < 0 || ly >= N) return OwnerAt(in, center, 1, ly, lz, lx);
+        return OwnerAt(in, center, 2, lz, lx, ly);
+    };
+
+    auto greedyAxis = [&](S32 d) {
+        S32 u{(d + 1) % 3};
+        S32 v{(d + 2) % 3};
+
+        static thread_local Vector<U32> mask;
+        constexpr USize maskSize{static_cast<USize>(N * N)};
+        if (mask.size() < maskSize) mask.resize(maskSize);
+        std::fill(mask.begin(), mask.begin() + maskSize, 0u);
+
+        S32 x[3]{0,0,0};
+        for (x[d]=0; x[d] <= N; ++x[d]) {
+            U32* m{mask.data()};
+            for (x[v]=0; x[v] < N; ++x[v]) {
+                for (x[u]=0; x[u] < N; ++x[u]) {
+                    S32 ax{x[0]}, ay{x[1]}, az{x[2]};
+                    S32 bx{ax}, by{ay}, bz{az};
+                    if (d==0) --ax; else if (d==1) --ay; else --az;
+
+                    Voxel va{sample(ax,ay,az)};
+                    Voxel vb{sample(bx,by,bz)};
+                    bool sa{va != Voxel::Air};
+                    bool sb{vb != Voxel::Air};
+
+                    if (sa != sb) {
+                        bool back{!sa};
+                        Voxel owner{back ? vb : va};
+                        *m = PackMask(TileOf(owner, d, back), back);
+                    } else {
+                        *m = 0u;
+                    }
+                    ++m;
+                }
+            }
+
+            S32 j{};
+            while (j < N) {
+                S32 i{};
+                while (i < N) {
+                    U32 key{mask[static_cast<USize>(i + j * N)]};
+                    if (key == 0u) { ++i; continue; }
+
+                    S32 w{1};
+                    while (i + w < N) {
+                        if (mask[static_cast<USize>(i + w + j * N)] != key) break;
+                        ++w;
+                    }
+
+                    S32 h{1}; bool extend{true};
+                    while (j + h < N && extend) {
+                        for (S32 k{}; k < w; ++k) {
+                            if (mask[static_cast<USize>(i + k + (j + h) * N)] != key) { extend = false; break; }
+                        }
+                        if (extend) ++h;
+                    }
+
+                    EmitQuad(out, d, x[d], i, j, w, h, key);
+
+                    for (S32 y{}; y < h; ++y) {
+                        USize base{static_cast<USize>((j + y) * N + i)};
+                        std::fill_n(mask.data() + base, static_cast<USize>(w), 0u);
+                    }
+                    i += w;
+                }
+                ++j;
+            }
+        }
+    };
+
+    greedyAxis(0); greedyAxis(1); greedyAxis(2);
+}
+
+// Same quads as MeshChunkGreedy, found with bit operations: every (u,v) column of the
+// chunk along an axis is one 64-bit occupancy word (bit 0 and bit N+1 hold the
+// neighbour border), faces are `col & ~(col >> 1)` and `~col & (col >> 1)`, and merging
+// runs over per-(tile, side) row masks with bit scans in the same row-major order.
+export void MeshChunkBinary(VoxelMeshInput const& in, VoxelMeshBuffers& out) {
+    Vector<Voxel> const& center{ExpandCenter(in)};
+
+    constexpr U32 kMaxTiles{16u};
+    constexpr USize kColumns{static_cast<USize>(N * N)};
+    constexpr USize kSliceRows{static_cast<USize>((N + 1) * N)};
+    constexpr U64 kFaceBits{(1ull << (N + 1)) - 1ull};
+
+    static thread_local std::array<std::array<U64, kColumns>, 3> cols{};
+    static thread_local Vector<U32> rows(static_cast<USize>(kMaxTiles) * 2u * kSliceRows, 0u);
+
+    for (auto& axis : cols) axis.fill(0ull);
+
+    for (S32 z{}; z < N; ++z) {
+        for (S32 y{}; y < N; ++y) {
+            Voxel const* row{center.data() + VoxelIndex(0u, static_cast<U32>(y), static_cast<U32>(z))};
+            U64& colX{cols[0][static_cast<USize>(y + z * N)]};
+            for (S32 x{}; x < N; ++x) {
+                if (row[x] == Voxel::Air) continue;
+                colX |= 1ull << (x + 1);
+                cols[1][static_cast<USize>(z + x * N)] |= 1ull << (y + 1);
+                cols[2][static_cast<USize>(x + y * N)] |= 1ull << (z + 1);
+            }
+        }
+    }
+
+    for (S32 d{}; d < 3; ++d) {
+        VoxelBlocks const* lo{in.neighbors[static_cast<USize>(d) * 2u]};
+        VoxelBlocks const* hi{in.neighbors[static_cast<USize>(d) * 2u + 1u]};
+        if (!lo && !hi) continue;
+        for (S32 cv{}; cv < N; ++cv) {
+            for (S32 cu{}; cu < N; ++cu) {
+                U64& col{cols[static_cast<USize>(d)][static_cast<USize>(cu + cv * N)]};
+                if (lo && OwnerAt(in, center, d, -1, cu, cv) != Voxel::Air) col |= 1ull;
+                if (hi && OwnerAt(in, center, d, N, cu, cv) != Voxel::Air) col |= 1ull << (N + 1);
+            }
+        }
+    }
+
+    for (S32 d{}; d < 3; ++d) {
+        U32 usedSlots{0};
+        auto slotRows = [&](U32 slot, S32 slice) -> U32* {
+            return rows.data() + static_cast<USize>(slot) * kSliceRows + static_cast<USize>(slice * N);
+        };
+
+        for (S32 cv{}; cv < N; ++cv) {
+            for (S32 cu{}; cu < N; ++cu) {
+                const U64 col{cols[static_cast<USize>(d)][static_cast<USize>(cu + cv * N)]};
+                const U64 front{col & ~(col >> 1) & kFaceBits};
+                const U64 back{~col & (col >> 1) & kFaceBits};
+
+                for (U64 bits{front}; bits; bits &= bits - 1ull) {
+                    const S32 slice{std::countr_zero(bits)};
+                    const U32 tile{TileOf(OwnerAt(in, center, d, slice - 1, cu, cv), d, false)};
+                    assert(tile < kMaxTiles, "Tile index exceeds binary mesher slots");
+                    const U32 slot{tile * 2u};
+                    usedSlots |= 1u << slot;
+                    slotRows(slot, slice)[cv] |= 1u << cu;
+                }
+                for (U64 bits{back}; bits; bits &= bits - 1ull) {
+                    const S32 slice{std::countr_zero(bits)};
+                    const U32 tile{TileOf(OwnerAt(in, center, d, slice, cu, cv), d, true)};
+                    assert(tile < kMaxTiles, "Tile index exceeds binary mesher slots");
+                    const U32 slot{tile * 2u + 1u};
+                    usedSlots |= 1u << slot;
+                    slotRows(slot, slice)[cv] |= 1u << cu;
+                }
+            }
+        }
+
+        for (S32 slice{}; slice <= N; ++slice) {
+            for (S32 j{}; j < N; ++j) {
+                U32 pending{0};
+                for (U32 slots{usedSlots}; slots; slots &= slots - 1u) {
+                    pending |= slotRows(static_cast<U32>(std::countr_zero(slots)), slice)[j];
+                }
+
+                while (pending) {
+                    const S32 i{std::countr_zero(pending)};
+                    U32 slot{0};
+                    for (U32 slots{usedSlots}; slots; slots &= slots - 1u) {
+                        slot = static_cast<U32>(std::countr_zero(slots));
+                        if (slotRows(slot, slice)[j] & (1u << i)) break;
+                    }
+
+                    U32* sliceRows{slotRows(slot, slice)};
+                    const S32 w{std::countr_one(sliceRows[j] >> i)};
+                    const U32 run{static_cast<U32>(((1ull << w) - 1ull) << i)};
+
+                    S32 h{1};
+                    while (j + h < N && (sliceRows[j + h] & run) == run) ++h;
+                    for (S32 y{}; y < h; ++y) sliceRows[j + y] &= ~run;
+                    pending &= ~run;
+
+                    EmitQuad(out, d, slice, i, j, w, h, PackMask(slot >> 1, (slot & 1u) != 0u));
+                }
+            }
+        }
+
+        for (U32 slots{usedSlots}; slots; slots &= slots - 1u) {
+            U32* slotBase{slotRows(static_cast<U32>(std::countr_zero(slots)), 0)};
+            std::fill_n(slotBase, kSliceRows, 0u);
+        }
+    }
+}
+
+export void MeshChunk(VoxelMesherKind kind, VoxelMeshInput const& in, VoxelMeshBuffers& out) {
+    assert(in.center && !in.center->Empty(), "Chunk must be generated");
+    out.Clear();
+    if (in.center->IsUniform() && in.center->Get(0) == Voxel::Air) return;
+
+    constexpr U32 reserveQuads{2u * static_cast<U32>(3 * N * N)};
+    out.vertices.reserve(4u * reserveQuads);
+    out.indices.reserve(6u * reserveQuads);
+
+    if (kind == VoxelMesherKind::Binary) MeshChunkBinary(in, out);
+    else MeshChunkGreedy(in, out);
+}
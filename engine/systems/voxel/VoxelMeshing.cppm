@@ -5,81 +5,173 @@ import ECS.SystemScheduler;
 import ECS.World;
 import Graphics;
 import Components.Voxel;
+import Systems.VoxelMesher;
+import Systems.VoxelBufferPool;
 import Components.VoxelStreaming;
+import Components.VoxelChunkIndex;
 import Systems.CameraManager;
 import Components.Transform;
 import Components.Camera;
+import Tasks.TaskProfiler;
+import Core.FrameArena;
 import Core.Types;
 import Core.Assert;
 import Math.Core;
 import Math.Vector;
 import Math.Matrix;
 import Math.Transform;
+import Math.Culling;
 import std;
 
-namespace detail {
-    inline void PushTri(Vector<Vertex>& out, Math::Vec3 const& a, Math::Vec3 const& b, Math::Vec3 const& c, Math::Vec3 const& n, Math::Vec2 const& uva, Math::Vec2 const& uvb, Math::Vec2 const& uvc, U32 mat) {
-        Vertex va{}; va.position[0]=a.x; va.position[1]=a.y; va.position[2]=a.z; va.normal[0]=n.x; va.normal[1]=n.y; va.normal[2]=n.z; va.uv[0]=uva.x; va.uv[1]=uva.y; va.material=mat;
-        Vertex vb{}; vb.position[0]=b.x; vb.position[1]=b.y; vb.position[2]=b.z; vb.normal[0]=n.x; vb.normal[1]=n.y; vb.normal[2]=n.z; vb.uv[0]=uvb.x; vb.uv[1]=uvb.y; vb.material=mat;
-        Vertex vc{}; vc.position[0]=c.x; vc.position[1]=c.y; vc.position[2]=c.z; vc.normal[0]=n.x; vc.normal[1]=n.y; vc.normal[2]=n.z; vc.uv[0]=uvc.x; vc.uv[1]=uvc.y; vc.material=mat;
-        out.push_back(va); out.push_back(vb); out.push_back(vc);
-    }
-    inline void AddFace(Vector<Vertex>& out, Math::Vec3 const& p0, Math::Vec3 const& p1, Math::Vec3 const& p2, Math::Vec3 const& p3, Math::Vec3 const& n, Math::Vec2 const& uv0, Math::Vec2 const& uv1, Math::Vec2 const& uv2, Math::Vec2 const& uv3, U32 mat, bool cw) {
-        if (cw) { PushTri(out, p0, p1, p2, n, uv0, uv1, uv2, mat); PushTri(out, p0, p2, p3, n, uv0, uv2, uv3, mat); }
-        else { PushTri(out, p3, p2, p1, n, uv3, uv2, uv1, mat); PushTri(out, p3, p1, p0, n, uv3, uv1, uv0, mat); }
-    }
-}
-
-namespace {
-    enum Face : U32 { NX, PX, NY, PY, NZ, PZ };
-
-    constexpr U32 TILE_DIRT{0u};
-    constexpr U32 TILE_GRASS_SIDE{1u};
-    constexpr U32 TILE_GRASS_TOP{2u};
-    constexpr U32 TILE_STONE{3u};
-    constexpr U32 TILE_LOG{4u};
-    constexpr U32 TILE_LOG_TOP{5u};
-    constexpr U32 TILE_LEAVES{6u};
-    constexpr U32 TILE_SAND{7u};
-    constexpr U32 TILE_WATER{8u};
-
-    struct MaterialDef { std::array<U32, 6> face; };
-
-    constexpr std::array<U32, 6> MakeBlock(U32 tile) { return {tile, tile, tile, tile, tile, tile}; }
-    constexpr std::array<U32, 6> MakeBlock(U32 tile, U32 tileTopAndBottom) { return {tile, tile, tileTopAndBottom, tileTopAndBottom, tile, tile}; }
-    constexpr std::array<U32, 6> MakeBlock(U32 tileTop, U32 tileBottom, U32 tileSide) { return {tileSide, tileSide, tileBottom, tileTop, tileSide, tileSide}; }
-
-    constexpr MaterialDef kMatLUT[]{
-        {{0,0,0,0,0,0}},
-        {MakeBlock(TILE_DIRT)},
-        {{MakeBlock(TILE_GRASS_TOP, TILE_DIRT, TILE_GRASS_SIDE)}},
-        {{MakeBlock(TILE_STONE)}},
-        {{MakeBlock(TILE_LOG, TILE_LOG_TOP)}},
-        {{MakeBlock(TILE_LEAVES)}},
-        {{MakeBlock(TILE_SAND)}},
-        {{MakeBlock(TILE_WATER)}},
+// Dirty chunks whose center lies further behind the view direction than this cosine wait,
+// even when a corner pokes into the frustum.
+export constexpr F32 VoxelMeshingConeCos{-0.25f};
+
+export class VoxelMeshingSystem : public System<VoxelMeshingSystem> {
+    // Immutable copy of everything the mesher reads, so workers never touch the World.
+    struct MeshJob {
+        EntityHandle h;
+        U32 revision;
+        VoxelMesherKind kind;
+        VoxelBlocks center;
+        std::array<VoxelBlocks, NeighborCount> neighbors;
+        std::array<bool, NeighborCount> hasNeighbor;
+        U32 vertexHint;
+        std::shared_ptr<VoxelBufferPool> pool;
     };
 
-    inline U32 FaceOf(S32 axis, bool back) {
-        if (axis == 0) return back ? NX : PX;
-        if (axis == 1) return back ? NY : PY;
-        return back ? NZ : PZ;
+    struct MeshResult {
+        EntityHandle h;
+        U32 revision;
+        VoxelMeshBuffers buffers;
+    };
+
+    static constexpr U32 kMaxJobsPerWorker{2};
+    static constexpr U32 kMinVertexReserve{1024};
+
+    // Each system owns its workers: started in Setup, stopped and joined on destruction, so
+    // a later World's mesher gets a fresh pool.
+    Vector<std::thread> m_Workers{};
+    std::mutex m_Mutex{};
+    std::condition_variable m_CV{};
+    std::deque<MeshJob> m_Jobs{};
+    bool m_Stop{false};
+    std::mutex m_ReadyMutex{};
+    std::deque<MeshResult> m_Ready{};
+    std::atomic<U32> m_InFlight{0};
+
+    VoxelMesherKind m_Mesher{VoxelMesherKind::Binary};
+    // Chunks waiting for a mesh, culled together each frame. A chunk takes a slot when it is
+    // first seen dirty and keeps it, bounds included, until it no longer needs meshing or is
+    // gone; VoxelChunk::meshSlot is its slot.
+    Math::BoundsSoA m_DirtyBounds{};
+    Vector<EntityHandle> m_DirtyHandles{};
+    Vector<U8> m_DirtyEdited{};
+    Vector<U32> m_DirtySeen{};
+    U32 m_Scan{0};
+    Math::CullResult m_DirtyCull{};
+
+    void MeshJobRun(MeshJob& job) {
+        VoxelMeshInput input{};
+        input.center = &job.center;
+        for (U32 n{}; n < NeighborCount; ++n) {
+            input.neighbors[n] = job.hasNeighbor[n] ? &job.neighbors[n] : nullptr;
+        }
+
+        // Sized from the chunk's previous mesh; six indices per four vertices.
+        VoxelMeshBuffers buffers{};
+        if (job.pool) {
+            const USize vertices{std::max(job.vertexHint, kMinVertexReserve)};
+            buffers.vertices = job.pool->Vertices().Acquire(vertices);
+            buffers.indices = job.pool->Indices().Acquire(vertices * 3 / 2);
+        }
+        {
+            ProfileZone zone{"MeshChunk"};
+            MeshChunk(job.kind, input, buffers);
+        }
+        if (job.pool) {
+            job.pool->Recycle(job.center);
+            for (auto& nb : job.neighbors) job.pool->Recycle(nb);
+        }
+
+        {
+            std::lock_guard lk{m_ReadyMutex};
+            m_Ready.push_back(MeshResult{job.h, job.revision, std::move(buffers)});
+        }
+    }
+
+    void StartPool(U32 threads) {
+        if (!m_Workers.empty()) return;
+        const U32 n{threads ? threads : std::max(2u, std::thread::hardware_concurrency() / 2u)};
+        for (U32 i{}; i < n; ++i) {
+            m_Workers.emplace_back([this]() {
+                for (;;) {
+                    MeshJob job{};
+                    {
+                        std::unique_lock lk{m_Mutex};
+                        m_CV.wait(lk, [this]{ return m_Stop || !m_Jobs.empty(); });
+                        if (m_Stop) return;
+                        job = std::move(m_Jobs.front());
+                        m_Jobs.pop_front();
+                    }
+
+                    MeshJobRun(job);
+                }
+            });
+        }
     }
 
-    inline U64 PackKey(S32 x, S32 y, S32 z) {
-        constexpr U64 B{1ull << 20};
-        return (static_cast<U64>(static_cast<S64>(x) + static_cast<S64>(B)))
-             | (static_cast<U64>(static_cast<S64>(y) + static_cast<S64>(B)) << 21)
-             | (static_cast<U64>(static_cast<S64>(z) + static_cast<S64>(B)) << 42);
+    // Publishes finished meshes; results for chunks edited since the snapshot are dropped
+    // and the chunk, still dirty, gets meshed again.
+    void ApplyResults(World* world) {
+        std::deque<MeshResult> ready{};
+        {
+            std::lock_guard lk{m_ReadyMutex};
+            ready.swap(m_Ready);
+        }
+
+        auto* pool{FindVoxelBufferPool(world)};
+        auto recycle = [pool](Vector<ChunkVertex>& vertices, Vector<U32>& indices) {
+            if (!pool) return;
+            pool->Vertices().Release(std::move(vertices));
+            pool->Indices().Release(std::move(indices));
+        };
+
+        S64 published{0};
+        for (auto& res : ready) {
+            m_InFlight.fetch_sub(1);
+            auto* mesh{world->GetComponent<VoxelMesh>(res.h)};
+            auto const* chunk{world->GetComponent<VoxelChunk>(res.h)};
+            if (!mesh || !chunk) { recycle(res.buffers.vertices, res.buffers.indices); continue; }
+
+            mesh->meshing = false;
+            if (chunk->revision != res.revision) { recycle(res.buffers.vertices, res.buffers.indices); continue; }
+
+            // A mesh that was never uploaded is replaced.
+            recycle(mesh->readyVertices, mesh->readyIndices);
+            mesh->readyVertices = std::move(res.buffers.vertices);
+            mesh->readyIndices = std::move(res.buffers.indices);
+            mesh->gpuDirty = true;
+            ++published;
+        }
+        if (published > 0) TaskProfiler::Get().AddCounter("ChunksMeshed", published);
     }
 
-    constexpr U32 BACK_BIT{0x80000000u};
-    inline U32 PackMask(U32 tile, bool back) { return (tile + 1u) | (back ? BACK_BIT : 0u); }
-    inline bool MaskBack(U32 key) { return (key & BACK_BIT) != 0u; }
-    inline U32 MaskTile(U32 key) { return (key & ~BACK_BIT) - 1u; }
-}
+    // Swap-removes a dirty slot, fixing up the chunks that owned it and the entry moved into it.
+    void RemoveDirty(World* world, U32 slot) {
+        if (auto* c{world->GetComponent<VoxelChunk>(m_DirtyHandles[slot])}; c && c->meshSlot == slot) c->meshSlot = INVALID_INDEX;
+        const U32 last{m_DirtyBounds.RemoveSwap(slot)};
+        if (last != slot) {
+            m_DirtyHandles[slot] = m_DirtyHandles[last];
+            m_DirtyEdited[slot] = m_DirtyEdited[last];
+            m_DirtySeen[slot] = m_DirtySeen[last];
+            if (auto* c{world->GetComponent<VoxelChunk>(m_DirtyHandles[slot])}; c && c->meshSlot == last) c->meshSlot = slot;
+        }
+        m_DirtyHandles.pop_back();
+        m_DirtyEdited.pop_back();
+        m_DirtySeen.pop_back();
+    }
 
-export class VoxelMeshingSystem : public System<VoxelMeshingSystem> {
 public:
     void Setup() {
         SetName("VoxelMeshing");
@@ -87,237 +179,140 @@ public:
         SetPriority(SystemPriority::High);
         RunBefore("VoxelUpload");
         SetParallel(false);
+        ReadsComponents<VoxelWorldConfig, VoxelStreamingConfig, VoxelChunkIndex, Camera, Transform, VoxelBufferPoolResource>();
+        WritesComponents<VoxelChunk, VoxelMesh>();
+        StartPool(0);
+    }
+
+    ~VoxelMeshingSystem() {
+        {
+            std::lock_guard lk{m_Mutex};
+            m_Stop = true;
+        }
+        m_CV.notify_all();
+        for (auto &t : m_Workers) if (t.joinable()) t.join();
     }
 
+    void SetMesher(VoxelMesherKind kind) { m_Mesher = kind; }
+    [[nodiscard]] VoxelMesherKind GetMesher() const { return m_Mesher; }
+
     void Run(World* world, F32) override {
-        auto* cfgStore{world->GetStorage<VoxelWorldConfig>()};
+        World const* view{world};
+        auto* cfgStore{view->GetStorage<VoxelWorldConfig>()};
         assert(cfgStore && cfgStore->Size() > 0, "Missing VoxelWorldConfig");
         VoxelWorldConfig const* cfg{}; for (auto [h,c] : *cfgStore) { cfg = &c; break; }
 
-        auto* scStore{world->GetStorage<VoxelStreamingConfig>()};
+        auto* scStore{view->GetStorage<VoxelStreamingConfig>()};
         assert(scStore && scStore->Size() > 0, "Missing VoxelStreamingConfig");
         VoxelStreamingConfig const* sc{}; for (auto [h,c] : *scStore) { sc = &c; break; }
 
+        ApplyResults(world);
+
         auto* chunkStore{world->GetStorage<VoxelChunk>()};
         if (!chunkStore) return;
 
-        const USize kCount{static_cast<USize>(VoxelChunk::SizeX) * VoxelChunk::SizeY * VoxelChunk::SizeZ};
-
-        UnorderedMap<U64, VoxelChunk const*> chunkMap{};
-        chunkMap.reserve(chunkStore->Size());
-        for (auto [h,c] : *chunkStore) {
-            if (c.blocks.size() != kCount) continue;
-            U64 k{PackKey(static_cast<S32>(c.cx), static_cast<S32>(c.cy), static_cast<S32>(c.cz))};
-            chunkMap.emplace(k, &c);
-        }
+        auto const* index{FindVoxelChunkIndex(view)};
+        if (!index) return;
 
         Math::Vec3 camPos{};
         Math::Vec3 camDir{};
         Math::Frustum fr{};
         bool haveFrustum{false};
         if (auto h{CameraManager::GetPrimaryCamera()}; h.valid()) {
-            if (auto* c{world->GetComponent<Camera>(h)}) { fr.SetFromMatrix(c->viewProjection); haveFrustum = true; }
-            if (auto* t{world->GetComponent<Transform>(h)}) { camPos = t->position; camDir = t->Forward(); }
+            if (auto* c{view->GetComponent<Camera>(h)}) { fr.SetFromMatrix(c->viewProjection); haveFrustum = true; }
+            if (auto* t{view->GetComponent<Transform>(h)}) { camPos = t->position; camDir = t->Forward(); }
         }
 
         const F32 sx{cfg->blockSize * static_cast<F32>(VoxelChunk::SizeX)};
         const F32 sy{cfg->blockSize * static_cast<F32>(VoxelChunk::SizeY)};
         const F32 sz{cfg->blockSize * static_cast<F32>(VoxelChunk::SizeZ)};
 
-        struct Item { F32 score; EntityHandle h; };
-        Vector<Item> dirty{};
-        dirty.reserve(chunkStore->Size());
+        // The scan only reads flags; slots of chunks that were meshed, emptied or unloaded are
+        // not marked seen and are dropped after it.
+        ++m_Scan;
         for (auto [h,c] : *chunkStore) {
-            if (!c.dirty || c.generating || c.blocks.size() != kCount) continue;
-            Math::Bounds b{c.origin, c.origin + Math::Vec3{sx, sy, sz}};
-            if (haveFrustum && !fr.Intersects(b)) continue;
-            Math::Vec3 center{c.origin.x + 0.5f * sx, c.origin.y + 0.5f * sy, c.origin.z + 0.5f * sz};
-            Math::Vec3 toC{center - camPos};
-            F32 d2{toC.LengthSquared()};
-            F32 cosA{d2 > 1e-6f ? camDir.Dot(toC.Normalized()) : 1.0f};
-            if (cosA < -0.25f) continue;
-            F32 score{d2 * (2.0f - std::clamp(cosA, -1.0f, 1.0f))};
-            dirty.push_back(Item{score, h});
+            if (c.meshSlot != INVALID_INDEX && (c.meshSlot >= m_DirtyHandles.size() || m_DirtyHandles[c.meshSlot] != h)) {
+                c.meshSlot = INVALID_INDEX;
+            }
+            if (!c.dirty || c.generating || c.blocks.Empty()) continue;
+            if (c.meshSlot == INVALID_INDEX) {
+                c.meshSlot = m_DirtyBounds.Add(Math::Bounds{c.origin, c.origin + Math::Vec3{sx, sy, sz}});
+                m_DirtyHandles.push_back(h);
+                m_DirtyEdited.push_back(0u);
+                m_DirtySeen.push_back(0u);
+            }
+            m_DirtyEdited[c.meshSlot] = !c.edited.Empty();
+            m_DirtySeen[c.meshSlot] = m_Scan;
+        }
+        for (U32 slot{m_DirtyBounds.Size()}; slot-- > 0u;) {
+            if (m_DirtySeen[slot] != m_Scan) RemoveDirty(world, slot);
+        }
+        if (m_DirtyHandles.empty()) return;
+
+        // Chunks well behind the camera wait; the rest are meshed nearest and most central
+        // first, with chunks touched by edits ahead of streaming remeshes so edits show up
+        // in the next frames.
+        Math::CullViewCone(haveFrustum ? &fr : nullptr, camPos, camDir, VoxelMeshingConeCos, m_DirtyBounds, m_DirtyCull);
+
+        struct Item { bool edited; F32 score; EntityHandle h; };
+        FrameVector<Item> dirty{FrameArena::Resource()};
+        dirty.reserve(m_DirtyCull.indices.size());
+        for (USize k{}; k < m_DirtyCull.indices.size(); ++k) {
+            const U32 i{m_DirtyCull.indices[k]};
+            const F32 score{m_DirtyCull.distanceSq[k] * (2.0f - std::clamp(m_DirtyCull.cosine[k], -1.0f, 1.0f))};
+            dirty.push_back(Item{m_DirtyEdited[i] != 0u, score, m_DirtyHandles[i]});
         }
 
         if (dirty.empty()) return;
-        std::ranges::sort(dirty, {}, &Item::score);
+        std::ranges::sort(dirty, [](Item const& a, Item const& b) {
+            return a.edited != b.edited ? a.edited : a.score < b.score;
+        });
 
+        std::shared_ptr<VoxelBufferPool> pool{};
+        if (auto* bpStore{view->GetStorage<VoxelBufferPoolResource>()}) {
+            for (auto [h,c] : *bpStore) { pool = c.pool; break; }
+        }
+
+        const U32 maxInFlight{static_cast<U32>(m_Workers.size()) * kMaxJobsPerWorker};
         U32 left{sc->meshBudget};
         for (auto const& it : dirty) {
-            if (left == 0u) break;
+            if (left == 0u || m_InFlight.load() >= maxInFlight) break;
 
             auto* mesh{world->GetComponent<VoxelMesh>(it.h)};
-            auto const* chunk{world->GetComponent<VoxelChunk>(it.h)};
-            if (!mesh || !chunk || !chunk->dirty) continue;
-            assert(chunk->blocks.size() == kCount, "Chunk must be generated");
-
-            bool anySolid{false};
-            for (auto const& v : chunk->blocks) { if (v != Voxel::Air) { anySolid = true; break; } }
-            if (!anySolid) {
-                mesh->cpuVertices.clear();
-                mesh->vertexCount = 0u;
-                mesh->gpuDirty = true;
-                const_cast<VoxelChunk*>(chunk)->dirty = false;
-                --left;
-                continue;
+            auto* chunk{world->GetComponent<VoxelChunk>(it.h)};
+            if (!mesh || !chunk || !chunk->dirty || mesh->meshing) continue;
+
+            MeshJob job{};
+            job.h = it.h;
+            job.revision = chunk->revision;
+            job.kind = m_Mesher;
+            job.vertexHint = mesh->vertexCount;
+            job.pool = pool;
+            // Snapshots take their index storage from the pool and give it back once meshed.
+            auto copyBlocks = [&pool](VoxelBlocks& dst, VoxelBlocks const& src) {
+                if (pool) dst.CopyFrom(src, pool->WordSource());
+                else dst = src;
+            };
+            copyBlocks(job.center, chunk->blocks);
+            const S32 cx{static_cast<S32>(chunk->cx)};
+            const S32 cy{static_cast<S32>(chunk->cy)};
+            const S32 cz{static_cast<S32>(chunk->cz)};
+            constexpr S32 kOffsets[NeighborCount][3]{{-1,0,0},{1,0,0},{0,-1,0},{0,1,0},{0,0,-1},{0,0,1}};
+            for (U32 n{}; n < NeighborCount; ++n) {
+                auto const* nb{FindChunk(world, *index, cx + kOffsets[n][0], cy + kOffsets[n][1], cz + kOffsets[n][2])};
+                job.hasNeighbor[n] = nb && !nb->blocks.Empty();
+                if (job.hasNeighbor[n]) copyBlocks(job.neighbors[n], nb->blocks);
             }
 
-            mesh->cpuVertices.clear();
-
-            const F32 s{cfg->blockSize};
-            const S32 NX{static_cast<S32>(VoxelChunk::SizeX)};
-            const S32 NY{static_cast<S32>(VoxelChunk::SizeY)};
-            const S32 NZ{static_cast<S32>(VoxelChunk::SizeZ)};
-
-            U32 reserveCount{12u * static_cast<U32>(NX*NY + NY*NZ + NX*NZ)};
-            mesh->cpuVertices.reserve(reserveCount);
-
-            VoxelChunk const* nbChunk[3][3][3]{};
-            Voxel const* nbData[3][3][3]{};
-            for (S32 dz{-1}; dz<=1; ++dz) {
-                for (S32 dy{-1}; dy<=1; ++dy) {
-                    for (S32 dx{-1}; dx<=1; ++dx) {
-                        S32 ccx{static_cast<S32>(chunk->cx) + dx};
-                        S32 ccy{static_cast<S32>(chunk->cy) + dy};
-                        S32 ccz{static_cast<S32>(chunk->cz) + dz};
-                        auto itn{chunkMap.find(PackKey(ccx,ccy,ccz))};
-                        VoxelChunk const* ch{(itn==chunkMap.end()? nullptr : itn->second)};
-                        nbChunk[dx+1][dy+1][dz+1] = ch;
-                        nbData[dx+1][dy+1][dz+1] = ch ? ch->blocks.data() : nullptr;
-                    }
-                }
+            chunk->dirty = false;
+            chunk->edited = {};
+            mesh->meshing = true;
+            m_InFlight.fetch_add(1);
+            {
+                std::lock_guard lk{m_Mutex};
+                m_Jobs.push_back(std::move(job));
             }
-
-            auto sample = [&](S32 lx, S32 ly, S32 lz) -> Voxel {
-                S32 nx{0}, ny{0}, nz{0};
-                if (lx < 0) { nx = -1; lx += NX; } else if (lx >= NX) { nx = 1; lx -= NX; }
-                if (ly < 0) { ny = -1; ly += NY; } else if (ly >= NY) { ny = 1; ly -= NY; }
-                if (lz < 0) { nz = -1; lz += NZ; } else if (lz >= NZ) { nz = 1; lz -= NZ; }
-                Voxel const* data{nbData[nx+1][ny+1][nz+1]};
-                if (!data) return Voxel::Air;
-                return data[VoxelIndex(static_cast<U32>(lx), static_cast<U32>(ly), static_cast<U32>(lz))];
-            };
-
-            auto makePos = [&](S32 gx, S32 gy, S32 gz) -> Math::Vec3 {
-                const S64 Cx{static_cast<S64>(static_cast<S32>(chunk->cx))};
-                const S64 Cy{static_cast<S64>(static_cast<S32>(chunk->cy))};
-                const S64 Cz{static_cast<S64>(static_cast<S32>(chunk->cz))};
-                const F64 ds{static_cast<F64>(s)};
-                const F64 X{(Cx * static_cast<S64>(NX) + static_cast<S64>(gx)) * ds};
-                const F64 Y{(Cy * static_cast<S64>(NY) + static_cast<S64>(gy)) * ds};
-                const F64 Z{(Cz * static_cast<S64>(NZ) + static_cast<S64>(gz)) * ds};
-                return Math::Vec3{static_cast<F32>(X), static_cast<F32>(Y), static_cast<F32>(Z)};
-            };
-
-            auto greedyAxis = [&](S32 d) {
-                S32 dims[3]{NX,NY,NZ};
-                S32 u{(d + 1) % 3};
-                S32 v{(d + 2) % 3};
-
-                struct MaskRow { U32* ptr; };
-                static thread_local Vector<U32> mask;
-                USize maskSize{static_cast<USize>(dims[u] * dims[v])};
-                if (mask.size() < maskSize) mask.resize(maskSize);
-                std::fill(mask.begin(), mask.begin() + maskSize, 0u);
-
-                S32 x[3]{0,0,0};
-                for (x[d]=0; x[d] <= dims[d]; ++x[d]) {
-                    U32* m{mask.data()};
-                    for (x[v]=0; x[v] < dims[v]; ++x[v]) {
-                        for (x[u]=0; x[u] < dims[u]; ++x[u]) {
-                            S32 ax{x[0]}, ay{x[1]}, az{x[2]};
-                            S32 bx{ax}, by{ay}, bz{az};
-                            if (d==0) --ax; else if (d==1) --ay; else --az;
-
-                            Voxel va{sample(ax,ay,az)};
-                            Voxel vb{sample(bx,by,bz)};
-                            bool sa{va != Voxel::Air};
-                            bool sb{vb != Voxel::Air};
-
-                            if (sa != sb) {
-                                bool back{!sa};
-                                Voxel owner{back ? vb : va};
-                                U32 face{FaceOf(d, back)};
-                                U32 tile{kMatLUT[static_cast<U32>(owner)].face[face]};
-                                *m = PackMask(tile, back);
-                            } else {
-                                *m = 0u;
-                            }
-                            ++m;
-                        }
-                    }
-
-                    S32 j{};
-                    while (j < dims[v]) {
-                        S32 i{};
-                        while (i < dims[u]) {
-                            U32 key{mask[static_cast<USize>(i + j * dims[u])]};
-                            if (key == 0u) { ++i; continue; }
-
-                            S32 w{1};
-                            while (i + w < dims[u]) {
-                                if (mask[static_cast<USize>(i + w + j * dims[u])] != key) break;
-                                ++w;
-                            }
-
-                            S32 h{1}; bool extend{true};
-                            while (j + h < dims[v] && extend) {
-                                for (S32 k{}; k < w; ++k) {
-                                    if (mask[static_cast<USize>(i + k + (j + h) * dims[u])] != key) { extend = false; break; }
-                                }
-                                if (extend) ++h;
-                            }
-
-                            S32 u0{i}, v0{j}, u1{i+w}, v1{j+h};
-                            S32 a0[3]{}, a1[3]{}, a2[3]{}, a3[3]{};
-                            a0[d]=x[d]; a0[u]=u0; a0[v]=v0;
-                            a1[d]=x[d]; a1[u]=u0; a1[v]=v1;
-                            a2[d]=x[d]; a2[u]=u1; a2[v]=v1;
-                            a3[d]=x[d]; a3[u]=u1; a3[v]=v0;
-
-                            Math::Vec3 p0{makePos(a0[0],a0[1],a0[2])};
-                            Math::Vec3 p1{makePos(a1[0],a1[1],a1[2])};
-                            Math::Vec3 p2{makePos(a2[0],a2[1],a2[2])};
-                            Math::Vec3 p3{makePos(a3[0],a3[1],a3[2])};
-
-                            Math::Vec3 nrm{};
-                            if (d==0) nrm = MaskBack(key) ? Math::Vec3{-1,0,0} : Math::Vec3{+1,0,0};
-                            if (d==1) nrm = MaskBack(key) ? Math::Vec3{0,-1,0} : Math::Vec3{0,+1,0};
-                            if (d==2) nrm = MaskBack(key) ? Math::Vec3{0,0,-1} : Math::Vec3{0,0,+1};
-
-                            bool cw{!MaskBack(key)};
-                            Math::Vec2 t0{}, t1{}, t2{}, t3{};
-                            if (d == 0 || d == 1) {
-                                t0 = {0.0f, 0.0f};
-                                t1 = {static_cast<F32>(h), 0.0f};
-                                t2 = {static_cast<F32>(h), static_cast<F32>(w)};
-                                t3 = {0.0f, static_cast<F32>(w)};
-                            } else {
-                                t0 = {0.0f, 0.0f};
-                                t1 = {0.0f, static_cast<F32>(h)};
-                                t2 = {static_cast<F32>(w), static_cast<F32>(h)};
-                                t3 = {static_cast<F32>(w), 0.0f};
-                            }
-
-                            detail::AddFace(mesh->cpuVertices, p0,p1,p2,p3, nrm, t0,t1,t2,t3, MaskTile(key), cw);
-
-                            for (S32 y{}; y < h; ++y) {
-                                USize base{static_cast<USize>((j + y) * dims[u] + i)};
-                                std::fill_n(mask.data() + base, static_cast<USize>(w), 0u);
-                            }
-                            i += w;
-                        }
-                        ++j;
-                    }
-                }
-            };
-
-            greedyAxis(0); greedyAxis(1); greedyAxis(2);
-
-            mesh->vertexCount = static_cast<U32>(mesh->cpuVertices.size());
-            mesh->gpuDirty = true;
-            const_cast<VoxelChunk*>(chunk)->dirty = false;
+            m_CV.notify_one();
             --left;
         }
     }
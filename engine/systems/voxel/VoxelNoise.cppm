@@ -0,0 +1,344 @@
+module;
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VOXEL_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define VOXEL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define VOXEL_TARGET_SSE41
+#define VOXEL_TARGET_AVX2
+#endif
+
+export module Systems.VoxelNoise;
+
+import Core.Types;
+import Core.Assert;
+import std;
+
+export enum class NoiseKernel : U8 {
+    Scalar,
+    SSE41,
+    AVX2
+};
+
+export namespace noise {
+    inline U32 wang(U32 s) {
+        s = (s ^ 61u) ^ (s >> 16);
+        s *= 9u;
+        s ^= s >> 4;
+        s *= 0x27d4eb2d;
+        s ^= s >> 15;
+        return s;
+    }
+
+    inline F32 rnd(S32 x, S32 y) {
+        U32 h{wang(static_cast<U32>(x) * 73856093u ^ static_cast<U32>(y) * 19349663u)};
+        return static_cast<F32>(h) / static_cast<F32>(std::numeric_limits<U32>::max());
+    }
+
+    inline F32 smooth(F32 t) {
+        return t * t * (3.0f - 2.0f * t);
+    }
+
+    inline F32 value2D(F32 x, F32 y) {
+        S32 ix{static_cast<S32>(std::floor(x))};
+        S32 iy{static_cast<S32>(std::floor(y))};
+        F32 fx{x - static_cast<F32>(ix)};
+        F32 fy{y - static_cast<F32>(iy)};
+        F32 v00{rnd(ix, iy)};
+        F32 v10{rnd(ix + 1, iy)};
+        F32 v01{rnd(ix, iy + 1)};
+        F32 v11{rnd(ix + 1, iy + 1)};
+        F32 sx{smooth(fx)}, sy{smooth(fy)};
+        F32 a{std::lerp(v00, v10, sx)};
+        F32 b{std::lerp(v01, v11, sx)};
+        return std::lerp(a, b, sy);
+    }
+
+    inline F32 fbm2D(F32 x, F32 y, U32 oct, F32 gain, F32 lacunarity) {
+        F32 a{1.0f}, f{1.0f}, sum{0.0f}, norm{0.0f};
+        for (U32 i{}; i < oct; ++i) {
+            sum += a * value2D(x * f, y * f);
+            norm += a;
+            a *= gain;
+            f *= lacunarity;
+        }
+        return sum / std::max(0.0001f, norm);
+    }
+
+    constexpr F32 kBiomeFrequency{0.004f};
+    constexpr F32 kTerrainFrequency{0.025f};
+    constexpr U32 kTerrainOctaves{4};
+
+    // Generates a simple and balanced biome value
+    inline F32 biomeValue(F32 x, F32 z, F32 freq = kBiomeFrequency) {
+        F32 large = value2D(x * freq, z * freq);           // Large areas
+        F32 detail = value2D(x * freq * 3.0f, z * freq * 3.0f) * 0.3f; // Details
+        return large + detail;
+    }
+
+    // Generates basic terrain height
+    inline F32 terrainNoise(F32 x, F32 z, F32 freq = kTerrainFrequency) {
+        return fbm2D(x * freq, z * freq, kTerrainOctaves, 0.5f, 2.0f);
+    }
+}
+
+// Row kernels. Every lane performs the exact operation sequence of the scalar functions
+// above (no FMA, std::lerp's P0811 branches as blends, U32 -> F32 through an exact
+// hi/lo split), so all kernels return bit-identical results and worlds do not change
+// with the CPU they are generated on.
+namespace {
+    constexpr F32 kU32Max{static_cast<F32>(std::numeric_limits<U32>::max())};
+
+    namespace sse41 {
+        VOXEL_TARGET_SSE41 inline __m128i Wang(__m128i s) {
+            s = _mm_xor_si128(_mm_xor_si128(s, _mm_set1_epi32(61)), _mm_srli_epi32(s, 16));
+            s = _mm_mullo_epi32(s, _mm_set1_epi32(9));
+            s = _mm_xor_si128(s, _mm_srli_epi32(s, 4));
+            s = _mm_mullo_epi32(s, _mm_set1_epi32(0x27d4eb2d));
+            s = _mm_xor_si128(s, _mm_srli_epi32(s, 15));
+            return s;
+        }
+
+        VOXEL_TARGET_SSE41 inline __m128 Rnd(__m128i x, __m128i y) {
+            __m128i h{Wang(_mm_xor_si128(_mm_mullo_epi32(x, _mm_set1_epi32(73856093)),
+                                         _mm_mullo_epi32(y, _mm_set1_epi32(19349663))))};
+            __m128 hi{_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(h, 16)), _mm_set1_ps(65536.0f))};
+            __m128 lo{_mm_cvtepi32_ps(_mm_and_si128(h, _mm_set1_epi32(0xFFFF)))};
+            return _mm_div_ps(_mm_add_ps(hi, lo), _mm_set1_ps(kU32Max));
+        }
+
+        VOXEL_TARGET_SSE41 inline __m128 Smooth(__m128 t) {
+            return _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_set1_ps(2.0f), t)));
+        }
+
+        VOXEL_TARGET_SSE41 inline __m128 Lerp(__m128 a, __m128 b, __m128 t) {
+            const __m128 zero{_mm_setzero_ps()};
+            const __m128 one{_mm_set1_ps(1.0f)};
+            __m128 straddle{_mm_or_ps(_mm_and_ps(_mm_cmple_ps(a, zero), _mm_cmpge_ps(b, zero)),
+                                      _mm_and_ps(_mm_cmpge_ps(a, zero), _mm_cmple_ps(b, zero)))};
+            __m128 exact{_mm_add_ps(_mm_mul_ps(t, b), _mm_mul_ps(_mm_sub_ps(one, t), a))};
+            __m128 x{_mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)))};
+            __m128 same{_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_castps_si128(_mm_cmpgt_ps(t, one)),
+                                                         _mm_castps_si128(_mm_cmpgt_ps(b, a))))};
+            __m128 up{_mm_blendv_ps(b, x, _mm_cmplt_ps(b, x))};
+            __m128 down{_mm_blendv_ps(b, x, _mm_cmpgt_ps(b, x))};
+            __m128 r{_mm_blendv_ps(down, up, same)};
+            r = _mm_blendv_ps(r, b, _mm_cmpeq_ps(t, one));
+            return _mm_blendv_ps(r, exact, straddle);
+        }
+
+        VOXEL_TARGET_SSE41 inline __m128 Value2D(__m128 x, __m128 y) {
+            __m128i ix{_mm_cvttps_epi32(_mm_floor_ps(x))};
+            __m128i iy{_mm_cvttps_epi32(_mm_floor_ps(y))};
+            __m128 fx{_mm_sub_ps(x, _mm_cvtepi32_ps(ix))};
+            __m128 fy{_mm_sub_ps(y, _mm_cvtepi32_ps(iy))};
+            const __m128i one{_mm_set1_epi32(1)};
+            __m128i ix1{_mm_add_epi32(ix, one)}, iy1{_mm_add_epi32(iy, one)};
+            __m128 v00{Rnd(ix, iy)};
+            __m128 v10{Rnd(ix1, iy)};
+            __m128 v01{Rnd(ix, iy1)};
+            __m128 v11{Rnd(ix1, iy1)};
+            __m128 sx{Smooth(fx)}, sy{Smooth(fy)};
+            return Lerp(Lerp(v00, v10, sx), Lerp(v01, v11, sx), sy);
+        }
+
+        VOXEL_TARGET_SSE41 void BiomeRow(F32 const* xs, F32 z, F32* out, USize count) {
+            const F32 freq{noise::kBiomeFrequency};
+            const __m128 zl{_mm_set1_ps(z * freq)};
+            const __m128 zd{_mm_set1_ps(z * freq * 3.0f)};
+            for (USize i{}; i < count; i += 4) {
+                __m128 xl{_mm_mul_ps(_mm_loadu_ps(xs + i), _mm_set1_ps(freq))};
+                __m128 large{Value2D(xl, zl)};
+                __m128 detail{_mm_mul_ps(Value2D(_mm_mul_ps(xl, _mm_set1_ps(3.0f)), zd), _mm_set1_ps(0.3f))};
+                _mm_storeu_ps(out + i, _mm_add_ps(large, detail));
+            }
+        }
+
+        VOXEL_TARGET_SSE41 void TerrainRow(F32 const* xs, F32 z, F32* out, USize count) {
+            const F32 freq{noise::kTerrainFrequency};
+            const F32 zf{z * freq};
+            for (USize i{}; i < count; i += 4) {
+                __m128 x{_mm_mul_ps(_mm_loadu_ps(xs + i), _mm_set1_ps(freq))};
+                F32 a{1.0f}, f{1.0f}, norm{0.0f};
+                __m128 sum{_mm_setzero_ps()};
+                for (U32 o{}; o < noise::kTerrainOctaves; ++o) {
+                    __m128 v{Value2D(_mm_mul_ps(x, _mm_set1_ps(f)), _mm_set1_ps(zf * f))};
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(a), v));
+                    norm += a;
+                    a *= 0.5f;
+                    f *= 2.0f;
+                }
+                _mm_storeu_ps(out + i, _mm_div_ps(sum, _mm_set1_ps(std::max(0.0001f, norm))));
+            }
+        }
+    }
+
+    namespace avx2 {
+        VOXEL_TARGET_AVX2 inline __m256i Wang(__m256i s) {
+            s = _mm256_xor_si256(_mm256_xor_si256(s, _mm256_set1_epi32(61)), _mm256_srli_epi32(s, 16));
+            s = _mm256_mullo_epi32(s, _mm256_set1_epi32(9));
+            s = _mm256_xor_si256(s, _mm256_srli_epi32(s, 4));
+            s = _mm256_mullo_epi32(s, _mm256_set1_epi32(0x27d4eb2d));
+            s = _mm256_xor_si256(s, _mm256_srli_epi32(s, 15));
+            return s;
+        }
+
+        VOXEL_TARGET_AVX2 inline __m256 Rnd(__m256i x, __m256i y) {
+            __m256i h{Wang(_mm256_xor_si256(_mm256_mullo_epi32(x, _mm256_set1_epi32(73856093)),
+                                            _mm256_mullo_epi32(y, _mm256_set1_epi32(19349663))))};
+            __m256 hi{_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(h, 16)), _mm256_set1_ps(65536.0f))};
+            __m256 lo{_mm256_cvtepi32_ps(_mm256_and_si256(h, _mm256_set1_epi32(0xFFFF)))};
+            return _mm256_div_ps(_mm256_add_ps(hi, lo), _mm256_set1_ps(kU32Max));
+        }
+
+        VOXEL_TARGET_AVX2 inline __m256 Smooth(__m256 t) {
+            return _mm256_mul_ps(_mm256_mul_ps(t, t),
+                                 _mm256_sub_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(_mm256_set1_ps(2.0f), t)));
+        }
+
+        VOXEL_TARGET_AVX2 inline __m256 Lerp(__m256 a, __m256 b, __m256 t) {
+            const __m256 zero{_mm256_setzero_ps()};
+            const __m256 one{_mm256_set1_ps(1.0f)};
+            __m256 straddle{_mm256_or_ps(
+                _mm256_and_ps(_mm256_cmp_ps(a, zero, _CMP_LE_OQ), _mm256_cmp_ps(b, zero, _CMP_GE_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(a, zero, _CMP_GE_OQ), _mm256_cmp_ps(b, zero, _CMP_LE_OQ)))};
+            __m256 exact{_mm256_add_ps(_mm256_mul_ps(t, b), _mm256_mul_ps(_mm256_sub_ps(one, t), a))};
+            __m256 x{_mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)))};
+            __m256 same{_mm256_castsi256_ps(_mm256_cmpeq_epi32(
+                _mm256_castps_si256(_mm256_cmp_ps(t, one, _CMP_GT_OQ)),
+                _mm256_castps_si256(_mm256_cmp_ps(b, a, _CMP_GT_OQ))))};
+            __m256 up{_mm256_blendv_ps(b, x, _mm256_cmp_ps(b, x, _CMP_LT_OQ))};
+            __m256 down{_mm256_blendv_ps(b, x, _mm256_cmp_ps(b, x, _CMP_GT_OQ))};
+            __m256 r{_mm256_blendv_ps(down, up, same)};
+            r = _mm256_blendv_ps(r, b, _mm256_cmp_ps(t, one, _CMP_EQ_OQ));
+            return _mm256_blendv_ps(r, exact, straddle);
+        }
+
+        VOXEL_TARGET_AVX2 inline __m256 Value2D(__m256 x, __m256 y) {
+            __m256i ix{_mm256_cvttps_epi32(_mm256_floor_ps(x))};
+            __m256i iy{_mm256_cvttps_epi32(_mm256_floor_ps(y))};
+            __m256 fx{_mm256_sub_ps(x, _mm256_cvtepi32_ps(ix))};
+            __m256 fy{_mm256_sub_ps(y, _mm256_cvtepi32_ps(iy))};
+            const __m256i one{_mm256_set1_epi32(1)};
+            __m256i ix1{_mm256_add_epi32(ix, one)}, iy1{_mm256_add_epi32(iy, one)};
+            __m256 v00{Rnd(ix, iy)};
+            __m256 v10{Rnd(ix1, iy)};
+            __m256 v01{Rnd(ix, iy1)};
+            __m256 v11{Rnd(ix1, iy1)};
+            __m256 sx{Smooth(fx)}, sy{Smooth(fy)};
+            return Lerp(Lerp(v00, v10, sx), Lerp(v01, v11, sx), sy);
+        }
+
+        VOXEL_TARGET_AVX2 void BiomeRow(F32 const* xs, F32 z, F32* out, USize count) {
+            const F32 freq{noise::kBiomeFrequency};
+            const __m256 zl{_mm256_set1_ps(z * freq)};
+            const __m256 zd{_mm256_set1_ps(z * freq * 3.0f)};
+            for (USize i{}; i < count; i += 8) {
+                __m256 xl{_mm256_mul_ps(_mm256_loadu_ps(xs + i), _mm256_set1_ps(freq))};
+                __m256 large{Value2D(xl, zl)};
+                __m256 detail{_mm256_mul_ps(Value2D(_mm256_mul_ps(xl, _mm256_set1_ps(3.0f)), zd),
+                                            _mm256_set1_ps(0.3f))};
+                _mm256_storeu_ps(out + i, _mm256_add_ps(large, detail));
+            }
+        }
+
+        VOXEL_TARGET_AVX2 void TerrainRow(F32 const* xs, F32 z, F32* out, USize count) {
+            const F32 freq{noise::kTerrainFrequency};
+            const F32 zf{z * freq};
+            for (USize i{}; i < count; i += 8) {
+                __m256 x{_mm256_mul_ps(_mm256_loadu_ps(xs + i), _mm256_set1_ps(freq))};
+                F32 a{1.0f}, f{1.0f}, norm{0.0f};
+                __m256 sum{_mm256_setzero_ps()};
+                for (U32 o{}; o < noise::kTerrainOctaves; ++o) {
+                    __m256 v{Value2D(_mm256_mul_ps(x, _mm256_set1_ps(f)), _mm256_set1_ps(zf * f))};
+                    sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(a), v));
+                    norm += a;
+                    a *= 0.5f;
+                    f *= 2.0f;
+                }
+                _mm256_storeu_ps(out + i, _mm256_div_ps(sum, _mm256_set1_ps(std::max(0.0001f, norm))));
+            }
+        }
+    }
+
+    bool CpuSupports(NoiseKernel kernel) {
+        if (kernel == NoiseKernel::Scalar) return true;
+#if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4]{};
+        __cpuid(regs, 0);
+        const int maxLeaf{regs[0]};
+        __cpuid(regs, 1);
+        const bool sse41{(regs[2] & (1 << 19)) != 0};
+        if (kernel == NoiseKernel::SSE41) return sse41;
+        const bool osAvx{(regs[2] & (1 << 27)) != 0 && (regs[2] & (1 << 28)) != 0
+                         && (_xgetbv(0) & 0x6) == 0x6};
+        if (!osAvx || maxLeaf < 7) return false;
+        __cpuidex(regs, 7, 0);
+        return (regs[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        if (kernel == NoiseKernel::SSE41) return __builtin_cpu_supports("sse4.1");
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    NoiseKernel DetectBestKernel() {
+        if (CpuSupports(NoiseKernel::AVX2)) return NoiseKernel::AVX2;
+        if (CpuSupports(NoiseKernel::SSE41)) return NoiseKernel::SSE41;
+        return NoiseKernel::Scalar;
+    }
+
+    std::atomic<NoiseKernel> s_ActiveKernel{DetectBestKernel()};
+
+    constexpr USize LaneCount(NoiseKernel kernel) {
+        switch (kernel) {
+            case NoiseKernel::AVX2: return 8;
+            case NoiseKernel::SSE41: return 4;
+            default: return 0;
+        }
+    }
+}
+
+export namespace noise {
+    [[nodiscard]] bool IsKernelSupported(NoiseKernel kernel) { return CpuSupports(kernel); }
+
+    // Picked once at startup from the CPU features; can be lowered for testing and benchmarks.
+    [[nodiscard]] NoiseKernel ActiveKernel() { return s_ActiveKernel.load(std::memory_order_relaxed); }
+
+    void SetKernel(NoiseKernel kernel) {
+        assert(CpuSupports(kernel), "Noise kernel not supported by this CPU");
+        s_ActiveKernel.store(kernel, std::memory_order_relaxed);
+    }
+
+    // biomeValue for every x of a row sharing the same z.
+    void BiomeValueRow(NoiseKernel kernel, std::span<const F32> xs, F32 z, std::span<F32> out) {
+        assert(out.size() >= xs.size(), "Noise row output too small");
+        const USize lanes{LaneCount(kernel)};
+        const USize body{lanes ? xs.size() / lanes * lanes : 0};
+        if (kernel == NoiseKernel::AVX2) avx2::BiomeRow(xs.data(), z, out.data(), body);
+        else if (kernel == NoiseKernel::SSE41) sse41::BiomeRow(xs.data(), z, out.data(), body);
+        for (USize i{body}; i < xs.size(); ++i) out[i] = biomeValue(xs[i], z);
+    }
+
+    // terrainNoise for every x of a row sharing the same z.
+    void TerrainNoiseRow(NoiseKernel kernel, std::span<const F32> xs, F32 z, std::span<F32> out) {
+        assert(out.size() >= xs.size(), "Noise row output too small");
+        const USize lanes{LaneCount(kernel)};
+        const USize body{lanes ? xs.size() / lanes * lanes : 0};
+        if (kernel == NoiseKernel::AVX2) avx2::TerrainRow(xs.data(), z, out.data(), body);
+        else if (kernel == NoiseKernel::SSE41) sse41::TerrainRow(xs.data(), z, out.data(), body);
+        for (USize i{body}; i < xs.size(); ++i) out[i] = terrainNoise(xs[i], z);
+    }
+
+    void BiomeValueRow(std::span<const F32> xs, F32 z, std::span<F32> out) {
+        BiomeValueRow(ActiveKernel(), xs, z, out);
+    }
+
+    void TerrainNoiseRow(std::span<const F32> xs, F32 z, std::span<F32> out) {
+        TerrainNoiseRow(ActiveKernel(), xs, z, out);
+    }
+}
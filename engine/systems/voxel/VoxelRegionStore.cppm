@@ -0,0 +1,618 @@
+module;
+#include <stdio.h>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+export module Systems.VoxelRegionStore;
+
+import ECS.Component;
+import ECS.World;
+import Components.ComponentRegistry;
+import Components.Voxel;
+import Components.VoxelChunkIndex;
+import Core.Types;
+import Core.Assert;
+import Core.Log;
+import std;
+
+// Region files group 32x8x32 chunks (X, Y, Z). Layout, little endian:
+//   header  : magic "VXRG", version, chunk count, reserved, U64 end of valid records, U64 reserved
+//   table   : one {U32 record offset, U32 payload size} per chunk, offset 0 = not stored
+//   records : {magic "VXCK", chunk index, payload size, CRC32 of payload} + payload, append only
+// A record is written and synced to disk before the table and the end marker point at it, so
+// a crash leaves either the old or the new version reachable. When the file size does not
+// match the end marker the table is rebuilt by scanning the records: a damaged record is
+// skipped by resuming at the next valid record header, and a torn tail is dropped.
+namespace {
+    constexpr U32 kFileMagic{0x47525856u};
+    constexpr U32 kRecordMagic{0x4B435856u};
+    constexpr U32 kFileVersion{1};
+    constexpr U8 kPayloadVersion{1};
+    constexpr U32 kRegionX{32}, kRegionY{8}, kRegionZ{32};
+    constexpr U32 kRegionChunks{kRegionX * kRegionY * kRegionZ};
+    constexpr U64 kHeaderBytes{32};
+    constexpr U64 kTableBytes{static_cast<U64>(kRegionChunks) * 8ull};
+    constexpr U64 kRecordsBegin{kHeaderBytes + kTableBytes};
+    constexpr U64 kRecordHeaderBytes{16};
+    constexpr U64 kCompactMinGarbage{1ull << 20};
+    constexpr USize kMaxOpenRegions{16};
+
+    constexpr std::array<U32, 256> MakeCrcTable() {
+        std::array<U32, 256> table{};
+        for (U32 i{}; i < 256; ++i) {
+            U32 c{i};
+            for (U32 k{}; k < 8; ++k) c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return table;
+    }
+
+    constexpr std::array<U32, 256> kCrcTable{MakeCrcTable()};
+
+    constexpr S32 FloorDiv(S32 a, S32 b) {
+        return a >= 0 ? a / b : -((-a + b - 1) / b);
+    }
+
+    void PutU32(U8* dst, U32 v) { std::memcpy(dst, &v, sizeof(v)); }
+    void PutU64(U8* dst, U64 v) { std::memcpy(dst, &v, sizeof(v)); }
+    U32 GetU32(U8 const* src) { U32 v; std::memcpy(&v, src, sizeof(v)); return v; }
+    U64 GetU64(U8 const* src) { U64 v; std::memcpy(&v, src, sizeof(v)); return v; }
+
+    // Region file handle. Sync is the durability point: everything written before it is on
+    // the disk, not only in the OS cache, when it returns true.
+    class RegionFile {
+    public:
+        RegionFile() = default;
+        RegionFile(RegionFile const&) = delete;
+        RegionFile& operator=(RegionFile const&) = delete;
+        ~RegionFile() { Close(); }
+
+        bool Open(std::filesystem::path const& path, bool truncate) {
+            Close();
+#if defined(_WIN32)
+            m_File = _wfopen(path.c_str(), truncate ? L"w+b" : L"r+b");
+#else
+            m_File = fopen(path.c_str(), truncate ? "w+b" : "r+b");
+#endif
+            return m_File != nullptr;
+        }
+
+        void Close() {
+            if (m_File) fclose(m_File);
+            m_File = nullptr;
+        }
+
+        [[nodiscard]] bool IsOpen() const { return m_File != nullptr; }
+
+        bool ReadAt(U64 offset, void* dst, USize bytes) {
+            return Seek(offset) && fread(dst, 1, bytes, m_File) == bytes;
+        }
+
+        bool WriteAt(U64 offset, void const* src, USize bytes) {
+            return Seek(offset) && fwrite(src, 1, bytes, m_File) == bytes;
+        }
+
+        bool Sync() {
+            if (!m_File || fflush(m_File) != 0) return false;
+#if defined(_WIN32)
+            return _commit(_fileno(m_File)) == 0;
+#else
+            return fsync(fileno(m_File)) == 0;
+#endif
+        }
+
+    private:
+        bool Seek(U64 offset) {
+            if (!m_File) return false;
+#if defined(_WIN32)
+            return _fseeki64(m_File, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+            return fseeko(m_File, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+        }
+
+        FILE* m_File{nullptr};
+    };
+
+    // Makes a file creation or rename in the directory durable. Windows has no equivalent;
+    // its metadata journal covers it.
+    void SyncDirectory([[maybe_unused]] std::filesystem::path const& dir) {
+#if !defined(_WIN32)
+        const int fd{open(dir.c_str(), O_RDONLY)};
+        if (fd < 0) return;
+        fsync(fd);
+        close(fd);
+#endif
+    }
+}
+
+export U32 Crc32(std::span<const U8> data) {
+    U32 c{0xFFFFFFFFu};
+    for (U8 b : data) c = kCrcTable[(c ^ b) & 0xFFu] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+// Payload: version byte followed by {U16 run length - 1, U8 voxel} runs in VoxelIndex order.
+export Vector<U8> EncodeChunkPayload(VoxelBlocks const& blocks) {
+    assert(!blocks.Empty(), "Cannot encode an ungenerated chunk");
+    Vector<U8> out{};
+    out.push_back(kPayloadVersion);
+    if (blocks.IsUniform()) {
+        constexpr U32 len{VoxelBlocks::Volume - 1};
+        out.insert(out.end(), {static_cast<U8>(len & 0xFFu), static_cast<U8>(len >> 8),
+                               static_cast<U8>(blocks.Get(0))});
+        return out;
+    }
+
+    static thread_local Vector<Voxel> dense{};
+    dense.resize(VoxelBlocks::Volume);
+    blocks.CopyTo(dense);
+    for (USize i{}; i < dense.size();) {
+        const Voxel v{dense[i]};
+        USize run{1};
+        while (i + run < dense.size() && dense[i + run] == v && run < 65536u) ++run;
+        const U32 len{static_cast<U32>(run - 1)};
+        out.insert(out.end(), {static_cast<U8>(len & 0xFFu), static_cast<U8>(len >> 8), static_cast<U8>(v)});
+        i += run;
+    }
+    return out;
+}
+
+export bool DecodeChunkPayload(std::span<const U8> payload, VoxelBlocks& out) {
+    if (payload.empty() || payload[0] != kPayloadVersion || (payload.size() - 1) % 3 != 0) return false;
+
+    if (payload.size() == 4) {
+        if ((payload[1] | (payload[2] << 8)) + 1u != VoxelBlocks::Volume) return false;
+        out.Fill(static_cast<Voxel>(payload[3]));
+        return true;
+    }
+
+    static thread_local Vector<Voxel> dense{};
+    dense.resize(VoxelBlocks::Volume);
+    USize at{};
+    for (USize p{1}; p < payload.size(); p += 3) {
+        const USize run{static_cast<USize>(payload[p] | (payload[p + 1] << 8)) + 1};
+        if (at + run > dense.size()) return false;
+        std::fill_n(dense.begin() + static_cast<std::ptrdiff_t>(at), run, static_cast<Voxel>(payload[p + 2]));
+        at += run;
+    }
+    if (at != dense.size()) return false;
+    out.Assign(dense);
+    return true;
+}
+
+export struct VoxelRegionStoreStats {
+    U64 saves{};
+    U64 loads{};
+    U64 misses{};
+    U64 bytesWritten{};
+    U64 compactions{};
+    U64 recoveries{};
+    U32 pending{};
+};
+
+// Chunk persistence. Save queues a copy for the background I/O thread; Load is synchronous
+// (generation workers call it) and sees saves that are still queued.
+export class VoxelRegionStore {
+public:
+    static constexpr U32 RegionSizeX{kRegionX}, RegionSizeY{kRegionY}, RegionSizeZ{kRegionZ};
+
+    explicit VoxelRegionStore(std::filesystem::path directory) : m_Directory{std::move(directory)} {
+        std::error_code ec{};
+        std::filesystem::create_directories(m_Directory, ec);
+        m_IoThread = std::thread{[this]() { IoLoop(); }};
+    }
+
+    ~VoxelRegionStore() {
+        {
+            std::lock_guard lk{m_QueueMutex};
+            m_Stop = true;
+        }
+        m_QueueCV.notify_all();
+        if (m_IoThread.joinable()) m_IoThread.join();
+    }
+
+    VoxelRegionStore(VoxelRegionStore const&) = delete;
+    VoxelRegionStore& operator=(VoxelRegionStore const&) = delete;
+
+    void Save(S32 cx, S32 cy, S32 cz, VoxelBlocks blocks) {
+        if (blocks.Empty()) return;
+        auto data{std::make_shared<const VoxelBlocks>(std::move(blocks))};
+        {
+            std::lock_guard lk{m_QueueMutex};
+            const U64 key{PackChunkKey(cx, cy, cz)};
+            auto [it, inserted]{m_Pending.try_emplace(key, PendingSave{cx, cy, cz, data, false})};
+            if (!inserted) it->second.blocks = std::move(data);
+            if (!it->second.queued) {
+                it->second.queued = true;
+                m_Queue.push_back(key);
+            }
+            ++m_Stats.saves;
+        }
+        m_QueueCV.notify_one();
+    }
+
+    [[nodiscard]] bool Load(S32 cx, S32 cy, S32 cz, VoxelBlocks& out) {
+        {
+            std::lock_guard lk{m_QueueMutex};
+            if (auto it{m_Pending.find(PackChunkKey(cx, cy, cz))}; it != m_Pending.end()) {
+                out = *it->second.blocks;
+                ++m_Stats.loads;
+                return true;
+            }
+        }
+
+        Vector<U8> payload{};
+        bool found{false};
+        {
+            std::lock_guard lk{m_FileMutex};
+            if (Region* r{OpenRegion(cx, cy, cz, false)}) found = ReadRecord(*r, LocalIndex(cx, cy, cz), payload);
+        }
+        found = found && DecodeChunkPayload(payload, out);
+
+        std::lock_guard lk{m_QueueMutex};
+        if (found) ++m_Stats.loads;
+        else ++m_Stats.misses;
+        return found;
+    }
+
+    // Blocks until every queued save is on disk.
+    void Flush() {
+        std::unique_lock lk{m_QueueMutex};
+        m_IdleCV.wait(lk, [this]() { return m_Queue.empty() && !m_Writing; });
+    }
+
+    void CompactAll() {
+        Flush();
+        std::lock_guard lk{m_FileMutex};
+        for (auto& r : m_Regions | std::views::values) Compact(*r);
+    }
+
+    [[nodiscard]] VoxelRegionStoreStats GetStats() const {
+        std::lock_guard lk{m_QueueMutex};
+        VoxelRegionStoreStats s{m_Stats};
+        s.pending = static_cast<U32>(m_Queue.size());
+        return s;
+    }
+
+    [[nodiscard]] std::filesystem::path const& Directory() const { return m_Directory; }
+
+    [[nodiscard]] static std::string RegionFileName(S32 rx, S32 ry, S32 rz) {
+        return "r." + std::to_string(rx) + "." + std::to_string(ry) + "." + std::to_string(rz) + ".vxr";
+    }
+
+    [[nodiscard]] static std::array<S32, 3> RegionOf(S32 cx, S32 cy, S32 cz) {
+        return {FloorDiv(cx, static_cast<S32>(kRegionX)), FloorDiv(cy, static_cast<S32>(kRegionY)),
+                FloorDiv(cz, static_cast<S32>(kRegionZ))};
+    }
+
+private:
+    struct PendingSave {
+        S32 cx, cy, cz;
+        std::shared_ptr<const VoxelBlocks> blocks;
+        bool queued;
+    };
+
+    struct Slot {
+        U32 offset{};
+        U32 size{};
+    };
+
+    struct Region {
+        std::filesystem::path path{};
+        RegionFile file{};
+        Vector<Slot> table{};
+        U64 end{};
+        U64 live{};
+        U64 lastUse{};
+    };
+
+    static U32 LocalIndex(S32 cx, S32 cy, S32 cz) {
+        auto [rx, ry, rz]{RegionOf(cx, cy, cz)};
+        const U32 lx{static_cast<U32>(cx - rx * static_cast<S32>(kRegionX))};
+        const U32 ly{static_cast<U32>(cy - ry * static_cast<S32>(kRegionY))};
+        const U32 lz{static_cast<U32>(cz - rz * static_cast<S32>(kRegionZ))};
+        return lx + lz * kRegionX + ly * kRegionX * kRegionZ;
+    }
+
+    void IoLoop() {
+        for (;;) {
+            PendingSave job{};
+            {
+                std::unique_lock lk{m_QueueMutex};
+                m_QueueCV.wait(lk, [this]() { return m_Stop || !m_Queue.empty(); });
+                if (m_Queue.empty()) return;
+                auto it{m_Pending.find(m_Queue.front())};
+                m_Queue.pop_front();
+                it->second.queued = false;
+                job = it->second;
+                m_Writing = true;
+            }
+
+            Vector<U8> payload{EncodeChunkPayload(*job.blocks)};
+            U64 written{};
+            U64 compactions{};
+            {
+                std::lock_guard lk{m_FileMutex};
+                if (Region* r{OpenRegion(job.cx, job.cy, job.cz, true)}) {
+                    WriteRecord(*r, LocalIndex(job.cx, job.cy, job.cz), payload);
+                    written = payload.size() + kRecordHeaderBytes;
+                    if (r->end - kRecordsBegin - r->live > std::max(kCompactMinGarbage, r->live)) {
+                        Compact(*r);
+                        ++compactions;
+                    }
+                }
+            }
+
+            {
+                std::lock_guard lk{m_QueueMutex};
+                const U64 key{PackChunkKey(job.cx, job.cy, job.cz)};
+                // A newer save for the same chunk may have arrived meanwhile; keep that one.
+                if (auto it{m_Pending.find(key)}; it != m_Pending.end() && it->second.blocks == job.blocks) {
+                    m_Pending.erase(it);
+                }
+                m_Stats.bytesWritten += written;
+                m_Stats.compactions += compactions;
+                m_Writing = false;
+            }
+            m_IdleCV.notify_all();
+        }
+    }
+
+    Region* OpenRegion(S32 cx, S32 cy, S32 cz, bool create) {
+        auto [rx, ry, rz]{RegionOf(cx, cy, cz)};
+        const U64 key{PackChunkKey(rx, ry, rz)};
+        if (auto it{m_Regions.find(key)}; it != m_Regions.end()) {
+            it->second->lastUse = ++m_UseTick;
+            return it->second.get();
+        }
+
+        auto path{m_Directory / RegionFileName(rx, ry, rz)};
+        std::error_code ec{};
+        if (!std::filesystem::exists(path, ec)) {
+            if (!create) return nullptr;
+            if (!WriteEmptyRegion(path)) return nullptr;
+        }
+
+        auto region{std::make_unique<Region>()};
+        region->path = std::move(path);
+        if (!LoadRegion(*region)) {
+            Logger::Warn(LogSystem, "Region file {} is unreadable, starting a new one", region->path.string());
+            region->file.Close();
+            if (!create || !WriteEmptyRegion(region->path) || !LoadRegion(*region)) return nullptr;
+        }
+
+        if (m_Regions.size() >= kMaxOpenRegions) {
+            auto oldest{std::ranges::min_element(m_Regions, {}, [](auto const& kv) { return kv.second->lastUse; })};
+            m_Regions.erase(oldest);
+        }
+        region->lastUse = ++m_UseTick;
+        return m_Regions.emplace(key, std::move(region)).first->second.get();
+    }
+
+    static bool WriteEmptyRegion(std::filesystem::path const& path) {
+        RegionFile out{};
+        if (!out.Open(path, true)) return false;
+        Vector<U8> bytes(kRecordsBegin, 0);
+        PutU32(bytes.data(), kFileMagic);
+        PutU32(bytes.data() + 4, kFileVersion);
+        PutU32(bytes.data() + 8, kRegionChunks);
+        PutU64(bytes.data() + 16, kRecordsBegin);
+        if (!out.WriteAt(0, bytes.data(), bytes.size()) || !out.Sync()) return false;
+        out.Close();
+        SyncDirectory(path.parent_path());
+        return true;
+    }
+
+    bool LoadRegion(Region& r) {
+        if (!r.file.Open(r.path, false)) return false;
+
+        Vector<U8> head(kRecordsBegin);
+        if (!r.file.ReadAt(0, head.data(), head.size())) return false;
+        if (GetU32(head.data()) != kFileMagic || GetU32(head.data() + 4) != kFileVersion
+            || GetU32(head.data() + 8) != kRegionChunks) return false;
+
+        r.end = GetU64(head.data() + 16);
+        r.table.resize(kRegionChunks);
+        for (U32 i{}; i < kRegionChunks; ++i) {
+            r.table[i] = Slot{GetU32(head.data() + kHeaderBytes + i * 8ull), GetU32(head.data() + kHeaderBytes + i * 8ull + 4)};
+        }
+
+        std::error_code ec{};
+        const U64 size{std::filesystem::file_size(r.path, ec)};
+        if (ec) return false;
+        if (size != r.end) Recover(r, size);
+
+        r.live = 0;
+        for (Slot const& s : r.table) {
+            if (s.offset != 0) r.live += kRecordHeaderBytes + s.size;
+        }
+        return true;
+    }
+
+    // Rebuilds the table from the record log; later records for a chunk win. A record that
+    // fails its checks is skipped by resuming at the next record magic, so one damaged record
+    // does not take the rest of the log with it. The CRC rejects magics found inside payloads.
+    void Recover(Region& r, U64 size) {
+        std::ranges::fill(r.table, Slot{});
+        Vector<U8> log(size > kRecordsBegin ? static_cast<USize>(size - kRecordsBegin) : 0);
+        if (!log.empty() && !r.file.ReadAt(kRecordsBegin, log.data(), log.size())) log.clear();
+
+        std::array<U8, 4> magic{};
+        PutU32(magic.data(), kRecordMagic);
+        USize pos{};
+        U64 end{kRecordsBegin};
+        U32 skipped{};
+        while (pos + kRecordHeaderBytes <= log.size()) {
+            U8 const* rh{log.data() + pos};
+            const U32 index{GetU32(rh + 4)};
+            const U32 len{GetU32(rh + 8)};
+            const bool valid{GetU32(rh) == kRecordMagic && index < kRegionChunks
+                             && pos + kRecordHeaderBytes + len <= log.size()
+                             && Crc32(std::span<const U8>{rh + kRecordHeaderBytes, len}) == GetU32(rh + 12)};
+            if (valid) {
+                r.table[index] = Slot{static_cast<U32>(kRecordsBegin + pos), len};
+                pos += kRecordHeaderBytes + len;
+                end = kRecordsBegin + pos;
+                continue;
+            }
+            ++skipped;
+            pos = static_cast<USize>(std::search(log.begin() + static_cast<std::ptrdiff_t>(pos) + 1, log.end(),
+                                                 magic.begin(), magic.end()) - log.begin());
+        }
+        r.file.Close();
+
+        // Everything past the last good record is a torn tail.
+        std::error_code ec{};
+        std::filesystem::resize_file(r.path, end, ec);
+        r.file.Open(r.path, false);
+        r.end = end;
+        WriteTable(r);
+        {
+            std::lock_guard lk{m_QueueMutex};
+            ++m_Stats.recoveries;
+        }
+        Logger::Warn(LogSystem, "Recovered region file {} ({} bytes kept of {}, {} damaged spans skipped)",
+                     r.path.string(), end, size, skipped);
+    }
+
+    void WriteTable(Region& r) {
+        Vector<U8> head(kRecordsBegin, 0);
+        PutU32(head.data(), kFileMagic);
+        PutU32(head.data() + 4, kFileVersion);
+        PutU32(head.data() + 8, kRegionChunks);
+        PutU64(head.data() + 16, r.end);
+        for (U32 i{}; i < kRegionChunks; ++i) {
+            PutU32(head.data() + kHeaderBytes + i * 8ull, r.table[i].offset);
+            PutU32(head.data() + kHeaderBytes + i * 8ull + 4, r.table[i].size);
+        }
+        r.file.WriteAt(0, head.data(), head.size());
+        r.file.Sync();
+    }
+
+    // With durable set the record is synced before the table names it and the table is synced
+    // before returning; compaction syncs the whole file once instead.
+    void WriteRecord(Region& r, U32 index, std::span<const U8> payload, bool durable = true) {
+        assert(r.end + kRecordHeaderBytes + payload.size() <= std::numeric_limits<U32>::max(),
+               "Region file exceeds 4 GiB");
+        std::array<U8, kRecordHeaderBytes> rh{};
+        PutU32(rh.data(), kRecordMagic);
+        PutU32(rh.data() + 4, index);
+        PutU32(rh.data() + 8, static_cast<U32>(payload.size()));
+        PutU32(rh.data() + 12, Crc32(payload));
+
+        if (!r.file.WriteAt(r.end, rh.data(), rh.size())
+            || !r.file.WriteAt(r.end + kRecordHeaderBytes, payload.data(), payload.size())
+            || (durable && !r.file.Sync())) {
+            Logger::Warn(LogSystem, "Writing a record to {} failed", r.path.string());
+            return;
+        }
+
+        Slot& slot{r.table[index]};
+        if (slot.offset != 0) r.live -= kRecordHeaderBytes + slot.size;
+        slot = Slot{static_cast<U32>(r.end), static_cast<U32>(payload.size())};
+        r.live += kRecordHeaderBytes + payload.size();
+        r.end += kRecordHeaderBytes + payload.size();
+
+        std::array<U8, 8> entry{};
+        PutU32(entry.data(), slot.offset);
+        PutU32(entry.data() + 4, slot.size);
+        r.file.WriteAt(kHeaderBytes + index * 8ull, entry.data(), entry.size());
+        std::array<U8, 8> end{};
+        PutU64(end.data(), r.end);
+        r.file.WriteAt(16, end.data(), end.size());
+        if (durable) r.file.Sync();
+    }
+
+    bool ReadRecord(Region& r, U32 index, Vector<U8>& payload) {
+        const Slot slot{r.table[index]};
+        if (slot.offset == 0) return false;
+
+        std::array<U8, kRecordHeaderBytes> rh{};
+        if (!r.file.ReadAt(slot.offset, rh.data(), rh.size())) return false;
+        if (GetU32(rh.data()) != kRecordMagic || GetU32(rh.data() + 4) != index
+            || GetU32(rh.data() + 8) != slot.size) return false;
+        payload.resize(slot.size);
+        if (!r.file.ReadAt(slot.offset + kRecordHeaderBytes, payload.data(), slot.size)) return false;
+        return Crc32(payload) == GetU32(rh.data() + 12);
+    }
+
+    // Rewrites the live records into a temporary file and renames it over the region, so
+    // a crash during compaction leaves the original untouched.
+    void Compact(Region& r) {
+        auto tmp{r.path};
+        tmp += ".tmp";
+        Region out{};
+        out.path = tmp;
+        if (!WriteEmptyRegion(tmp) || !out.file.Open(tmp, false)) return;
+        out.table.resize(kRegionChunks);
+        out.end = kRecordsBegin;
+
+        Vector<U8> payload{};
+        for (U32 i{}; i < kRegionChunks; ++i) {
+            if (r.table[i].offset == 0 || !ReadRecord(r, i, payload)) continue;
+            WriteRecord(out, i, payload, false);
+        }
+        const bool synced{out.file.Sync()};
+        out.file.Close();
+        r.file.Close();
+
+        std::error_code ec{};
+        if (synced) std::filesystem::rename(tmp, r.path, ec);
+        if (!synced || ec) {
+            Logger::Warn(LogSystem, "Region compaction of {} failed: {}", r.path.string(), synced ? ec.message() : "sync failed");
+            std::filesystem::remove(tmp, ec);
+        } else {
+            SyncDirectory(r.path.parent_path());
+            r.table = std::move(out.table);
+            r.end = out.end;
+            r.live = out.live;
+        }
+        r.file.Open(r.path, false);
+    }
+
+    std::filesystem::path m_Directory{};
+
+    mutable std::mutex m_QueueMutex{};
+    std::condition_variable m_QueueCV{};
+    std::condition_variable m_IdleCV{};
+    std::deque<U64> m_Queue{};
+    UnorderedMap<U64, PendingSave> m_Pending{};
+    bool m_Writing{false};
+    bool m_Stop{false};
+    VoxelRegionStoreStats m_Stats{};
+
+    std::mutex m_FileMutex{};
+    UnorderedMap<U64, std::unique_ptr<Region>> m_Regions{};
+    U64 m_UseTick{0};
+
+    std::thread m_IoThread{};
+};
+
+// World resource handing the store to streaming (saves) and generation (loads).
+export struct VoxelRegionStoreResource {
+    std::shared_ptr<VoxelRegionStore> store{};
+};
+
+export template<>
+struct ComponentTypeID<VoxelRegionStoreResource> {
+    static consteval ComponentID value() { return VoxelRegionStoreResource_ID; }
+};
+
+// Directory under root for the saves of worlds with the given generator key, so saves made
+// with other terrain settings are never loaded into this one.
+export inline std::filesystem::path VoxelSaveDirectory(std::filesystem::path const& root, U64 generatorKey) {
+    return root / std::format("{:016x}", generatorKey);
+}
+
+// Finding the store only reads the resource handle; the store itself is thread-safe.
+export inline VoxelRegionStore* FindVoxelRegionStore(World const* world) {
+    auto* store{world->GetStorage<VoxelRegionStoreResource>()};
+    if (!store) return nullptr;
+    for (auto [h,c] : *store) return c.store.get();
+    return nullptr;
+}
@@ -37,7 +37,6 @@ private:
     U32 m_VB{INVALID_INDEX};
     U32 m_IB{INVALID_INDEX};
     U32 m_CameraCB{INVALID_INDEX};
-    U32 m_ObjectCB{INVALID_INDEX};
     U32 m_VCount{0};
     U32 m_ICount{0};
 
@@ -47,6 +46,7 @@ public:
         SetStage(SystemStage::Render);
         SetPriority(SystemPriority::High);
         SetParallel(false);
+        ReadsComponents<VoxelWorldConfig, VoxelSelection, Camera, Transform>();
     }
 
     void SetGraphicsContext(IGraphicsContext* gfx) {
@@ -56,9 +56,10 @@ public:
     void Run(World* world, F32) override {
         assert(m_Gfx != nullptr, "GraphicsContext must be set");
         EnsureResources();
+        World const* view{world};
 
         VoxelSelection sel{};
-        if (auto* s{world->GetStorage<VoxelSelection>()}) {
+        if (auto* s{view->GetStorage<VoxelSelection>()}) {
             for (auto [h,c] : *s) {
                 sel = c;
                 break;
@@ -66,7 +67,7 @@ public:
         }
         if (!sel.valid) return;
 
-        auto* wcfg{world->GetStorage<VoxelWorldConfig>()};
+        auto* wcfg{view->GetStorage<VoxelWorldConfig>()};
         assert(wcfg && wcfg->Size() > 0, "Missing VoxelWorldConfig");
         VoxelWorldConfig const* cfg{};
         for (auto [h,c] : *wcfg) {
@@ -77,12 +78,12 @@ public:
 
         CameraConstants cam{};
         if (auto h{CameraManager::GetPrimaryCamera()}; h.valid()) {
-            if (auto* c{world->GetComponent<Camera>(h)}) {
+            if (auto* c{view->GetComponent<Camera>(h)}) {
                 cam.view = c->view;
                 cam.projection = c->projection;
                 cam.viewProjection = c->viewProjection;
             }
-            if (auto* t{world->GetComponent<Transform>(h)}) {
+            if (auto* t{view->GetComponent<Transform>(h)}) {
                 cam.cameraPosition = t->position;
             }
         }
@@ -96,11 +97,10 @@ public:
         )};
         ObjectConstants obj{};
         obj.world = T * S;
-        m_Gfx->UpdateConstantBuffer(m_ObjectCB, &obj, sizeof(obj));
 
         m_Gfx->SetPipeline(m_Pipeline);
         m_Gfx->SetConstantBuffer(m_CameraCB, 0);
-        m_Gfx->SetConstantBuffer(m_ObjectCB, 1);
+        m_Gfx->SetObjectConstants(&obj, sizeof(obj));
         m_Gfx->SetVertexBuffer(m_VB);
         m_Gfx->SetIndexBuffer(m_IB);
         m_Gfx->DrawIndexed(m_ICount);
@@ -154,9 +154,6 @@ private:
         if (m_CameraCB == INVALID_INDEX) {
             m_CameraCB = m_Gfx->CreateConstantBuffer(sizeof(CameraConstants));
         }
-        if (m_ObjectCB == INVALID_INDEX) {
-            m_ObjectCB = m_Gfx->CreateConstantBuffer(sizeof(ObjectConstants));
-        }
         assert(sizeof(Math::Vec3) == 12 || sizeof(Math::Vec3) == 16, "Unexpected Vec3 size");
     }
 };
\ No newline at end of file
@@ -1,12 +1,18 @@
 export module Systems.VoxelStreaming;
 
 import ECS.SystemScheduler;
+import ECS.CommandBuffer;
 import ECS.World;
 import ECS.Query;
 import Components.Voxel;
 import Components.Transform;
 import Components.Camera;
 import Components.VoxelStreaming;
+import Components.VoxelChunkIndex;
+import Components.VoxelStreamingEvents;
+import Systems.VoxelColumnCache;
+import Systems.VoxelRegionStore;
+import Systems.VoxelBufferPool;
 import Systems.CameraManager;
 import Core.Types;
 import Core.Assert;
@@ -14,28 +20,59 @@ import Math.Core;
 import Math.Vector;
 import std;
 
-namespace {
-    inline U64 PackKey(S32 x, S32 y, S32 z) {
-        constexpr U64 B{1ull << 20};
-        return (static_cast<U64>(static_cast<S64>(x) + static_cast<S64>(B)))
-               | (static_cast<U64>(static_cast<S64>(y) + static_cast<S64>(B)) << 21)
-               | (static_cast<U64>(static_cast<S64>(z) + static_cast<S64>(B)) << 42);
+export class VoxelStreamingSystem : public System<VoxelStreamingSystem> {
+    // Chunk of the load region that does not exist yet.
+    struct Cand {
+        S32 cx;
+        S32 cy;
+        S32 cz;
+        F32 score;
+    };
+
+    static constexpr S32 kNoChunk{std::numeric_limits<S32>::max()};
+    // The queue is re-ranked when the view turns by more than ~25 degrees.
+    static constexpr F32 kRescoreCos{0.9f};
+
+    S32 m_CenterX{kNoChunk};
+    S32 m_CenterY{kNoChunk};
+    S32 m_CenterZ{kNoChunk};
+    VoxelStreamingConfig m_Config{};
+    Math::Vec3 m_ScoreDir{};
+    // Missing chunks ordered by score, best last; rebuilt when the camera changes chunk.
+    Vector<Cand> m_Queue{};
+    bool m_UnloadPending{false};
+
+    // Distance weighted by view direction, as in meshing: lower loads first.
+    static F32 Score(Math::Vec3 const &center, Math::Vec3 const &camPos, Math::Vec3 const &camDir) {
+        const Math::Vec3 toC{center - camPos};
+        const F32 d2{toC.LengthSquared()};
+        const F32 cosA{d2 > 1e-6f && camDir.LengthSquared() > 0.0f ? camDir.Dot(toC.Normalized()) : 1.0f};
+        return d2 * (2.0f - std::clamp(cosA, -1.0f, 1.0f));
+    }
+
+    void SortQueue() {
+        std::ranges::sort(m_Queue, std::ranges::greater{}, &Cand::score);
     }
-}
 
-export class VoxelStreamingSystem : public System<VoxelStreamingSystem> {
 public:
     void Setup() {
         SetName("VoxelStreaming");
         SetStage(SystemStage::PreUpdate);
         SetPriority(SystemPriority::Critical);
-        SetParallel(false);
+        // Entities are created and destroyed through Commands(), played back after the stage.
+        SetParallel(true);
         RunBefore("VoxelGeneration");
         RunBefore("VoxelMeshing");
+        ReadsComponents<VoxelWorldConfig, VoxelStreamingConfig, VoxelChunkIndex, Transform>();
+        WritesComponents<VoxelChunk, VoxelColumnCacheResource, VoxelRegionStoreResource, VoxelBufferPoolResource,
+                         VoxelStreamingEvents>();
     }
 
     void Run(World *world, F32) override {
-        auto *wcfgStore{world->GetStorage<VoxelWorldConfig>()};
+        CommandBuffer &cmd{Commands()};
+        World const *view{world};
+
+        auto *wcfgStore{view->GetStorage<VoxelWorldConfig>()};
         assert(wcfgStore && wcfgStore->Size() > 0, "Missing VoxelWorldConfig");
         VoxelWorldConfig const *wcfg{};
         for (auto [h,c]: *wcfgStore) {
@@ -43,11 +80,10 @@ public:
             break;
         }
 
-        auto *scStore{world->GetStorage<VoxelStreamingConfig>()};
+        auto *scStore{view->GetStorage<VoxelStreamingConfig>()};
         if (!scStore || scStore->Size() == 0) {
-            auto e{world->CreateEntity()};
-            world->AddComponent(e, VoxelStreamingConfig{});
-            scStore = world->GetStorage<VoxelStreamingConfig>();
+            cmd.AddComponent(cmd.CreateEntity(), VoxelStreamingConfig{});
+            return;
         }
         VoxelStreamingConfig const *sc{};
         for (auto [h,c]: *scStore) {
@@ -57,8 +93,12 @@ public:
         assert(sc != nullptr, "Missing VoxelStreamingConfig");
 
         Math::Vec3 camPos{};
+        Math::Vec3 camDir{};
         if (auto h{CameraManager::GetPrimaryCamera()}; h.valid()) {
-            if (auto *t{world->GetComponent<Transform>(h)}) camPos = t->position;
+            if (auto *t{view->GetComponent<Transform>(h)}) {
+                camPos = t->position;
+                camDir = t->Forward();
+            }
         }
 
         const F32 sx{wcfg->blockSize * static_cast<F32>(VoxelChunk::SizeX)};
@@ -67,82 +107,130 @@ public:
         const S32 ccx{static_cast<S32>(std::floor(camPos.x / sx))};
         const S32 ccy{static_cast<S32>(std::floor(camPos.y / sy))};
         const S32 ccz{static_cast<S32>(std::floor(camPos.z / sz))};
+        auto chunkCenter = [sx, sy, sz](S32 cx, S32 cy, S32 cz) {
+            return Math::Vec3{
+                (static_cast<F32>(cx) + 0.5f) * sx,
+                (static_cast<F32>(cy) + 0.5f) * sy,
+                (static_cast<F32>(cz) + 0.5f) * sz
+            };
+        };
 
-        UnorderedMap<U64, VoxelChunk *> existing{};
-        if (auto *store{world->GetStorage<VoxelChunk>()}) {
-            for (auto [h,c]: *store) {
-                existing.emplace(
-                    PackKey(static_cast<S32>(c.cx), static_cast<S32>(c.cy), static_cast<S32>(c.cz)),
-                    const_cast<VoxelChunk *>(&c)
-                );
+        // World resources are created on the first frame; streaming starts on the next.
+        auto const *index{FindVoxelChunkIndex(view)};
+        auto *columns{FindVoxelColumnCache(world)};
+        auto *pool{FindVoxelBufferPool(world)};
+        auto *events{FindVoxelStreamingEvents(world)};
+        if (!index || !columns || !pool || !events) {
+            if (!index) cmd.AddComponent(cmd.CreateEntity(), VoxelChunkIndex{});
+            if (!columns) {
+                const U32 side{2u * (sc->radius + sc->margin) + 1u};
+                cmd.AddComponent(cmd.CreateEntity(),
+                                 VoxelColumnCacheResource{std::make_shared<VoxelColumnCache>(side * side)});
+            }
+            if (!pool) {
+                cmd.AddComponent(cmd.CreateEntity(), VoxelBufferPoolResource{std::make_shared<VoxelBufferPool>()});
             }
+            if (!events) cmd.AddComponent(cmd.CreateEntity(), VoxelStreamingEvents{});
+            return;
         }
+        pool->Tick();
+        events->loaded.Clear();
+        events->unloaded.Clear();
 
-        UnorderedMap<U64, bool> wanted{};
-        U32 createLeft{sc->createBudget};
-        U32 removeLeft{sc->removeBudget};
-
-        struct Cand {
-            S32 cx;
-            S32 cy;
-            S32 cz;
-            F32 d2;
-            U64 key;
-        };
-        Vector<Cand> cands{};
-
-        for (S32 dz{-static_cast<S32>(sc->radius)}; dz <= static_cast<S32>(sc->radius); ++dz) {
-            for (S32 dx{-static_cast<S32>(sc->radius)}; dx <= static_cast<S32>(sc->radius); ++dx) {
-                if (std::max(std::abs(dx), std::abs(dz)) > static_cast<S32>(sc->radius)) continue;
-                for (S32 dy{sc->minChunkY}; dy <= sc->maxChunkY; ++dy) {
-                    S32 cx{ccx + dx}, cy{ccy + dy}, cz{ccz + dz};
-                    Math::Vec3 center{
-                        (static_cast<F32>(cx) + 0.5f) * sx,
-                        (static_cast<F32>(cy) + 0.5f) * sy,
-                        (static_cast<F32>(cz) + 0.5f) * sz
-                    };
-                    F32 d2{(center - camPos).LengthSquared()};
-                    U64 k{PackKey(cx, cy, cz)};
-                    cands.push_back(Cand{cx, cy, cz, d2, k});
+        // The load region only changes when the camera changes chunk or the config changes;
+        // in between, creation drains the queue and unloading is skipped.
+        const bool moved{ccx != m_CenterX || ccy != m_CenterY || ccz != m_CenterZ};
+        const bool reconfigured{sc->radius != m_Config.radius || sc->margin != m_Config.margin ||
+                                sc->minChunkY != m_Config.minChunkY || sc->maxChunkY != m_Config.maxChunkY};
+        if (moved || reconfigured) {
+            m_Queue.clear();
+            for (S32 dz{-static_cast<S32>(sc->radius)}; dz <= static_cast<S32>(sc->radius); ++dz) {
+                for (S32 dx{-static_cast<S32>(sc->radius)}; dx <= static_cast<S32>(sc->radius); ++dx) {
+                    for (S32 dy{sc->minChunkY}; dy <= sc->maxChunkY; ++dy) {
+                        const S32 cx{ccx + dx}, cy{ccy + dy}, cz{ccz + dz};
+                        if (index->Contains(cx, cy, cz)) continue;
+                        m_Queue.push_back(Cand{cx, cy, cz, Score(chunkCenter(cx, cy, cz), camPos, camDir)});
+                    }
                 }
             }
-        }
+            SortQueue();
+            m_ScoreDir = camDir;
+            m_UnloadPending = true;
 
-        std::ranges::sort(cands, {}, &Cand::d2);
-
-        for (auto const &c: cands) {
-            wanted.emplace(c.key, true);
-            if (createLeft == 0u) break;
-            if (!existing.contains(c.key)) {
-                auto e{world->CreateEntity()};
-                VoxelChunk chunk{};
-                chunk.cx = static_cast<U32>(c.cx);
-                chunk.cy = static_cast<U32>(c.cy);
-                chunk.cz = static_cast<U32>(c.cz);
-                chunk.origin = Math::Vec3{
-                    static_cast<F32>(c.cx) * sx,
-                    static_cast<F32>(c.cy) * sy,
-                    static_cast<F32>(c.cz) * sz
-                };
-                chunk.blocks.clear();
-                chunk.dirty = false;
-                world->AddComponent(e, std::move(chunk));
-                world->AddComponent(e, VoxelMesh{});
-                --createLeft;
+            // Columns leave the cache with the chunks that used them.
+            if (ccx != m_CenterX || ccz != m_CenterZ || reconfigured) {
+                columns->EvictOutside(ccx, ccz, static_cast<S32>(sc->radius + sc->margin));
             }
+            m_CenterX = ccx;
+            m_CenterY = ccy;
+            m_CenterZ = ccz;
+            m_Config = *sc;
+        } else if (!m_Queue.empty() && camDir.Dot(m_ScoreDir) < kRescoreCos) {
+            for (Cand &c: m_Queue) c.score = Score(chunkCenter(c.cx, c.cy, c.cz), camPos, camDir);
+            SortQueue();
+            m_ScoreDir = camDir;
+        }
+
+        U32 createLeft{sc->createBudget};
+        while (createLeft > 0u && !m_Queue.empty()) {
+            const Cand c{m_Queue.back()};
+            m_Queue.pop_back();
+            if (index->Contains(c.cx, c.cy, c.cz)) continue;
+
+            auto e{cmd.CreateEntity()};
+            VoxelChunk chunk{};
+            chunk.cx = static_cast<U32>(c.cx);
+            chunk.cy = static_cast<U32>(c.cy);
+            chunk.cz = static_cast<U32>(c.cz);
+            chunk.origin = Math::Vec3{
+                static_cast<F32>(c.cx) * sx,
+                static_cast<F32>(c.cy) * sy,
+                static_cast<F32>(c.cz) * sz
+            };
+            chunk.blocks.Clear();
+            chunk.dirty = false;
+            cmd.AddComponent(e, std::move(chunk));
+            cmd.AddComponent(e, VoxelMesh{});
+            cmd.Defer(e, [cx{c.cx}, cy{c.cy}, cz{c.cz}](World &w, EntityHandle h) {
+                if (auto *idx{FindVoxelChunkIndex(&w)}) idx->Insert(cx, cy, cz, h);
+                if (auto *ev{FindVoxelStreamingEvents(&w)}) ev->loaded.Publish(ChunkLoaded{h, cx, cy, cz});
+            });
+            --createLeft;
         }
 
+        // Chunks only fall out of range when the center moves; a scan cut short by the budget
+        // resumes next frame.
+        if (!m_UnloadPending) return;
+        U32 removeLeft{sc->removeBudget};
         if (auto *store{world->GetStorage<VoxelChunk>()}) {
             for (auto [h,c]: *store) {
+                if (removeLeft == 0u) break;
                 const S32 dx{static_cast<S32>(c.cx) - ccx};
                 const S32 dy{static_cast<S32>(c.cy) - ccy};
                 const S32 dz{static_cast<S32>(c.cz) - ccz};
                 const S32 md{std::max({std::abs(dx), std::abs(dy), std::abs(dz)})};
-                if (md > static_cast<S32>(sc->radius + sc->margin) && removeLeft > 0) {
-                    world->DestroyEntity(h);
-                    --removeLeft;
-                }
+                if (md <= static_cast<S32>(sc->radius + sc->margin)) continue;
+
+                cmd.Defer(h, [cx{static_cast<S32>(c.cx)}, cy{static_cast<S32>(c.cy)}, cz{static_cast<S32>(c.cz)}](World &w, EntityHandle e) {
+                    if (auto *ev{FindVoxelStreamingEvents(&w)}) ev->unloaded.Publish(ChunkUnloaded{e, cx, cy, cz});
+                    auto *idx{FindVoxelChunkIndex(&w)};
+                    if (idx && idx->Find(cx, cy, cz) == e) idx->Erase(cx, cy, cz);
+                    // Edits are saved at playback, when the chunk is no longer shared with other systems.
+                    auto *chunk{w.GetComponent<VoxelChunk>(e)};
+                    auto *regionStore{FindVoxelRegionStore(&w)};
+                    if (chunk && regionStore && chunk->modified && !chunk->blocks.Empty()) {
+                        regionStore->Save(cx, cy, cz, std::move(chunk->blocks));
+                    }
+                    // Hand the chunk's buffers back before the entity is destroyed.
+                    if (auto *bufferPool{FindVoxelBufferPool(&w)}) {
+                        if (chunk) bufferPool->Recycle(chunk->blocks);
+                        if (auto *mesh{w.GetComponent<VoxelMesh>(e)}) bufferPool->Recycle(*mesh);
+                    }
+                });
+                cmd.DestroyEntity(h);
+                --removeLeft;
             }
         }
+        m_UnloadPending = removeLeft == 0u;
     }
 };
@@ -2,64 +2,152 @@ export module Systems.VoxelUpload;
 
 import ECS.SystemScheduler;
 import ECS.World;
+import ECS.EventChannel;
 import Components.Voxel;
 import Components.VoxelStreaming;
+import Components.VoxelStreamingEvents;
+import Components.VoxelDrawList;
+import Systems.VoxelBufferPool;
 import Graphics;
+import Graphics.MeshArena;
+import Math.Vector;
+import Math.Matrix;
+import Math.Transform;
+import Tasks.TaskProfiler;
 import Core.Types;
 import Core.Assert;
 import std;
 
+// Uploads finished meshes into the graphics context's mesh arena. A remesh frees the previous
+// allocation and an unloaded chunk frees its own; the arena holds both back until the GPU is done.
+// Non-empty meshes are kept in the VoxelDrawList the renderer culls and draws from.
 export class VoxelUploadSystem : public System<VoxelUploadSystem> {
 private:
     IGraphicsContext* m_Gfx{nullptr};
+    VoxelStreamingEvents* m_Events{nullptr};
+    EventChannel<ChunkUnloaded>::SubscriptionID m_UnloadSubscription{};
 
 public:
+    ~VoxelUploadSystem() override {
+        if (m_Events) m_Events->unloaded.Unsubscribe(m_UnloadSubscription);
+    }
+
     void Setup() {
         SetName("VoxelUpload");
         SetStage(SystemStage::PreRender);
         SetPriority(SystemPriority::High);
         SetParallel(false);
+        ReadsComponents<VoxelWorldConfig, VoxelStreamingConfig, VoxelChunk, VoxelBufferPoolResource>();
+        WritesComponents<VoxelMesh, VoxelStreamingEvents, VoxelDrawList>();
     }
 
     void SetGraphicsContext(IGraphicsContext* gfx) {
         m_Gfx = gfx;
     }
 
+    static Math::Mat4 ChunkWorldMatrix(VoxelChunk const& chunk, F32 blockSize) {
+        auto corner = [&](U32 c, U32 size) -> F32 {
+            return static_cast<F32>(static_cast<F64>(static_cast<S64>(static_cast<S32>(c)) * static_cast<S64>(size)) * static_cast<F64>(blockSize));
+        };
+        Math::Mat4 T{Math::Mat4::Translation(corner(chunk.cx, VoxelChunk::SizeX), corner(chunk.cy, VoxelChunk::SizeY), corner(chunk.cz, VoxelChunk::SizeZ))};
+        Math::Mat4 S{Math::Mat4::Scale(blockSize, blockSize, blockSize)};
+        return T * S;
+    }
+
     void Run(World* world, F32) override {
         assert(m_Gfx != nullptr, "GraphicsContext must be set");
+        World const* view{world};
 
-        auto* scStore{world->GetStorage<VoxelStreamingConfig>()};
+        auto* scStore{view->GetStorage<VoxelStreamingConfig>()};
         assert(scStore && scStore->Size() > 0, "Missing VoxelStreamingConfig");
         VoxelStreamingConfig const* sc{};
         for (auto [h,c] : *scStore) { sc = &c; break; }
 
+        auto* cfgStore{view->GetStorage<VoxelWorldConfig>()};
+        assert(cfgStore && cfgStore->Size() > 0, "Missing VoxelWorldConfig");
+        VoxelWorldConfig const* cfg{};
+        for (auto [h,c] : *cfgStore) { cfg = &c; break; }
+
+        MeshArena& arena{m_Gfx->GetMeshArena()};
+        assert(arena.VertexStride() == sizeof(ChunkVertex), "Mesh arena stride must match ChunkVertex");
+        if (!FindVoxelDrawList(world)) world->AddComponent(world->CreateEntity(), VoxelDrawList{});
+        if (!m_Events && (m_Events = FindVoxelStreamingEvents(world)) != nullptr) {
+            // Playback publishes while the chunk's components still exist.
+            m_UnloadSubscription = m_Events->unloaded.Subscribe([world, &arena](ChunkUnloaded const& e) {
+                if (auto* mesh{world->GetComponent<VoxelMesh>(e.entity)}) {
+                    arena.Free(mesh->gpu);
+                    mesh->gpu = MeshAllocation{};
+                    RemoveDraw(world, *mesh);
+                }
+            });
+        }
+        VoxelDrawList& draws{*FindVoxelDrawList(world)};
+        const Math::Vec3 chunkSize{cfg->blockSize * static_cast<F32>(VoxelChunk::SizeX),
+                                   cfg->blockSize * static_cast<F32>(VoxelChunk::SizeY),
+                                   cfg->blockSize * static_cast<F32>(VoxelChunk::SizeZ)};
+
         auto* storage{world->GetStorage<VoxelMesh>()};
         if (!storage) return;
 
+        auto* pool{FindVoxelBufferPool(world)};
         U32 left{sc->uploadBudget};
+        U64 uploadedBytes{0};
         for (auto [handle, mesh] : *storage) {
             if (!mesh.gpuDirty) continue;
             if (left == 0u) break;
 
-            // Swap ready vertices to CPU buffer
-            if (!mesh.readyVertices.empty()) {
-                mesh.cpuVertices.swap(mesh.readyVertices);
-                mesh.readyVertices.clear();
+            // Staging space runs out before heap space; whatever is left goes next frame.
+            std::optional<MeshAllocation> gpu{arena.Upload(mesh.readyVertices.data(), static_cast<U32>(mesh.readyVertices.size()),
+                                                           mesh.readyIndices.data(), static_cast<U32>(mesh.readyIndices.size()))};
+            if (!gpu) break;
+            arena.Free(mesh.gpu);
+            mesh.gpu = *gpu;
+
+            // Swap the finished mesh into the CPU buffers; an empty result clears the chunk.
+            // The previous buffers go back to the pool for the next meshing job.
+            mesh.cpuVertices.swap(mesh.readyVertices);
+            mesh.cpuIndices.swap(mesh.readyIndices);
+            if (pool) {
+                pool->Vertices().Release(std::move(mesh.readyVertices));
+                pool->Indices().Release(std::move(mesh.readyIndices));
             }
+            mesh.readyVertices.clear();
+            mesh.readyIndices.clear();
+            mesh.vertexCount = static_cast<U32>(mesh.cpuVertices.size());
+            mesh.indexCount = static_cast<U32>(mesh.cpuIndices.size());
 
-            // Upload to GPU
-            const U64 vsize{static_cast<U64>(mesh.cpuVertices.size() * sizeof(Vertex))};
-            const U64 isize{static_cast<U64>(mesh.cpuIndices.size() * sizeof(U32))};
+            // Vertices are chunk-local block corners; the per-chunk world matrix places them
+            auto const* chunk{view->GetComponent<VoxelChunk>(handle)};
+            if (chunk) mesh.world = ChunkWorldMatrix(*chunk, cfg->blockSize);
 
-            if (vsize) {
-                mesh.vertexBuffer = m_Gfx->CreateVertexBuffer(mesh.cpuVertices.data(), vsize);
-            }
-            if (isize) {
-                mesh.indexBuffer = m_Gfx->CreateIndexBuffer(mesh.cpuIndices.data(), isize);
+            if (!chunk || mesh.indexCount == 0u) {
+                RemoveDraw(world, mesh);
+            } else if (mesh.drawSlot == INVALID_INDEX) {
+                mesh.drawSlot = draws.Add(handle, Math::Bounds{chunk->origin, chunk->origin + chunkSize}, VoxelDraw{mesh.gpu, mesh.world});
+            } else {
+                draws.Update(mesh.drawSlot, VoxelDraw{mesh.gpu, mesh.world});
             }
 
             mesh.gpuDirty = false;
+            uploadedBytes += static_cast<U64>(mesh.vertexCount) * sizeof(ChunkVertex) + static_cast<U64>(mesh.indexCount) * sizeof(U32);
             --left;
         }
+
+        if (const U32 uploaded{sc->uploadBudget - left}; uploaded > 0u) {
+            TaskProfiler::Get().AddCounter("MeshesUploaded", uploaded);
+            TaskProfiler::Get().AddCounter("BytesUploaded", static_cast<S64>(uploadedBytes));
+        }
+    }
+
+private:
+    // Drops the mesh's draw entry; the entry swapped into its slot gets its owner's slot updated.
+    static void RemoveDraw(World* world, VoxelMesh& mesh) {
+        if (mesh.drawSlot == INVALID_INDEX) return;
+        auto* draws{FindVoxelDrawList(world)};
+        if (!draws) return;
+        if (const EntityHandle moved{draws->Remove(mesh.drawSlot)}; moved.valid()) {
+            if (auto* other{world->GetComponent<VoxelMesh>(moved)}) other->drawSlot = mesh.drawSlot;
+        }
+        mesh.drawSlot = INVALID_INDEX;
     }
 };
\ No newline at end of file
@@ -16,9 +16,7 @@ private:
     World* m_World;
     F32 m_DeltaTime{0.016f};
 
-    // Add synchronization
     mutable std::mutex m_ExecutionMutex;
-    std::atomic<bool> m_IsExecuting{false};
 
     // Map SystemPriority to TaskPriority
     static TaskPriority ConvertPriority(SystemPriority sysPriority) {
@@ -84,35 +82,15 @@ private:
                 // Capture node by value to ensure it's valid during execution
                 auto* capturedNode = node;
                 auto* capturedScheduler = m_Scheduler;
-                auto* capturedWorld = m_World;
                 auto* deltaTimePtr = &m_DeltaTime;
-                auto* isExecutingPtr = &m_IsExecuting;
 
+                // Systems that must not overlap are already ordered by the scheduler's
+                // dependency edges, so tasks run without extra locking.
                 Task* task = m_Orchestrator->AddTaskToPhase(
                     phaseName,
                     node->metadata.name,
-                    [capturedNode, capturedScheduler, capturedWorld, deltaTimePtr, isExecutingPtr]() {
-                        // Ensure only one system executes at a time if not parallel
-                        if (!capturedNode->metadata.isParallel) {
-                            bool expected = false;
-                            while (!isExecutingPtr->compare_exchange_weak(expected, true)) {
-                                expected = false;
-                                std::this_thread::yield();
-                            }
-                        }
-
-                        try {
-                            capturedScheduler->ExecuteSystem(capturedNode, *deltaTimePtr);
-                        } catch (...) {
-                            if (!capturedNode->metadata.isParallel) {
-                                isExecutingPtr->store(false);
-                            }
-                            throw;
-                        }
-
-                        if (!capturedNode->metadata.isParallel) {
-                            isExecutingPtr->store(false);
-                        }
+                    [capturedNode, capturedScheduler, deltaTimePtr]() {
+                        capturedScheduler->ExecuteSystem(capturedNode, *deltaTimePtr);
                     },
                     ConvertPriority(node->metadata.priority)
                 );
@@ -124,6 +102,30 @@ private:
             }
         }
 
+        // Each stage ends by playing back its systems' command buffers once all of them ran.
+        // Idle so that priority inheritance does not lift every system of the stage; it is
+        // the only task left ready by the time it can run.
+        for (const auto& [stage, nodes] : m_Scheduler->GetStageNodes()) {
+            std::string phaseName = GetStagePhaseName(stage);
+            auto* capturedScheduler = m_Scheduler;
+            const SystemStage capturedStage = stage;
+
+            Task* flushTask = m_Orchestrator->AddTaskToPhase(
+                phaseName,
+                phaseName + "Commands",
+                [capturedScheduler, capturedStage]() {
+                    capturedScheduler->FlushCommands(capturedStage);
+                },
+                TaskPriority::Idle
+            );
+
+            for (auto* node : nodes) {
+                if (Task* nodeTask = nodeToTask[node]) {
+                    flushTask->AddDependency(nodeTask);
+                }
+            }
+        }
+
         // Add dependencies between tasks with validation
         for (const auto& [stage, nodes] : m_Scheduler->GetStageNodes()) {
             for (auto* node : nodes) {
@@ -4,6 +4,7 @@ import Core.Types;
 import Core.Assert;
 import Core.Log;
 import Tasks.TaskProfiler;
+import Tasks.WorkStealingDeque;
 import std;
 
 export enum class TaskStatus : U8 {
@@ -32,6 +33,9 @@ export class Task {
 public:
     using TaskFunc = std::function<void()>;
 
+    // Weight of the newest sample in the moving average of execution time.
+    static constexpr F32 kTimeSmoothing{0.2f};
+
 private:
     std::string m_Name;
     TaskFunc m_Function;
@@ -43,6 +47,14 @@ private:
     U64 m_ExecutionTime{0};
     U32 m_TaskID;
     U32 m_PhaseID{0};
+    bool m_Transient{false};   // ParallelFor helper, freed when the executor drains
+
+    // Scheduling state refreshed by TaskGraph before each run of the phase.
+    F32 m_AverageTime{0.0f};
+    bool m_HasHistory{false};
+    U64 m_CriticalPath{0};
+    TaskPriority m_EffectivePriority{TaskPriority::Normal};
+    U32 m_UnresolvedDependencies{0};
 
     std::chrono::high_resolution_clock::time_point m_StartTime;
     std::chrono::high_resolution_clock::time_point m_EndTime;
@@ -51,7 +63,8 @@ private:
 
 public:
     Task(std::string name, TaskFunc func, TaskPriority priority = TaskPriority::Normal)
-        : m_Name{std::move(name)}, m_Function{std::move(func)}, m_Priority{priority} {
+        : m_Name{std::move(name)}, m_Function{std::move(func)}, m_Priority{priority},
+          m_EffectivePriority{priority} {
         static std::atomic<U32> s_NextID{0};
         m_TaskID = s_NextID.fetch_add(1);
     }
@@ -73,6 +86,10 @@ public:
         m_EndTime = std::chrono::high_resolution_clock::now();
         m_ExecutionTime = std::chrono::duration_cast<std::chrono::microseconds>(
             m_EndTime - m_StartTime).count();
+
+        const F32 sample = static_cast<F32>(m_ExecutionTime);
+        m_AverageTime = m_HasHistory ? m_AverageTime + kTimeSmoothing * (sample - m_AverageTime) : sample;
+        m_HasHistory = true;
     }
 
     void AddDependency(Task* dependency) {
@@ -92,6 +109,9 @@ public:
     [[nodiscard]] U32 GetID() const { return m_TaskID; }
     [[nodiscard]] U64 GetExecutionTime() const { return m_ExecutionTime; }
     [[nodiscard]] TaskPriority GetPriority() const { return m_Priority; }
+    [[nodiscard]] TaskPriority GetEffectivePriority() const { return m_EffectivePriority; }
+    [[nodiscard]] F32 GetAverageExecutionTime() const { return m_AverageTime; }
+    [[nodiscard]] U64 GetCriticalPath() const { return m_CriticalPath; }
     [[nodiscard]] U32 GetPhaseID() const { return m_PhaseID; }
     [[nodiscard]] U64 GetStartTimestamp() const {
         return std::chrono::duration_cast<std::chrono::microseconds>(
@@ -164,26 +184,58 @@ public:
     [[nodiscard]] const Vector<std::unique_ptr<Task>>& GetTasks() const { return m_Tasks; }
 };
 
+// Each worker owns one Chase–Lev deque per priority lane: tasks released by a finished task
+// are pushed to the releasing thread's deque and idle threads steal from the others. Roots
+// submitted from outside the pool go through a small injection queue. The thread blocked in
+// WaitForCompletion takes an extra slot and executes tasks until the submitted work drains.
+//
+// Lanes are served highest first. A lane that keeps being passed over while it has ready
+// work ages, and after kAgingLimit skips it is served once ahead of the higher lanes.
 class TaskExecutor {
 private:
-    struct WorkerThread {
+    static constexpr U32 kLaneCount{5};
+    static constexpr U32 kAgingLimit{16};
+    static constexpr U32 kSpinRounds{64};
+    // Profiler name of ParallelFor helpers. The profiler keeps name pointers until EndFrame,
+    // after the helpers themselves are freed, so they report this literal instead.
+    static constexpr const char* kParallelForName{"ParallelFor"};
+
+    struct alignas(64) WorkerThread {
         std::thread thread;
-        std::atomic<bool> shouldStop{false};
+        std::array<WorkStealingDeque<Task*>, kLaneCount> lanes;
+        std::array<U32, kLaneCount> skipped{};
         U32 threadID;
+        U32 rng;
         U64 totalExecutionTime{0};
         U32 tasksExecuted{0};
     };
 
+    static inline thread_local TaskExecutor* s_CurrentExecutor{nullptr};
+    static inline thread_local WorkerThread* s_CurrentWorker{nullptr};
+    static inline thread_local Task* s_CurrentTask{nullptr};
+
+    // One slot per worker thread plus the helper slot used by WaitForCompletion.
     Vector<std::unique_ptr<WorkerThread>> m_Workers;
-    std::queue<Task*> m_ReadyQueue;
-    std::mutex m_QueueMutex;
-    std::condition_variable m_QueueCV;
-    std::atomic<U32> m_ActiveTasks{0};
+    U32 m_ThreadCount{0};
+
+    std::mutex m_InjectMutex;
+    std::array<std::deque<Task*>, kLaneCount> m_Injected;
+    // Ready-but-not-started tasks per lane, across every deque and the injection queue.
+    std::array<std::atomic<U32>, kLaneCount> m_LaneReady{};
+
+    // Submitted or released tasks that have not finished yet.
+    std::atomic<U32> m_Outstanding{0};
+    // Bumped whenever work appears or drains; sleeping threads wait for it to change.
+    std::atomic<U32> m_Epoch{0};
+    std::atomic<U32> m_Sleepers{0};
+    std::atomic<bool> m_Helping{false};
     std::atomic<bool> m_Running{false};
     bool m_ProfilingEnabled{true};
 
-    std::chrono::steady_clock::time_point m_LastProgressTime;
-    std::atomic<U32> m_LastActiveCount{0};
+    // Helper tasks spawned by ParallelFor; freed once the executor drains, when no worker
+    // can still be touching them.
+    std::mutex m_TransientMutex;
+    Vector<std::unique_ptr<Task>> m_Transient;
 
 public:
     explicit TaskExecutor(U32 threadCount = 0) {
@@ -191,17 +243,21 @@ public:
             threadCount = std::thread::hardware_concurrency();
             if (threadCount == 0) threadCount = 4;
         }
+        m_ThreadCount = threadCount;
 
-        m_Workers.reserve(threadCount);
-        for (U32 i = 0; i < threadCount; ++i) {
+        m_Workers.reserve(threadCount + 1);
+        for (U32 i = 0; i <= threadCount; ++i) {
             auto worker = std::make_unique<WorkerThread>();
             worker->threadID = i;
-            worker->thread = std::thread(&TaskExecutor::WorkerLoop, this, worker.get());
+            worker->rng = 0x9E3779B9u * (i + 1);
             m_Workers.push_back(std::move(worker));
         }
 
         m_Running.store(true);
-        m_LastProgressTime = std::chrono::steady_clock::now();
+        for (U32 i = 0; i < threadCount; ++i) {
+            m_Workers[i]->thread = std::thread(&TaskExecutor::WorkerLoop, this, m_Workers[i].get());
+        }
+
         Logger::Info(LogTasks, "TaskExecutor initialized with {} worker threads", threadCount);
     }
 
@@ -209,68 +265,95 @@ public:
         Shutdown();
     }
 
+    static U32 LaneOf(TaskPriority priority) {
+        const S32 value = static_cast<S32>(priority);
+        if (value >= static_cast<S32>(TaskPriority::Critical)) return 0;
+        if (value >= static_cast<S32>(TaskPriority::High)) return 1;
+        if (value >= static_cast<S32>(TaskPriority::Normal)) return 2;
+        if (value >= static_cast<S32>(TaskPriority::Low)) return 3;
+        return 4;
+    }
+
     void SubmitTask(Task* task) {
         if (!task) return;
 
-        {
-            std::lock_guard lock(m_QueueMutex);
-            m_ReadyQueue.push(task);
+        const U32 lane = LaneOf(task->m_EffectivePriority);
+        m_Outstanding.fetch_add(1);
+        if (s_CurrentExecutor == this) {
+            s_CurrentWorker->lanes[lane].Push(task);
+        } else {
+            std::lock_guard lock(m_InjectMutex);
+            m_Injected[lane].push_back(task);
         }
-        m_QueueCV.notify_one();
+        m_LaneReady[lane].fetch_add(1);
+        Wake(false);
     }
 
+    // Runs tasks on the calling thread until every submitted task and everything it
+    // released has finished. Only one thread may wait at a time.
     void WaitForCompletion() {
-        constexpr auto timeout = std::chrono::seconds(30);
-        constexpr auto checkInterval = std::chrono::milliseconds(100);
-        auto start = std::chrono::steady_clock::now();
-
-        std::unique_lock lock(m_QueueMutex);
-
-        while (!m_ReadyQueue.empty() || m_ActiveTasks.load() > 0) {
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = now - start;
-
-            if (elapsed > timeout) {
-                Logger::Error(LogTasks, "WaitForCompletion timeout! Queue size: {}, Active tasks: {}",
-                             m_ReadyQueue.size(), m_ActiveTasks.load());
-
-                break;
+        assert(s_CurrentExecutor != this, "WaitForCompletion called from a task of the same executor");
+        const bool wasHelping = m_Helping.exchange(true);
+        assert(!wasHelping, "Only one thread may wait on a TaskExecutor");
+
+        WorkerThread* helper = m_Workers.back().get();
+        s_CurrentExecutor = this;
+        s_CurrentWorker = helper;
+
+        U32 idle = 0;
+        while (m_Outstanding.load() > 0) {
+            if (Task* task = FindTask(helper)) {
+                RunTask(helper, task);
+                idle = 0;
+                continue;
             }
-
-            bool signaled = m_QueueCV.wait_for(lock, checkInterval, [this] {
-                return m_ReadyQueue.empty() && m_ActiveTasks.load() == 0;
-            });
-
-            U32 currentActive = m_ActiveTasks.load();
-            if (currentActive != m_LastActiveCount.load()) {
-                m_LastActiveCount.store(currentActive);
-                m_LastProgressTime = now;
-            } else if (currentActive > 0) {
-
-                auto timeSinceProgress = now - m_LastProgressTime;
-                if (timeSinceProgress > std::chrono::seconds(5)) {
-                    Logger::Warn(LogTasks, "No progress for {}s. Active tasks: {}, Queue size: {}",
-                                std::chrono::duration_cast<std::chrono::seconds>(timeSinceProgress).count(),
-                                currentActive, m_ReadyQueue.size());
-                }
+            if (++idle < kSpinRounds) {
+                std::this_thread::yield();
+                continue;
             }
+            idle = 0;
 
-            if (m_ReadyQueue.empty() && m_ActiveTasks.load() == 0) {
-                break;
+            const U32 epoch = m_Epoch.load();
+            if (m_Outstanding.load() == 0) break;
+            if (Task* task = FindTask(helper)) {
+                RunTask(helper, task);
+                continue;
             }
+            Sleep(epoch);
+        }
+
+        s_CurrentExecutor = nullptr;
+        s_CurrentWorker = nullptr;
+        {
+            std::lock_guard lock(m_TransientMutex);
+            m_Transient.clear();
         }
+        m_Helping.store(false);
+    }
+
+    // Fork-join over [0, count): func(begin, end) runs on ranges of at most grain items, on
+    // the calling thread and on helper tasks that other workers pick up. Once out of ranges
+    // the caller runs other ready tasks until every range is done. Called from a thread that
+    // is not running tasks of an executor, or with a single range, func runs inline.
+    static void ParallelFor(U32 count, U32 grain, const std::function<void(U32, U32)>& func) {
+        grain = std::max(grain, 1u);
+        TaskExecutor* executor = s_CurrentExecutor;
+        if (!executor || count <= grain) {
+            if (count > 0) func(0, count);
+            return;
+        }
+        executor->ForkJoin(count, grain, func);
     }
 
     void Shutdown() {
         if (!m_Running.load()) return;
 
         m_Running.store(false);
-        m_QueueCV.notify_all();
+        Wake(true);
 
-        for (auto& worker : m_Workers) {
-            worker->shouldStop.store(true);
-            if (worker->thread.joinable()) {
-                worker->thread.join();
+        for (U32 i = 0; i < m_ThreadCount; ++i) {
+            if (m_Workers[i]->thread.joinable()) {
+                m_Workers[i]->thread.join();
             }
         }
 
@@ -278,75 +361,200 @@ public:
     }
 
     void SetProfilingEnabled(bool enabled) { m_ProfilingEnabled = enabled; }
-    [[nodiscard]] U32 GetThreadCount() const { return static_cast<U32>(m_Workers.size()); }
+    [[nodiscard]] U32 GetThreadCount() const { return m_ThreadCount; }
 
 private:
+    void ForkJoin(U32 count, U32 grain, const std::function<void(U32, U32)>& func) {
+        // Helpers that start after every range is claimed only touch the shared counters.
+        struct State {
+            std::atomic<U32> next{0};
+            std::atomic<U32> done{0};
+            U32 count;
+            U32 grain;
+            const std::function<void(U32, U32)>* func;
+        };
+        auto state = std::make_shared<State>();
+        state->count = count;
+        state->grain = grain;
+        state->func = &func;
+
+        auto work = [state]() {
+            for (;;) {
+                const U32 begin = state->next.fetch_add(state->grain);
+                if (begin >= state->count) return;
+                const U32 end = std::min(begin + state->grain, state->count);
+                (*state->func)(begin, end);
+                state->done.fetch_add(end - begin, std::memory_order_release);
+            }
+        };
+
+        const U32 ranges = (count + grain - 1) / grain;
+        const U32 helpers = std::min(ranges - 1, m_ThreadCount);
+        // Helpers are profiled under the phase of the task that forked them.
+        const U32 phaseID = s_CurrentTask ? s_CurrentTask->GetPhaseID() : 0;
+        Vector<Task*> spawned;
+        spawned.reserve(helpers);
+        {
+            std::lock_guard lock(m_TransientMutex);
+            for (U32 i = 0; i < helpers; ++i) {
+                m_Transient.push_back(std::make_unique<Task>(kParallelForName, work, TaskPriority::High));
+                m_Transient.back()->SetPhaseID(phaseID);
+                m_Transient.back()->m_Transient = true;
+                spawned.push_back(m_Transient.back().get());
+            }
+        }
+        for (Task* task : spawned) SubmitTask(task);
+
+        work();
+        WorkerThread* self = s_CurrentWorker;
+        while (state->done.load(std::memory_order_acquire) < count) {
+            if (Task* task = FindTask(self)) {
+                RunTask(self, task);
+                continue;
+            }
+            std::this_thread::yield();
+        }
+    }
+
     void WorkerLoop(WorkerThread* worker) {
+        s_CurrentExecutor = this;
+        s_CurrentWorker = worker;
+
+        U32 idle = 0;
         while (m_Running.load()) {
-            Task* task = nullptr;
+            if (Task* task = FindTask(worker)) {
+                RunTask(worker, task);
+                idle = 0;
+                continue;
+            }
+            if (++idle < kSpinRounds) {
+                std::this_thread::yield();
+                continue;
+            }
+            idle = 0;
+
+            // Anything pushed after this load bumps the epoch, so the wait cannot miss it.
+            const U32 epoch = m_Epoch.load();
+            if (!m_Running.load()) break;
+            if (Task* task = FindTask(worker)) {
+                RunTask(worker, task);
+                continue;
+            }
+            Sleep(epoch);
+        }
+    }
 
-            {
-                std::unique_lock lock(m_QueueMutex);
+    Task* FindTask(WorkerThread* self) {
+        for (U32 lane = 0; lane < kLaneCount; ++lane) {
+            if (self->skipped[lane] < kAgingLimit || m_LaneReady[lane].load() == 0) continue;
+            if (Task* task = TakeFromLane(self, lane)) {
+                self->skipped[lane] = 0;
+                return task;
+            }
+        }
 
-                if (m_ReadyQueue.empty() && m_ActiveTasks.load() == 0) {
-                    m_QueueCV.notify_all();
+        for (U32 lane = 0; lane < kLaneCount; ++lane) {
+            if (m_LaneReady[lane].load() == 0) continue;
+            if (Task* task = TakeFromLane(self, lane)) {
+                for (U32 lower = lane + 1; lower < kLaneCount; ++lower) {
+                    if (m_LaneReady[lower].load() > 0) self->skipped[lower]++;
                 }
+                self->skipped[lane] = 0;
+                return task;
+            }
+        }
+        return nullptr;
+    }
 
-                m_QueueCV.wait(lock, [this, worker] {
-                    return !m_ReadyQueue.empty() || !m_Running.load() || worker->shouldStop.load();
-                });
-
-                if (!m_Running.load() || worker->shouldStop.load()) break;
+    Task* TakeFromLane(WorkerThread* self, U32 lane) {
+        Task* task = nullptr;
+        if (auto own = self->lanes[lane].Pop()) {
+            task = *own;
+        } else {
+            task = TakeInjected(lane);
+        }
 
-                if (!m_ReadyQueue.empty()) {
-                    task = m_ReadyQueue.front();
-                    m_ReadyQueue.pop();
-                    m_ActiveTasks.fetch_add(1);
-                }
+        if (!task) {
+            const U32 slots = static_cast<U32>(m_Workers.size());
+            self->rng ^= self->rng << 13;
+            self->rng ^= self->rng >> 17;
+            self->rng ^= self->rng << 5;
+            const U32 start = self->rng % slots;
+            for (U32 i = 0; i < slots && !task; ++i) {
+                WorkerThread* victim = m_Workers[(start + i) % slots].get();
+                if (victim == self || victim->lanes[lane].Empty()) continue;
+                if (auto stolen = victim->lanes[lane].Steal()) task = *stolen;
             }
+        }
 
-            if (task) {
-                task->Execute();
-                worker->tasksExecuted++;
-                worker->totalExecutionTime += task->GetExecutionTime();
-
-                if (m_ProfilingEnabled && TaskProfiler::Get().IsEnabled()) {
-                    TaskProfiler::Get().RecordTask(
-                        task->GetName(),
-                        task->GetID(),
-                        task->GetPhaseID(),
-                        task->GetStartTimestamp(),
-                        task->GetEndTimestamp()
-                    );
-                }
+        if (task) m_LaneReady[lane].fetch_sub(1);
+        return task;
+    }
 
-                {
-                    std::lock_guard lock(m_QueueMutex);
-
-                    for (Task* dependent : task->m_Dependents) {
-                        if (dependent->GetStatus() == TaskStatus::Pending) {
-                            U32 remaining = dependent->m_PendingDependencies.fetch_sub(1);
-                            if (remaining == 1) {
-                                m_ReadyQueue.push(dependent);
-                                m_QueueCV.notify_one();
-                            }
-                        }
-                    }
-                }
+    Task* TakeInjected(U32 lane) {
+        std::lock_guard lock(m_InjectMutex);
+        if (m_Injected[lane].empty()) return nullptr;
+        Task* task = m_Injected[lane].front();
+        m_Injected[lane].pop_front();
+        return task;
+    }
 
-                U32 currentActive = m_ActiveTasks.fetch_sub(1) - 1;
+    void RunTask(WorkerThread* worker, Task* task) {
+        // Restored afterwards: a ParallelFor caller runs other tasks while it waits.
+        Task* const outer = std::exchange(s_CurrentTask, task);
+        task->Execute();
+        s_CurrentTask = outer;
+        worker->tasksExecuted++;
+        worker->totalExecutionTime += task->GetExecutionTime();
 
-                {
-                    std::lock_guard lock(m_QueueMutex);
-                    if (currentActive == 0 && m_ReadyQueue.empty()) {
-                        m_QueueCV.notify_all();
-                    }
-                }
+        if (m_ProfilingEnabled && TaskProfiler::Get().IsEnabled()) {
+            TaskProfiler::Get().RecordTask(
+                task->m_Transient ? kParallelForName : task->GetName().c_str(),
+                task->GetID(),
+                task->GetPhaseID(),
+                task->GetStartTimestamp(),
+                task->GetEndTimestamp()
+            );
+        }
+
+        // The last finishing dependency releases a dependent; counted before this task
+        // retires so m_Outstanding never touches zero while work is still reachable.
+        // Dependents are sorted by ascending critical path, so the longest one is pushed
+        // last and popped next by this thread.
+        U32 released = 0;
+        for (Task* dependent : task->m_Dependents) {
+            if (dependent->m_PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                const U32 lane = LaneOf(dependent->m_EffectivePriority);
+                m_Outstanding.fetch_add(1);
+                worker->lanes[lane].Push(dependent);
+                m_LaneReady[lane].fetch_add(1);
+                released++;
             }
         }
+        if (released > 0) Wake(released > 1);
+
+        if (m_Outstanding.fetch_sub(1) == 1) Wake(true);
+    }
+
+    void Sleep(U32 epoch) {
+        m_Sleepers.fetch_add(1);
+        m_Epoch.wait(epoch);
+        m_Sleepers.fetch_sub(1);
+    }
+
+    void Wake(bool all) {
+        m_Epoch.fetch_add(1);
+        if (m_Sleepers.load() == 0) return;
+        if (all) m_Epoch.notify_all();
+        else m_Epoch.notify_one();
     }
 };
 
+// See TaskExecutor::ParallelFor.
+export inline void ParallelFor(U32 count, U32 grain, const std::function<void(U32, U32)>& func) {
+    TaskExecutor::ParallelFor(count, grain, func);
+}
+
 export struct TaskGraphStats {
     U64 totalExecutionTime;
     U32 totalTasks;
@@ -394,6 +602,7 @@ public:
 
         for (auto& phase : m_Phases) {
             phase->Reset();
+            UpdateSchedule(phase.get());
         }
 
         for (auto& phase : m_Phases) {
@@ -411,13 +620,18 @@ public:
             TaskProfiler::Get().BeginPhase(phase->GetName(), phase->GetID());
         }
 
-        U32 submittedCount = 0;
+        Vector<Task*> roots;
         for (const auto& task : phase->GetTasks()) {
             if (task->m_Dependencies.empty()) {
-                m_Executor->SubmitTask(task.get());
-                submittedCount++;
+                roots.push_back(task.get());
             }
         }
+        std::ranges::stable_sort(roots, std::greater{}, &Task::m_CriticalPath);
+
+        const U32 submittedCount = static_cast<U32>(roots.size());
+        for (Task* task : roots) {
+            m_Executor->SubmitTask(task);
+        }
 
         if (submittedCount == 0 && !phase->GetTasks().empty()) {
             Logger::Error(LogTasks, "No tasks in phase '{}' could be submitted - possible circular dependency",
@@ -541,6 +755,51 @@ public:
     }
 
 private:
+    // Ranks every task by the longest estimated path from its start to the end of the phase,
+    // using the moving average of past execution times (1µs for tasks that never ran), and
+    // lifts each task to the highest priority of anything that transitively waits on it.
+    static void UpdateSchedule(TaskPhase* phase) {
+        const auto& tasks = phase->GetTasks();
+
+        Vector<Task*> order;
+        order.reserve(tasks.size());
+        for (const auto& task : tasks) {
+            task->m_UnresolvedDependencies = static_cast<U32>(task->m_Dependencies.size());
+            if (task->m_UnresolvedDependencies == 0) order.push_back(task.get());
+        }
+        for (USize i = 0; i < order.size(); ++i) {
+            for (Task* dependent : order[i]->m_Dependents) {
+                if (--dependent->m_UnresolvedDependencies == 0) order.push_back(dependent);
+            }
+        }
+
+        // Tasks stuck in a cycle never run; ExecutePhase reports them.
+        for (const auto& task : tasks) {
+            task->m_CriticalPath = EstimatedTime(*task);
+            task->m_EffectivePriority = task->m_Priority;
+        }
+
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            Task* task = *it;
+            U64 longest = 0;
+            for (const Task* dependent : task->m_Dependents) {
+                longest = std::max(longest, dependent->m_CriticalPath);
+                if (dependent->m_EffectivePriority > task->m_EffectivePriority) {
+                    task->m_EffectivePriority = dependent->m_EffectivePriority;
+                }
+            }
+            task->m_CriticalPath = EstimatedTime(*task) + longest;
+        }
+
+        for (const auto& task : tasks) {
+            std::ranges::stable_sort(task->m_Dependents, {}, &Task::m_CriticalPath);
+        }
+    }
+
+    static U64 EstimatedTime(const Task& task) {
+        return std::max<U64>(1, static_cast<U64>(task.m_AverageTime + 0.5f));
+    }
+
     void UpdateStats() {
         m_LastStats = {};
 
@@ -3,10 +3,10 @@ export module Tasks.Orchestrator;
 import Core.Types;
 import Core.Assert;
 import Core.Log;
+import Core.FrameArena;
 import Tasks.TaskGraph;
 import Tasks.TaskProfiler;
 import Input.Manager;
-import Graphics.Window;
 import ECS.World;
 import Graphics;
 import std;
@@ -36,7 +36,6 @@ private:
     std::unique_ptr<TaskGraph> m_TaskGraph;
 
     InputManager *m_InputManager{nullptr};
-    Window *m_Window{nullptr};
     World *m_World{nullptr};
     IGraphicsContext *m_Graphics{nullptr};
 
@@ -44,23 +43,28 @@ private:
     std::chrono::high_resolution_clock::time_point m_LastFrameTime;
     std::chrono::high_resolution_clock::time_point m_StartTime;
 
+    // Fixed ring of recent frame times; nothing is allocated per frame.
     struct ProfileData {
-        std::deque<U64> frameTimes;
-        std::deque<U64> phaseTimes[10];
         static constexpr size_t MAX_SAMPLES = 120;
+        std::array<U64, MAX_SAMPLES> frameTimes{};
+        size_t next{0};
+        size_t count{0};
+        U64 sum{0};
 
         void AddFrameTime(U64 time) {
-            frameTimes.push_back(time);
-            if (frameTimes.size() > MAX_SAMPLES) {
-                frameTimes.pop_front();
+            if (count == MAX_SAMPLES) {
+                sum -= frameTimes[next];
+            } else {
+                ++count;
             }
+            frameTimes[next] = time;
+            sum += time;
+            next = (next + 1) % MAX_SAMPLES;
         }
 
         [[nodiscard]] F64 GetAverageFrameTime() const {
-            if (frameTimes.empty()) return 0.0;
-            U64 sum = 0;
-            for (U64 time: frameTimes) sum += time;
-            return static_cast<F64>(sum) / frameTimes.size();
+            if (count == 0) return 0.0;
+            return static_cast<F64>(sum) / count;
         }
     };
 
@@ -68,6 +72,7 @@ private:
     bool m_ProfilingEnabled{true};
     U32 m_FrameLimitFPS{0};
 
+    std::function<void()> m_EventPump;
     std::function<void(FrameData &)> m_PreFrameCallback;
     std::function<void(FrameData &)> m_UpdateCallback;
     std::function<void(FrameData &)> m_RenderCallback;
@@ -89,9 +94,9 @@ public:
         m_InputManager = inputManager;
     }
 
-    void SetWindow(Window *window) {
-        assert(window, "Window cannot be null");
-        m_Window = window;
+    // Pumps platform events at the start of each frame; the orchestrator itself stays windowless.
+    void SetEventPump(std::function<void()> pump) {
+        m_EventPump = std::move(pump);
     }
 
     void SetWorld(World *world) {
@@ -148,13 +153,18 @@ public:
             m_InputManager->BeginFrame(m_CurrentFrame.totalTime);
         }
 
-        if (m_Window) {
-            m_Window->PollEvents();
+        if (m_EventPump) {
+            m_EventPump();
         }
 
         m_TaskGraph->Execute();
 
+        // Every phase has completed, so no task still holds frame-arena memory.
+        const FrameArenaStats arena = FrameArena::EndFrame();
+
         if (m_ProfilingEnabled) {
+            TaskProfiler::Get().AddCounter("FrameArenaBytes", static_cast<S64>(arena.allocated));
+            TaskProfiler::Get().AddCounter("FrameArenaHighWater", static_cast<S64>(arena.highWater));
             TaskProfiler::Get().EndFrame();
             if (m_FrameLimitFPS > 0) {
                 F64 targetSec{1.0 / static_cast<F64>(m_FrameLimitFPS)};
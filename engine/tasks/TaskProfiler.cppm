@@ -39,12 +39,23 @@ export struct PhaseProfile {
     }
 };
 
+export struct ZoneProfile {
+    std::string name;
+    U64 startTime;
+    U64 endTime;
+    U32 threadID;
+
+    [[nodiscard]] U64 GetDurationMicros() const { return endTime - startTime; }
+};
+
 export struct FrameProfile {
     U64 frameNumber;
     U64 startTime;
     U64 endTime;
     U64 duration;
     Vector<PhaseProfile> phases;
+    Vector<ZoneProfile> zones;
+    Vector<std::pair<std::string, S64>> counters;
 
     [[nodiscard]] const PhaseProfile* GetPhase(const std::string& name) const {
         auto it = std::ranges::find_if(phases, [&name](const auto& p) { return p.name == name; });
@@ -52,11 +63,40 @@ export struct FrameProfile {
     }
 };
 
+// Workers record into their own pre-allocated ring of fixed-size events without locking;
+// the rings are drained into the current frame at EndFrame. Names are stored as pointers,
+// so they must stay alive until the frame ends (task names and string literals do).
 export class TaskProfiler {
 private:
-    struct ThreadLocalData {
-        Vector<TaskProfile> currentFrameTasks;
-        U32 threadID;
+    enum class EventKind : U8 { Task, Zone, Counter };
+
+    struct Event {
+        const char* name;
+        U64 startTime;
+        U64 endTime;
+        S64 value;
+        U32 taskID;
+        U32 phaseID;
+        EventKind kind;
+    };
+
+    // Single producer (the owning thread), single consumer (EndFrame). When the producer
+    // laps the consumer the oldest events are dropped.
+    struct ThreadBuffer {
+        static constexpr U64 CAPACITY = 16384;
+
+        std::unique_ptr<Event[]> events{std::make_unique<Event[]>(CAPACITY)};
+        alignas(64) std::atomic<U64> written{0};
+        U64 read{0};
+        U64 dropped{0};
+        U32 threadID{0};
+        std::atomic<bool> owned{true};
+
+        void Push(const Event& event) {
+            const U64 w = written.load(std::memory_order_relaxed);
+            events[w % CAPACITY] = event;
+            written.store(w + 1, std::memory_order_release);
+        }
     };
 
     static constexpr size_t MAX_FRAME_HISTORY = 300;
@@ -65,10 +105,10 @@ private:
     FrameProfile m_CurrentFrame;
 
     std::mutex m_Mutex;
-    UnorderedMap<std::thread::id, ThreadLocalData> m_ThreadData;
-    std::atomic<U32> m_NextThreadID{0};
+    Vector<UniquePtr<ThreadBuffer>> m_Buffers;
+    Vector<Event> m_Drain;
 
-    bool m_Enabled{true};
+    std::atomic<bool> m_Enabled{true};
     bool m_DetailedProfiling{false};
 
     // Statistics
@@ -79,10 +119,12 @@ private:
         F64 frameTimeStdDev{0.0};
         UnorderedMap<std::string, F64> avgPhaseTimes;
         UnorderedMap<std::string, F64> avgTaskTimes;
+        U64 droppedEvents{0};
     };
 
     Stats m_CachedStats;
     bool m_StatsDirty{true};
+    U64 m_DroppedEvents{0};
 
 public:
     static TaskProfiler& Get() {
@@ -91,7 +133,7 @@ public:
     }
 
     void BeginFrame(U64 frameNumber) {
-        if (!m_Enabled) return;
+        if (!IsEnabled()) return;
 
         std::lock_guard lock(m_Mutex);
 
@@ -108,23 +150,22 @@ public:
         m_CurrentFrame = {};
         m_CurrentFrame.frameNumber = frameNumber;
         m_CurrentFrame.startTime = GetTimestamp();
-
-        // Clear thread data
-        for (auto& [id, data] : m_ThreadData) {
-            data.currentFrameTasks.clear();
-        }
     }
 
     void EndFrame() {
-        if (!m_Enabled) return;
+        if (!IsEnabled()) return;
 
         std::lock_guard lock(m_Mutex);
         m_CurrentFrame.endTime = GetTimestamp();
         m_CurrentFrame.duration = m_CurrentFrame.endTime - m_CurrentFrame.startTime;
+
+        for (auto& buffer : m_Buffers) {
+            DrainBuffer(*buffer);
+        }
     }
 
     void BeginPhase(const std::string& name, U32 phaseID) {
-        if (!m_Enabled) return;
+        if (!IsEnabled()) return;
 
         std::lock_guard lock(m_Mutex);
         PhaseProfile phase;
@@ -135,7 +176,7 @@ public:
     }
 
     void EndPhase(U32 phaseID) {
-        if (!m_Enabled) return;
+        if (!IsEnabled()) return;
 
         std::lock_guard lock(m_Mutex);
         auto it = std::ranges::find_if(m_CurrentFrame.phases,
@@ -144,41 +185,29 @@ public:
         if (it != m_CurrentFrame.phases.end()) {
             it->endTime = GetTimestamp();
             it->duration = it->endTime - it->startTime;
-
-            // Collect tasks from all threads for this phase
-            for (auto& [id, data] : m_ThreadData) {
-                for (const auto& task : data.currentFrameTasks) {
-                    if (task.phaseID == phaseID) {
-                        it->tasks.push_back(task);
-                    }
-                }
-            }
         }
     }
 
-    void RecordTask(const std::string& name, U32 taskID, U32 phaseID,
-                    U64 startTime, U64 endTime) {
-        if (!m_Enabled) return;
-
-        auto threadID = std::this_thread::get_id();
-
-        std::lock_guard lock(m_Mutex);
+    void RecordTask(const char* name, U32 taskID, U32 phaseID, U64 startTime, U64 endTime) {
+        if (!IsEnabled()) return;
+        LocalBuffer().Push(Event{name, startTime, endTime, 0, taskID, phaseID, EventKind::Task});
+    }
 
-        // Get or create thread data
-        if (!m_ThreadData.contains(threadID)) {
-            m_ThreadData[threadID].threadID = m_NextThreadID.fetch_add(1);
-        }
+    void RecordZone(const char* name, U64 startTime, U64 endTime) {
+        if (!IsEnabled()) return;
+        LocalBuffer().Push(Event{name, startTime, endTime, 0, 0, 0, EventKind::Zone});
+    }
 
-        TaskProfile task;
-        task.name = name;
-        task.taskID = taskID;
-        task.phaseID = phaseID;
-        task.startTime = startTime;
-        task.endTime = endTime;
-        task.duration = endTime - startTime;
-        task.threadID = m_ThreadData[threadID].threadID;
+    // Per-frame counter; deltas recorded during a frame are summed when it ends.
+    void AddCounter(const char* name, S64 delta) {
+        if (!IsEnabled()) return;
+        const U64 now = GetTimestamp();
+        LocalBuffer().Push(Event{name, now, now, delta, 0, 0, EventKind::Counter});
+    }
 
-        m_ThreadData[threadID].currentFrameTasks.push_back(std::move(task));
+    [[nodiscard]] static U64 GetTimestamp() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now().time_since_epoch()).count();
     }
 
     [[nodiscard]] std::string GenerateReport() const {
@@ -193,6 +222,9 @@ public:
         ss << std::format("  Max: {:.2f}ms\n", m_CachedStats.maxFrameTime);
         ss << std::format("  StdDev: {:.2f}ms\n", m_CachedStats.frameTimeStdDev);
         ss << std::format("  FPS: {:.1f}\n", 1000.0 / m_CachedStats.avgFrameTime);
+        if (m_CachedStats.droppedEvents > 0) {
+            ss << std::format("  Dropped events: {}\n", m_CachedStats.droppedEvents);
+        }
 
         ss << "\nPhase Timings:\n";
         Vector<std::pair<std::string, F64>> sortedPhases(m_CachedStats.avgPhaseTimes.begin(),
@@ -257,8 +289,65 @@ public:
         return ss.str();
     }
 
-    void SetEnabled(bool enabled) { m_Enabled = enabled; }
-    [[nodiscard]] bool IsEnabled() const { return m_Enabled; }
+    // Chrome Trace Event JSON (loads in chrome://tracing and Perfetto) for the frame history:
+    // frames and phases on track 0, tasks and zones on one track per thread, counters as
+    // counter tracks sampled at the end of each frame.
+    [[nodiscard]] std::string GenerateChromeTrace() const {
+        std::stringstream ss;
+        ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        bool first = true;
+        auto separator = [&]() -> std::stringstream& {
+            if (!first) ss << ",\n";
+            first = false;
+            return ss;
+        };
+        auto complete = [&](const std::string& name, const char* category, U32 tid, U64 start, U64 end) {
+            separator() << "{\"name\":\"" << EscapeJson(name) << "\",\"cat\":\"" << category
+                        << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                        << ",\"ts\":" << start << ",\"dur\":" << (end - start) << "}";
+        };
+
+        separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+                    << "\"args\":{\"name\":\"Frame\"}}";
+        for (U32 i = 0; i < m_Buffers.size(); ++i) {
+            separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i + 1
+                        << ",\"args\":{\"name\":\"Thread " << i << "\"}}";
+        }
+
+        for (const auto& frame : m_FrameHistory) {
+            complete("Frame " + std::to_string(frame.frameNumber), "frame", 0, frame.startTime, frame.endTime);
+            for (const auto& phase : frame.phases) {
+                complete(phase.name, "phase", 0, phase.startTime, phase.endTime);
+                for (const auto& task : phase.tasks) {
+                    complete(task.name, "task", task.threadID + 1, task.startTime, task.endTime);
+                }
+            }
+            for (const auto& zone : frame.zones) {
+                complete(zone.name, "zone", zone.threadID + 1, zone.startTime, zone.endTime);
+            }
+            for (const auto& [name, value] : frame.counters) {
+                separator() << "{\"name\":\"" << EscapeJson(name) << "\",\"ph\":\"C\",\"pid\":1,"
+                            << "\"ts\":" << frame.endTime << ",\"args\":{\"value\":" << value << "}}";
+            }
+        }
+
+        ss << "\n]}\n";
+        return ss.str();
+    }
+
+    void SaveChromeTrace(const std::string& filename) const {
+        std::ofstream file(filename);
+        if (file.is_open()) {
+            file << GenerateChromeTrace();
+            Logger::Info(LogTasks, "Profiler trace saved to {}", filename);
+        } else {
+            Logger::Error(LogTasks, "Failed to save profiler trace to {}", filename);
+        }
+    }
+
+    void SetEnabled(bool enabled) { m_Enabled.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
 
     void SetDetailedProfiling(bool detailed) { m_DetailedProfiling = detailed; }
     [[nodiscard]] bool IsDetailedProfiling() const { return m_DetailedProfiling; }
@@ -275,16 +364,23 @@ public:
         }
     }
 
+    [[nodiscard]] const std::deque<FrameProfile>& GetFrameHistory() const { return m_FrameHistory; }
+
     [[nodiscard]] const Stats& GetStats() const {
         const_cast<TaskProfiler*>(this)->UpdateStats();
         return m_CachedStats;
     }
 
+    // Thread buffers stay registered: live threads keep pointing at them.
     void Clear() {
         std::lock_guard lock(m_Mutex);
         m_FrameHistory.clear();
         m_CurrentFrame = {};
-        m_ThreadData.clear();
+        for (auto& buffer : m_Buffers) {
+            buffer->read = buffer->written.load(std::memory_order_acquire);
+            buffer->dropped = 0;
+        }
+        m_DroppedEvents = 0;
         m_CachedStats = {};
         m_StatsDirty = true;
     }
@@ -292,9 +388,113 @@ public:
 private:
     TaskProfiler() = default;
 
-    [[nodiscard]] static U64 GetTimestamp() {
-        return std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    ThreadBuffer& LocalBuffer() {
+        // Hands the buffer back when the thread exits so a later thread can reuse it.
+        struct Owner {
+            ThreadBuffer* buffer{nullptr};
+            ~Owner() {
+                if (buffer) buffer->owned.store(false, std::memory_order_release);
+            }
+        };
+        thread_local Owner t_Owner{};
+
+        if (!t_Owner.buffer) [[unlikely]] {
+            // Once per thread.
+            std::lock_guard lock(m_Mutex);
+            for (auto& buffer : m_Buffers) {
+                if (!buffer->owned.load(std::memory_order_acquire)) {
+                    buffer->owned.store(true, std::memory_order_relaxed);
+                    t_Owner.buffer = buffer.get();
+                    break;
+                }
+            }
+            if (!t_Owner.buffer) {
+                auto buffer = std::make_unique<ThreadBuffer>();
+                buffer->threadID = static_cast<U32>(m_Buffers.size());
+                t_Owner.buffer = buffer.get();
+                m_Buffers.push_back(std::move(buffer));
+            }
+        }
+        return *t_Owner.buffer;
+    }
+
+    // Called with m_Mutex held.
+    void DrainBuffer(ThreadBuffer& buffer) {
+        constexpr U64 capacity = ThreadBuffer::CAPACITY;
+
+        const U64 end = buffer.written.load(std::memory_order_acquire);
+        U64 begin = std::max(buffer.read, end > capacity ? end - capacity : 0);
+        buffer.dropped += begin - buffer.read;
+
+        m_Drain.clear();
+        for (U64 i = begin; i < end; ++i) {
+            m_Drain.push_back(buffer.events[i % capacity]);
+        }
+
+        // Slots the producer reused while we were copying may be torn; drop them. A Push in
+        // flight writes event `after` before publishing it, over event `after - capacity`.
+        const U64 after = buffer.written.load(std::memory_order_acquire);
+        const U64 safeBegin = after + 1 > capacity ? after + 1 - capacity : 0;
+        if (safeBegin > begin) {
+            const U64 torn = std::min(safeBegin, end) - begin;
+            m_Drain.erase(m_Drain.begin(), m_Drain.begin() + static_cast<SSize>(torn));
+            buffer.dropped += torn;
+        }
+        buffer.read = end;
+        m_DroppedEvents += buffer.dropped;
+        buffer.dropped = 0;
+
+        for (const Event& event : m_Drain) {
+            switch (event.kind) {
+                case EventKind::Task: {
+                    auto phase = std::ranges::find_if(m_CurrentFrame.phases,
+                        [&event](const auto& p) { return p.phaseID == event.phaseID; });
+                    if (phase == m_CurrentFrame.phases.end()) break;
+
+                    TaskProfile task;
+                    task.name = event.name;
+                    task.taskID = event.taskID;
+                    task.phaseID = event.phaseID;
+                    task.startTime = event.startTime;
+                    task.endTime = event.endTime;
+                    task.duration = event.endTime - event.startTime;
+                    task.threadID = buffer.threadID;
+                    phase->tasks.push_back(std::move(task));
+                    break;
+                }
+                case EventKind::Zone:
+                    m_CurrentFrame.zones.push_back(ZoneProfile{event.name, event.startTime, event.endTime,
+                                                               buffer.threadID});
+                    break;
+                case EventKind::Counter: {
+                    auto counter = std::ranges::find_if(m_CurrentFrame.counters,
+                        [&event](const auto& c) { return c.first == event.name; });
+                    if (counter == m_CurrentFrame.counters.end()) {
+                        m_CurrentFrame.counters.emplace_back(event.name, event.value);
+                    } else {
+                        counter->second += event.value;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] static std::string EscapeJson(std::string_view text) {
+        std::string out;
+        out.reserve(text.size());
+        for (char c : text) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) >= 0x20) out += c;
+                    break;
+            }
+        }
+        return out;
     }
 
     void UpdateStats() {
@@ -303,6 +503,7 @@ private:
         std::lock_guard lock(m_Mutex);
 
         m_CachedStats = {};
+        m_CachedStats.droppedEvents = m_DroppedEvents;
 
         if (m_FrameHistory.empty()) return;
 
@@ -359,25 +560,38 @@ private:
     }
 };
 
-// RAII helper for profiling
+// RAII helper for profiling; name must outlive the current frame.
 export class ScopedProfiler {
 private:
-    std::string m_Name;
+    const char* m_Name;
     U32 m_TaskID;
     U32 m_PhaseID;
     U64 m_StartTime;
 
 public:
-    ScopedProfiler(std::string name, U32 taskID, U32 phaseID)
-        : m_Name{std::move(name)}, m_TaskID{taskID}, m_PhaseID{phaseID} {
-        m_StartTime = std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::high_resolution_clock::now().time_since_epoch()).count();
-    }
+    ScopedProfiler(const char* name, U32 taskID, U32 phaseID)
+        : m_Name{name}, m_TaskID{taskID}, m_PhaseID{phaseID}, m_StartTime{TaskProfiler::GetTimestamp()} {}
 
     ~ScopedProfiler() {
-        U64 endTime = std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+        TaskProfiler::Get().RecordTask(m_Name, m_TaskID, m_PhaseID, m_StartTime, TaskProfiler::GetTimestamp());
+    }
+};
 
-        TaskProfiler::Get().RecordTask(m_Name, m_TaskID, m_PhaseID, m_StartTime, endTime);
+// Times the enclosing scope as a zone on the current thread's track, e.g.
+// `ProfileZone zone{"GreedyMesh"};` inside a meshing job.
+export class ProfileZone {
+private:
+    const char* m_Name;
+    U64 m_StartTime;
+
+public:
+    explicit ProfileZone(const char* name)
+        : m_Name{name}, m_StartTime{TaskProfiler::Get().IsEnabled() ? TaskProfiler::GetTimestamp() : 0} {}
+
+    ~ProfileZone() {
+        if (m_StartTime != 0) TaskProfiler::Get().RecordZone(m_Name, m_StartTime, TaskProfiler::GetTimestamp());
     }
-};
\ No newline at end of file
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
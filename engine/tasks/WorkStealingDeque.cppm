@@ -0,0 +1,106 @@
+export module Tasks.WorkStealingDeque;
+
+import Core.Types;
+import std;
+
+// Chase–Lev work-stealing deque (Lê et al., "Correct and Efficient Work-Stealing for Weak
+// Memory Models"). The owning thread pushes and pops at the bottom; any other thread may
+// steal from the top. Only Push and Pop may be called by the owner, Steal by anyone.
+// Outgrown rings are kept until the deque dies so a thief never reads freed memory.
+export template<typename T>
+    requires std::is_trivially_copyable_v<T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(U32 capacity = 256) {
+        U32 cap{1};
+        while (cap < std::max(2u, capacity)) cap <<= 1;
+        m_Rings.push_back(std::make_unique<Ring>(cap));
+        m_Ring.store(m_Rings.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(WorkStealingDeque const&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque const&) = delete;
+
+    void Push(T value) {
+        const S64 b{m_Bottom.load(std::memory_order_relaxed)};
+        const S64 t{m_Top.load(std::memory_order_acquire)};
+        Ring* ring{m_Ring.load(std::memory_order_relaxed)};
+        if (b - t > static_cast<S64>(ring->mask)) ring = Grow(ring, t, b);
+        ring->Put(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_Bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    std::optional<T> Pop() {
+        const S64 b{m_Bottom.load(std::memory_order_relaxed) - 1};
+        Ring* ring{m_Ring.load(std::memory_order_relaxed)};
+        m_Bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        S64 t{m_Top.load(std::memory_order_relaxed)};
+
+        if (t > b) {
+            m_Bottom.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        std::optional<T> value{ring->Get(b)};
+        if (t == b) {
+            // Last element: race thieves for it.
+            if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                value.reset();
+            }
+            m_Bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    std::optional<T> Steal() {
+        S64 t{m_Top.load(std::memory_order_acquire)};
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const S64 b{m_Bottom.load(std::memory_order_acquire)};
+        if (t >= b) return std::nullopt;
+
+        Ring* ring{m_Ring.load(std::memory_order_acquire)};
+        T value{ring->Get(t)};
+        if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    // Approximate; exact only when no other thread is touching the deque.
+    [[nodiscard]] U32 Size() const {
+        const S64 b{m_Bottom.load(std::memory_order_relaxed)};
+        const S64 t{m_Top.load(std::memory_order_relaxed)};
+        return b > t ? static_cast<U32>(b - t) : 0u;
+    }
+
+    [[nodiscard]] bool Empty() const { return Size() == 0; }
+    [[nodiscard]] U32 Capacity() const { return m_Ring.load(std::memory_order_relaxed)->mask + 1; }
+
+private:
+    struct Ring {
+        explicit Ring(U32 capacity)
+            : mask{capacity - 1}, slots{std::make_unique<std::atomic<T>[]>(capacity)} {}
+
+        void Put(S64 i, T value) { slots[static_cast<U64>(i) & mask].store(value, std::memory_order_relaxed); }
+        T Get(S64 i) const { return slots[static_cast<U64>(i) & mask].load(std::memory_order_relaxed); }
+
+        U32 mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    Ring* Grow(Ring* old, S64 t, S64 b) {
+        auto ring{std::make_unique<Ring>((old->mask + 1) * 2)};
+        for (S64 i{t}; i < b; ++i) ring->Put(i, old->Get(i));
+        Ring* ptr{ring.get()};
+        m_Rings.push_back(std::move(ring));
+        m_Ring.store(ptr, std::memory_order_release);
+        return ptr;
+    }
+
+    alignas(64) std::atomic<S64> m_Top{0};
+    alignas(64) std::atomic<S64> m_Bottom{0};
+    alignas(64) std::atomic<Ring*> m_Ring{nullptr};
+    Vector<std::unique_ptr<Ring>> m_Rings{};
+};
@@ -34,6 +34,7 @@ import Systems.VoxelMeshing;
 import Systems.VoxelUpload;
 import Systems.VoxelRenderer;
 import Systems.VoxelEdit;
+import Systems.VoxelRegionStore;
 import Systems.VoxelSelectionRender;
 import Systems.Hotbar;
 
@@ -113,6 +114,10 @@ int main() {
    scfg.removeBudget = 16;
    world.AddComponent(streamCfgEntity, scfg);
 
+   auto regionStoreEntity{world.CreateEntity()};
+   world.AddComponent(regionStoreEntity, VoxelRegionStoreResource{
+       std::make_shared<VoxelRegionStore>(VoxelSaveDirectory("saves/world", VoxelGeneratorKey(vcfg)))});
+
    auto crosshair{uiManager.CreatePanel("Crosshair")};
    crosshair->SetAnchor(AnchorPreset::Center);
    crosshair->SetPivot({0.5f, 0.5f});
@@ -131,7 +136,7 @@ int main() {
    debugPanel->SetAnchor(AnchorPreset::TopLeft);
    debugPanel->SetPivot({0.0f, 0.0f});
    debugPanel->SetAnchoredPosition({10.0f, 10.0f});
-   debugPanel->SetSizeDelta({200.0f, 140.0f});
+   debugPanel->SetSizeDelta({200.0f, 160.0f});
    std::static_pointer_cast<UIPanel>(debugPanel)->SetBackgroundColor(Color{0.0f, 0.0f, 0.0f, 0.7f});
    uiManager.GetRoot()->AddChild(debugPanel);
 
@@ -168,6 +173,9 @@ int main() {
    auto drawsText{uiManager.CreateText("Draws: 0  Vtx/Idx: 0/0")};
    sized(drawsText, 16.0f); v->AddChild(drawsText);
 
+   auto memText{uiManager.CreateText("Blocks: 0 KiB")};
+   sized(memText, 16.0f); v->AddChild(memText);
+
    windowInput.SetResizeCallback([&graphics, &uiManager](U32 w, U32 h) {
        if (w > 0 && h > 0) {
            graphics->OnResize(w, h);
@@ -180,7 +188,7 @@ int main() {
 
    EngineOrchestrator orchestrator{0};
    orchestrator.SetInputManager(&inputManager);
-   orchestrator.SetWindow(&window);
+   orchestrator.SetEventPump([&window] { window.PollEvents(); });
    orchestrator.SetWorld(&world);
    orchestrator.SetGraphicsContext(graphics.get());
    orchestrator.SetFrameLimit(144);
@@ -221,6 +229,7 @@ int main() {
    U32 frameCount{0};
    F32 fpsTimer{0.0f};
    U32 currentFPS{60};
+   std::ofstream cameraPath{}; // F6: one "position direction" line per frame, replayable by voxel_bench
 
    orchestrator.SetPreFrameCallback([&](EngineOrchestrator::FrameData& frame) {
        frameTime = static_cast<F32>(frame.deltaTime);
@@ -243,6 +252,11 @@ int main() {
            posStr += ", ";
            posStr += Utils::ToString(static_cast<S32>(transform->position.z));
            std::static_pointer_cast<UIText>(posText)->SetText(posStr);
+
+           if (cameraPath.is_open()) {
+               const Math::Vec3 dir{transform->Forward()};
+               cameraPath << std::format("{} {} {} {} {} {}\n", transform->position.x, transform->position.y, transform->position.z, dir.x, dir.y, dir.z);
+           }
        }
 
        auto* chunkStore{world.GetStorage<VoxelChunk>()};
@@ -258,6 +272,12 @@ int main() {
            std::static_pointer_cast<UIText>(drawsText)->SetText(std::string{"Draws: "} + Utils::ToString(s.drawCalls) + "  Vtx/Idx: " + Utils::ToString(static_cast<U64>(s.drawnVerts)) + "/" + Utils::ToString(static_cast<U64>(s.drawnIndices)));
        }
 
+       if (auto* mStore{world.GetStorage<VoxelMemoryStats>()}; mStore && mStore->Size() > 0) {
+           VoxelMemoryStats m{};
+           for (auto [h, ms] : *mStore) { m = ms; break; }
+           std::static_pointer_cast<UIText>(memText)->SetText(std::string{"Blocks: "} + Utils::ToString(m.blockBytes / 1024u) + " KiB  " + Utils::ToString(m.bytesPerChunk) + " B/chunk  Pool: " + Utils::ToString(m.poolBytes / 1024u) + " KiB  GPU: " + Utils::ToString(m.gpuMeshBytes >> 20u) + "/" + Utils::ToString(m.gpuHeapBytes >> 20u) + " MiB");
+       }
+
        uiManager.Update(frameTime);
        orchestratorECS.UpdateECS(frameTime);
    });
@@ -276,6 +296,7 @@ int main() {
            auto report{TaskProfiler::Get().GenerateReport()};
            if (!report.empty()) {
                TaskProfiler::Get().SaveToFile("output/profiler_data.txt");
+               TaskProfiler::Get().SaveChromeTrace("output/profiler_trace.json");
                Logger::Info("Profiler data saved");
            }
        }
@@ -286,6 +307,18 @@ int main() {
            TaskProfiler::Get().SetEnabled(profilingEnabled);
            Logger::Info("Profiling {}", profilingEnabled ? "enabled" : "disabled");
        }
+
+       if (inputManager.IsKeyJustPressed(Key::F6)) {
+           if (cameraPath.is_open()) {
+               cameraPath.close();
+               Logger::Info("Camera path saved");
+           } else {
+               std::filesystem::create_directories("output");
+               cameraPath.open("output/camera_path.txt");
+               cameraPath << "# px py pz dx dy dz\n";
+               Logger::Info("Recording camera path");
+           }
+       }
    });
 
    orchestrator.SetUpdateCallback([&](EngineOrchestrator::FrameData&) {});
@@ -341,9 +374,21 @@ int main() {
        orchestrator.ExecuteFrame();
    }
 
+   if (auto* regionStore{FindVoxelRegionStore(&world)}) {
+       if (auto* chunkStore{world.GetStorage<VoxelChunk>()}) {
+           for (auto [h, c] : *chunkStore) {
+               if (!c.modified || c.blocks.Empty()) continue;
+               regionStore->Save(static_cast<S32>(c.cx), static_cast<S32>(c.cy), static_cast<S32>(c.cz), c.blocks);
+           }
+       }
+       regionStore->Flush();
+       Logger::Info("World saved to {}", regionStore->Directory().string());
+   }
+
    auto report{TaskProfiler::Get().GenerateReport()};
    if (!report.empty()) {
        TaskProfiler::Get().SaveToFile("output/final_profiler_data.txt");
+       TaskProfiler::Get().SaveChromeTrace("output/final_profiler_trace.json");
        Logger::Info("Profiler data saved");
    }
 
@@ -18,11 +18,11 @@ cbuffer AtlasCB : register(b2) {
 Texture2D gAtlas : register(t0);
 SamplerState gSamp : register(s0);
 
+// Packed ChunkVertex, see Components.Voxel.
+// x: pos.x | pos.y << 6 | pos.z << 12 | face << 18
+// y: u | v << 6 | tile << 12
 struct VSIn {
-    float3 pos : POSITION;
-    float3 nrm : NORMAL;
-    float2 uv  : TEXCOORD;
-    uint   mat : COLOR;
+    uint2 packed : PACKED;
 };
 struct VSOut {
     float4 svpos : SV_Position;
@@ -31,15 +31,26 @@ struct VSOut {
     uint   mat   : COLOR0;
 };
 
+static const float3 kFaceNormals[6] = {
+    float3(-1, 0, 0), float3(1, 0, 0),
+    float3(0, -1, 0), float3(0, 1, 0),
+    float3(0, 0, -1), float3(0, 0, 1)
+};
+
 VSOut VSMain(VSIn i) {
+    float3 pos = float3(i.packed.x & 63u, (i.packed.x >> 6) & 63u, (i.packed.x >> 12) & 63u);
+    float3 nrm = kFaceNormals[(i.packed.x >> 18) & 7u];
+    float2 uv  = float2(i.packed.y & 63u, (i.packed.y >> 6) & 63u);
+    uint   mat = (i.packed.y >> 12) & 255u;
+
     VSOut o;
-    float4 wp = mul(float4(i.pos,1), gWorld);
+    float4 wp = mul(float4(pos,1), gWorld);
     o.svpos = mul(wp, gViewProj);
-    o.nrm = normalize(mul(float4(i.nrm,0), gWorld).xyz);
+    o.nrm = normalize(mul(float4(nrm,0), gWorld).xyz);
 
-    float side = 1.0f - step(0.5f, abs(i.nrm.y));
-    o.uv = float2(i.uv.x, lerp(i.uv.y, 1.0f - i.uv.y, side));
-    o.mat = i.mat;
+    float side = 1.0f - step(0.5f, abs(nrm.y));
+    o.uv = float2(uv.x, lerp(uv.y, 1.0f - uv.y, side));
+    o.mat = mat;
     return o;
 }
 
@@ -0,0 +1,73 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Core.FrameArena;
+import std;
+
+TEST_CASE("LinearArena hands out aligned, non-overlapping memory", "[FrameArena]") {
+    LinearArena arena{256};
+
+    void* a{arena.allocate(3, 1)};
+    void* b{arena.allocate(16, 16)};
+    void* c{arena.allocate(8, 8)};
+
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 16 == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(c) % 8 == 0);
+    REQUIRE(static_cast<std::byte*>(b) >= static_cast<std::byte*>(a) + 3);
+    REQUIRE(static_cast<std::byte*>(c) >= static_cast<std::byte*>(b) + 16);
+    REQUIRE(arena.Allocated() >= 27);
+    REQUIRE(arena.HighWater() == arena.Allocated());
+}
+
+TEST_CASE("LinearArena grows and coalesces its blocks on reset", "[FrameArena]") {
+    LinearArena arena{128};
+
+    std::pmr::vector<U32> values{&arena};
+    for (U32 i{0}; i < 1000; ++i) values.push_back(i);
+    REQUIRE(values[999] == 999);
+
+    const USize used{arena.Allocated()};
+    const USize capacity{arena.Capacity()};
+    REQUIRE(used > 1000 * sizeof(U32));
+    REQUIRE(capacity >= used);
+
+    values = std::pmr::vector<U32>{&arena};
+    arena.Reset();
+    REQUIRE(arena.Allocated() == 0);
+    REQUIRE(arena.Capacity() == capacity);
+    REQUIRE(arena.HighWater() == used);
+
+    // After the reset everything fits in the single coalesced block.
+    std::pmr::vector<U32> again{&arena};
+    again.reserve(1000);
+    REQUIRE(arena.Capacity() == capacity);
+}
+
+TEST_CASE("FrameArena keeps one arena per thread and resets them at frame end", "[FrameArena]") {
+    FrameArena::EndFrame();
+
+    LinearArena* mainArena{&FrameArena::Local()};
+    LinearArena* otherArena{};
+    std::thread{[&]() {
+        otherArena = &FrameArena::Local();
+        FrameVector<U64> scratch{FrameArena::Resource()};
+        scratch.resize(64);
+    }}.join();
+    REQUIRE(otherArena != mainArena);
+
+    FrameVector<U64> scratch{FrameArena::Resource()};
+    scratch.resize(32);
+
+    const FrameArenaStats stats{FrameArena::EndFrame()};
+    REQUIRE(stats.allocated >= 96 * sizeof(U64));
+    REQUIRE(stats.highWater >= stats.allocated);
+    REQUIRE(stats.threads >= 2);
+    REQUIRE(FrameArena::GetStats().allocated == stats.allocated);
+    REQUIRE(mainArena->Allocated() == 0);
+
+    // An exited thread's arena is reused by the next thread.
+    LinearArena* reused{};
+    std::thread{[&]() { reused = &FrameArena::Local(); }}.join();
+    REQUIRE(reused == otherArena);
+}
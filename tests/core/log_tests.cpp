@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Core.Log;
+import std;
+
+namespace {
+    struct MutedTag {};
+    constexpr CategoryWithTag<MutedTag> LogMuted{"Muted"};
+
+    // Has no formatter: a call that is not stripped would not compile.
+    struct NotFormattable {};
+
+    using TestLogger = DebugLogger;
+
+    std::filesystem::path LogPath() {
+        return std::filesystem::temp_directory_path() / "voksel_log_tests.txt";
+    }
+
+    // Routes output to a fresh file only.
+    void BeginCapture() {
+        TestLogger::EnableConsole(false);
+        TestLogger::SetFile(LogPath());
+    }
+
+    // Message part of each line: "[hh:mm:ss] [LEVEL] [Category] message".
+    Vector<std::string> EndCapture() {
+        TestLogger::Flush();
+        TestLogger::SetFile({});
+        TestLogger::EnableConsole(true);
+        Vector<std::string> messages{};
+        std::ifstream in{LogPath()};
+        std::string line{};
+        while (std::getline(in, line)) {
+            USize pos{0};
+            for (U32 i{}; i < 3 && pos != std::string::npos; ++i) pos = line.find("] ", pos == 0 ? 0 : pos + 2);
+            messages.push_back(pos == std::string::npos ? line : line.substr(pos + 2));
+        }
+        return messages;
+    }
+}
+
+template<>
+struct CategoryEnabled<MutedTag> : std::false_type {};
+
+TEST_CASE("Disabled levels and categories compile away", "[Log]") {
+    STATIC_REQUIRE_FALSE(ReleaseLogger::IsEnabled<LogLevel::Debug>);
+    STATIC_REQUIRE(ReleaseLogger::IsEnabled<LogLevel::Info>);
+    STATIC_REQUIRE(TraceLogger::IsEnabled<LogLevel::Trace, decltype(LogTasks)>);
+    STATIC_REQUIRE_FALSE(TraceLogger::IsEnabled<LogLevel::Critical, decltype(LogMuted)>);
+
+    const LogStats before{TestLogger::GetStats()};
+    ReleaseLogger::Debug("{}", NotFormattable{});
+    TraceLogger::Error(LogMuted, "{}", NotFormattable{});
+    TestLogger::Flush();
+    REQUIRE(TestLogger::GetStats().written == before.written);
+}
+
+TEST_CASE("Logger formats stored arguments on the writer thread", "[Log]") {
+    BeginCapture();
+    {
+        std::string temporary{"owned"};
+        const char* text{"literal"};
+        Vector<S32> list{1, 2, 3};
+        TestLogger::Info(LogTasks, "{} {} {:.2f} {} {}", 42, temporary, 1.5, text, std::string_view{"view"});
+        TestLogger::Warn("{:>5}|{}", 7, list);
+        temporary.assign("changed");
+        list.clear();
+    }
+    TestLogger::Debug("no arguments");
+    TestLogger::Error("{} {}", "missing argument");
+    const Vector<std::string> messages{EndCapture()};
+
+    REQUIRE(messages.size() == 4);
+    REQUIRE(messages[0] == "42 owned 1.50 literal view");
+    REQUIRE(messages[1] == "    7|[1, 2, 3]");
+    REQUIRE(messages[2] == "no arguments");
+    REQUIRE(messages[3].starts_with("<bad log format"));
+}
+
+TEST_CASE("Logger keeps per-thread order and loses nothing when blocking", "[Log]") {
+    constexpr U32 kThreads{4};
+    constexpr U32 kMessages{20000};
+    TestLogger::SetOverflow(LogOverflow::Block);
+    const LogStats before{TestLogger::GetStats()};
+    BeginCapture();
+
+    Vector<std::thread> threads{};
+    for (U32 t{}; t < kThreads; ++t) {
+        threads.emplace_back([t]() {
+            for (U32 i{}; i < kMessages; ++i) TestLogger::Info("{} {} {}", t, i, std::string(i % 64, 'x'));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    const Vector<std::string> messages{EndCapture()};
+
+    const LogStats after{TestLogger::GetStats()};
+    REQUIRE(after.dropped == before.dropped);
+    REQUIRE(after.written - before.written == kThreads * kMessages);
+    REQUIRE(messages.size() == kThreads * kMessages);
+
+    std::array<U32, kThreads> next{};
+    bool ordered{true};
+    for (std::string const& message : messages) {
+        std::istringstream in{message};
+        U32 t{}, i{};
+        in >> t >> i;
+        ordered = ordered && t < kThreads && i == next[t];
+        if (t < kThreads) ++next[t];
+    }
+    REQUIRE(ordered);
+}
+
+TEST_CASE("Logger drop policy accounts for every message", "[Log]") {
+    constexpr U32 kThreads{4};
+    constexpr U32 kMessages{50000};
+    TestLogger::SetOverflow(LogOverflow::Drop);
+    const LogStats before{TestLogger::GetStats()};
+    BeginCapture();
+
+    Vector<std::thread> threads{};
+    for (U32 t{}; t < kThreads; ++t) {
+        threads.emplace_back([t]() {
+            for (U32 i{}; i < kMessages; ++i) TestLogger::Info("{} {} {}", t, i, std::string(200, 'y'));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    const Vector<std::string> messages{EndCapture()};
+    TestLogger::SetOverflow(LogOverflow::Block);
+
+    const LogStats after{TestLogger::GetStats()};
+    const U64 written{after.written - before.written};
+    const U64 dropped{after.dropped - before.dropped};
+    REQUIRE(written + dropped == kThreads * kMessages);
+    // Drops are reported in the output itself.
+    U64 notices{0}, reported{0};
+    for (std::string const& message : messages) {
+        if (message.find(" log messages dropped") == std::string::npos) continue;
+        ++notices;
+        reported += std::stoull(message);
+    }
+    REQUIRE(messages.size() == written + notices);
+    REQUIRE(reported == dropped);
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Core.VectorPool;
+import std;
+
+TEST_CASE("VectorPool recycles released vectors of the requested size class", "[VectorPool]") {
+    VectorPool<U32> pool{1 << 20};
+
+    Vector<U32> a{pool.Acquire(1000)};
+    REQUIRE(a.capacity() >= 1000);
+    REQUIRE(pool.GetStats().misses == 1);
+
+    a.assign(700, 7u);
+    const U32* data{a.data()};
+    pool.Release(std::move(a));
+    REQUIRE(pool.GetStats().retainedBuffers == 1);
+    REQUIRE(pool.GetStats().retainedBytes >= 1000 * sizeof(U32));
+
+    Vector<U32> b{pool.Acquire(900)};
+    REQUIRE(b.data() == data);
+    REQUIRE(b.empty());
+    REQUIRE(pool.GetStats().hits == 1);
+    REQUIRE(pool.GetStats().retainedBytes == 0);
+
+    // A larger request comes from a larger class.
+    pool.Release(std::move(b));
+    Vector<U32> c{pool.Acquire(3000)};
+    REQUIRE(c.capacity() >= 3000);
+    REQUIRE(pool.GetStats().misses == 2);
+}
+
+TEST_CASE("VectorPool discards vectors over budget or outside the size classes", "[VectorPool]") {
+    VectorPool<U64> pool{8 * 1024, 6, 10};
+
+    pool.Release(pool.Acquire(1024));   // 8 KiB, fills the budget
+    pool.Release(pool.Acquire(64));     // over budget
+    pool.Release(pool.Acquire(4096));   // above the largest class
+    Vector<U64> tiny{};
+    tiny.reserve(4);
+    pool.Release(std::move(tiny));      // below the smallest class
+
+    const auto stats{pool.GetStats()};
+    REQUIRE(stats.retainedBuffers == 1);
+    REQUIRE(stats.retainedBytes == 8 * 1024);
+    REQUIRE(stats.discarded == 3);
+}
+
+TEST_CASE("VectorPool trims the largest vectors first", "[VectorPool]") {
+    VectorPool<U8> pool{1 << 20};
+    pool.Release(pool.Acquire(64));
+    pool.Release(pool.Acquire(4096));
+    pool.Release(pool.Acquire(1024));
+
+    pool.Trim(2048);
+    auto stats{pool.GetStats()};
+    REQUIRE(stats.trimmed == 1);
+    REQUIRE(stats.retainedBytes == 64 + 1024);
+
+    pool.SetBudget(0);
+    stats = pool.GetStats();
+    REQUIRE(stats.retainedBuffers == 0);
+    REQUIRE(stats.retainedBytes == 0);
+    REQUIRE(pool.Budget() == 0);
+}
+
+TEST_CASE("VectorPool is safe to share between threads", "[VectorPool]") {
+    VectorPool<U32> pool{64 << 20};
+    std::atomic<U32> corrupted{0};
+    Vector<std::thread> threads{};
+    for (U32 t{0}; t < 4; ++t) {
+        threads.emplace_back([&pool, &corrupted, t] {
+            for (U32 i{0}; i < 500; ++i) {
+                Vector<U32> v{pool.Acquire(256 + (i % 4) * 256)};
+                if (!v.empty()) corrupted.fetch_add(1);
+                v.assign(256, t);
+                pool.Release(std::move(v));
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    REQUIRE(corrupted.load() == 0);
+
+    const auto stats{pool.GetStats()};
+    REQUIRE(stats.hits + stats.misses == 2000);
+    // At most one vector per thread and size class is ever allocated.
+    REQUIRE(stats.misses <= 4 * 3);
+}
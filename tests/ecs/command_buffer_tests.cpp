@@ -0,0 +1,121 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.Component;
+import ECS.World;
+import ECS.CommandBuffer;
+import ECS.SystemScheduler;
+import std;
+
+namespace {
+    struct Tagged { U32 value{}; };
+    struct Marker {};
+}
+
+template<> struct ComponentTypeID<Tagged> { static consteval ComponentID value() { return 53; } };
+template<> struct ComponentTypeID<Marker> { static consteval ComponentID value() { return 54; } };
+
+TEST_CASE("CommandBuffer defers structural changes until playback", "[CommandBuffer]") {
+    World world{};
+    EntityHandle existing{world.CreateEntity()};
+    world.AddComponent(existing, Tagged{1});
+
+    CommandBuffer cmd{};
+    EntityHandle a{cmd.CreateEntity()};
+    REQUIRE(CommandBuffer::IsPlaceholder(a));
+    cmd.AddComponent(a, Tagged{2});
+    cmd.AddComponent(a, Marker{});
+    cmd.AddOrReplaceComponent(existing, Tagged{3});
+    cmd.AddComponent(existing, Marker{});
+
+    EntityHandle resolved{};
+    cmd.Defer(a, [&](World&, EntityHandle h) { resolved = h; });
+
+    REQUIRE(world.GetEntityCount() == 1);
+    REQUIRE(world.GetComponent<Tagged>(existing)->value == 1);
+    REQUIRE(cmd.Size() == 6);
+
+    cmd.Playback(world);
+    REQUIRE(cmd.Empty());
+    REQUIRE(world.GetEntityCount() == 2);
+    REQUIRE(resolved.valid());
+    REQUIRE_FALSE(CommandBuffer::IsPlaceholder(resolved));
+    REQUIRE(world.GetComponent<Tagged>(resolved)->value == 2);
+    REQUIRE(world.GetComponent<Marker>(resolved) != nullptr);
+    REQUIRE(world.GetComponent<Tagged>(existing)->value == 3);
+
+    cmd.RemoveComponent<Marker>(existing);
+    cmd.DestroyEntity(resolved);
+    cmd.Playback(world);
+    REQUIRE(world.GetEntityCount() == 1);
+    REQUIRE(world.GetComponent<Marker>(existing) == nullptr);
+    REQUIRE(world.GetComponent<Tagged>(resolved) == nullptr);
+}
+
+TEST_CASE("CommandBuffer::Append renumbers placeholders and keeps order", "[CommandBuffer]") {
+    World world{};
+    CommandBuffer first{}, second{};
+    Vector<U32> order{};
+
+    EntityHandle a{first.CreateEntity()};
+    first.AddComponent(a, Tagged{10});
+    first.Defer([&](World&, EntityHandle) { order.push_back(1); });
+
+    EntityHandle b{second.CreateEntity()};
+    REQUIRE(a == b);
+    second.AddComponent(b, Tagged{20});
+    second.Defer(b, [&](World& w, EntityHandle h) { order.push_back(w.GetComponent<Tagged>(h)->value); });
+
+    first.Append(std::move(second));
+    REQUIRE(second.Empty());
+    first.Playback(world);
+
+    REQUIRE(world.GetEntityCount() == 2);
+    REQUIRE(order == Vector<U32>{1, 20});
+
+    U32 sum{};
+    for (auto [h, t] : *world.GetStorage<Tagged>()) sum += t.value;
+    REQUIRE(sum == 30);
+}
+
+namespace {
+    class RecordingSystem : public System<RecordingSystem> {
+    public:
+        explicit RecordingSystem(std::string name, U32 value) : m_Name{std::move(name)}, m_Value{value} {}
+
+        void Setup() {
+            SetName(m_Name);
+            SetStage(SystemStage::Update);
+        }
+
+        void Run(World*, F32) override {
+            auto& cmd{Commands()};
+            cmd.AddComponent(cmd.CreateEntity(), Tagged{m_Value});
+        }
+
+    private:
+        std::string m_Name;
+        U32 m_Value;
+    };
+}
+
+TEST_CASE("SystemScheduler plays stage buffers back in registration order", "[CommandBuffer]") {
+    World world{};
+    SystemScheduler scheduler{};
+    scheduler.AddSystem<RecordingSystem>("First", 1u);
+    scheduler.AddSystem<RecordingSystem>("Second", 2u);
+    scheduler.BuildExecutionGraph(&world);
+
+    // Run in reverse; playback order must still follow registration.
+    auto const& nodes{scheduler.GetStageNodes().at(SystemStage::Update)};
+    for (auto it{nodes.rbegin()}; it != nodes.rend(); ++it) scheduler.ExecuteSystem(*it, 0.0f);
+    REQUIRE(world.GetEntityCount() == 0);
+
+    scheduler.FlushCommands(SystemStage::PreUpdate);
+    REQUIRE(world.GetEntityCount() == 0);
+
+    scheduler.FlushCommands(SystemStage::Update);
+    Vector<U32> values{};
+    for (auto [h, t] : *world.GetStorage<Tagged>()) values.push_back(t.value);
+    REQUIRE(values == Vector<U32>{1, 2});
+}
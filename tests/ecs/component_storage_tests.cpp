@@ -0,0 +1,116 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.Component;
+import std;
+
+namespace {
+    struct Health { S32 value{}; };
+}
+
+TEST_CASE("ComponentStorage keeps components packed across removals", "[ComponentStorage]") {
+    ComponentStorage<Health> storage{};
+    for (U16 id{1}; id <= 200; ++id) storage.Insert(EntityHandle{id, 1}, Health{id});
+    REQUIRE(storage.Size() == 200);
+
+    for (U16 id{1}; id <= 200; id += 2) storage.Remove(EntityHandle{id, 1});
+    REQUIRE(storage.Size() == 100);
+
+    for (U16 id{1}; id <= 200; ++id) {
+        const bool even{id % 2 == 0};
+        REQUIRE(storage.Contains(EntityHandle{id, 1}) == even);
+        if (even) REQUIRE(storage.Get(EntityHandle{id, 1})->value == id);
+    }
+
+    U32 visited{};
+    S64 sum{};
+    for (auto [h, c] : storage) {
+        REQUIRE(c.value == h.id());
+        sum += c.value;
+        ++visited;
+    }
+    REQUIRE(visited == 100);
+    REQUIRE(sum == 10100);
+
+    U32 spanned{};
+    storage.ForEachSpan([&](std::span<const EntityHandle> entities, std::span<Health> components) {
+        REQUIRE(entities.size() == components.size());
+        spanned += static_cast<U32>(components.size());
+    });
+    REQUIRE(spanned == 100);
+}
+
+TEST_CASE("ComponentStorage rejects stale generations and replaces in place", "[ComponentStorage]") {
+    ComponentStorage<Health> storage{};
+    storage.Insert(EntityHandle{7, 1}, Health{1});
+    REQUIRE(storage.Get(EntityHandle{7, 2}) == nullptr);
+    REQUIRE_FALSE(storage.Contains(EntityHandle{7, 2}));
+
+    storage.Insert(EntityHandle{7, 2}, Health{2});
+    REQUIRE(storage.Size() == 1);
+    REQUIRE(storage.Get(EntityHandle{7, 1}) == nullptr);
+    REQUIRE(storage.Get(EntityHandle{7, 2})->value == 2);
+
+    // High ids land in a later sparse page.
+    storage.Insert(EntityHandle{60000, 1}, Health{3});
+    REQUIRE(storage.Get(EntityHandle{60000, 1})->value == 3);
+    storage.Remove(EntityHandle{7, 2});
+    REQUIRE(storage.Get(EntityHandle{60000, 1})->value == 3);
+    REQUIRE(storage.Size() == 1);
+
+    storage.Clear();
+    REQUIRE(storage.Size() == 0);
+    REQUIRE_FALSE(storage.Contains(EntityHandle{60000, 1}));
+}
+
+TEST_CASE("ComponentStorage insertion never moves existing components", "[ComponentStorage]") {
+    ComponentStorage<Health> storage{};
+    storage.Insert(EntityHandle{1, 1}, Health{42});
+    Health* first{storage.Get(EntityHandle{1, 1})};
+    for (U16 id{2}; id < 5000; ++id) storage.Insert(EntityHandle{id, 1}, Health{id});
+    REQUIRE(storage.Get(EntityHandle{1, 1}) == first);
+    REQUIRE(first->value == 42);
+}
+
+TEST_CASE("ComponentStorage iteration visits everything when removing the current component", "[ComponentStorage]") {
+    ComponentStorage<Health> storage{};
+    for (U16 id{1}; id <= 100; ++id) storage.Insert(EntityHandle{id, 1}, Health{id});
+
+    SECTION("remove every component") {
+        U32 visited{};
+        for (auto [h, c] : storage) {
+            ++visited;
+            storage.Remove(h);
+        }
+        REQUIRE(visited == 100);
+        REQUIRE(storage.Size() == 0);
+    }
+
+    SECTION("remove every odd component") {
+        std::set<U16> seen{};
+        for (auto [h, c] : storage) {
+            REQUIRE(seen.insert(h.id()).second);
+            if (c.value % 2 == 1) storage.Remove(h);
+        }
+        REQUIRE(seen.size() == 100);
+        REQUIRE(storage.Size() == 50);
+        for (auto [h, c] : storage) REQUIRE(c.value % 2 == 0);
+    }
+}
+
+TEST_CASE("ComponentStorage iterators advance without being dereferenced", "[ComponentStorage]") {
+    STATIC_REQUIRE(std::forward_iterator<ComponentStorage<Health>::Iterator>);
+    STATIC_REQUIRE(std::forward_iterator<ComponentStorage<Health>::ConstIterator>);
+
+    ComponentStorage<Health> storage{};
+    for (U16 id{1}; id <= 10; ++id) storage.Insert(EntityHandle{id, 1}, Health{id});
+
+    REQUIRE(std::ranges::distance(storage) == 10);
+    REQUIRE(std::ranges::distance(std::as_const(storage)) == 10);
+    REQUIRE((*std::next(storage.begin(), 3)).second.value == 4);
+    REQUIRE(std::next(storage.begin(), 10) == storage.end());
+
+    auto it{storage.begin()};
+    it++;
+    REQUIRE((*it).first == EntityHandle{2, 1});
+}
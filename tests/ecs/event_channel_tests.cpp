@@ -0,0 +1,32 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.EventChannel;
+import std;
+
+namespace {
+    struct Ping { U32 value{}; };
+}
+
+TEST_CASE("EventChannel delivers to subscribers and keeps events until cleared", "[EventChannel]") {
+    EventChannel<Ping> channel{};
+    Vector<U32> a{}, b{};
+    const auto idA{channel.Subscribe([&a](Ping const& p) { a.push_back(p.value); })};
+    channel.Subscribe([&b](Ping const& p) { b.push_back(p.value * 10); });
+    REQUIRE(channel.SubscriberCount() == 2);
+
+    channel.Publish(Ping{1});
+    channel.Publish(Ping{2});
+    REQUIRE(a == Vector<U32>{1, 2});
+    REQUIRE(b == Vector<U32>{10, 20});
+    REQUIRE(channel.Events().size() == 2);
+    REQUIRE(channel.Events()[1].value == 2);
+
+    channel.Unsubscribe(idA);
+    channel.Clear();
+    channel.Publish(Ping{3});
+    REQUIRE(a == Vector<U32>{1, 2});
+    REQUIRE(b == Vector<U32>{10, 20, 30});
+    REQUIRE(channel.Events().size() == 1);
+    REQUIRE(channel.SubscriberCount() == 1);
+}
@@ -0,0 +1,140 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.Component;
+import ECS.World;
+import ECS.Query;
+import std;
+
+namespace {
+    struct Position { F32 x{}, y{}, z{}; };
+    struct Velocity { F32 x{}, y{}, z{}; };
+    struct Frozen {};
+}
+
+template<> struct ComponentTypeID<Position> { static consteval ComponentID value() { return 50; } };
+template<> struct ComponentTypeID<Velocity> { static consteval ComponentID value() { return 51; } };
+template<> struct ComponentTypeID<Frozen> { static consteval ComponentID value() { return 52; } };
+
+TEST_CASE("Query visits exactly the entities of matching archetypes", "[Query]") {
+    World world{};
+    Vector<EntityHandle> moving{}, still{}, frozen{};
+    for (U32 i{}; i < 300; ++i) {
+        EntityHandle h{world.CreateEntity()};
+        world.AddComponent(h, Position{static_cast<F32>(i), 0.0f, 0.0f});
+        if (i % 3 == 0) { still.push_back(h); continue; }
+        world.AddComponent(h, Velocity{1.0f, 0.0f, 0.0f});
+        if (i % 3 == 1) { moving.push_back(h); continue; }
+        world.AddComponent(h, Frozen{});
+        frozen.push_back(h);
+    }
+    world.CreateEntity();
+
+    REQUIRE(Query<World, Position>{&world}.Count() == 300);
+    REQUIRE(Query<World, Position, Velocity>{&world}.Count() == 200);
+    REQUIRE(Query<World, Position, Without<Velocity>>{&world}.Count() == 100);
+    REQUIRE(Query<World, Read<Position>, Velocity, Without<Frozen>>{&world}.Count() == 100);
+    REQUIRE(Query<World, With<Frozen>>{&world}.Count() == 100);
+
+    Query<World, Position, Read<Velocity>, Without<Frozen>> q{&world};
+    U32 visited{};
+    q.ForEach([&](Position* p, Velocity const* v) {
+        p->x += v->x;
+        ++visited;
+    });
+    REQUIRE(visited == 100);
+    for (EntityHandle h : moving) REQUIRE(world.GetComponent<Position>(h)->x == static_cast<F32>(h.id() - 1) + 1.0f);
+    for (EntityHandle h : still) REQUIRE(world.GetComponent<Position>(h)->x == static_cast<F32>(h.id() - 1));
+
+    U32 iterated{};
+    for (auto [p, v] : q.Iter<Position, Velocity>()) {
+        REQUIRE(p != nullptr);
+        REQUIRE(v != nullptr);
+        ++iterated;
+    }
+    REQUIRE(iterated == 100);
+}
+
+TEST_CASE("Archetype buckets follow component changes and destruction", "[Query]") {
+    World world{};
+    Vector<EntityHandle> handles{};
+    for (U32 i{}; i < 64; ++i) {
+        EntityHandle h{world.CreateEntity()};
+        world.AddComponent(h, Position{});
+        handles.push_back(h);
+    }
+
+    Query<World, Position, Velocity> moving{&world};
+    REQUIRE(moving.IsEmpty());
+
+    // A new archetype after the first lookup must be picked up by the cached match.
+    for (U32 i{}; i < 64; i += 2) world.AddComponent(handles[i], Velocity{});
+    REQUIRE(moving.Count() == 32);
+
+    for (U32 i{}; i < 64; i += 4) world.RemoveComponent<Velocity>(handles[i]);
+    REQUIRE(moving.Count() == 16);
+    REQUIRE(Query<World, Position, Without<Velocity>>{&world}.Count() == 48);
+
+    for (U32 i{1}; i < 64; i += 4) world.DestroyEntity(handles[i]);
+    REQUIRE(Query<World, Position>{&world}.Count() == 48);
+    REQUIRE(moving.Count() == 16);
+    REQUIRE(world.GetEntityCount() == 48);
+
+    std::set<Position*> seen{};
+    moving.ForEach([&](Position* p, Velocity*) { seen.insert(p); });
+    REQUIRE(seen.size() == 16);
+
+    world.Clear();
+    REQUIRE(moving.IsEmpty());
+}
+
+TEST_CASE("ForEachChunk hands out contiguous component spans", "[Query]") {
+    World world{};
+    for (U32 i{}; i < 1000; ++i) {
+        EntityHandle h{world.CreateEntity()};
+        world.AddComponent(h, Velocity{static_cast<F32>(i), 0.0f, 0.0f});
+    }
+
+    F32 sum{};
+    U32 count{};
+    Query<World, Read<Velocity>>{&world}.ForEachChunk([&](std::span<const EntityHandle> entities, std::span<const Velocity> velocities) {
+        REQUIRE(entities.size() == velocities.size());
+        for (auto const& v : velocities) sum += v.x;
+        count += static_cast<U32>(velocities.size());
+    });
+    REQUIRE(count == 1000);
+    REQUIRE(sum == 499500.0f);
+
+    Query<World, Velocity>{&world}.ForEachChunk([](std::span<const EntityHandle>, std::span<Velocity> velocities) {
+        for (auto& v : velocities) v.y = 2.0f;
+    });
+    U32 updated{};
+    Query<World, Read<Velocity>>{&world}.ForEach([&](Velocity const* v) { updated += v->y == 2.0f ? 1u : 0u; });
+    REQUIRE(updated == 1000);
+}
+
+TEST_CASE("Query::Collect snapshots matching entities", "[Query]") {
+    World world{};
+    Vector<EntityHandle> moving{};
+    for (U32 i = 0; i < 10; ++i) {
+        EntityHandle e = world.CreateEntity();
+        world.AddComponent(e, Position{static_cast<F32>(i), 0.0f, 0.0f});
+        if (i % 2 == 0) {
+            world.AddComponent(e, Velocity{1.0f, 0.0f, 0.0f});
+            moving.push_back(e);
+        }
+    }
+
+    Query<World, Position, Velocity> query{&world};
+    auto entities = query.Collect();
+    REQUIRE(entities.size() == moving.size());
+
+    // Removing components while walking the snapshot is safe.
+    for (EntityHandle e : entities) world.RemoveComponent<Velocity>(e);
+    REQUIRE(query.IsEmpty());
+
+    std::ranges::sort(entities, {}, [](EntityHandle h) { return h.packed; });
+    std::ranges::sort(moving, {}, [](EntityHandle h) { return h.packed; });
+    REQUIRE(std::ranges::equal(entities, moving));
+}
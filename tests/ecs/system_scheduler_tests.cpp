@@ -0,0 +1,161 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.Component;
+import ECS.World;
+import ECS.SystemScheduler;
+import std;
+
+namespace {
+    struct Alpha { F32 value{}; };
+    struct Beta { F32 value{}; };
+    struct Gamma { F32 value{}; };
+}
+
+template<> struct ComponentTypeID<Alpha> { static consteval ComponentID value() { return 55; } };
+template<> struct ComponentTypeID<Beta> { static consteval ComponentID value() { return 56; } };
+template<> struct ComponentTypeID<Gamma> { static consteval ComponentID value() { return 57; } };
+
+namespace {
+    // Access is configured per instance so one type covers every test shape.
+    class AccessSystem : public System<AccessSystem> {
+    public:
+        using Declare = std::function<void(AccessSystem&)>;
+
+        AccessSystem(std::string name, Declare declare, SystemPriority priority = SystemPriority::Normal)
+            : m_Name{std::move(name)}, m_Declare{std::move(declare)}, m_Priority{priority} {}
+
+        void Setup() {
+            SetName(m_Name);
+            SetStage(SystemStage::Update);
+            SetPriority(m_Priority);
+            if (m_Declare) m_Declare(*this);
+        }
+
+        void Run(World* world, F32) override {
+            if (const ComponentAccess* access = World::CurrentAccess()) seen = *access;
+            if (auto* alpha = world->GetStorage<Alpha>()) {
+                for (auto [h, a] : *alpha) a.value += 1.0f;
+            }
+        }
+
+        using System::ReadsComponents;
+        using System::WritesComponents;
+        using System::SetParallel;
+
+        ComponentAccess seen{};
+
+    private:
+        std::string m_Name;
+        Declare m_Declare;
+        SystemPriority m_Priority;
+    };
+
+    bool DependsOn(const SystemScheduler& scheduler, const std::string& a, const std::string& b) {
+        const SystemNode* node = scheduler.GetSystemNodes().at(a);
+        const SystemNode* dep = scheduler.GetSystemNodes().at(b);
+        return std::ranges::find(node->dependencies, dep) != node->dependencies.end();
+    }
+}
+
+TEST_CASE("ReadsComponents and WritesComponents build access masks", "[SystemScheduler]") {
+    SystemScheduler scheduler{};
+    scheduler.AddSystem<AccessSystem>("S", [](AccessSystem& s) {
+        s.ReadsComponents<Alpha, Beta>();
+        s.WritesComponents<Gamma>();
+    });
+
+    const SystemMetadata& m = scheduler.GetSystemNodes().at("S")->metadata;
+    REQUIRE(m.readComponents == MakeArchetype<Alpha, Beta>());
+    REQUIRE(m.writeComponents == MakeArchetype<Gamma>());
+}
+
+TEST_CASE("Only conflicting systems of a stage are ordered", "[SystemScheduler]") {
+    World world{};
+    SystemScheduler scheduler{};
+    scheduler.AddSystem<AccessSystem>("WriteAlpha", [](AccessSystem& s) { s.WritesComponents<Alpha>(); });
+    scheduler.AddSystem<AccessSystem>("WriteBeta", [](AccessSystem& s) { s.WritesComponents<Beta>(); });
+    scheduler.AddSystem<AccessSystem>("ReadAlpha", [](AccessSystem& s) { s.ReadsComponents<Alpha>(); });
+    scheduler.AddSystem<AccessSystem>("ReadAlphaToo", [](AccessSystem& s) { s.ReadsComponents<Alpha>(); });
+    scheduler.AddSystem<AccessSystem>("WriteGamma", [](AccessSystem& s) { s.WritesComponents<Gamma>(); },
+                                      SystemPriority::High);
+    scheduler.AddSystem<AccessSystem>("ReadGamma", [](AccessSystem& s) { s.ReadsComponents<Gamma>(); },
+                                      SystemPriority::Critical);
+    scheduler.BuildExecutionGraph(&world);
+
+    // Readers wait for the writer but not for each other.
+    REQUIRE(DependsOn(scheduler, "ReadAlpha", "WriteAlpha"));
+    REQUIRE(DependsOn(scheduler, "ReadAlphaToo", "WriteAlpha"));
+    REQUIRE_FALSE(DependsOn(scheduler, "ReadAlphaToo", "ReadAlpha"));
+    REQUIRE_FALSE(DependsOn(scheduler, "ReadAlpha", "ReadAlphaToo"));
+
+    // Disjoint systems stay unordered.
+    REQUIRE(scheduler.GetSystemNodes().at("WriteBeta")->dependencies.empty());
+    REQUIRE(scheduler.GetSystemNodes().at("WriteBeta")->dependents.empty());
+
+    // Higher priority goes first.
+    REQUIRE(DependsOn(scheduler, "WriteGamma", "ReadGamma"));
+}
+
+TEST_CASE("Edges implied by other edges are not added", "[SystemScheduler]") {
+    World world{};
+    SystemScheduler scheduler{};
+    scheduler.AddSystem<AccessSystem>("First", [](AccessSystem& s) { s.WritesComponents<Alpha, Beta>(); });
+    scheduler.AddSystem<AccessSystem>("Second", [](AccessSystem& s) { s.ReadsComponents<Alpha>(); s.WritesComponents<Gamma>(); });
+    scheduler.AddSystem<AccessSystem>("Third", [](AccessSystem& s) { s.ReadsComponents<Beta, Gamma>(); });
+    scheduler.BuildExecutionGraph(&world);
+
+    REQUIRE(DependsOn(scheduler, "Second", "First"));
+    REQUIRE(DependsOn(scheduler, "Third", "Second"));
+    REQUIRE_FALSE(DependsOn(scheduler, "Third", "First"));
+}
+
+TEST_CASE("Non-parallel systems never overlap each other", "[SystemScheduler]") {
+    World world{};
+    SystemScheduler scheduler{};
+    scheduler.AddSystem<AccessSystem>("SerialA", [](AccessSystem& s) { s.SetParallel(false); s.ReadsComponents<Alpha>(); });
+    scheduler.AddSystem<AccessSystem>("SerialB", [](AccessSystem& s) { s.SetParallel(false); s.ReadsComponents<Beta>(); });
+    scheduler.AddSystem<AccessSystem>("Parallel", [](AccessSystem& s) { s.ReadsComponents<Gamma>(); });
+    scheduler.BuildExecutionGraph(&world);
+
+    REQUIRE(DependsOn(scheduler, "SerialB", "SerialA"));
+    REQUIRE(scheduler.GetSystemNodes().at("Parallel")->dependencies.empty());
+    REQUIRE(scheduler.GetSystemNodes().at("Parallel")->dependents.empty());
+}
+
+TEST_CASE("Systems run with their declared access installed", "[SystemScheduler]") {
+    World world{};
+    EntityHandle e = world.CreateEntity();
+    world.AddComponent(e, Alpha{1.0f});
+
+    SystemScheduler scheduler{};
+    auto* system = scheduler.AddSystem<AccessSystem>("Writer", [](AccessSystem& s) {
+        s.ReadsComponents<Beta>();
+        s.WritesComponents<Alpha>();
+    });
+    scheduler.BuildExecutionGraph(&world);
+
+    REQUIRE(World::CurrentAccess() == nullptr);
+    scheduler.ExecuteSystem(scheduler.GetSystemNodes().at("Writer"), 0.0f);
+    REQUIRE(World::CurrentAccess() == nullptr);
+
+    REQUIRE(system->seen.reads == MakeArchetype<Beta>());
+    REQUIRE(system->seen.writes == MakeArchetype<Alpha>());
+    REQUIRE(std::string{system->seen.system} == "Writer");
+    REQUIRE(world.GetComponent<Alpha>(e)->value == 2.0f);
+}
+
+TEST_CASE("Const World access is checked as a read", "[SystemScheduler]") {
+    World world{};
+    EntityHandle e = world.CreateEntity();
+    world.AddComponent(e, Alpha{3.0f});
+
+    const ComponentAccess reader{MakeArchetype<Alpha>(), 0, "Reader"};
+    World::AccessScope accessScope{&reader};
+    const World& view = world;
+
+    STATIC_REQUIRE(std::is_same_v<decltype(view.GetComponent<Alpha>(e)), const Alpha*>);
+    STATIC_REQUIRE(std::is_same_v<decltype(view.GetStorage<Alpha>()), const ComponentStorage<Alpha>*>);
+    REQUIRE(view.GetComponent<Alpha>(e)->value == 3.0f);
+    for (auto [h, a] : *view.GetStorage<Alpha>()) REQUIRE(a.value == 3.0f);
+}
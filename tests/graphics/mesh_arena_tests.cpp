@@ -0,0 +1,308 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Graphics.MeshArena;
+import std;
+
+namespace {
+    // CPU stand-in for the GPU: copies are queued per frame and only executed when the frame's
+    // fence completes, reading the staging memory at that point like the real copy engine.
+    struct FakeBackend final : IMeshArenaBackend {
+        Vector<Vector<std::byte>> vertexHeaps{};
+        Vector<Vector<std::byte>> indexHeaps{};
+        Vector<std::byte> staging{};
+        std::deque<std::pair<U64, Vector<MeshCopy>>> queued{};
+        U64 frameFence{1};
+        U64 completed{0};
+        U32 copyBatches{0};
+
+        U32 CreateHeap(MeshHeapKind kind, U64 bytes) override {
+            auto& heaps{kind == MeshHeapKind::Vertex ? vertexHeaps : indexHeaps};
+            heaps.emplace_back(bytes);
+            return static_cast<U32>(heaps.size() - 1);
+        }
+
+        std::span<std::byte> CreateStaging(U64 bytes) override {
+            staging.resize(bytes);
+            return staging;
+        }
+
+        void RecordCopies(std::span<const MeshCopy> copies) override {
+            queued.emplace_back(frameFence, Vector<MeshCopy>{copies.begin(), copies.end()});
+            ++copyBatches;
+        }
+
+        U64 FrameFence() const override { return frameFence; }
+        U64 CompletedFence() const override { return completed; }
+
+        void Submit() { ++frameFence; }
+
+        void Complete(U64 fence) {
+            while (!queued.empty() && queued.front().first <= fence) {
+                for (MeshCopy const& c : queued.front().second) {
+                    auto& heap{(c.kind == MeshHeapKind::Vertex ? vertexHeaps : indexHeaps)[c.heap]};
+                    REQUIRE(c.dstOffset + c.size <= heap.size());
+                    std::memcpy(heap.data() + c.dstOffset, staging.data() + c.srcOffset, c.size);
+                }
+                queued.pop_front();
+            }
+            completed = std::max(completed, fence);
+        }
+    };
+
+    struct TestMesh {
+        Vector<U64> vertices{};
+        Vector<U32> indices{};
+    };
+
+    TestMesh MakeMesh(std::mt19937& rng, U32 maxVertices) {
+        std::uniform_int_distribution<U32> count{1, maxVertices};
+        TestMesh m{};
+        m.vertices.resize(count(rng));
+        for (U64& v : m.vertices) v = rng();
+        m.indices.resize(m.vertices.size() * 3 / 2);
+        for (U32& i : m.indices) i = static_cast<U32>(rng());
+        return m;
+    }
+
+    std::optional<MeshAllocation> Upload(MeshArena& arena, TestMesh const& m) {
+        return arena.Upload(m.vertices.data(), static_cast<U32>(m.vertices.size()),
+                            m.indices.data(), static_cast<U32>(m.indices.size()));
+    }
+
+    bool Matches(FakeBackend const& gpu, MeshArena const& arena, MeshAllocation const& a, TestMesh const& m) {
+        auto const& vh{gpu.vertexHeaps[arena.VertexHeap(a.page)]};
+        auto const& ih{gpu.indexHeaps[arena.IndexHeap(a.page)]};
+        return a.vertexCount == m.vertices.size() && a.indexCount == m.indices.size()
+            && std::memcmp(vh.data() + static_cast<USize>(a.firstVertex) * 8, m.vertices.data(), m.vertices.size() * 8) == 0
+            && std::memcmp(ih.data() + static_cast<USize>(a.firstIndex) * 4, m.indices.data(), m.indices.size() * 4) == 0;
+    }
+}
+
+TEST_CASE("RangeAllocator picks the best fit and coalesces freed ranges", "[MeshArena]") {
+    RangeAllocator ranges{100};
+    REQUIRE(ranges.Allocate(10) == 0u);
+    REQUIRE(ranges.Allocate(20) == 10u);
+    REQUIRE(ranges.Allocate(30) == 30u);
+    REQUIRE(ranges.FreeCount() == 40);
+
+    ranges.Free(10, 20);
+    REQUIRE(ranges.FreeRanges() == 2);
+    // [10,30) fits better than [60,100).
+    REQUIRE(ranges.Allocate(15) == 10u);
+    REQUIRE_FALSE(ranges.Allocate(41).has_value());
+    REQUIRE_FALSE(ranges.Allocate(0).has_value());
+
+    ranges.Free(0, 10);
+    ranges.Free(30, 30);
+    ranges.Free(10, 15);
+    REQUIRE(ranges.FreeRanges() == 1);
+    REQUIRE(ranges.LargestFree() == 100);
+    REQUIRE(ranges.FreeCount() == 100);
+}
+
+TEST_CASE("RangeAllocator never hands out overlapping ranges", "[MeshArena]") {
+    constexpr U32 kCapacity{4096};
+    RangeAllocator ranges{kCapacity};
+    Vector<U8> used(kCapacity, 0);
+    Vector<std::pair<U32, U32>> live{};
+    std::mt19937 rng{7};
+
+    for (U32 step{}; step < 20000; ++step) {
+        if (live.empty() || rng() % 3 != 0) {
+            const U32 count{1 + static_cast<U32>(rng() % 64)};
+            if (auto offset{ranges.Allocate(count)}) {
+                for (U32 i{*offset}; i < *offset + count; ++i) {
+                    REQUIRE(used[i] == 0);
+                    used[i] = 1;
+                }
+                live.emplace_back(*offset, count);
+            }
+        } else {
+            const USize pick{rng() % live.size()};
+            auto [offset, count]{live[pick]};
+            for (U32 i{offset}; i < offset + count; ++i) used[i] = 0;
+            ranges.Free(offset, count);
+            live[pick] = live.back();
+            live.pop_back();
+        }
+        if (step % 1000 == 0) {
+            REQUIRE(ranges.FreeCount() == static_cast<U32>(std::count(used.begin(), used.end(), U8{0})));
+        }
+    }
+
+    for (auto [offset, count] : live) ranges.Free(offset, count);
+    REQUIRE(ranges.FreeRanges() == 1);
+    REQUIRE(ranges.FreeCount() == kCapacity);
+}
+
+TEST_CASE("StagingRing reuses space only after its fence completes", "[MeshArena]") {
+    StagingRing ring{100};
+    REQUIRE(ring.Allocate(40) == 0u);
+    REQUIRE(ring.Allocate(40) == 48u);
+    ring.Retire(1);
+    REQUIRE_FALSE(ring.Allocate(40).has_value());
+
+    ring.Release(0);
+    REQUIRE(ring.Used() == 88);
+    ring.Release(1);
+    REQUIRE(ring.Used() == 0);
+
+    REQUIRE(ring.Allocate(40) == 0u);
+    ring.Retire(2);
+    REQUIRE(ring.Allocate(40) == 48u);
+    ring.Retire(3);
+    ring.Release(2);
+    // The tail end is skipped rather than split.
+    REQUIRE(ring.Allocate(30) == 0u);
+    REQUIRE_FALSE(ring.Allocate(20).has_value());
+    ring.Retire(4);
+    ring.Release(4);
+    REQUIRE(ring.Used() == 0);
+    REQUIRE_FALSE(ring.Allocate(101).has_value());
+}
+
+TEST_CASE("MeshArena defers frees until the GPU has finished the frame", "[MeshArena]") {
+    FakeBackend gpu{};
+    MeshArena arena{gpu, MeshArenaConfig{8, 1u << 12, 1u << 13, 1u << 16}};
+    std::mt19937 rng{3};
+    const TestMesh mesh{MakeMesh(rng, 500)};
+
+    arena.BeginFrame();
+    const auto a{Upload(arena, mesh)};
+    REQUIRE(a.has_value());
+    arena.EndFrame();
+    gpu.Submit();
+
+    arena.BeginFrame();
+    arena.Free(*a);
+    REQUIRE(arena.GetStats().pendingFreeBytes > 0);
+    const auto b{Upload(arena, mesh)};
+    REQUIRE(b.has_value());
+    REQUIRE(b->firstVertex != a->firstVertex);
+    arena.EndFrame();
+    gpu.Submit();
+
+    // Frame 1 done: a's range is still in use by frame 2.
+    gpu.Complete(1);
+    arena.BeginFrame();
+    REQUIRE(arena.GetStats().pendingFreeBytes > 0);
+    arena.EndFrame();
+    gpu.Submit();
+
+    gpu.Complete(2);
+    arena.BeginFrame();
+    REQUIRE(arena.GetStats().pendingFreeBytes == 0);
+    const auto c{Upload(arena, mesh)};
+    REQUIRE(c.has_value());
+    REQUIRE(c->firstVertex == a->firstVertex);
+    REQUIRE(c->firstIndex == a->firstIndex);
+    arena.EndFrame();
+    gpu.Submit();
+    gpu.Complete(gpu.FrameFence() - 1);
+
+    REQUIRE(Matches(gpu, arena, *b, mesh));
+    REQUIRE(Matches(gpu, arena, *c, mesh));
+    REQUIRE(arena.PageCount() == 1);
+}
+
+TEST_CASE("MeshArena opens pages on demand and sizes oversized ones to fit", "[MeshArena]") {
+    FakeBackend gpu{};
+    MeshArena arena{gpu, MeshArenaConfig{8, 1024, 2048, 1u << 20}};
+    const TestMesh small{Vector<U64>(600, 1), Vector<U32>(900, 2)};
+    const TestMesh large{Vector<U64>(5000, 3), Vector<U32>(7500, 4)};
+
+    arena.BeginFrame();
+    const auto a{Upload(arena, small)};
+    const auto b{Upload(arena, small)};
+    const auto c{Upload(arena, large)};
+    const auto empty{arena.Upload(nullptr, 0, nullptr, 0)};
+    arena.EndFrame();
+    gpu.Submit();
+    gpu.Complete(1);
+
+    REQUIRE(a->page == 0);
+    REQUIRE(b->page == 1);
+    REQUIRE(c->page == 2);
+    REQUIRE(empty.has_value());
+    REQUIRE_FALSE(empty->Valid());
+    REQUIRE(gpu.vertexHeaps[arena.VertexHeap(2)].size() == 5000 * 8);
+    REQUIRE(gpu.copyBatches == 1);
+    REQUIRE(Matches(gpu, arena, *a, small));
+    REQUIRE(Matches(gpu, arena, *b, small));
+    REQUIRE(Matches(gpu, arena, *c, large));
+
+    const MeshArenaStats stats{arena.GetStats()};
+    REQUIRE(stats.pages == 3);
+    REQUIRE(stats.uploads == 3);
+    REQUIRE(stats.usedBytes == (600 + 600 + 5000) * 8 + (900 + 900 + 7500) * 4);
+}
+
+TEST_CASE("MeshArena keeps every live mesh intact while streaming against a lagging GPU", "[MeshArena]") {
+    FakeBackend gpu{};
+    // A small ring so uploads regularly wait for the GPU to free staging space.
+    MeshArena arena{gpu, MeshArenaConfig{8, 1u << 14, 1u << 15, 96u << 10}};
+    std::mt19937 rng{11};
+
+    constexpr U32 kSlots{48};
+    Vector<TestMesh> meshes(kSlots);
+    Vector<MeshAllocation> gpuMeshes(kSlots);
+    Vector<U8> dirty(kSlots, 0);
+
+    for (U32 frame{}; frame < 300; ++frame) {
+        arena.BeginFrame();
+        for (U32 k{}; k < 6; ++k) {
+            const U32 slot{static_cast<U32>(rng() % kSlots)};
+            meshes[slot] = MakeMesh(rng, 2000);
+            dirty[slot] = 1;
+        }
+        for (U32 slot{}; slot < kSlots; ++slot) {
+            if (!dirty[slot]) continue;
+            auto a{Upload(arena, meshes[slot])};
+            if (!a) break;
+            arena.Free(gpuMeshes[slot]);
+            gpuMeshes[slot] = *a;
+            dirty[slot] = 0;
+        }
+        arena.EndFrame();
+        gpu.Submit();
+        // The GPU finishes frames two behind the CPU.
+        if (gpu.FrameFence() > 3) gpu.Complete(gpu.FrameFence() - 3);
+    }
+
+    // Drain what is still pending.
+    for (U32 frame{}; frame < 64 && std::count(dirty.begin(), dirty.end(), U8{1}) > 0; ++frame) {
+        arena.BeginFrame();
+        for (U32 slot{}; slot < kSlots; ++slot) {
+            if (!dirty[slot]) continue;
+            auto a{Upload(arena, meshes[slot])};
+            if (!a) break;
+            arena.Free(gpuMeshes[slot]);
+            gpuMeshes[slot] = *a;
+            dirty[slot] = 0;
+        }
+        arena.EndFrame();
+        gpu.Submit();
+        gpu.Complete(gpu.FrameFence() - 1);
+    }
+    REQUIRE(std::count(dirty.begin(), dirty.end(), U8{1}) == 0);
+    gpu.Complete(gpu.FrameFence() - 1);
+
+    for (U32 slot{}; slot < kSlots; ++slot) {
+        if (!gpuMeshes[slot].Valid()) continue;
+        REQUIRE(Matches(gpu, arena, gpuMeshes[slot], meshes[slot]));
+    }
+
+    const MeshArenaStats stats{arena.GetStats()};
+    REQUIRE(stats.stalls > 0);
+    REQUIRE(stats.pages <= 3);
+
+    // Once the last frees retire, only the live meshes are left.
+    arena.BeginFrame();
+    U64 live{0};
+    for (MeshAllocation const& a : gpuMeshes) live += static_cast<U64>(a.vertexCount) * 8 + static_cast<U64>(a.indexCount) * 4;
+    REQUIRE(arena.GetStats().pendingFreeBytes == 0);
+    REQUIRE(arena.GetStats().usedBytes == live);
+    REQUIRE(arena.GetStats().stagingBytes == 0);
+}
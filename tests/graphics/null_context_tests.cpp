@@ -0,0 +1,202 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.World;
+import Components.Voxel;
+import Components.VoxelStreaming;
+import Components.VoxelStreamingEvents;
+import Components.VoxelDrawList;
+import Systems.VoxelUpload;
+import Graphics;
+import Graphics.MeshArena;
+import Graphics.Null.GraphicsContext;
+import Math.Matrix;
+import std;
+
+namespace {
+    void FillMesh(VoxelMesh& mesh, U32 quads) {
+        mesh.readyVertices.assign(static_cast<USize>(quads) * 4u, ChunkVertex{1u, 2u});
+        mesh.readyIndices.clear();
+        for (U32 q{}; q < quads; ++q) {
+            for (U32 i : {0u, 1u, 2u, 0u, 2u, 3u}) mesh.readyIndices.push_back(q * 4u + i);
+        }
+        mesh.gpuDirty = true;
+    }
+
+    void Frame(NullGraphicsContext& gfx, VoxelUploadSystem& upload, World& world) {
+        gfx.BeginFrame();
+        upload.Run(&world, 1.0f / 60.0f);
+        gfx.EndFrame();
+    }
+}
+
+TEST_CASE("NullGraphicsContext counts resources, uploads and draws", "[graphics][null]") {
+    NullGraphicsContext gfx{};
+    const std::array<U32, 6> indices{0, 1, 2, 0, 2, 3};
+
+    const U32 vb{gfx.CreateVertexBuffer(nullptr, 64)};
+    const U32 ib{gfx.CreateIndexBuffer(indices.data(), sizeof(indices))};
+    const U32 cb{gfx.CreateConstantBuffer(256)};
+    gfx.UpdateConstantBuffer(cb, nullptr, 128);
+    gfx.CreateTexture2D(nullptr, 16, 16, 0);
+
+    gfx.BeginFrame();
+    gfx.BeginRenderPass(RenderPassInfo{});
+    gfx.SetVertexBuffer(vb);
+    gfx.SetIndexBuffer(ib);
+    const std::array<F32, 16> world{};
+    gfx.SetObjectConstants(world.data(), sizeof(world));
+    gfx.DrawIndexed(6, 2, 0, 0, 0);
+    gfx.Draw(3, 1, 0, 0);
+    gfx.EndRenderPass();
+    gfx.EndFrame();
+
+    const NullGraphicsStats s{gfx.GetStats()};
+    REQUIRE(s.frames == 1);
+    REQUIRE(s.vertexBuffers == 1);
+    REQUIRE(s.indexBuffers == 1);
+    REQUIRE(s.constantBuffers == 1);
+    REQUIRE(s.textures == 1);
+    REQUIRE(s.bytesUploaded == 64 + sizeof(indices) + 128 + 16 * 16 * 4);
+    REQUIRE(s.objectConstants == 1);
+    REQUIRE(s.drawCalls == 2);
+    REQUIRE(s.drawnIndices == 12);
+    REQUIRE(s.drawnVertices == 3);
+    REQUIRE_FALSE(gfx.ShouldClose());
+}
+
+TEST_CASE("NullGraphicsContext retires mesh arena frees one frame later", "[graphics][null]") {
+    NullGraphicsContext gfx{};
+    MeshArena& arena{gfx.GetMeshArena()};
+    const std::array<U64, 4> vertices{};
+    const std::array<U32, 6> indices{0, 1, 2, 0, 2, 3};
+
+    gfx.BeginFrame();
+    const std::optional<MeshAllocation> a{arena.Upload(vertices.data(), 4, indices.data(), 6)};
+    gfx.EndFrame();
+    REQUIRE(a);
+    REQUIRE(a->Valid());
+    REQUIRE(gfx.GetStats().meshHeaps == 2);
+    REQUIRE(gfx.GetStats().meshCopies == 2);
+
+    gfx.BeginFrame();
+    arena.Free(*a);
+    gfx.EndFrame();
+    REQUIRE(arena.GetStats().pendingFreeBytes > 0);
+
+    gfx.BeginFrame();
+    gfx.EndFrame();
+    REQUIRE(arena.GetStats().usedBytes == 0);
+    REQUIRE(arena.GetStats().pendingFreeBytes == 0);
+}
+
+TEST_CASE("VoxelUploadSystem runs headless on the null context", "[graphics][null][voxel]") {
+    NullGraphicsContext gfx{};
+    World world{};
+    world.AddComponent(world.CreateEntity(), VoxelWorldConfig{});
+    world.AddComponent(world.CreateEntity(), VoxelStreamingConfig{});
+    world.AddComponent(world.CreateEntity(), VoxelStreamingEvents{});
+
+    const EntityHandle chunk{world.CreateEntity()};
+    world.AddComponent(chunk, VoxelChunk{});
+    VoxelMesh mesh{};
+    FillMesh(mesh, 8);
+    world.AddComponent(chunk, std::move(mesh));
+
+    VoxelUploadSystem upload{};
+    upload.SetGraphicsContext(&gfx);
+    MeshArena& arena{gfx.GetMeshArena()};
+
+    SECTION("upload and remesh") {
+        Frame(gfx, upload, world);
+        VoxelMesh* m{world.GetComponent<VoxelMesh>(chunk)};
+        REQUIRE_FALSE(m->gpuDirty);
+        REQUIRE(m->gpu.Valid());
+        REQUIRE(m->gpu.indexCount == 48);
+        REQUIRE(arena.GetStats().usedBytes == 32 * sizeof(ChunkVertex) + 48 * sizeof(U32));
+
+        FillMesh(*m, 2);
+        Frame(gfx, upload, world);
+        REQUIRE(m->gpu.indexCount == 12);
+        Frame(gfx, upload, world);
+        REQUIRE(arena.GetStats().usedBytes == 8 * sizeof(ChunkVertex) + 12 * sizeof(U32));
+        REQUIRE(FindVoxelDrawList(&world)->Draw(m->drawSlot).gpu.indexCount == 12);
+
+        // An empty remesh leaves nothing to draw.
+        FillMesh(*m, 0);
+        Frame(gfx, upload, world);
+        REQUIRE(m->drawSlot == INVALID_INDEX);
+        REQUIRE(FindVoxelDrawList(&world)->Size() == 0);
+    }
+
+    SECTION("unloading a chunk frees its mesh") {
+        Frame(gfx, upload, world);
+        REQUIRE(arena.GetStats().usedBytes > 0);
+
+        VoxelStreamingEvents* events{FindVoxelStreamingEvents(&world)};
+        events->unloaded.Publish(ChunkUnloaded{chunk, 0, 0, 0});
+        REQUIRE_FALSE(world.GetComponent<VoxelMesh>(chunk)->gpu.Valid());
+
+        Frame(gfx, upload, world);
+        Frame(gfx, upload, world);
+        REQUIRE(arena.GetStats().usedBytes == 0);
+    }
+}
+
+TEST_CASE("Streaming chunks in and out leaves no GPU memory behind", "[graphics][null][voxel]") {
+    NullGraphicsContext gfx{};
+    World world{};
+    world.AddComponent(world.CreateEntity(), VoxelWorldConfig{});
+    world.AddComponent(world.CreateEntity(), VoxelStreamingConfig{});
+    world.AddComponent(world.CreateEntity(), VoxelStreamingEvents{});
+
+    VoxelUploadSystem upload{};
+    upload.SetGraphicsContext(&gfx);
+    MeshArena& arena{gfx.GetMeshArena()};
+    const F32 blockSize{VoxelWorldConfig{}.blockSize};
+
+    for (U32 cycle{}; cycle < 4; ++cycle) {
+        Vector<EntityHandle> chunks{};
+        for (S32 i{}; i < 8; ++i) {
+            const EntityHandle e{world.CreateEntity()};
+            VoxelChunk chunk{};
+            chunk.cx = static_cast<U32>(i - 4);
+            chunk.cz = cycle;
+            world.AddComponent(e, std::move(chunk));
+            VoxelMesh mesh{};
+            FillMesh(mesh, 4);
+            world.AddComponent(e, std::move(mesh));
+            chunks.push_back(e);
+        }
+        for (U32 f{}; f < 4; ++f) Frame(gfx, upload, world);
+
+        VoxelDrawList const* draws{FindVoxelDrawList(&world)};
+        REQUIRE(draws->Size() == chunks.size());
+        for (EntityHandle e : chunks) {
+            VoxelMesh const* m{world.GetComponent<VoxelMesh>(e)};
+            REQUIRE(m->gpu.Valid());
+            const Math::Mat4 expected{VoxelUploadSystem::ChunkWorldMatrix(*world.GetComponent<VoxelChunk>(e), blockSize)};
+            REQUIRE(std::memcmp(&m->world, &expected, sizeof(expected)) == 0);
+            REQUIRE(draws->Owner(m->drawSlot) == e);
+            REQUIRE(draws->Draw(m->drawSlot).gpu.firstIndex == m->gpu.firstIndex);
+        }
+
+        // Unload from the middle so swap-removal moves entries that stay.
+        VoxelStreamingEvents* events{FindVoxelStreamingEvents(&world)};
+        for (USize i{}; i < chunks.size(); ++i) {
+            const EntityHandle e{chunks[(i * 3) % chunks.size()]};
+            events->unloaded.Publish(ChunkUnloaded{e, 0, 0, 0});
+            world.DestroyEntity(e);
+            for (USize slot{}; slot < draws->Size(); ++slot) {
+                VoxelMesh const* m{world.GetComponent<VoxelMesh>(draws->Owner(static_cast<U32>(slot)))};
+                REQUIRE(m != nullptr);
+                REQUIRE(m->drawSlot == slot);
+            }
+        }
+        REQUIRE(draws->Size() == 0);
+        Frame(gfx, upload, world);
+        Frame(gfx, upload, world);
+        REQUIRE(arena.GetStats().usedBytes == 0);
+    }
+    REQUIRE(gfx.GetStats().constantBuffers == 0);
+}
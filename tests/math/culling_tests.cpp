@@ -0,0 +1,150 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Math.Matrix;
+import Math.Vector;
+import Math.Transform;
+import Math.Culling;
+import std;
+
+using namespace Math;
+
+namespace {
+    Frustum MakeFrustum(const Vec3& eye, const Vec3& target) {
+        const Mat4 viewProjection = Mat4::Perspective(1.2f, 16.0f / 9.0f, 0.1f, 400.0f)
+                                    * Mat4::LookAt(eye, target, Vec3{0.0f, 1.0f, 0.0f});
+        Frustum frustum{};
+        frustum.SetFromMatrix(viewProjection);
+        return frustum;
+    }
+
+    // Chunk-sized boxes scattered around the eye, with some degenerate and huge ones.
+    Vector<Bounds> RandomBounds(U32 count) {
+        std::mt19937 rng{7};
+        std::uniform_real_distribution<F32> pos{-500.0f, 500.0f};
+        std::uniform_real_distribution<F32> size{0.0f, 40.0f};
+        Vector<Bounds> boxes{};
+        for (U32 i = 0; i < count; ++i) {
+            const Vec3 min{pos(rng), pos(rng) * 0.25f, pos(rng)};
+            const Vec3 extent = i % 97 == 0 ? Vec3{600.0f, 600.0f, 600.0f} : Vec3{size(rng), size(rng), size(rng)};
+            boxes.push_back(Bounds{min, min + extent});
+        }
+        return boxes;
+    }
+
+    Vector<CullKernel> SupportedKernels() {
+        Vector<CullKernel> kernels{};
+        for (CullKernel kernel : {CullKernel::Scalar, CullKernel::SSE, CullKernel::AVX}) {
+            if (IsCullKernelSupported(kernel)) kernels.push_back(kernel);
+        }
+        return kernels;
+    }
+}
+
+TEST_CASE("Frustum culling of SoA bounds matches Frustum::Intersects", "[Culling]") {
+    const Frustum frustum = MakeFrustum(Vec3{10.0f, 20.0f, -30.0f}, Vec3{60.0f, 0.0f, 100.0f});
+    // Counts that leave partial SIMD blocks.
+    for (U32 count : {0u, 1u, 7u, 9u, 1001u}) {
+        const Vector<Bounds> boxes = RandomBounds(count);
+        BoundsSoA soa{};
+        for (const Bounds& b : boxes) soa.Add(b);
+        REQUIRE(soa.Size() == count);
+
+        Vector<U32> expected{};
+        for (U32 i = 0; i < count; ++i) {
+            if (frustum.Intersects(boxes[i])) expected.push_back(i);
+        }
+        for (CullKernel kernel : SupportedKernels()) {
+            CullResult result{};
+            Cull(kernel, CullQuery{.frustum = &frustum}, soa, result);
+            REQUIRE(result.indices == expected);
+            REQUIRE(result.distanceSq.empty());
+        }
+    }
+}
+
+TEST_CASE("Distance band and view cone filter on box centers", "[Culling]") {
+    const Vec3 eye{5.0f, 10.0f, 5.0f};
+    const Vec3 dir = Vec3{1.0f, -0.2f, 0.5f}.Normalized();
+    const Frustum frustum = MakeFrustum(eye, eye + dir);
+    const Vector<Bounds> boxes = RandomBounds(3000);
+    BoundsSoA soa{};
+    for (const Bounds& b : boxes) soa.Add(b);
+    // A box centered on the eye counts as straight ahead.
+    soa.Add(Bounds{eye - Vec3{1.0f, 1.0f, 1.0f}, eye + Vec3{1.0f, 1.0f, 1.0f}});
+
+    CullResult scalar{};
+    Cull(CullKernel::Scalar, CullQuery{.eye = eye, .minDistance = 50.0f, .maxDistance = 300.0f}, soa, scalar);
+    U32 inBand = 0;
+    for (U32 i = 0; i < soa.Size(); ++i) {
+        const F32 d = (soa.Center(i) - eye).Length();
+        if (d > 50.5f && d < 299.5f) ++inBand;
+    }
+    REQUIRE(scalar.indices.size() >= inBand);
+    REQUIRE(scalar.indices.size() <= inBand + 10);
+    for (USize k = 0; k < scalar.indices.size(); ++k) {
+        REQUIRE(scalar.distanceSq[k] == Approx((soa.Center(scalar.indices[k]) - eye).LengthSquared()));
+    }
+
+    const Bounds eyeBox{eye - Vec3{1.0f, 1.0f, 1.0f}, eye + Vec3{1.0f, 1.0f, 1.0f}};
+    const CullQuery coneQuery{.frustum = &frustum, .eye = eye, .coneDir = dir, .coneMinCos = 0.5f};
+    CullResult reference{};
+    Cull(CullKernel::Scalar, coneQuery, soa, reference);
+    REQUIRE(reference.indices.back() == soa.Size() - 1);
+    REQUIRE(reference.cosine.back() == 1.0f);
+
+    for (CullKernel kernel : SupportedKernels()) {
+        CullResult band{};
+        Cull(kernel, CullQuery{.eye = eye, .minDistance = 50.0f, .maxDistance = 300.0f}, soa, band);
+        REQUIRE(band.indices == scalar.indices);
+
+        CullResult cone{};
+        Cull(kernel, coneQuery, soa, cone);
+        REQUIRE(cone.indices == reference.indices);
+        REQUIRE(cone.cosine.size() == cone.indices.size());
+        for (USize k = 0; k < cone.indices.size(); ++k) {
+            const U32 i = cone.indices[k];
+            REQUIRE(cone.cosine[k] >= 0.5f);
+            REQUIRE(cone.cosine[k] == Approx(reference.cosine[k]).margin(1e-6f));
+            REQUIRE(frustum.Intersects(i < boxes.size() ? boxes[i] : eyeBox));
+        }
+    }
+
+    CullResult viaHelper{};
+    CullViewCone(&frustum, eye, dir, 0.5f, soa, viaHelper);
+    REQUIRE(viaHelper.indices == reference.indices);
+}
+
+TEST_CASE("BoundsSoA reuse after Clear ignores stale padding", "[Culling]") {
+    const Frustum frustum = MakeFrustum(Vec3{0.0f, 0.0f, 0.0f}, Vec3{0.0f, 0.0f, -1.0f});
+    BoundsSoA soa{};
+    for (U32 i = 0; i < 16; ++i) soa.Add(Bounds{Vec3{-1.0f, -1.0f, -20.0f}, Vec3{1.0f, 1.0f, -10.0f}});
+    soa.Clear();
+    soa.Add(Bounds{Vec3{-1.0f, -1.0f, 10.0f}, Vec3{1.0f, 1.0f, 20.0f}});
+    soa.Add(Bounds{Vec3{-1.0f, -1.0f, -20.0f}, Vec3{1.0f, 1.0f, -10.0f}});
+
+    for (CullKernel kernel : SupportedKernels()) {
+        CullResult result{};
+        Cull(kernel, CullQuery{.frustum = &frustum}, soa, result);
+        REQUIRE(result.indices == Vector<U32>{1});
+    }
+}
+
+TEST_CASE("BoundsSoA swap-removal keeps the other boxes", "[Culling]") {
+    const Frustum frustum = MakeFrustum(Vec3{0.0f, 0.0f, 0.0f}, Vec3{0.0f, 0.0f, -1.0f});
+    const Bounds front{Vec3{-1.0f, -1.0f, -20.0f}, Vec3{1.0f, 1.0f, -10.0f}};
+    const Bounds behind{Vec3{-1.0f, -1.0f, 10.0f}, Vec3{1.0f, 1.0f, 20.0f}};
+    BoundsSoA soa{};
+    for (U32 i = 0; i < 9; ++i) soa.Add(i % 3 == 0 ? behind : front);
+
+    REQUIRE(soa.RemoveSwap(8) == 8);
+    REQUIRE(soa.RemoveSwap(0) == 7);
+    REQUIRE(soa.Size() == 7);
+    REQUIRE(soa.Center(0) == front.Center());
+
+    for (CullKernel kernel : SupportedKernels()) {
+        CullResult result{};
+        Cull(kernel, CullQuery{.frustum = &frustum}, soa, result);
+        REQUIRE(result.indices == Vector<U32>{0, 1, 2, 4, 5});
+    }
+}
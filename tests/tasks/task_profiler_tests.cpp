@@ -0,0 +1,143 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Tasks.TaskProfiler;
+import std;
+
+namespace {
+    // Frames move to the history when the next one begins.
+    void FinishFrame(TaskProfiler& profiler, U64 next) {
+        profiler.EndFrame();
+        profiler.BeginFrame(next);
+    }
+
+    USize CountOccurrences(const std::string& text, std::string_view needle) {
+        USize count{0};
+        for (USize pos{text.find(needle)}; pos != std::string::npos; pos = text.find(needle, pos + 1)) ++count;
+        return count;
+    }
+}
+
+TEST_CASE("TaskProfiler merges per-thread events at the end of the frame", "[TaskProfiler]") {
+    TaskProfiler& profiler{TaskProfiler::Get()};
+    profiler.SetEnabled(true);
+    profiler.Clear();
+
+    constexpr U32 kThreads{4};
+    constexpr U32 kTasksPerThread{100};
+
+    profiler.BeginFrame(1);
+    profiler.BeginPhase("Update", 7);
+
+    Vector<std::thread> threads{};
+    for (U32 t{0}; t < kThreads; ++t) {
+        threads.emplace_back([&profiler, t]() {
+            for (U32 i{0}; i < kTasksPerThread; ++i) {
+                const U64 now{TaskProfiler::GetTimestamp()};
+                profiler.RecordTask("Work", t * kTasksPerThread + i, 7, now, now + 1);
+            }
+            ProfileZone zone{"Zone"};
+            profiler.AddCounter("Items", 5);
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    profiler.EndPhase(7);
+    FinishFrame(profiler, 2);
+
+    const auto& history{profiler.GetFrameHistory()};
+    REQUIRE(history.size() == 1);
+    const FrameProfile& frame{history.back()};
+
+    const PhaseProfile* phase{frame.GetPhase("Update")};
+    REQUIRE(phase != nullptr);
+    REQUIRE(phase->tasks.size() == kThreads * kTasksPerThread);
+
+    std::set<U32> ids{};
+    for (const auto& task : phase->tasks) ids.insert(task.taskID);
+    REQUIRE(ids.size() == kThreads * kTasksPerThread);
+
+    REQUIRE(frame.zones.size() == kThreads);
+    REQUIRE(frame.counters.size() == 1);
+    REQUIRE(frame.counters[0].first == "Items");
+    REQUIRE(frame.counters[0].second == 5 * kThreads);
+}
+
+TEST_CASE("TaskProfiler drops the oldest events when a thread overruns its ring", "[TaskProfiler]") {
+    TaskProfiler& profiler{TaskProfiler::Get()};
+    profiler.SetEnabled(true);
+    profiler.Clear();
+
+    constexpr U32 kEvents{20000};
+
+    profiler.BeginFrame(1);
+    profiler.BeginPhase("Busy", 3);
+    std::thread{[&profiler]() {
+        for (U32 i{0}; i < kEvents; ++i) profiler.RecordTask("Tiny", i, 3, 10, 11);
+    }}.join();
+    profiler.EndPhase(3);
+    FinishFrame(profiler, 2);
+
+    const PhaseProfile* phase{profiler.GetFrameHistory().back().GetPhase("Busy")};
+    REQUIRE(phase != nullptr);
+    REQUIRE(phase->tasks.size() < kEvents);
+    REQUIRE(phase->tasks.back().taskID == kEvents - 1);
+    REQUIRE(phase->tasks.size() + profiler.GetStats().droppedEvents == kEvents);
+}
+
+TEST_CASE("TaskProfiler exports Chrome trace events", "[TaskProfiler]") {
+    TaskProfiler& profiler{TaskProfiler::Get()};
+    profiler.SetEnabled(true);
+    profiler.Clear();
+
+    profiler.BeginFrame(1);
+    profiler.BeginPhase("Render", 1);
+    profiler.RecordTask("Draw \"chunks\"", 1, 1, 100, 250);
+    profiler.RecordZone("Greedy", 120, 200);
+    profiler.AddCounter("BytesUploaded", 4096);
+    profiler.EndPhase(1);
+    FinishFrame(profiler, 2);
+
+    const std::string trace{profiler.GenerateChromeTrace()};
+    REQUIRE(trace.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    REQUIRE(trace.find("\"name\":\"Draw \\\"chunks\\\"\",\"cat\":\"task\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(trace.find("\"ts\":100,\"dur\":150") != std::string::npos);
+    REQUIRE(trace.find("\"name\":\"Greedy\",\"cat\":\"zone\"") != std::string::npos);
+    REQUIRE(trace.find("\"ph\":\"C\"") != std::string::npos);
+    REQUIRE(trace.find("\"args\":{\"value\":4096}") != std::string::npos);
+    REQUIRE(CountOccurrences(trace, "\"cat\":\"frame\"") == 1);
+    REQUIRE(CountOccurrences(trace, "{") == CountOccurrences(trace, "}"));
+}
+
+TEST_CASE("Disabled TaskProfiler records nothing", "[TaskProfiler]") {
+    TaskProfiler& profiler{TaskProfiler::Get()};
+    profiler.SetEnabled(true);
+    profiler.Clear();
+    profiler.BeginFrame(1);
+    profiler.BeginPhase("Idle", 1);
+    profiler.SetEnabled(false);
+    profiler.RecordTask("Skipped", 1, 1, 0, 1);
+    { ProfileZone zone{"Skipped"}; }
+    profiler.SetEnabled(true);
+    profiler.EndPhase(1);
+    FinishFrame(profiler, 2);
+
+    const FrameProfile& frame{profiler.GetFrameHistory().back()};
+    REQUIRE(frame.GetPhase("Idle")->tasks.empty());
+    REQUIRE(frame.zones.empty());
+}
+
+TEST_CASE("TaskProfiler reuses the buffers of exited threads", "[TaskProfiler]") {
+    TaskProfiler& profiler{TaskProfiler::Get()};
+    profiler.SetEnabled(true);
+    profiler.Clear();
+
+    auto recordOnNewThread = [&profiler]() {
+        std::thread{[&profiler]() { profiler.RecordZone("Once", 1, 2); }}.join();
+    };
+
+    recordOnNewThread();
+    const USize threadsBefore{CountOccurrences(profiler.GenerateChromeTrace(), "thread_name")};
+    for (U32 i{0}; i < 8; ++i) recordOnNewThread();
+    REQUIRE(CountOccurrences(profiler.GenerateChromeTrace(), "thread_name") == threadsBefore);
+}
@@ -0,0 +1,213 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Tasks.WorkStealingDeque;
+import Tasks.TaskGraph;
+import Tasks.TaskProfiler;
+import std;
+
+TEST_CASE("WorkStealingDeque pops LIFO and steals FIFO", "[WorkStealingDeque]") {
+    WorkStealingDeque<U32> deque{4};
+    for (U32 i{}; i < 10; ++i) deque.Push(i);
+
+    REQUIRE(deque.Size() == 10);
+    REQUIRE(deque.Capacity() >= 10);
+    REQUIRE(deque.Steal() == std::optional<U32>{0});
+    REQUIRE(deque.Pop() == std::optional<U32>{9});
+    REQUIRE(deque.Steal() == std::optional<U32>{1});
+
+    U32 left{};
+    while (deque.Pop()) ++left;
+    REQUIRE(left == 7);
+    REQUIRE(deque.Empty());
+    REQUIRE_FALSE(deque.Steal().has_value());
+}
+
+TEST_CASE("WorkStealingDeque hands every item to exactly one thread", "[WorkStealingDeque]") {
+    constexpr U32 kItems{200000};
+    constexpr U32 kThieves{4};
+    WorkStealingDeque<U32> deque{64};
+    Vector<std::atomic<U32>> seen(kItems);
+    std::atomic<bool> done{false};
+    std::atomic<U32> taken{0};
+
+    Vector<std::thread> thieves{};
+    for (U32 t{}; t < kThieves; ++t) {
+        thieves.emplace_back([&]() {
+            while (!done.load() || !deque.Empty()) {
+                if (auto v{deque.Steal()}) { seen[*v].fetch_add(1); taken.fetch_add(1); }
+            }
+        });
+    }
+
+    for (U32 i{}; i < kItems; ++i) {
+        deque.Push(i);
+        if ((i & 3) == 0) {
+            if (auto v{deque.Pop()}) { seen[*v].fetch_add(1); taken.fetch_add(1); }
+        }
+    }
+    while (auto v{deque.Pop()}) { seen[*v].fetch_add(1); taken.fetch_add(1); }
+    done.store(true);
+    for (auto& t : thieves) t.join();
+
+    REQUIRE(taken.load() == kItems);
+    U32 duplicates{};
+    for (auto& s : seen) duplicates += s.load() != 1 ? 1u : 0u;
+    REQUIRE(duplicates == 0);
+}
+
+TEST_CASE("TaskGraph runs dependents only after their dependencies", "[TaskGraph]") {
+    TaskGraph graph{4};
+    graph.SetProfilingEnabled(false);
+    TaskPhase* phase{graph.CreatePhase("Diamond")};
+
+    constexpr U32 kWidth{64};
+    std::atomic<U32> started{0};
+    std::atomic<U32> middle{0};
+    std::atomic<bool> orderOk{true};
+
+    Task* root{phase->AddTask("root", [&]() { started.fetch_add(1); })};
+    Task* sink{phase->AddTask("sink", [&]() {
+        if (middle.load() != kWidth) orderOk.store(false);
+    })};
+    for (U32 i{}; i < kWidth; ++i) {
+        Task* t{phase->AddTask("mid" + std::to_string(i), [&]() {
+            if (started.load() != 1) orderOk.store(false);
+            middle.fetch_add(1);
+        })};
+        phase->AddDependency(t, root);
+        phase->AddDependency(sink, t);
+    }
+
+    for (U32 frame{}; frame < 50; ++frame) {
+        started.store(0);
+        middle.store(0);
+        graph.Execute();
+        REQUIRE(phase->IsCompleted());
+    }
+    REQUIRE(orderOk.load());
+    REQUIRE(graph.GetStats().completedTasks == kWidth + 2);
+}
+
+TEST_CASE("TaskGraph drains long chains across phases", "[TaskGraph]") {
+    TaskGraph graph{3};
+    graph.SetProfilingEnabled(false);
+
+    std::atomic<U32> counter{0};
+    std::atomic<bool> orderOk{true};
+    constexpr U32 kChain{500};
+    for (U32 p{}; p < 3; ++p) {
+        TaskPhase* phase{graph.CreatePhase("Phase" + std::to_string(p))};
+        Task* prev{nullptr};
+        for (U32 i{}; i < kChain; ++i) {
+            const U32 expected{p * kChain + i};
+            Task* t{phase->AddTask("t" + std::to_string(i), [&, expected]() {
+                if (counter.fetch_add(1) != expected) orderOk.store(false);
+            })};
+            if (prev) phase->AddDependency(t, prev);
+            prev = t;
+        }
+    }
+
+    graph.Execute();
+    REQUIRE(counter.load() == 3 * kChain);
+    REQUIRE(orderOk.load());
+}
+
+TEST_CASE("TaskGraph ranks tasks by critical path and inherits priority", "[TaskGraph]") {
+    TaskGraph graph{2};
+    graph.SetProfilingEnabled(false);
+    TaskPhase* phase{graph.CreatePhase("Schedule")};
+
+    Task* load{phase->AddTask("load", []() {}, TaskPriority::Idle)};
+    Task* slow{phase->AddTask("slow", []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }, TaskPriority::Low)};
+    Task* stream{phase->AddTask("stream", []() {}, TaskPriority::Critical)};
+    Task* other{phase->AddTask("other", []() {}, TaskPriority::Normal)};
+    phase->AddDependency(slow, load);
+    phase->AddDependency(stream, slow);
+
+    graph.Execute();
+    graph.Execute();
+
+    REQUIRE(slow->GetAverageExecutionTime() >= 2000.0f);
+    REQUIRE(load->GetCriticalPath() >= slow->GetCriticalPath() + 1);
+    REQUIRE(slow->GetCriticalPath() >= stream->GetCriticalPath() + 2000);
+    REQUIRE(load->GetCriticalPath() > other->GetCriticalPath());
+
+    REQUIRE(load->GetEffectivePriority() == TaskPriority::Critical);
+    REQUIRE(slow->GetEffectivePriority() == TaskPriority::Critical);
+    REQUIRE(other->GetEffectivePriority() == TaskPriority::Normal);
+    REQUIRE(load->GetPriority() == TaskPriority::Idle);
+}
+
+TEST_CASE("ParallelFor covers every index once, inline and from tasks", "[TaskGraph]") {
+    constexpr U32 kCount{10000};
+    Vector<std::atomic<U32>> seen(kCount);
+    auto body = [&](U32 begin, U32 end) {
+        for (U32 i{begin}; i < end; ++i) seen[i].fetch_add(1);
+    };
+
+    ParallelFor(kCount, 64, body);
+
+    TaskGraph graph{4};
+    graph.SetProfilingEnabled(false);
+    TaskPhase* phase{graph.CreatePhase("Fork")};
+    std::atomic<U32> threads{0};
+    for (U32 t{}; t < 3; ++t) {
+        phase->AddTask("fork" + std::to_string(t), [&]() {
+            ParallelFor(kCount, 32, body);
+            threads.fetch_add(1);
+        });
+    }
+    for (U32 frame{}; frame < 5; ++frame) graph.Execute();
+
+    REQUIRE(threads.load() == 15);
+    bool exact{true};
+    for (auto const& s : seen) exact = exact && s.load() == 16;
+    REQUIRE(exact);
+}
+
+TEST_CASE("ParallelFor helpers are profiled under the forking task's phase", "[TaskGraph]") {
+    TaskProfiler& profiler{TaskProfiler::Get()};
+    profiler.SetEnabled(true);
+    profiler.Clear();
+
+    TaskGraph graph{4};
+    TaskPhase* first{graph.CreatePhase("First")};
+    TaskPhase* second{graph.CreatePhase("Second")};
+    first->AddTask("plain", []() {});
+    std::atomic<U64> sum{0};
+    second->AddTask("fork", [&]() {
+        ParallelFor(4096, 16, [&](U32 begin, U32 end) {
+            U64 local{};
+            for (U32 i{begin}; i < end; ++i) local += i;
+            sum.fetch_add(local);
+        });
+    });
+
+    profiler.BeginFrame(1);
+    graph.Execute();
+    // The helpers are freed by now; the frame still reads their names.
+    profiler.EndFrame();
+    profiler.BeginFrame(2);
+    profiler.SetEnabled(false);
+
+    REQUIRE(sum.load() == 4095ull * 4096ull / 2ull);
+    const FrameProfile& frame{profiler.GetFrameHistory().back()};
+    const PhaseProfile* firstProfile{frame.GetPhase("First")};
+    const PhaseProfile* secondProfile{frame.GetPhase("Second")};
+    REQUIRE(firstProfile != nullptr);
+    REQUIRE(secondProfile != nullptr);
+    REQUIRE(firstProfile->tasks.size() == 1);
+    USize helpers{};
+    for (const TaskProfile& task : secondProfile->tasks) {
+        if (task.name == "ParallelFor") {
+            ++helpers;
+            REQUIRE(task.phaseID == second->GetID());
+        }
+    }
+    REQUIRE(helpers > 0);
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Components.Voxel;
+import std;
+
+namespace {
+    U32 ExpectedBits(USize paletteSize) {
+        if (paletteSize <= 1) return 0;
+        if (paletteSize <= 2) return 1;
+        if (paletteSize <= 4) return 2;
+        if (paletteSize <= 16) return 4;
+        return 8;
+    }
+
+    bool Matches(VoxelBlocks const& blocks, Vector<Voxel> const& dense) {
+        for (U32 i{}; i < VoxelBlocks::Volume; ++i) {
+            if (blocks.Get(i) != dense[i]) return false;
+        }
+        Vector<Voxel> copy(VoxelBlocks::Volume, Voxel::Air);
+        blocks.CopyTo(copy);
+        return copy == dense;
+    }
+
+    // Spreads writes over the whole chunk so every index word is exercised.
+    USize Scatter(U32 n) { return (static_cast<USize>(n) * 7919u) % VoxelBlocks::Volume; }
+}
+
+TEST_CASE("VoxelBlocks::Set widens the index as the palette grows", "[VoxelBlocks]") {
+    VoxelBlocks blocks{};
+    blocks.Fill(Voxel::Stone);
+    Vector<Voxel> dense(VoxelBlocks::Volume, Voxel::Stone);
+    REQUIRE(blocks.BitsPerIndex() == 0);
+
+    // Each new block type adds a palette entry (200 stands in for Stone, already present);
+    // writes made before a repack must survive it.
+    U32 written{};
+    for (U32 type{}; type < 40; ++type) {
+        const Voxel v{static_cast<Voxel>(type == 3 ? 200 : type)};
+        for (U32 k{}; k < 5; ++k, ++written) {
+            const USize index{Scatter(written)};
+            blocks.Set(index, v);
+            dense[index] = v;
+        }
+        REQUIRE(blocks.PaletteSize() == type + 2);
+        REQUIRE(blocks.BitsPerIndex() == ExpectedBits(blocks.PaletteSize()));
+        REQUIRE(Matches(blocks, dense));
+    }
+    REQUIRE(blocks.BitsPerIndex() == 8);
+
+    // Existing block types do not grow the palette.
+    blocks.Set(0, Voxel::Air);
+    dense[0] = Voxel::Air;
+    REQUIRE(blocks.PaletteSize() == 41);
+    REQUIRE(Matches(blocks, dense));
+}
+
+TEST_CASE("VoxelBlocks::Compact narrows the index once palette entries are unused", "[VoxelBlocks]") {
+    Vector<Voxel> dense(VoxelBlocks::Volume, Voxel::Air);
+    for (U32 i{}; i < VoxelBlocks::Volume; ++i) dense[i] = static_cast<Voxel>(i % 20u);
+    VoxelBlocks blocks{};
+    blocks.Assign(dense);
+    REQUIRE(blocks.PaletteSize() == 20);
+    REQUIRE(blocks.BitsPerIndex() == 8);
+
+    SECTION("down to a smaller width") {
+        // Overwriting leaves the palette and width alone until Compact drops the dead entries.
+        for (U32 i{}; i < VoxelBlocks::Volume; ++i) {
+            if (dense[i] > Voxel::Log) {
+                dense[i] = Voxel::Dirt;
+                blocks.Set(i, Voxel::Dirt);
+            }
+        }
+        REQUIRE(blocks.PaletteSize() == 20);
+        REQUIRE(blocks.BitsPerIndex() == 8);
+        REQUIRE(Matches(blocks, dense));
+
+        blocks.Compact();
+        REQUIRE(blocks.PaletteSize() == 5);
+        REQUIRE(blocks.BitsPerIndex() == 4);
+        REQUIRE(Matches(blocks, dense));
+
+        // The compacted storage widens again on the next new type.
+        for (U32 type{20}; type < 32; ++type) {
+            blocks.Set(Scatter(type), static_cast<Voxel>(type));
+            dense[Scatter(type)] = static_cast<Voxel>(type);
+        }
+        REQUIRE(blocks.PaletteSize() == 17);
+        REQUIRE(blocks.BitsPerIndex() == 8);
+        REQUIRE(Matches(blocks, dense));
+    }
+
+    SECTION("down to a uniform chunk") {
+        for (U32 i{}; i < VoxelBlocks::Volume; ++i) blocks.Set(i, Voxel::Air);
+        REQUIRE(blocks.PaletteSize() == 20);
+        REQUIRE_FALSE(blocks.HasSolid());
+
+        blocks.Compact();
+        REQUIRE(blocks.IsUniform());
+        REQUIRE(blocks.BitsPerIndex() == 0);
+        REQUIRE(blocks.Get(VoxelBlocks::Volume - 1) == Voxel::Air);
+        REQUIRE_FALSE(blocks.HasSolid());
+    }
+}
+
+TEST_CASE("VoxelBlocks::Assign round-trips at every index width boundary", "[VoxelBlocks]") {
+    for (U32 paletteSize : {1u, 2u, 3u, 4u, 5u, 16u, 17u, 255u, 256u}) {
+        INFO("palette size " << paletteSize);
+        Vector<Voxel> dense(VoxelBlocks::Volume, Voxel::Air);
+        // A stride coprime with every size keeps neighbours distinct inside each index word.
+        for (U32 i{}; i < VoxelBlocks::Volume; ++i) dense[i] = static_cast<Voxel>((i * 37u) % paletteSize);
+
+        VoxelBlocks blocks{};
+        blocks.Assign(dense);
+        REQUIRE(blocks.PaletteSize() == paletteSize);
+        REQUIRE(blocks.BitsPerIndex() == ExpectedBits(paletteSize));
+        REQUIRE(Matches(blocks, dense));
+        REQUIRE(blocks.HasSolid() == (paletteSize > 1));
+
+        // Rewriting every voxel in place keeps the width and the contents.
+        std::ranges::reverse(dense);
+        for (U32 i{}; i < VoxelBlocks::Volume; ++i) blocks.Set(i, dense[i]);
+        REQUIRE(blocks.PaletteSize() == paletteSize);
+        REQUIRE(blocks.BitsPerIndex() == ExpectedBits(paletteSize));
+        REQUIRE(Matches(blocks, dense));
+    }
+}
@@ -0,0 +1,68 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Components.Voxel;
+import Systems.VoxelBufferPool;
+import std;
+
+namespace {
+    Vector<Voxel> Layered() {
+        Vector<Voxel> dense(VoxelBlocks::Volume, Voxel::Air);
+        for (USize i{0}; i < dense.size() / 2; ++i) dense[i] = (i % 3 == 0) ? Voxel::Stone : Voxel::Dirt;
+        return dense;
+    }
+}
+
+TEST_CASE("VoxelBlocks reuse pooled index storage", "[VoxelBufferPool]") {
+    VoxelBufferPool pool{};
+    const auto dense{Layered()};
+
+    VoxelBlocks a{};
+    a.Assign(dense, pool.WordSource());
+    REQUIRE(pool.Blocks().GetStats().misses == 1);
+    pool.Recycle(a);
+    REQUIRE(a.Empty());
+    REQUIRE(pool.Blocks().GetStats().retainedBuffers == 1);
+
+    VoxelBlocks b{};
+    b.Assign(dense, pool.WordSource());
+    REQUIRE(pool.Blocks().GetStats().hits == 1);
+
+    VoxelBlocks copy{};
+    copy.CopyFrom(b, pool.WordSource());
+    Vector<Voxel> out(VoxelBlocks::Volume);
+    copy.CopyTo(out);
+    REQUIRE(out == dense);
+
+    // Uniform chunks have no index storage to take or give back.
+    VoxelBlocks uniform{};
+    uniform.Fill(Voxel::Stone);
+    VoxelBlocks uniformCopy{};
+    uniformCopy.CopyFrom(uniform, pool.WordSource());
+    REQUIRE(uniformCopy.IsUniform());
+    REQUIRE(pool.Blocks().GetStats().misses == 2);
+}
+
+TEST_CASE("VoxelBufferPool takes back mesh buffers and trims when idle", "[VoxelBufferPool]") {
+    VoxelBufferPoolConfig config{};
+    config.idleFrames = 2;
+    VoxelBufferPool pool{config};
+
+    VoxelMesh mesh{};
+    mesh.cpuVertices = pool.Vertices().Acquire(4096);
+    mesh.cpuIndices = pool.Indices().Acquire(6144);
+    mesh.readyVertices = pool.Vertices().Acquire(1024);
+    pool.Recycle(mesh);
+    REQUIRE(mesh.cpuVertices.capacity() == 0);
+    REQUIRE(pool.GetStats().retainedBuffers == 3);
+
+    const USize retained{pool.GetStats().retainedBytes};
+    pool.Tick();   // sees the acquires above
+    pool.Tick();
+    REQUIRE(pool.GetStats().retainedBytes == retained);
+    pool.Tick();   // idle for two frames
+    REQUIRE(pool.GetStats().retainedBytes <= retained / 2);
+
+    pool.Trim();
+    REQUIRE(pool.GetStats().retainedBytes == 0);
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.Component;
+import Components.VoxelChunkIndex;
+import Math.Vector;
+import std;
+
+TEST_CASE("VoxelChunkIndex finds inserted chunks", "[VoxelChunkIndex]") {
+    VoxelChunkIndex index{};
+    index.Insert(0, 0, 0, EntityHandle{1, 1});
+    index.Insert(-1, 2, -3, EntityHandle{2, 1});
+
+    REQUIRE(index.Size() == 2u);
+    REQUIRE(index.Find(0, 0, 0) == EntityHandle{1, 1});
+    REQUIRE(index.Find(-1, 2, -3) == EntityHandle{2, 1});
+    REQUIRE_FALSE(index.Find(1, 0, 0).valid());
+
+    index.Insert(0, 0, 0, EntityHandle{3, 2});
+    REQUIRE(index.Size() == 2u);
+    REQUIRE(index.Find(0, 0, 0) == EntityHandle{3, 2});
+}
+
+TEST_CASE("VoxelChunkIndex keeps probe chains intact across erase and growth", "[VoxelChunkIndex]") {
+    VoxelChunkIndex index{};
+    auto handleFor = [](S32 x, S32 y, S32 z) {
+        return EntityHandle{static_cast<U16>(((x + 20) * 41 + (z + 20)) * 3 + (y + 1) + 1), 1};
+    };
+
+    for (S32 z{-20}; z <= 20; ++z)
+        for (S32 x{-20}; x <= 20; ++x)
+            for (S32 y{-1}; y <= 1; ++y) index.Insert(x, y, z, handleFor(x, y, z));
+    REQUIRE(index.Size() == 41u * 41u * 3u);
+    REQUIRE(index.Capacity() >= index.Size() * 2u);
+
+    for (S32 z{-20}; z <= 20; ++z)
+        for (S32 x{-20}; x <= 20; ++x)
+            if ((x + z) % 2 == 0) REQUIRE(index.Erase(x, 0, z));
+    REQUIRE_FALSE(index.Erase(100, 0, 100));
+
+    for (S32 z{-20}; z <= 20; ++z) {
+        for (S32 x{-20}; x <= 20; ++x) {
+            for (S32 y{-1}; y <= 1; ++y) {
+                const bool erased{y == 0 && (x + z) % 2 == 0};
+                REQUIRE(index.Find(x, y, z) == (erased ? EntityHandle{} : handleFor(x, y, z)));
+            }
+        }
+    }
+
+    index.Clear();
+    REQUIRE(index.Size() == 0u);
+    REQUIRE_FALSE(index.Find(0, 0, 0).valid());
+}
+
+TEST_CASE("UnpackChunkKey inverts PackChunkKey", "[VoxelChunkIndex]") {
+    constexpr S32 kMin{-(1 << 20)}, kMax{(1 << 20) - 1};
+    const S32 values[]{kMin, kMin + 1, -4097, -1, 0, 1, 4096, kMax - 1, kMax};
+    for (S32 x : values)
+        for (S32 y : values)
+            for (S32 z : values) REQUIRE(UnpackChunkKey(PackChunkKey(x, y, z)) == Math::IVec3{x, y, z});
+
+    // Distinct coordinates never share a key.
+    REQUIRE(PackChunkKey(kMin, 0, 0) != PackChunkKey(kMax, 0, 0));
+    REQUIRE(PackChunkKey(-1, 0, 0) != PackChunkKey(0, -1, 0));
+    REQUIRE(PackChunkKey(0, 0, -1) != PackChunkKey(0, -1, 0));
+}
@@ -0,0 +1,38 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Components.Voxel;
+import std;
+
+TEST_CASE("ChunkVertex round-trips every field", "[ChunkVertex]") {
+    ChunkVertexData in{32u, 0u, 17u, 5u, 32u, 31u, 255u};
+    ChunkVertexData out{UnpackChunkVertex(PackChunkVertex(in))};
+    REQUIRE(out == in);
+}
+
+TEST_CASE("ChunkVertex fields do not bleed into each other", "[ChunkVertex]") {
+    ChunkVertexData in{63u, 63u, 63u, 7u, 63u, 63u, 255u};
+    ChunkVertex packed{PackChunkVertex(in)};
+    REQUIRE(packed.lo == 0x1FFFFFu);
+    REQUIRE(packed.hi == 0xFFFFFu);
+
+    ChunkVertexData onlyTile{0u, 0u, 0u, 0u, 0u, 0u, 8u};
+    ChunkVertexData back{UnpackChunkVertex(PackChunkVertex(onlyTile))};
+    REQUIRE(back == onlyTile);
+}
+
+TEST_CASE("ChunkVertex is eight bytes", "[ChunkVertex]") {
+    STATIC_REQUIRE(sizeof(ChunkVertex) == 8u);
+    STATIC_REQUIRE(UnpackChunkVertex(PackChunkVertex(ChunkVertexData{1u, 2u, 3u, 4u, 5u, 6u, 7u})).tile == 7u);
+}
+
+TEST_CASE("ChunkVertex exhaustive position and face round-trip", "[ChunkVertex]") {
+    for (U32 x{}; x <= VoxelChunk::SizeX; ++x) {
+        for (U32 y{}; y <= VoxelChunk::SizeY; ++y) {
+            for (U32 face{}; face < 6u; ++face) {
+                ChunkVertexData in{x, y, (x + y) % 33u, face, y, x, (x * 7u + face) % 256u};
+                REQUIRE(UnpackChunkVertex(PackChunkVertex(in)) == in);
+            }
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Systems.VoxelColumnCache;
+import std;
+
+namespace {
+    auto FillWith(S32 value, std::atomic<U32>& calls) {
+        return [value, &calls](VoxelColumn& c) {
+            calls.fetch_add(1);
+            c.heights.fill(value);
+        };
+    }
+}
+
+TEST_CASE("VoxelColumnCache computes a column once and counts hits", "[VoxelColumnCache]") {
+    VoxelColumnCache cache{16};
+    std::atomic<U32> calls{0};
+
+    auto a{cache.GetOrCompute(3, -4, FillWith(7, calls))};
+    auto b{cache.GetOrCompute(3, -4, FillWith(9, calls))};
+    REQUIRE(calls.load() == 1u);
+    REQUIRE(a == b);
+    REQUIRE(b->heights[0] == 7);
+
+    auto stats{cache.GetStats()};
+    REQUIRE(stats.misses == 1u);
+    REQUIRE(stats.hits == 1u);
+    REQUIRE(stats.columns == 1u);
+}
+
+TEST_CASE("VoxelColumnCache makes concurrent jobs wait for the in-flight column", "[VoxelColumnCache]") {
+    VoxelColumnCache cache{16};
+    std::atomic<U32> calls{0};
+    auto slowFill = [&calls](VoxelColumn& c) {
+        calls.fetch_add(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        c.heights.fill(42);
+    };
+
+    Vector<std::thread> threads{};
+    std::array<S32, 8> seen{};
+    for (U32 i{}; i < seen.size(); ++i) {
+        threads.emplace_back([&, i]() { seen[i] = cache.GetOrCompute(0, 0, slowFill)->heights[5]; });
+    }
+    for (auto& t : threads) t.join();
+
+    REQUIRE(calls.load() == 1u);
+    for (S32 v : seen) REQUIRE(v == 42);
+    auto stats{cache.GetStats()};
+    REQUIRE(stats.misses == 1u);
+    REQUIRE(stats.hits + stats.misses == seen.size());
+}
+
+TEST_CASE("VoxelColumnCache evicts least recently used and out-of-range columns", "[VoxelColumnCache]") {
+    VoxelColumnCache cache{2};
+    std::atomic<U32> calls{0};
+
+    cache.GetOrCompute(0, 0, FillWith(0, calls));
+    cache.GetOrCompute(1, 0, FillWith(1, calls));
+    cache.GetOrCompute(0, 0, FillWith(0, calls));
+    cache.GetOrCompute(2, 0, FillWith(2, calls));
+    REQUIRE(cache.GetStats().columns == 2u);
+
+    // (1, 0) was the least recently used one.
+    cache.GetOrCompute(0, 0, FillWith(0, calls));
+    REQUIRE(calls.load() == 3u);
+    cache.GetOrCompute(1, 0, FillWith(1, calls));
+    REQUIRE(calls.load() == 4u);
+
+    cache.EvictOutside(-5, 0, 5);
+    REQUIRE(cache.GetStats().columns == 1u);
+    cache.GetOrCompute(1, 0, FillWith(1, calls));
+    REQUIRE(calls.load() == 5u);
+}
+
+TEST_CASE("VoxelColumnCache passes a failed fill to its waiters and retries later", "[VoxelColumnCache]") {
+    VoxelColumnCache cache{16};
+    std::atomic<U32> calls{0};
+    std::atomic<bool> release{false};
+    auto failingFill = [&](VoxelColumn&) {
+        calls.fetch_add(1);
+        while (!release.load()) std::this_thread::yield();
+        throw std::runtime_error{"generation failed"};
+    };
+
+    constexpr U32 kWaiters{3};
+    std::atomic<U32> failures{0};
+    Vector<std::thread> threads{};
+    threads.emplace_back([&]() {
+        try { cache.GetOrCompute(1, 1, failingFill); } catch (std::runtime_error const&) { failures.fetch_add(1); }
+    });
+    while (calls.load() == 0) std::this_thread::yield();
+    for (U32 i{}; i < kWaiters; ++i) {
+        threads.emplace_back([&]() {
+            try { cache.GetOrCompute(1, 1, failingFill); } catch (std::runtime_error const&) { failures.fetch_add(1); }
+        });
+    }
+    while (cache.GetStats().waits < kWaiters) std::this_thread::yield();
+    release.store(true);
+    for (auto& t : threads) t.join();
+
+    REQUIRE(calls.load() == 1u);
+    REQUIRE(failures.load() == kWaiters + 1);
+    REQUIRE(cache.GetStats().columns == 0u);
+
+    auto column{cache.GetOrCompute(1, 1, FillWith(3, calls))};
+    REQUIRE(calls.load() == 2u);
+    REQUIRE(column->heights[0] == 3);
+}
+
+TEST_CASE("VoxelColumnCache keeps in-flight columns through eviction and trimming", "[VoxelColumnCache]") {
+    VoxelColumnCache cache{1};
+    std::atomic<U32> calls{0};
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    auto slowFill = [&](VoxelColumn& c) {
+        calls.fetch_add(1);
+        started.store(true);
+        while (!release.load()) std::this_thread::yield();
+        c.heights.fill(11);
+    };
+
+    VoxelColumnCache::ColumnPtr slow{};
+    std::thread filler{[&]() { slow = cache.GetOrCompute(0, 0, slowFill); }};
+    while (!started.load()) std::this_thread::yield();
+
+    cache.Evict(0, 0);
+    cache.EvictOutside(100, 100, 1);
+    cache.Clear();
+    cache.GetOrCompute(5, 5, FillWith(5, calls));
+    cache.GetOrCompute(6, 6, FillWith(6, calls));
+    release.store(true);
+    filler.join();
+
+    REQUIRE(slow->heights[0] == 11);
+    auto stats{cache.GetStats()};
+    REQUIRE(stats.columns == 1u);
+    REQUIRE(stats.evictions == 2u);
+
+    // The finished column is the only one left and is served without refilling.
+    auto again{cache.GetOrCompute(0, 0, FillWith(0, calls))};
+    REQUIRE(again == slow);
+    REQUIRE(calls.load() == 3u);
+}
@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.Component;
+import ECS.World;
+import Components.Voxel;
+import Components.VoxelChunkIndex;
+import Systems.VoxelEditBatch;
+import Math.Vector;
+import std;
+
+namespace {
+    // 2x1x1 chunks at (0,0,0) and (1,0,0), plus an untouched neighbour above the first one.
+    struct EditWorld {
+        World world{};
+        EntityHandle a{}, b{}, above{};
+
+        EditWorld() {
+            auto indexEntity{world.CreateEntity()};
+            world.AddComponent(indexEntity, VoxelChunkIndex{});
+            a = AddChunk(0, 0, 0);
+            b = AddChunk(1, 0, 0);
+            above = AddChunk(0, 1, 0);
+        }
+
+        EntityHandle AddChunk(S32 cx, S32 cy, S32 cz) {
+            auto e{world.CreateEntity()};
+            VoxelChunk chunk{};
+            chunk.cx = static_cast<U32>(cx);
+            chunk.cy = static_cast<U32>(cy);
+            chunk.cz = static_cast<U32>(cz);
+            chunk.blocks.Fill(Voxel::Stone);
+            chunk.dirty = false;
+            world.AddComponent(e, std::move(chunk));
+            FindVoxelChunkIndex(&world)->Insert(cx, cy, cz, e);
+            return e;
+        }
+
+        VoxelChunk& Chunk(EntityHandle e) { return *world.GetComponent<VoxelChunk>(e); }
+
+        Voxel At(S32 gx, S32 gy, S32 gz) {
+            const S32 cx{gx >= 32 ? 1 : 0};
+            VoxelChunk const& c{Chunk(cx == 1 ? b : (gy >= 32 ? above : a))};
+            return c.blocks.Get(VoxelIndex(static_cast<U32>(gx - cx * 32), static_cast<U32>(gy % 32), static_cast<U32>(gz)));
+        }
+
+        void ResetDirty() {
+            for (auto e : {a, b, above}) {
+                Chunk(e).dirty = false;
+                Chunk(e).edited = {};
+            }
+        }
+    };
+}
+
+TEST_CASE("VoxelEditBatch fills shapes across chunks and records only real changes", "[VoxelEditBatch]") {
+    EditWorld w{};
+
+    VoxelEditBatch batch{};
+    batch.FillBox(Math::IVec3{30, 4, 4}, Math::IVec3{33, 5, 5}, Voxel::Air);
+    batch.FillSphere(Math::IVec3{10, 10, 10}, 2.0f, Voxel::Dirt);
+    batch.Set(Math::IVec3{20, 20, 20}, Voxel::Stone);   // already stone: no change
+    const VoxelEditRecord record{batch.Apply(&w.world)};
+
+    REQUIRE(record.chunks.size() == 2);
+    REQUIRE(record.voxels == 4 * 2 * 2 + 33);
+    REQUIRE(w.At(30, 4, 4) == Voxel::Air);
+    REQUIRE(w.At(33, 5, 5) == Voxel::Air);
+    REQUIRE(w.At(34, 5, 5) == Voxel::Stone);
+    REQUIRE(w.At(10, 12, 10) == Voxel::Dirt);
+    REQUIRE(w.At(11, 12, 10) == Voxel::Stone);
+    REQUIRE(w.Chunk(w.a).modified);
+    REQUIRE(w.Chunk(w.a).edited.maxX == 31);
+    REQUIRE(w.Chunk(w.b).edited.minX == 0);
+    REQUIRE(w.Chunk(w.b).edited.maxX == 1);
+    // Nothing touched the top face of chunk a.
+    REQUIRE_FALSE(w.Chunk(w.above).dirty);
+}
+
+TEST_CASE("VoxelEditBatch marks only neighbours across touched faces", "[VoxelEditBatch]") {
+    EditWorld w{};
+
+    VoxelEditBatch interior{};
+    interior.Set(Math::IVec3{5, 5, 5}, Voxel::Air);
+    interior.Apply(&w.world);
+    REQUIRE(w.Chunk(w.a).dirty);
+    REQUIRE_FALSE(w.Chunk(w.b).dirty);
+    REQUIRE_FALSE(w.Chunk(w.above).dirty);
+
+    w.ResetDirty();
+    VoxelEditBatch top{};
+    top.Line(Math::IVec3{0, 31, 0}, Math::IVec3{10, 31, 3}, Voxel::Air);
+    const VoxelEditRecord record{top.Apply(&w.world)};
+    REQUIRE(record.voxels == 11);
+    REQUIRE(w.Chunk(w.above).dirty);
+    REQUIRE_FALSE(w.Chunk(w.b).dirty);
+    // The neighbour's stale region is its bottom layer under the line.
+    VoxelEditBox const& stale{w.Chunk(w.above).edited};
+    REQUIRE(stale.minY == 0);
+    REQUIRE(stale.maxY == 0);
+    REQUIRE(stale.minX == 0);
+    REQUIRE(stale.maxX == 10);
+    REQUIRE(stale.minZ == 0);
+    REQUIRE(stale.maxZ == 3);
+    REQUIRE(w.Chunk(w.b).edited.Empty());
+}
+
+TEST_CASE("VoxelEditBatch copies and pastes regions", "[VoxelEditBatch]") {
+    EditWorld w{};
+    VoxelEditBatch carve{};
+    carve.Set(Math::IVec3{1, 1, 1}, Voxel::Log);
+    carve.Set(Math::IVec3{2, 1, 1}, Voxel::Air);
+    carve.Apply(&w.world);
+
+    VoxelClipboard clip{CopyVoxelRegion(&w.world, Math::IVec3{2, 1, 1}, Math::IVec3{1, 1, 1})};
+    REQUIRE(clip.sizeX == 2);
+    REQUIRE(clip.At(0, 0, 0) == Voxel::Log);
+    REQUIRE(clip.At(1, 0, 0) == Voxel::Air);
+
+    VoxelEditBatch paste{};
+    paste.Paste(clip, Math::IVec3{40, 1, 1});
+    paste.Apply(&w.world);
+    REQUIRE(w.At(40, 1, 1) == Voxel::Log);
+    REQUIRE(w.At(41, 1, 1) == Voxel::Stone);   // Air is skipped by default
+}
+
+TEST_CASE("VoxelEditJournal undoes and redoes records", "[VoxelEditBatch]") {
+    EditWorld w{};
+    VoxelEditJournal journal{};
+
+    VoxelEditBatch first{};
+    first.FillBox(Math::IVec3{0, 0, 0}, Math::IVec3{40, 3, 3}, Voxel::Sand);
+    journal.Push(first.Apply(&w.world));
+    VoxelEditBatch second{};
+    second.Set(Math::IVec3{1, 1, 1}, Voxel::Water);
+    journal.Push(second.Apply(&w.world));
+    REQUIRE(w.At(1, 1, 1) == Voxel::Water);
+
+    REQUIRE(journal.Undo(&w.world));
+    REQUIRE(w.At(1, 1, 1) == Voxel::Sand);
+    REQUIRE(journal.Undo(&w.world));
+    REQUIRE(w.At(1, 1, 1) == Voxel::Stone);
+    REQUIRE(w.At(40, 3, 3) == Voxel::Stone);
+    REQUIRE_FALSE(journal.Undo(&w.world));
+
+    REQUIRE(journal.Redo(&w.world));
+    REQUIRE(w.At(40, 3, 3) == Voxel::Sand);
+    REQUIRE(journal.CanRedo());
+
+    // A new edit drops the redo branch.
+    VoxelEditBatch third{};
+    third.Set(Math::IVec3{5, 5, 5}, Voxel::Leaves);
+    journal.Push(third.Apply(&w.world));
+    REQUIRE_FALSE(journal.CanRedo());
+    REQUIRE(journal.MemoryUsage() > 0);
+}
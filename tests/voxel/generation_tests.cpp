@@ -0,0 +1,70 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.World;
+import Components.Voxel;
+import Components.VoxelStreaming;
+import Systems.VoxelColumnCache;
+import Systems.VoxelGeneration;
+import std;
+
+TEST_CASE("GenerateVoxelChunk is deterministic and follows the column heights", "[VoxelGeneration]") {
+    for (auto [cx, cz] : {std::pair{0, 0}, std::pair{-3, 5}, std::pair{17, -9}}) {
+        VoxelColumn column{};
+        GenerateVoxelColumn(cx, cz, 1.0f, column);
+
+        VoxelColumn again{};
+        GenerateVoxelColumn(cx, cz, 1.0f, again);
+        REQUIRE(column.heights == again.heights);
+        REQUIRE(column.biomes == again.biomes);
+
+        for (S32 cy{-1}; cy <= 1; ++cy) {
+            const VoxelBlocks a{GenerateVoxelChunk(cx, cy, cz, 1.0f, column)};
+            const VoxelBlocks b{GenerateVoxelChunk(cx, cy, cz, 1.0f, column)};
+            U32 mismatches{};
+            for (U32 i{}; i < VoxelBlocks::Volume; ++i) mismatches += a.Get(i) != b.Get(i) ? 1u : 0u;
+            REQUIRE(mismatches == 0);
+
+            // Below the surface layers it is always stone, whatever vegetation grows on top.
+            for (U32 z{}; z < VoxelChunk::SizeZ; z += 5) {
+                for (U32 x{}; x < VoxelChunk::SizeX; x += 5) {
+                    const S32 height{column.heights[x + z * VoxelChunk::SizeX]};
+                    const S32 y{height - 4 - cy * static_cast<S32>(VoxelChunk::SizeY)};
+                    if (y < 0 || y >= static_cast<S32>(VoxelChunk::SizeY)) continue;
+                    REQUIRE(a.Get(VoxelIndex(x, static_cast<U32>(y), z)) == Voxel::Stone);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("VoxelGeneratorKey changes with the terrain a config generates", "[VoxelGeneration]") {
+    VoxelWorldConfig a{};
+    VoxelWorldConfig b{};
+    b.chunksX = a.chunksX + 4;
+    REQUIRE(VoxelGeneratorKey(a) == VoxelGeneratorKey(b));
+
+    b.blockSize = a.blockSize * 0.5f;
+    REQUIRE(VoxelGeneratorKey(a) != VoxelGeneratorKey(b));
+}
+
+TEST_CASE("Each VoxelGenerationSystem runs its own workers", "[VoxelGeneration]") {
+    // A second World, with a second system, must still generate after the first is gone.
+    for (U32 round{}; round < 2; ++round) {
+        World world{};
+        world.AddComponent(world.CreateEntity(), VoxelWorldConfig{});
+        world.AddComponent(world.CreateEntity(), VoxelStreamingConfig{});
+        const EntityHandle e{world.CreateEntity()};
+        world.AddComponent(e, VoxelChunk{});
+
+        VoxelGenerationSystem generation{};
+        generation.Setup();
+        const auto deadline{std::chrono::steady_clock::now() + std::chrono::seconds{10}};
+        while (world.GetComponent<VoxelChunk>(e)->blocks.Empty() && std::chrono::steady_clock::now() < deadline) {
+            generation.Run(&world, 1.0f / 60.0f);
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        REQUIRE_FALSE(world.GetComponent<VoxelChunk>(e)->blocks.Empty());
+        REQUIRE_FALSE(world.GetComponent<VoxelChunk>(e)->generating);
+    }
+}
@@ -0,0 +1,101 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+#include <cstring>
+
+import Core.Types;
+import Components.Voxel;
+import Systems.VoxelMesher;
+import std;
+
+namespace {
+    VoxelBlocks MakeTerrain(U32 seed, S32 baseHeight) {
+        std::mt19937 rng{seed};
+        Vector<Voxel> dense(VoxelBlocks::Volume, Voxel::Air);
+        for (U32 z{}; z < VoxelChunk::SizeZ; ++z) {
+            for (U32 x{}; x < VoxelChunk::SizeX; ++x) {
+                S32 height{baseHeight + static_cast<S32>(rng() % 6u)};
+                for (S32 y{}; y < std::min(height, static_cast<S32>(VoxelChunk::SizeY)); ++y) {
+                    Voxel v{y == height - 1 ? Voxel::Grass : (y < height - 3 ? Voxel::Stone : Voxel::Dirt)};
+                    dense[VoxelIndex(x, static_cast<U32>(y), z)] = v;
+                }
+            }
+        }
+        VoxelBlocks blocks{};
+        blocks.Assign(dense);
+        return blocks;
+    }
+
+    VoxelBlocks MakeNoise(U32 seed, U32 materials) {
+        std::mt19937 rng{seed};
+        Vector<Voxel> dense(VoxelBlocks::Volume);
+        for (auto& v : dense) v = static_cast<Voxel>(rng() % materials);
+        VoxelBlocks blocks{};
+        blocks.Assign(dense);
+        return blocks;
+    }
+
+    bool SameMesh(VoxelMeshBuffers const& a, VoxelMeshBuffers const& b) {
+        return a.vertices.size() == b.vertices.size() && a.indices == b.indices
+            && std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(ChunkVertex)) == 0;
+    }
+}
+
+TEST_CASE("Binary mesher matches greedy mesher on terrain", "[Mesher]") {
+    VoxelBlocks center{MakeTerrain(1u, 12)};
+    VoxelBlocks below{};
+    below.Fill(Voxel::Stone);
+    VoxelBlocks side{MakeTerrain(2u, 10)};
+
+    VoxelMeshInput in{};
+    in.center = &center;
+    in.neighbors[NeighborNY] = &below;
+    in.neighbors[NeighborPX] = &side;
+
+    VoxelMeshBuffers greedy{}, binary{};
+    MeshChunk(VoxelMesherKind::Greedy, in, greedy);
+    MeshChunk(VoxelMesherKind::Binary, in, binary);
+
+    REQUIRE(!greedy.vertices.empty());
+    REQUIRE(SameMesh(greedy, binary));
+}
+
+TEST_CASE("Binary mesher matches greedy mesher on noisy chunks", "[Mesher]") {
+    for (U32 seed{}; seed < 4u; ++seed) {
+        VoxelBlocks center{MakeNoise(seed, 2u + seed * 2u)};
+        std::array<VoxelBlocks, NeighborCount> neighbors{};
+        VoxelMeshInput in{};
+        in.center = &center;
+        for (U32 n{}; n < NeighborCount; ++n) {
+            neighbors[n] = MakeNoise(seed * 31u + n, 3u);
+            if ((n + seed) % 3u != 0u) in.neighbors[n] = &neighbors[n];
+        }
+
+        VoxelMeshBuffers greedy{}, binary{};
+        MeshChunk(VoxelMesherKind::Greedy, in, greedy);
+        MeshChunk(VoxelMesherKind::Binary, in, binary);
+
+        REQUIRE(SameMesh(greedy, binary));
+    }
+}
+
+TEST_CASE("Air chunks produce no geometry", "[Mesher]") {
+    VoxelBlocks air{};
+    air.Fill(Voxel::Air);
+    VoxelBlocks stone{};
+    stone.Fill(Voxel::Stone);
+
+    VoxelMeshInput in{};
+    in.center = &air;
+    in.neighbors[NeighborNX] = &stone;
+
+    VoxelMeshBuffers out{};
+    MeshChunk(VoxelMesherKind::Binary, in, out);
+    REQUIRE(out.vertices.empty());
+    REQUIRE(out.indices.empty());
+
+    in.center = &stone;
+    in.neighbors[NeighborNX] = nullptr;
+    MeshChunk(VoxelMesherKind::Binary, in, out);
+    REQUIRE(out.vertices.size() == 6u * 4u);
+    REQUIRE(out.indices.size() == 6u * 6u);
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Systems.VoxelNoise;
+import std;
+
+namespace {
+    Vector<NoiseKernel> SupportedKernels() {
+        Vector<NoiseKernel> kernels{};
+        for (NoiseKernel k : {NoiseKernel::Scalar, NoiseKernel::SSE41, NoiseKernel::AVX2}) {
+            if (noise::IsKernelSupported(k)) kernels.push_back(k);
+        }
+        return kernels;
+    }
+
+    // 32-wide rows like the generator uses, plus an odd width to exercise the scalar tail.
+    Vector<F32> MakeRow(F32 x0, F32 step, U32 count) {
+        Vector<F32> xs(count);
+        for (U32 i{}; i < count; ++i) xs[i] = x0 + static_cast<F32>(i) * step;
+        return xs;
+    }
+}
+
+TEST_CASE("Noise row kernels match the scalar path bit for bit", "[VoxelNoise]") {
+    const F32 starts[]{0.0f, -32.0f, 1234.5f, -98765.0f, 40000.0f};
+    const F32 zs[]{0.0f, -1.0f, 17.25f, -4096.0f, 65535.0f};
+    const U32 widths[]{32u, 13u};
+
+    for (NoiseKernel kernel : SupportedKernels()) {
+        for (F32 x0 : starts) {
+            for (F32 z : zs) {
+                for (U32 width : widths) {
+                    Vector<F32> xs{MakeRow(x0, 1.0f, width)};
+                    Vector<F32> biome(width), terrain(width);
+                    noise::BiomeValueRow(kernel, xs, z, biome);
+                    noise::TerrainNoiseRow(kernel, xs, z, terrain);
+
+                    for (U32 i{}; i < width; ++i) {
+                        INFO("kernel " << static_cast<U32>(kernel) << " x " << xs[i] << " z " << z);
+                        REQUIRE(std::bit_cast<U32>(biome[i]) == std::bit_cast<U32>(noise::biomeValue(xs[i], z)));
+                        REQUIRE(std::bit_cast<U32>(terrain[i]) == std::bit_cast<U32>(noise::terrainNoise(xs[i], z)));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Noise kernel selection defaults to a supported kernel", "[VoxelNoise]") {
+    const NoiseKernel active{noise::ActiveKernel()};
+    REQUIRE(noise::IsKernelSupported(active));
+
+    noise::SetKernel(NoiseKernel::Scalar);
+    REQUIRE(noise::ActiveKernel() == NoiseKernel::Scalar);
+    noise::SetKernel(active);
+}
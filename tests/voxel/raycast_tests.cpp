@@ -0,0 +1,291 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.Component;
+import ECS.World;
+import Components.Voxel;
+import Components.VoxelChunkIndex;
+import Systems.VoxelRaycast;
+import Tasks.TaskGraph;
+import Math.Vector;
+import std;
+
+namespace {
+    constexpr S32 kN{32};
+
+    // 3x2x3 chunks, mostly sparse: one chunk is left all Air, one ungenerated, one solid.
+    struct RayWorld {
+        World world{};
+
+        RayWorld() {
+            auto cfgEntity{world.CreateEntity()};
+            world.AddComponent(cfgEntity, VoxelWorldConfig{3, 2, 3, 1.0f});
+            auto indexEntity{world.CreateEntity()};
+            world.AddComponent(indexEntity, VoxelChunkIndex{});
+
+            std::mt19937 rng{1234};
+            std::uniform_int_distribution<U32> coord{0, kN - 1};
+            for (S32 cz{}; cz < 3; ++cz) {
+                for (S32 cy{}; cy < 2; ++cy) {
+                    for (S32 cx{}; cx < 3; ++cx) {
+                        VoxelChunk chunk{};
+                        chunk.cx = static_cast<U32>(cx);
+                        chunk.cy = static_cast<U32>(cy);
+                        chunk.cz = static_cast<U32>(cz);
+                        const S32 id{cx + 3 * (cy + 2 * cz)};
+                        if (id != 4) chunk.blocks.Fill(id == 7 ? Voxel::Stone : Voxel::Air);
+                        if (id != 4 && id != 7 && id != 10) {
+                            for (U32 i{}; i < 60; ++i) {
+                                chunk.blocks.Set(VoxelIndex(coord(rng), coord(rng), coord(rng)), Voxel::Dirt);
+                            }
+                        }
+                        auto e{world.CreateEntity()};
+                        world.AddComponent(e, std::move(chunk));
+                        FindVoxelChunkIndex(&world)->Insert(cx, cy, cz, e);
+                    }
+                }
+            }
+        }
+    };
+
+    // The single-ray walk RaycastVoxelDDA replaced, copied verbatim apart from the chunk
+    // accessors: a linear chunk scan and an accumulate-and-divide DDA stepping voxel by voxel.
+    S32 FloorDiv(S32 a, S32 b) {
+        return static_cast<S32>(std::floor(static_cast<F32>(a) / static_cast<F32>(b)));
+    }
+
+    bool FetchChunk(World* w, S32 cx, S32 cy, S32 cz, VoxelChunk*& out) {
+        out = nullptr;
+        if (auto* s = w->GetStorage<VoxelChunk>()) {
+            for (auto [h,c] : *s) {
+                if (static_cast<S32>(c.cx)==cx && static_cast<S32>(c.cy)==cy && static_cast<S32>(c.cz)==cz) {
+                    out = const_cast<VoxelChunk*>(&c);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool GetVoxel(World* w, S32 gx, S32 gy, S32 gz, Voxel& out) {
+        S32 cx{FloorDiv(gx, kN)}, cy{FloorDiv(gy, kN)}, cz{FloorDiv(gz, kN)};
+        S32 lx{gx - cx*kN}, ly{gy - cy*kN}, lz{gz - cz*kN};
+        VoxelChunk* ch{};
+        if (!FetchChunk(w, cx, cy, cz, ch)) return false;
+        if (ch->blocks.Empty()) return false;
+        out = ch->blocks.Get(VoxelIndex(static_cast<U32>(lx), static_cast<U32>(ly), static_cast<U32>(lz)));
+        return true;
+    }
+
+    VoxelRayHit ReferenceRaycast(World* world, Math::Vec3 origin, Math::Vec3 dir, F32 maxDist) {
+        VoxelRayHit hit{};
+        const F32 bs{1.0f};
+
+        Math::Vec3 rd{dir.Normalized()};
+        const F32 eps{1e-6f};
+        const F32 inf{1e30f};
+
+        auto wx = static_cast<F32>(std::floor(origin.x / bs));
+        auto wy = static_cast<F32>(std::floor(origin.y / bs));
+        auto wz = static_cast<F32>(std::floor(origin.z / bs));
+        S32 gx{static_cast<S32>(wx)}, gy{static_cast<S32>(wy)}, gz{static_cast<S32>(wz)};
+
+        S32 stepx{rd.x>0.0f?1:-1}, stepy{rd.y>0.0f?1:-1}, stepz{rd.z>0.0f?1:-1};
+
+        auto nextBoundary = [&](F32 o, F32 d, S32 g, S32 s)->F32 {
+            F32 nb = (static_cast<F32>(g + (s>0?1:0)) * bs - o) / (std::abs(d)<eps? (s>0?+eps:-eps) : d);
+            return nb < 0.0f ? 0.0f : nb;
+        };
+        auto delta = [&](F32 d)->F32 { return std::abs(d)<eps ? inf : (bs / std::abs(d)); };
+
+        F32 tMaxX{nextBoundary(origin.x, rd.x, gx, stepx)};
+        F32 tMaxY{nextBoundary(origin.y, rd.y, gy, stepy)};
+        F32 tMaxZ{nextBoundary(origin.z, rd.z, gz, stepz)};
+        F32 tDeltaX{delta(rd.x)}, tDeltaY{delta(rd.y)}, tDeltaZ{delta(rd.z)};
+
+        S32 px{gx}, py{gy}, pz{gz};
+        for (;;) {
+            Voxel v{};
+            if (GetVoxel(world, gx, gy, gz, v) && v != Voxel::Air) {
+                hit.hit = true;
+                hit.gx = gx; hit.gy = gy; hit.gz = gz;
+                hit.pgx = px; hit.pgy = py; hit.pgz = pz;
+                hit.t = std::min({tMaxX, tMaxY, tMaxZ});
+                if (tMaxX <= tMaxY && tMaxX <= tMaxZ) hit.normal = Math::Vec3{static_cast<F32>(-stepx),0.0f,0.0f};
+                else if (tMaxY <= tMaxZ) hit.normal = Math::Vec3{0.0f,static_cast<F32>(-stepy),0.0f};
+                else hit.normal = Math::Vec3{0.0f,0.0f,static_cast<F32>(-stepz)};
+                return hit;
+            }
+
+            if (tMaxX < tMaxY) {
+                if (tMaxX < tMaxZ) {
+                    px=gx; py=gy; pz=gz; gx += stepx; hit.t = tMaxX; tMaxX += tDeltaX;
+                } else {
+                    px=gx; py=gy; pz=gz; gz += stepz; hit.t = tMaxZ; tMaxZ += tDeltaZ;
+                }
+            } else {
+                if (tMaxY < tMaxZ) {
+                    px=gx; py=gy; pz=gz; gy += stepy; hit.t = tMaxY; tMaxY += tDeltaY;
+                } else {
+                    px=gx; py=gy; pz=gz; gz += stepz; hit.t = tMaxZ; tMaxZ += tDeltaZ;
+                }
+            }
+
+            if (hit.t > maxDist) return VoxelRayHit{};
+        }
+    }
+
+    Vector<VoxelRay> RandomRays(U32 count) {
+        std::mt19937 rng{42};
+        std::uniform_real_distribution<F32> pos{-10.0f, 106.0f};
+        std::uniform_real_distribution<F32> dir{-1.0f, 1.0f};
+        Vector<VoxelRay> rays{};
+        for (U32 i{}; i < count; ++i) {
+            Math::Vec3 d{dir(rng), dir(rng), dir(rng)};
+            // A few axis-aligned rays exercise the zero-direction paths.
+            if (i % 17 == 0) d = Math::Vec3{0.0f, 0.0f, i % 2 ? 1.0f : -1.0f};
+            if (d.Length() < 1e-3f) d = Math::Vec3{1.0f, 0.0f, 0.0f};
+            Math::Vec3 o{pos(rng), pos(rng) * 0.6f, pos(rng)};
+            // Diagonals from cell centres cross boundaries on several axes at once, which
+            // exercises the tie order.
+            if (i % 13 == 0) {
+                o = Math::Vec3{std::floor(o.x) + 0.5f, std::floor(o.y) + 0.5f, std::floor(o.z) + 0.5f};
+                d = Math::Vec3{i % 2 ? 1.0f : -1.0f, i % 3 ? 1.0f : -1.0f, i % 5 == 0 ? 0.0f : (i % 4 ? 1.0f : -1.0f)};
+            }
+            rays.push_back(VoxelRay{o, d, 120.0f});
+        }
+        return rays;
+    }
+
+    bool SameHit(VoxelRayHit const& a, VoxelRayHit const& b) {
+        return a.hit == b.hit && a.gx == b.gx && a.gy == b.gy && a.gz == b.gz
+            && a.pgx == b.pgx && a.pgy == b.pgy && a.pgz == b.pgz && a.t == b.t
+            && a.normal.x == b.normal.x && a.normal.y == b.normal.y && a.normal.z == b.normal.z;
+    }
+}
+
+TEST_CASE("VoxelBlocks tracks brick and region occupancy", "[VoxelRaycast]") {
+    VoxelBlocks blocks{};
+    REQUIRE_FALSE(blocks.HasSolid());
+
+    blocks.Fill(Voxel::Air);
+    REQUIRE_FALSE(blocks.HasSolid());
+
+    blocks.Set(VoxelIndex(9, 17, 30), Voxel::Stone);
+    REQUIRE(blocks.HasSolid());
+    REQUIRE(blocks.RegionOccupied(8, 16, 24));
+    REQUIRE(blocks.BrickOccupied(8, 16, 28));
+    REQUIRE_FALSE(blocks.BrickOccupied(12, 16, 28));
+    REQUIRE_FALSE(blocks.RegionOccupied(0, 16, 24));
+
+    blocks.Set(VoxelIndex(10, 18, 31), Voxel::Dirt);
+    blocks.Set(VoxelIndex(9, 17, 30), Voxel::Air);
+    REQUIRE(blocks.BrickOccupied(8, 16, 28));
+    blocks.Set(VoxelIndex(10, 18, 31), Voxel::Air);
+    REQUIRE_FALSE(blocks.BrickOccupied(8, 16, 28));
+    REQUIRE_FALSE(blocks.HasSolid());
+
+    Vector<Voxel> dense(VoxelBlocks::Volume, Voxel::Air);
+    dense[VoxelIndex(31, 0, 0)] = Voxel::Grass;
+    blocks.Assign(dense);
+    REQUIRE(blocks.RegionOccupied(31, 0, 0));
+    REQUIRE_FALSE(blocks.RegionOccupied(0, 0, 0));
+
+    VoxelBlocks copy{};
+    copy.CopyFrom(blocks, [](USize) { return Vector<U64>{}; });
+    REQUIRE(copy.BrickOccupied(28, 0, 0));
+
+    blocks.Fill(Voxel::Stone);
+    REQUIRE(blocks.RegionOccupied(0, 0, 0));
+    REQUIRE(blocks.BrickOccupied(31, 31, 31));
+}
+
+TEST_CASE("RaycastVoxelDDA matches the baseline per-voxel walk", "[VoxelRaycast]") {
+    RayWorld w{};
+    const Vector<VoxelRay> rays{RandomRays(2000)};
+
+    U32 hits{0};
+    for (VoxelRay const& ray : rays) {
+        const VoxelRayHit expected{ReferenceRaycast(&w.world, ray.origin, ray.dir, ray.maxDist)};
+        const VoxelRayHit actual{RaycastVoxelDDA(&w.world, ray.origin, ray.dir, ray.maxDist)};
+        REQUIRE(SameHit(expected, actual));
+        if (actual.hit) ++hits;
+    }
+    // Both hits and misses are covered.
+    REQUIRE(hits > 100);
+    REQUIRE(hits < rays.size() - 100);
+}
+
+TEST_CASE("RaycastVoxelBatch matches single rays inline and across task workers", "[VoxelRaycast]") {
+    RayWorld w{};
+    const Vector<VoxelRay> rays{RandomRays(3000)};
+    Vector<VoxelRayHit> expected{};
+    for (VoxelRay const& ray : rays) expected.push_back(RaycastVoxelDDA(&w.world, ray.origin, ray.dir, ray.maxDist));
+
+    Vector<VoxelRayHit> inlineHits(rays.size());
+    RaycastVoxelBatch(&w.world, rays, inlineHits);
+
+    Vector<VoxelRayHit> taskHits(rays.size());
+    TaskGraph graph{4};
+    graph.SetProfilingEnabled(false);
+    TaskPhase* phase{graph.CreatePhase("Rays")};
+    phase->AddTask("batch", [&]() { RaycastVoxelBatch(&w.world, rays, taskHits); });
+    graph.Execute();
+
+    for (USize i{}; i < rays.size(); ++i) {
+        REQUIRE(SameHit(expected[i], inlineHits[i]));
+        REQUIRE(SameHit(expected[i], taskHits[i]));
+    }
+}
+
+TEST_CASE("RaycastVoxelDDA jumps through long stretches of empty space", "[VoxelRaycast]") {
+    // A row of 16 chunks along X with gaps where chunks are not loaded; only the last one and
+    // a single brick in the middle hold anything.
+    World world{};
+    world.AddComponent(world.CreateEntity(), VoxelWorldConfig{16, 1, 1, 1.0f});
+    world.AddComponent(world.CreateEntity(), VoxelChunkIndex{});
+    for (S32 cx{}; cx < 16; ++cx) {
+        if (cx % 3 == 1) continue;
+        VoxelChunk chunk{};
+        chunk.cx = static_cast<U32>(cx);
+        chunk.blocks.Fill(Voxel::Air);
+        if (cx == 15) {
+            for (U32 y{}; y < kN; ++y) {
+                for (U32 z{}; z < kN; ++z) chunk.blocks.Set(VoxelIndex(20, y, z), Voxel::Stone);
+            }
+        }
+        if (cx == 6) chunk.blocks.Set(VoxelIndex(13, 9, 22), Voxel::Dirt);
+        auto e{world.CreateEntity()};
+        world.AddComponent(e, std::move(chunk));
+        FindVoxelChunkIndex(&world)->Insert(cx, 0, 0, e);
+    }
+
+    const Math::Vec3 start{-40.5f, 16.5f, 16.5f};
+    const VoxelRayHit wall{RaycastVoxelDDA(&world, start, Math::Vec3{1.0f, 0.0f, 0.0f}, 1000.0f)};
+    REQUIRE(wall.hit);
+    REQUIRE(wall.gx == 15 * kN + 20);
+    REQUIRE(wall.pgx == 15 * kN + 19);
+    REQUIRE(wall.normal.x == -1.0f);
+    REQUIRE(SameHit(wall, ReferenceRaycast(&world, start, Math::Vec3{1.0f, 0.0f, 0.0f}, 1000.0f)));
+
+    // Slanted rays from far outside, including ones that clip the lone voxel's brick.
+    std::mt19937 rng{7};
+    std::uniform_real_distribution<F32> yz{0.0f, 32.0f};
+    std::uniform_real_distribution<F32> slope{-0.06f, 0.06f};
+    U32 hits{};
+    for (U32 i{}; i < 500; ++i) {
+        const Math::Vec3 origin{-60.0f + yz(rng), yz(rng), yz(rng)};
+        Math::Vec3 dir{1.0f, slope(rng), slope(rng)};
+        if (i % 5 == 0) dir = Math::Vec3{(6.0f * kN + 13.5f) - origin.x, 9.5f - origin.y, 22.5f - origin.z};
+        const F32 maxDist{i % 7 == 0 ? 300.0f : 800.0f};
+        const VoxelRayHit expected{ReferenceRaycast(&world, origin, dir, maxDist)};
+        const VoxelRayHit actual{RaycastVoxelDDA(&world, origin, dir, maxDist)};
+        REQUIRE(SameHit(expected, actual));
+        if (actual.hit) ++hits;
+    }
+    REQUIRE(hits > 100);
+    REQUIRE(hits < 500);
+
+    // Backwards through the same row ends in the void.
+    REQUIRE_FALSE(RaycastVoxelDDA(&world, Math::Vec3{15.0f * kN + 10.5f, 3.5f, 3.5f}, Math::Vec3{-1.0f, 0.01f, 0.0f}, 1000.0f).hit);
+}
@@ -0,0 +1,196 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import Components.Voxel;
+import Systems.VoxelRegionStore;
+import std;
+
+namespace {
+    std::filesystem::path FreshDir(std::string_view name) {
+        auto dir{std::filesystem::temp_directory_path() / "voksel_tests" / name};
+        std::filesystem::remove_all(dir);
+        return dir;
+    }
+
+    VoxelBlocks MakeChunk(U32 seed) {
+        Vector<Voxel> dense(VoxelBlocks::Volume, Voxel::Air);
+        for (U32 z{}; z < VoxelChunk::SizeZ; ++z) {
+            for (U32 x{}; x < VoxelChunk::SizeX; ++x) {
+                const U32 h{(x * 7u + z * 13u + seed) % VoxelChunk::SizeY};
+                for (U32 y{}; y < h; ++y) {
+                    dense[VoxelIndex(x, y, z)] = y + 1 == h ? Voxel::Grass : (y + 4 < h ? Voxel::Stone : Voxel::Dirt);
+                }
+            }
+        }
+        VoxelBlocks blocks{};
+        blocks.Assign(dense);
+        return blocks;
+    }
+
+    bool SameBlocks(VoxelBlocks const& a, VoxelBlocks const& b) {
+        for (U32 i{}; i < VoxelBlocks::Volume; ++i) {
+            if (a.Get(i) != b.Get(i)) return false;
+        }
+        return true;
+    }
+
+    std::filesystem::path RegionPath(std::filesystem::path const& dir, S32 cx, S32 cy, S32 cz) {
+        auto [rx, ry, rz]{VoxelRegionStore::RegionOf(cx, cy, cz)};
+        return dir / VoxelRegionStore::RegionFileName(rx, ry, rz);
+    }
+}
+
+TEST_CASE("Chunk payloads round-trip through the run-length encoding", "[VoxelRegionStore]") {
+    VoxelBlocks mixed{MakeChunk(3)};
+    VoxelBlocks decoded{};
+    REQUIRE(DecodeChunkPayload(EncodeChunkPayload(mixed), decoded));
+    REQUIRE(SameBlocks(mixed, decoded));
+
+    VoxelBlocks stone{};
+    stone.Fill(Voxel::Stone);
+    auto payload{EncodeChunkPayload(stone)};
+    REQUIRE(payload.size() == 4u);
+    REQUIRE(DecodeChunkPayload(payload, decoded));
+    REQUIRE(decoded.IsUniform());
+    REQUIRE(decoded.Get(0) == Voxel::Stone);
+
+    payload.pop_back();
+    REQUIRE_FALSE(DecodeChunkPayload(payload, decoded));
+}
+
+TEST_CASE("Saved chunks load back after reopening the store", "[VoxelRegionStore]") {
+    auto dir{FreshDir("roundtrip")};
+    const std::array<std::array<S32, 3>, 4> coords{{{0, 0, 0}, {-1, -1, -1}, {31, 7, 31}, {-33, 8, 64}}};
+    {
+        VoxelRegionStore store{dir};
+        for (U32 i{}; i < coords.size(); ++i) store.Save(coords[i][0], coords[i][1], coords[i][2], MakeChunk(i));
+
+        // Queued saves are visible before they reach the disk.
+        VoxelBlocks early{};
+        REQUIRE(store.Load(0, 0, 0, early));
+        store.Flush();
+    }
+
+    VoxelRegionStore store{dir};
+    for (U32 i{}; i < coords.size(); ++i) {
+        VoxelBlocks loaded{};
+        REQUIRE(store.Load(coords[i][0], coords[i][1], coords[i][2], loaded));
+        REQUIRE(SameBlocks(loaded, MakeChunk(i)));
+    }
+    VoxelBlocks missing{};
+    REQUIRE_FALSE(store.Load(5, 0, 5, missing));
+    REQUIRE(store.GetStats().misses == 1u);
+}
+
+TEST_CASE("Rewrites keep the latest version and compaction preserves it", "[VoxelRegionStore]") {
+    auto dir{FreshDir("compact")};
+    VoxelRegionStore store{dir};
+    for (U32 v{}; v < 40; ++v) {
+        store.Save(1, 0, 1, MakeChunk(v));
+        store.Save(2, 0, 1, MakeChunk(v + 100));
+    }
+    store.Flush();
+    const auto before{std::filesystem::file_size(RegionPath(dir, 1, 0, 1))};
+    store.CompactAll();
+    REQUIRE(std::filesystem::file_size(RegionPath(dir, 1, 0, 1)) <= before);
+
+    VoxelBlocks loaded{};
+    REQUIRE(store.Load(1, 0, 1, loaded));
+    REQUIRE(SameBlocks(loaded, MakeChunk(39)));
+    REQUIRE(store.Load(2, 0, 1, loaded));
+    REQUIRE(SameBlocks(loaded, MakeChunk(139)));
+}
+
+TEST_CASE("A torn or corrupted record falls back to the previous version", "[VoxelRegionStore]") {
+    auto dir{FreshDir("crash")};
+    auto path{RegionPath(dir, 4, 0, 4)};
+    {
+        VoxelRegionStore store{dir};
+        store.Save(4, 0, 4, MakeChunk(1));
+        store.Flush();
+    }
+    const auto v1Size{std::filesystem::file_size(path)};
+    {
+        VoxelRegionStore store{dir};
+        store.Save(4, 0, 4, MakeChunk(2));
+        store.Flush();
+    }
+    const auto v2Size{std::filesystem::file_size(path)};
+    REQUIRE(v2Size > v1Size);
+
+    std::ifstream in{path, std::ios::binary};
+    Vector<char> full(v2Size);
+    in.read(full.data(), static_cast<std::streamsize>(full.size()));
+    in.close();
+
+    auto restore = [&](USize bytes) {
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        out.write(full.data(), static_cast<std::streamsize>(bytes));
+    };
+
+    // Crash at several points while the second record was being appended. The table and
+    // end marker already name the new record, as in the worst case of an unflushed tail.
+    for (USize cut : {v1Size + 1, v1Size + 15, v1Size + 16, (v1Size + v2Size) / 2, v2Size - 1}) {
+        restore(cut);
+        VoxelRegionStore store{dir};
+        VoxelBlocks loaded{};
+        REQUIRE(store.Load(4, 0, 4, loaded));
+        REQUIRE(SameBlocks(loaded, MakeChunk(1)));
+        REQUIRE(std::filesystem::file_size(path) == v1Size);
+    }
+
+    // Complete record with a flipped payload byte and no trailing table update.
+    restore(v2Size);
+    {
+        std::fstream f{path, std::ios::in | std::ios::out | std::ios::binary};
+        f.seekp(static_cast<std::streamoff>(v2Size - 2));
+        f.put('\x5A');
+        f.seekp(16);
+        const U64 staleEnd{v1Size};
+        f.write(reinterpret_cast<const char*>(&staleEnd), sizeof(staleEnd));
+        f.seekp(0, std::ios::end);
+        f.put('\0');
+    }
+    VoxelRegionStore store{dir};
+    VoxelBlocks loaded{};
+    REQUIRE(store.Load(4, 0, 4, loaded));
+    REQUIRE(SameBlocks(loaded, MakeChunk(1)));
+    REQUIRE(store.GetStats().recoveries == 1u);
+}
+
+TEST_CASE("Recovery resyncs past a damaged record in the middle of the log", "[VoxelRegionStore]") {
+    auto dir{FreshDir("resync")};
+    auto path{RegionPath(dir, 4, 0, 4)};
+    REQUIRE(RegionPath(dir, 5, 0, 4) == path);
+    REQUIRE(RegionPath(dir, 6, 0, 4) == path);
+    U64 sizes[3]{};
+    {
+        VoxelRegionStore store{dir};
+        for (S32 i{}; i < 3; ++i) {
+            store.Save(4 + i, 0, 4, MakeChunk(10u + static_cast<U32>(i)));
+            store.Flush();
+            sizes[i] = std::filesystem::file_size(path);
+        }
+    }
+
+    // Damage the second record's payload and leave the end marker behind it, as if the
+    // machine went down before the table was rewritten.
+    {
+        std::fstream f{path, std::ios::in | std::ios::out | std::ios::binary};
+        f.seekp(static_cast<std::streamoff>(sizes[1] - 2));
+        f.put('\x5A');
+        f.seekp(16);
+        const U64 staleEnd{sizes[0]};
+        f.write(reinterpret_cast<const char*>(&staleEnd), sizeof(staleEnd));
+    }
+
+    VoxelRegionStore store{dir};
+    VoxelBlocks loaded{};
+    REQUIRE(store.Load(4, 0, 4, loaded));
+    REQUIRE(SameBlocks(loaded, MakeChunk(10)));
+    REQUIRE(store.Load(6, 0, 4, loaded));
+    REQUIRE(SameBlocks(loaded, MakeChunk(12)));
+    REQUIRE_FALSE(store.Load(5, 0, 4, loaded));
+    REQUIRE(store.GetStats().recoveries == 1u);
+    REQUIRE(std::filesystem::file_size(path) == sizes[2]);
+}
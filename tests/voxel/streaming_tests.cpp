@@ -0,0 +1,164 @@
+#include <catch2/catch.hpp>
+
+import Core.Types;
+import ECS.World;
+import Components.Voxel;
+import Components.Transform;
+import Components.VoxelStreaming;
+import Components.VoxelChunkIndex;
+import Components.VoxelStreamingEvents;
+import Systems.VoxelStreaming;
+import Systems.VoxelRegionStore;
+import Systems.CameraManager;
+import Math.Vector;
+import Math.Quaternion;
+import std;
+
+namespace {
+    // A 5x5 ring of chunks on one layer, created four per frame.
+    VoxelStreamingConfig SmallConfig() {
+        VoxelStreamingConfig sc{};
+        sc.radius = 2;
+        sc.margin = 1;
+        sc.minChunkY = 0;
+        sc.maxChunkY = 0;
+        sc.createBudget = 4;
+        sc.removeBudget = 64;
+        return sc;
+    }
+
+    struct StreamingWorld {
+        World world{};
+        VoxelStreamingSystem streaming{};
+        EntityHandle camera{};
+        F32 chunkSize{};
+
+        explicit StreamingWorld(VoxelStreamingConfig const& sc) {
+            CameraManager::Clear();
+            const VoxelWorldConfig wcfg{};
+            chunkSize = wcfg.blockSize * static_cast<F32>(VoxelChunk::SizeX);
+            world.AddComponent(world.CreateEntity(), wcfg);
+            world.AddComponent(world.CreateEntity(), sc);
+            camera = world.CreateEntity();
+            world.AddComponent(camera, Transform{});
+            CameraManager::SetPrimaryCamera(camera);
+            LookFrom(0, Math::Vec3{1.0f, 0.0f, 0.0f});
+            // The first frame only creates the world resources.
+            Frame();
+        }
+
+        ~StreamingWorld() { CameraManager::Clear(); }
+
+        // Places the camera at the center of chunk (cx, 0, 0).
+        void LookFrom(S32 cx, Math::Vec3 const& dir) {
+            Transform* t{world.GetComponent<Transform>(camera)};
+            t->SetPosition(Math::Vec3{(static_cast<F32>(cx) + 0.5f) * chunkSize, 0.5f * chunkSize, 0.5f * chunkSize});
+            // Yaw about +Y turns the default -Z forward toward dir.
+            t->rotation = Math::Quat::FromAxisAngle(Math::Vec3::UnitY, std::atan2(-dir.x, -dir.z));
+            REQUIRE(t->Forward().Dot(dir) > 0.99f);
+        }
+
+        std::span<const ChunkLoaded> Frame() {
+            streaming.Run(&world, 1.0f / 60.0f);
+            streaming.GetCommandBuffer()->Playback(world);
+            VoxelStreamingEvents* events{FindVoxelStreamingEvents(&world)};
+            return events ? events->loaded.Events() : std::span<const ChunkLoaded>{};
+        }
+
+        [[nodiscard]] U32 Loaded() { return FindVoxelChunkIndex(&world)->Size(); }
+    };
+}
+
+TEST_CASE("VoxelStreamingSystem splits creation across frames by budget", "[VoxelStreaming]") {
+    StreamingWorld sw{SmallConfig()};
+    REQUIRE(FindVoxelChunkIndex(&sw.world) != nullptr);
+    REQUIRE(sw.Loaded() == 0);
+
+    Vector<USize> perFrame{};
+    for (U32 f{}; f < 8; ++f) perFrame.push_back(sw.Frame().size());
+    REQUIRE(perFrame == Vector<USize>{4, 4, 4, 4, 4, 4, 1, 0});
+    REQUIRE(sw.Loaded() == 25);
+
+    VoxelChunkIndex const* index{FindVoxelChunkIndex(&sw.world)};
+    for (S32 cz{-2}; cz <= 2; ++cz) {
+        for (S32 cx{-2}; cx <= 2; ++cx) REQUIRE(index->Contains(cx, 0, cz));
+    }
+    REQUIRE_FALSE(index->Contains(3, 0, 0));
+}
+
+TEST_CASE("VoxelStreamingSystem re-prioritizes its queue when the camera turns or moves", "[VoxelStreaming]") {
+    StreamingWorld sw{SmallConfig()};
+
+    // Facing +X, the first batch is the camera's chunk and the chunks beside and ahead of it.
+    for (ChunkLoaded const& c : sw.Frame()) REQUIRE(c.cx >= 0);
+
+    SECTION("turning around") {
+        // Ranked for +X, the next batch would include chunks ahead; after the turn it is all behind.
+        sw.LookFrom(0, Math::Vec3{-1.0f, 0.0f, 0.0f});
+        const std::span<const ChunkLoaded> batch{sw.Frame()};
+        REQUIRE(batch.size() == 4);
+        for (ChunkLoaded const& c : batch) REQUIRE(c.cx < 0);
+    }
+
+    SECTION("moving to another chunk") {
+        sw.LookFrom(10, Math::Vec3{1.0f, 0.0f, 0.0f});
+        const std::span<const ChunkLoaded> batch{sw.Frame()};
+        REQUIRE(batch.size() == 4);
+        for (ChunkLoaded const& c : batch) REQUIRE(c.cx >= 10);
+        REQUIRE(FindVoxelChunkIndex(&sw.world)->Contains(10, 0, 0));
+    }
+}
+
+TEST_CASE("VoxelStreamingSystem keeps chunks inside the unload margin", "[VoxelStreaming]") {
+    StreamingWorld sw{SmallConfig()};
+    for (U32 f{}; f < 8; ++f) sw.Frame();
+    REQUIRE(sw.Loaded() == 25);
+
+    // One chunk over, the farthest column sits exactly at radius + margin.
+    sw.LookFrom(1, Math::Vec3{1.0f, 0.0f, 0.0f});
+    for (U32 f{}; f < 4; ++f) {
+        sw.Frame();
+        REQUIRE(FindVoxelStreamingEvents(&sw.world)->unloaded.Events().empty());
+    }
+    REQUIRE(sw.Loaded() == 30);
+
+    // Two chunks over, only the column at cx == -2 leaves.
+    sw.LookFrom(2, Math::Vec3{1.0f, 0.0f, 0.0f});
+    sw.Frame();
+    std::span<const ChunkUnloaded> unloaded{FindVoxelStreamingEvents(&sw.world)->unloaded.Events()};
+    REQUIRE(unloaded.size() == 5);
+    for (ChunkUnloaded const& c : unloaded) REQUIRE(c.cx == -2);
+
+    VoxelChunkIndex const* index{FindVoxelChunkIndex(&sw.world)};
+    for (S32 cz{-2}; cz <= 2; ++cz) {
+        REQUIRE_FALSE(index->Contains(-2, 0, cz));
+        REQUIRE(index->Contains(-1, 0, cz));
+    }
+}
+
+TEST_CASE("VoxelStreamingSystem saves edited chunks as they unload", "[VoxelStreaming]") {
+    const auto dir{std::filesystem::temp_directory_path() / "voksel_tests" / "streaming_save"};
+    std::filesystem::remove_all(dir);
+    auto store{std::make_shared<VoxelRegionStore>(dir)};
+
+    StreamingWorld sw{SmallConfig()};
+    sw.world.AddComponent(sw.world.CreateEntity(), VoxelRegionStoreResource{store});
+    for (U32 f{}; f < 8; ++f) sw.Frame();
+
+    VoxelChunk* edited{sw.world.GetComponent<VoxelChunk>(FindVoxelChunkIndex(&sw.world)->Find(-2, 0, 1))};
+    edited->blocks.Fill(Voxel::Air);
+    edited->blocks.Set(VoxelIndex(3, 4, 5), Voxel::Stone);
+    edited->modified = true;
+    VoxelChunk* untouched{sw.world.GetComponent<VoxelChunk>(FindVoxelChunkIndex(&sw.world)->Find(-2, 0, 0))};
+    untouched->blocks.Fill(Voxel::Stone);
+
+    sw.LookFrom(2, Math::Vec3{1.0f, 0.0f, 0.0f});
+    sw.Frame();
+    REQUIRE(FindVoxelStreamingEvents(&sw.world)->unloaded.Events().size() == 5);
+
+    VoxelBlocks loaded{};
+    REQUIRE(store->Load(-2, 0, 1, loaded));
+    REQUIRE(loaded.Get(VoxelIndex(3, 4, 5)) == Voxel::Stone);
+    REQUIRE(loaded.Get(VoxelIndex(0, 0, 0)) == Voxel::Air);
+    REQUIRE_FALSE(store->Load(-2, 0, 0, loaded));
+}